@@ -300,6 +300,11 @@ extern OD_ATTR_OD OD_t *OD;
 #define OD_ENTRY_H1A02 &OD->list[31]
 #define OD_ENTRY_H1A03 &OD->list[32]
 #define OD_ENTRY_H2110 &OD->list[33]
+#define OD_ENTRY_H2200 &OD->list[34]
+#define OD_ENTRY_H2210 &OD->list[35]
+#define OD_ENTRY_H2211 &OD->list[36]
+#define OD_ENTRY_H2220 &OD->list[37]
+#define OD_ENTRY_H2221 &OD->list[38]
 
 
 /*******************************************************************************
@@ -339,6 +344,11 @@ extern OD_ATTR_OD OD_t *OD;
 #define OD_ENTRY_H1A02_TPDOMappingParameter &OD->list[31]
 #define OD_ENTRY_H1A03_TPDOMappingParameter &OD->list[32]
 #define OD_ENTRY_H2110_object_test &OD->list[33]
+#define OD_ENTRY_H2200_PDORemap &OD->list[34]
+#define OD_ENTRY_H2210_SDOServerStatistics &OD->list[35]
+#define OD_ENTRY_H2211_SDOClientStatistics &OD->list[36]
+#define OD_ENTRY_H2220_emergencyCounters &OD->list[37]
+#define OD_ENTRY_H2221_emergencyLog &OD->list[38]
 
 
 /*******************************************************************************
@@ -0,0 +1,356 @@
+/*
+ * CANopen Emergency consumer table, active errors of each node.
+ *
+ * @file        CO_EMcons.c
+ * @ingroup     CO_EMcons
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "301/CO_EMcons.h"
+
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_CONS_TABLE
+
+/* verify configuration */
+#if !((CO_CONFIG_EM) & CO_CONFIG_EM_CONSUMER)
+ #error CO_CONFIG_EM_CONS_TABLE requires CO_CONFIG_EM_CONSUMER
+#endif
+#if CO_CONFIG_EM_CONS_NODES < 1 || CO_CONFIG_EM_CONS_NODES > 127
+ #error CO_CONFIG_EM_CONS_NODES is not correct
+#endif
+#if CO_CONFIG_EM_CONS_ACTIVE < 1 || CO_CONFIG_EM_CONS_ACTIVE > 255
+ #error CO_CONFIG_EM_CONS_ACTIVE is not correct
+#endif
+
+/* largest serialized node */
+#define EMCONS_NODE_MAX_SIZE (CO_EMCONS_NODE_SIZE \
+                              + CO_CONFIG_EM_CONS_ACTIVE * CO_EMCONS_ERROR_SIZE)
+
+/* serialize header */
+static void CO_EMcons_serializeHeader(const CO_EMcons_t *cons,
+                                      uint32_t changeCount,
+                                      uint8_t nodeCount,
+                                      uint8_t *buf)
+{
+    CO_setUint32(&buf[0], CO_SWAP_32(cons->clock_ms));
+    CO_setUint32(&buf[4], CO_SWAP_32(changeCount));
+    buf[8] = nodeCount;
+    CO_setUint16(&buf[9], CO_SWAP_16(cons->lostCount));
+}
+
+/* serialize node with first activeCount errors, return size */
+static size_t CO_EMcons_serializeNode(const CO_EMconsNode_t *node,
+                                      uint8_t activeCount, uint8_t *buf)
+{
+    buf[0] = node->nodeId;
+    buf[1] = node->errorRegister;
+    buf[2] = node->flags;
+    buf[3] = activeCount;
+    CO_setUint16(&buf[4], CO_SWAP_16(node->emcyCount));
+    CO_setUint32(&buf[6], CO_SWAP_32(node->lastTime_ms));
+    buf += CO_EMCONS_NODE_SIZE;
+
+    for (uint8_t i = 0; i < activeCount; i++) {
+        const CO_EMconsError_t *err = &node->active[i];
+
+        CO_setUint16(&buf[0], CO_SWAP_16(err->errorCode));
+        buf[2] = err->errorBit;
+        CO_setUint32(&buf[3], CO_SWAP_32(err->infoCode));
+        CO_setUint32(&buf[7], CO_SWAP_32(err->time_ms));
+        buf += CO_EMCONS_ERROR_SIZE;
+    }
+
+    return CO_EMCONS_NODE_SIZE + (size_t)activeCount * CO_EMCONS_ERROR_SIZE;
+}
+
+
+/*
+ * Custom function for reading OD object "Emergency consumer table"
+ *
+ * For more information see file CO_ODinterface.h, OD_IO_t.
+ */
+static ODR_t OD_read_EMcons(OD_stream_t *stream, void *buf,
+                            OD_size_t count, OD_size_t *countRead)
+{
+    if (stream == NULL || buf == NULL || countRead == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    CO_EMcons_t *cons = (CO_EMcons_t *)stream->object;
+
+    /* start of new upload, take a copy, which is streamed until the end */
+    if (stream->dataOffset == 0) {
+        cons->readLength = (OD_size_t)CO_EMcons_serialize(cons,
+                                        cons->readBuf, sizeof(cons->readBuf));
+    }
+    stream->dataLength = cons->readLength;
+
+    OD_size_t remaining = stream->dataOffset < cons->readLength
+                        ? cons->readLength - stream->dataOffset : 0;
+    ODR_t returnCode = ODR_OK;
+
+    if (remaining > count) {
+        remaining = count;
+        returnCode = ODR_PARTIAL;
+    }
+
+    memcpy(buf, &cons->readBuf[stream->dataOffset], remaining);
+
+    stream->dataOffset = (returnCode == ODR_PARTIAL)
+                       ? stream->dataOffset + remaining : 0;
+    *countRead = remaining;
+    return returnCode;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_EMcons_init(CO_EMcons_t *cons,
+                                CO_CANmodule_t *CANdevRx,
+                                OD_entry_t *OD_table)
+{
+    if (cons == NULL || CANdevRx == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(cons, 0, sizeof(CO_EMcons_t));
+    cons->CANdevRx = CANdevRx;
+
+    if (OD_table != NULL) {
+        cons->OD_table_extension.object = cons;
+        cons->OD_table_extension.read = OD_read_EMcons;
+        cons->OD_table_extension.write = NULL;
+        OD_extension_init(OD_table, &cons->OD_table_extension);
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_EMcons_initCallbackChange(CO_EMcons_t *cons,
+                                  void *object,
+                                  void (*pFunctChange)(void *object,
+                                                const CO_EMconsNode_t *node))
+{
+    if (cons != NULL) {
+        cons->functChangeObject = object;
+        cons->pFunctChange = pFunctChange;
+    }
+}
+
+
+/*
+ * Free the entry of the error free node, which sent its last emergency message
+ * first.
+ *
+ * @return Index of the entry + 1 or 0, if all nodes have errors.
+ */
+static uint8_t CO_EMcons_reclaim(CO_EMcons_t *cons) {
+    uint8_t index = 0;
+    uint32_t ageMax = 0;
+
+    for (uint8_t i = 0; i < cons->nodeCount; i++) {
+        const CO_EMconsNode_t *node = &cons->nodes[i];
+        uint32_t age = cons->clock_ms - node->lastTime_ms;
+
+        if (node->activeCount == 0 && node->errorRegister == 0
+            && (index == 0 || age > ageMax)
+        ) {
+            index = i + 1;
+            ageMax = age;
+        }
+    }
+
+    if (index != 0) {
+        CO_EMconsNode_t *node = &cons->nodes[index - 1];
+        cons->index[node->nodeId - 1] = 0;
+        memset(node, 0, sizeof(CO_EMconsNode_t));
+    }
+    return index;
+}
+
+
+/******************************************************************************/
+void CO_EMcons_receive(void *object,
+                       uint16_t ident,
+                       uint16_t errorCode,
+                       uint8_t errorRegister,
+                       uint8_t errorBit,
+                       uint32_t infoCode)
+{
+    CO_EMcons_t *cons = (CO_EMcons_t *)object;
+    uint8_t nodeId = (uint8_t)(ident & 0x7F);
+    CO_EMconsNode_t *node;
+
+    if (cons == NULL || nodeId == 0) {
+        return;
+    }
+
+    /* find the entry of the node or take a new one */
+    uint8_t index = cons->index[nodeId - 1];
+    if (index == 0) {
+        index = (cons->nodeCount < CO_CONFIG_EM_CONS_NODES)
+              ? ++cons->nodeCount : CO_EMcons_reclaim(cons);
+        if (index == 0) {
+            cons->lostCount++;
+            return;
+        }
+        cons->index[nodeId - 1] = index;
+        cons->nodes[index - 1].nodeId = nodeId;
+    }
+    node = &cons->nodes[index - 1];
+
+    node->errorRegister = errorRegister;
+    node->lastTime_ms = cons->clock_ms;
+    node->emcyCount++;
+
+    if (errorCode == CO_EMC_NO_ERROR) {
+        /* error reset, remove the condition or all, if node is error free */
+        uint8_t kept = 0;
+        for (uint8_t i = 0; i < node->activeCount; i++) {
+            if (errorRegister != 0 && node->active[i].errorBit != errorBit) {
+                node->active[kept++] = node->active[i];
+            }
+        }
+        node->activeCount = kept;
+    }
+    else {
+        CO_EMconsError_t *err = NULL;
+
+        for (uint8_t i = 0; i < node->activeCount; i++) {
+            if (node->active[i].errorCode == errorCode
+                && node->active[i].errorBit == errorBit
+            ) {
+                err = &node->active[i];
+                break;
+            }
+        }
+        if (err == NULL) {
+            if (node->activeCount >= CO_CONFIG_EM_CONS_ACTIVE) {
+                /* drop the oldest error */
+                memmove(&node->active[0], &node->active[1],
+                        (CO_CONFIG_EM_CONS_ACTIVE - 1)
+                        * sizeof(CO_EMconsError_t));
+                node->activeCount--;
+                node->flags |= CO_EMCONS_OVERFLOW;
+            }
+            err = &node->active[node->activeCount++];
+            err->errorCode = errorCode;
+            err->errorBit = errorBit;
+        }
+        err->infoCode = infoCode;
+        err->time_ms = cons->clock_ms;
+    }
+
+    cons->changed[nodeId >> 5] |= 1UL << (nodeId & 0x1F);
+    cons->changeCount++;
+}
+
+
+/******************************************************************************/
+bool_t CO_EMcons_read(CO_EMcons_t *cons,
+                      uint8_t nodeId,
+                      CO_EMconsNode_t *node)
+{
+    if (cons == NULL || node == NULL || nodeId < 1 || nodeId > 127) {
+        return false;
+    }
+
+    bool_t found = false;
+
+    CO_LOCK_EMCY(cons->CANdevRx);
+    uint8_t index = cons->index[nodeId - 1];
+    if (index != 0) {
+        *node = cons->nodes[index - 1];
+        found = true;
+    }
+    CO_UNLOCK_EMCY(cons->CANdevRx);
+
+    return found;
+}
+
+
+/******************************************************************************/
+size_t CO_EMcons_serialize(CO_EMcons_t *cons, uint8_t *buf, size_t bufSize) {
+    if (cons == NULL || buf == NULL || bufSize < CO_EMCONS_HEADER_SIZE) {
+        return 0;
+    }
+
+    size_t length = CO_EMCONS_HEADER_SIZE;
+    uint8_t nodeCount = 0;
+    uint32_t changeCount = cons->changeCount;
+
+    /* lock only one node at a time, not to delay CAN reception */
+    for (uint8_t i = 0; i < cons->nodeCount; i++) {
+        uint8_t piece[EMCONS_NODE_MAX_SIZE];
+        size_t pieceSize;
+
+        CO_LOCK_EMCY(cons->CANdevRx);
+        pieceSize = CO_EMcons_serializeNode(&cons->nodes[i],
+                                            cons->nodes[i].activeCount, piece);
+        CO_UNLOCK_EMCY(cons->CANdevRx);
+
+        if (length + pieceSize > bufSize) {
+            break;
+        }
+        memcpy(&buf[length], piece, pieceSize);
+        length += pieceSize;
+        nodeCount++;
+    }
+
+    /* change counter from before the copy, so changes are not missed */
+    CO_EMcons_serializeHeader(cons, changeCount, nodeCount, buf);
+
+    return length;
+}
+
+
+/******************************************************************************/
+void CO_EMcons_process(CO_EMcons_t *cons, uint32_t timeDifference_us) {
+    if (cons == NULL) {
+        return;
+    }
+
+    uint32_t us = timeDifference_us + cons->clockResidual_us;
+    cons->clock_ms += us / 1000;
+    cons->clockResidual_us = (uint16_t)(us % 1000);
+
+    for (uint8_t i = 0; i < 4; i++) {
+        uint32_t changed;
+
+        CO_LOCK_EMCY(cons->CANdevRx);
+        changed = cons->changed[i];
+        cons->changed[i] = 0;
+        CO_UNLOCK_EMCY(cons->CANdevRx);
+
+        for (uint8_t bit = 0; changed != 0 && cons->pFunctChange != NULL;
+             bit++, changed >>= 1
+        ) {
+            CO_EMconsNode_t node;
+
+            if ((changed & 1) != 0
+                && CO_EMcons_read(cons, (uint8_t)(i * 32 + bit), &node)
+            ) {
+                cons->pFunctChange(cons->functChangeObject, &node);
+            }
+        }
+    }
+}
+
+#endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_CONS_TABLE */
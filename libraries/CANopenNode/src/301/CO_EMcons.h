@@ -0,0 +1,288 @@
+/**
+ * CANopen Emergency consumer table, active errors of each node.
+ *
+ * @file        CO_EMcons.h
+ * @ingroup     CO_EMcons
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_EM_CONS_H
+#define CO_EM_CONS_H
+
+#include "301/CO_driver.h"
+#include "301/CO_ODinterface.h"
+#include "301/CO_Emergency.h"
+
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_CONS_TABLE) || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_EMcons Emergency consumer table
+ * Active errors of each node on the network, from received emergency messages.
+ *
+ * @ingroup CO_CANopen_301
+ * @{
+ * Emergency consumer table decodes each received emergency message
+ * (CO_CAN_ID_EMERGENCY + node-ID) and keeps the list of active errors of the
+ * sending node. Messages are passed from the emergency consumer with
+ * CO_EM_initCallbackRxTable(), so the callback from CO_EM_initCallbackRx()
+ * stays free for the application.
+ *
+ * Error with non-zero error code is added to the list of the node or, if the
+ * same error code and error bit is already active, updated. Message with error
+ * code CO_EMC_NO_ERROR removes the errors with the same error bit (byte 3 of
+ * the message, as sent by CANopenNode devices) or all errors, if error
+ * register is zero. If the list is full, the oldest error is dropped and
+ * CO_EMCONS_OVERFLOW is set.
+ *
+ * Entry for the node is taken from the pool of @ref CO_CONFIG_EM_CONS_NODES
+ * entries on the first emergency message. If the pool is full, the entry of an
+ * error free node (no active errors and error register zero), which sent its
+ * last emergency message first, is reused. If all nodes in the pool have
+ * errors, message is counted in CO_EMcons_t::lostCount. Entries are found by
+ * node-ID through the index array, so reception is O(1). Times are in milliseconds of CO_EMcons_t::clock_ms, which
+ * is advanced in CO_EMcons_process().
+ *
+ * Changed nodes are marked on reception and reported by the change callback
+ * from CO_EMcons_process(), outside of the receive context.
+ *
+ * The whole table is read with CO_EMcons_serialize() or with one SDO upload of
+ * DOMAIN object #CO_EMCONS_OD_INDEX. Format is little endian:
+ * - header, #CO_EMCONS_HEADER_SIZE bytes: CO_EMcons_t::clock_ms (4),
+ *   CO_EMcons_t::changeCount (4), number of nodes (1),
+ *   CO_EMcons_t::lostCount (2),
+ * - for each node, #CO_EMCONS_NODE_SIZE bytes: node-ID (1), error register
+ *   (1), flags (1), number of active errors (1), emergency count (2), time of
+ *   the last emergency (4),
+ * - followed by each active error, oldest first, #CO_EMCONS_ERROR_SIZE bytes:
+ *   error code (2), error bit (1), info code (4), time (4).
+ *
+ * SDO upload streams a copy of the table, serialized at its start into
+ * CO_EMcons_t::readBuf (#CO_EMCONS_TABLE_SIZE bytes), so all segments belong to
+ * the same table. If changeCount differs between two uploads, the table changed
+ * in between.
+ *
+ * If enabled, Emergency consumer table is initialized in CANopen.c file.
+ */
+
+/** Index of manufacturer specific DOMAIN object with the table. If object does
+ * not exist in Object Dictionary, table is still maintained. */
+#ifndef CO_EMCONS_OD_INDEX
+#define CO_EMCONS_OD_INDEX 0x2222
+#endif
+
+/** Size of serialized header, bytes */
+#define CO_EMCONS_HEADER_SIZE 11
+/** Size of serialized node without errors, bytes */
+#define CO_EMCONS_NODE_SIZE 10
+/** Size of serialized active error, bytes */
+#define CO_EMCONS_ERROR_SIZE 11
+/** Size of serialized table with all nodes and active errors, bytes */
+#define CO_EMCONS_TABLE_SIZE (CO_EMCONS_HEADER_SIZE + CO_CONFIG_EM_CONS_NODES \
+    * (CO_EMCONS_NODE_SIZE + CO_CONFIG_EM_CONS_ACTIVE * CO_EMCONS_ERROR_SIZE))
+
+
+/** Flags in CO_EMconsNode_t::flags */
+typedef enum {
+    CO_EMCONS_OVERFLOW = 0x01U /**< Active error was dropped, list was full */
+} CO_EMcons_flags_t;
+
+
+/**
+ * Active error of the node.
+ */
+typedef struct {
+    /** Additional information, bytes 4..7 of the emergency message */
+    uint32_t infoCode;
+    /** Time of the last message with this error, milliseconds */
+    uint32_t time_ms;
+    /** Error code, @ref CO_EM_errorCode_t */
+    uint16_t errorCode;
+    /** Error bit, byte 3 of the emergency message */
+    uint8_t errorBit;
+} CO_EMconsError_t;
+
+
+/**
+ * Emergency state of one node inside CO_EMcons_t.
+ */
+typedef struct {
+    /** Active errors, oldest first */
+    CO_EMconsError_t active[CO_CONFIG_EM_CONS_ACTIVE];
+    /** Time of the last emergency message, milliseconds */
+    uint32_t lastTime_ms;
+    /** Number of received emergency messages, wraps around */
+    uint16_t emcyCount;
+    /** Node-ID */
+    uint8_t nodeId;
+    /** Error register from the last emergency message */
+    uint8_t errorRegister;
+    /** Number of valid entries in active */
+    uint8_t activeCount;
+    /** Combination of @ref CO_EMcons_flags_t */
+    uint8_t flags;
+} CO_EMconsNode_t;
+
+
+/**
+ * Emergency consumer table object.
+ */
+typedef struct {
+    /** Entries of the nodes, see index */
+    CO_EMconsNode_t nodes[CO_CONFIG_EM_CONS_NODES];
+    /** nodes[index[nodeId - 1] - 1] is the entry of the node, 0 if none */
+    uint8_t index[127];
+    /** Number of used entries in nodes */
+    uint8_t nodeCount;
+    /** Number of emergency messages from nodes, which did not fit into the
+     * table, because all entries had errors, wraps around */
+    uint16_t lostCount;
+    /** Incremented on each received emergency message, wraps around */
+    volatile uint32_t changeCount;
+    /** Nodes changed since the last CO_EMcons_process(), bit (nodeId & 0x1F)
+     * of changed[nodeId >> 5] */
+    uint32_t changed[4];
+    /** Time since CO_EMcons_init(), milliseconds */
+    uint32_t clock_ms;
+    /** Residual microseconds of clock_ms */
+    uint16_t clockResidual_us;
+    /** From CO_EMcons_init() */
+    CO_CANmodule_t *CANdevRx;
+    /** From CO_EMcons_initCallbackChange() or NULL */
+    void (*pFunctChange)(void *object, const CO_EMconsNode_t *node);
+    /** From CO_EMcons_initCallbackChange() or NULL */
+    void *functChangeObject;
+    /** Table serialized at the start of the OD upload in progress */
+    uint8_t readBuf[CO_EMCONS_TABLE_SIZE];
+    /** Number of bytes in readBuf */
+    OD_size_t readLength;
+    /** Extension for OD object */
+    OD_extension_t OD_table_extension;
+} CO_EMcons_t;
+
+
+/**
+ * Initialize Emergency consumer table.
+ *
+ * Function must be called in the communication reset section. Table is
+ * cleared.
+ *
+ * @param cons This object will be initialized.
+ * @param CANdevRx CAN device for emergency reception, used for locking.
+ * @param OD_table OD entry of type DOMAIN, see #CO_EMCONS_OD_INDEX. May be
+ * NULL.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_EMcons_init(CO_EMcons_t *cons,
+                                CO_CANmodule_t *CANdevRx,
+                                OD_entry_t *OD_table);
+
+
+/**
+ * Initialize change callback function.
+ *
+ * Callback is called from CO_EMcons_process() once for each node, which
+ * received emergency messages since the previous call.
+ *
+ * @param cons This object.
+ * @param object Pointer to object, which will be passed to pFunctChange(). Can
+ * be NULL
+ * @param pFunctChange Pointer to the callback function. Not called if NULL.
+ * Argument node is a consistent copy of the entry.
+ */
+void CO_EMcons_initCallbackChange(CO_EMcons_t *cons,
+                                  void *object,
+                                  void (*pFunctChange)(void *object,
+                                                const CO_EMconsNode_t *node));
+
+
+/**
+ * Add received emergency message to the table.
+ *
+ * Function has the signature of the callback from CO_EM_initCallbackRxTable()
+ * and is called from the CAN receive function.
+ *
+ * @param object Pointer to CO_EMcons_t.
+ * @param ident CAN-ID of the emergency message.
+ * @param errorCode Error code from @ref CO_EM_errorCode_t.
+ * @param errorRegister Error register.
+ * @param errorBit Error bit.
+ * @param infoCode Additional information.
+ */
+void CO_EMcons_receive(void *object,
+                       uint16_t ident,
+                       uint16_t errorCode,
+                       uint8_t errorRegister,
+                       uint8_t errorBit,
+                       uint32_t infoCode);
+
+
+/**
+ * Copy emergency state of one node.
+ *
+ * @param cons This object.
+ * @param nodeId Node-ID, 1 to 127.
+ * @param [out] node Copy of the node state.
+ *
+ * @return true, if emergency message was received from the node.
+ */
+bool_t CO_EMcons_read(CO_EMcons_t *cons,
+                      uint8_t nodeId,
+                      CO_EMconsNode_t *node);
+
+
+/**
+ * Serialize the table.
+ *
+ * Format is described in @ref CO_EMcons. Each node is copied consistently.
+ * Nodes, which do not fit into buf, are omitted and not counted in the header.
+ *
+ * @param cons This object.
+ * @param [out] buf Buffer for the serialized table.
+ * @param bufSize Size of buf, at least #CO_EMCONS_HEADER_SIZE.
+ *
+ * @return Number of bytes written, 0 if buf is too small.
+ */
+size_t CO_EMcons_serialize(CO_EMcons_t *cons, uint8_t *buf, size_t bufSize);
+
+
+/**
+ * Process Emergency consumer table.
+ *
+ * Function must be called cyclically. It advances CO_EMcons_t::clock_ms and
+ * calls the change callback.
+ *
+ * @param cons This object.
+ * @param timeDifference_us Time difference from previous function call in
+ * [microseconds].
+ */
+void CO_EMcons_process(CO_EMcons_t *cons, uint32_t timeDifference_us);
+
+/** @} */ /* CO_EMcons */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_CONS_TABLE */
+
+#endif /* CO_EM_CONS_H */
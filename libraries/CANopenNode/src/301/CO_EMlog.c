@@ -0,0 +1,422 @@
+/*
+ * CANopen Emergency log, timestamped history which survives reset.
+ *
+ * @file        CO_EMlog.c
+ * @ingroup     CO_EMlog
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "301/CO_EMlog.h"
+#include "301/crc16-ccitt.h"
+
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_LOG
+
+/* verify configuration */
+#if !((CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY))
+ #error CO_CONFIG_EM_LOG requires CO_CONFIG_EM_PRODUCER or CO_CONFIG_EM_HISTORY
+#endif
+#if !((CO_CONFIG_CRC16) & CO_CONFIG_CRC16_ENABLE)
+ #error CO_CONFIG_CRC16_ENABLE must be enabled for CO_CONFIG_EM_LOG
+#endif
+#if CO_CONFIG_EM_LOG_SIZE < 1 || CO_CONFIG_EM_LOG_SIZE > 255
+ #error CO_CONFIG_EM_LOG_SIZE is not correct
+#endif
+#if CO_EMLOG_FLUSH_INTERVAL_MS > 4000000 || CO_EMLOG_FLUSH_DELAY_MS > 4000000
+ #error CO_EMLOG_FLUSH_INTERVAL_MS or CO_EMLOG_FLUSH_DELAY_MS is not correct
+#endif
+
+/* CRC covers the image from the member 'size' to the end */
+#define EMLOG_CRC_OFFSET offsetof(CO_EMlogRam_t, size)
+
+/* calculate CRC of the image */
+static uint16_t CO_EMlog_crc(const CO_EMlogRam_t *ram) {
+    return crc16_ccitt((const uint8_t *)ram + EMLOG_CRC_OFFSET,
+                       sizeof(CO_EMlogRam_t) - EMLOG_CRC_OFFSET, 0);
+}
+
+/* verify the image, read from no-init RAM or from flash */
+static bool_t CO_EMlog_valid(const CO_EMlogRam_t *ram) {
+    return ram->magic == CO_EMLOG_MAGIC
+        && ram->size == CO_CONFIG_EM_LOG_SIZE
+        && ram->head < CO_CONFIG_EM_LOG_SIZE
+        && ram->count <= CO_CONFIG_EM_LOG_SIZE
+        && ram->crc == CO_EMlog_crc(ram);
+}
+
+/* clear the image and keep boot counter */
+static void CO_EMlog_reset(CO_EMlogRam_t *ram, uint16_t bootCount) {
+    memset(ram, 0, sizeof(CO_EMlogRam_t));
+    ram->magic = CO_EMLOG_MAGIC;
+    ram->size = CO_CONFIG_EM_LOG_SIZE;
+    ram->bootCount = bootCount;
+    ram->crc = CO_EMlog_crc(ram);
+}
+
+/* new record or clear, flash write is delayed until the burst ends */
+static void CO_EMlog_changed(CO_EMlog_t *log) {
+    log->quietTimer_us = 0;
+    if (!log->dirty) {
+        log->dirty = true;
+        log->dirtyTimer_us = 0;
+    }
+}
+
+/* write the image to flash, on failure try again after the interval */
+static bool_t CO_EMlog_write(CO_EMlog_t *log) {
+    log->writeTimer_us = 0;
+    if (!log->flashWrite(log->flashObject, log->ram, sizeof(CO_EMlogRam_t))) {
+        log->dirtyTimer_us = 0;
+        return false;
+    }
+    log->dirty = false;
+    return true;
+}
+
+/* advance the timer, which stops at the limit */
+static uint32_t CO_EMlog_timer(uint32_t timer_us, uint32_t diff_us,
+                               uint32_t limit_us)
+{
+    return (limit_us - timer_us > diff_us) ? timer_us + diff_us : limit_us;
+}
+
+/* serialize record with index in the ring into 16 bytes, little endian */
+static void CO_EMlog_serialize(const CO_EMlogRam_t *ram, uint8_t index,
+                               uint8_t *buf)
+{
+    const CO_EMlogRecord_t *rec = &ram->records[index];
+
+    CO_setUint32(&buf[0], CO_SWAP_32(rec->ms));
+    CO_setUint16(&buf[4], CO_SWAP_16(rec->days));
+    CO_setUint16(&buf[6], CO_SWAP_16(rec->errorCode));
+    CO_setUint32(&buf[8], CO_SWAP_32(rec->infoCode));
+    buf[12] = rec->errorRegister;
+    buf[13] = rec->errorBit;
+    buf[14] = rec->flags;
+    buf[15] = rec->bootCount;
+}
+
+
+/*
+ * Custom functions for read/write OD object "Emergency log"
+ *
+ * For more information see file CO_ODinterface.h, OD_IO_t.
+ */
+static ODR_t OD_read_EMlog(OD_stream_t *stream, void *buf,
+                           OD_size_t count, OD_size_t *countRead)
+{
+    if (stream == NULL || buf == NULL || countRead == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    CO_EMlog_t *log = (CO_EMlog_t *)stream->object;
+    CO_EMlogRam_t *ram = log->ram;
+
+    /* start of new upload, records written during upload are not included */
+    if (stream->dataOffset == 0) {
+        log->readCount = ram->count;
+        log->readFirst = (uint8_t)((ram->head + CO_CONFIG_EM_LOG_SIZE
+                                    - ram->count) % CO_CONFIG_EM_LOG_SIZE);
+        stream->dataLength = (OD_size_t)log->readCount * CO_EMLOG_RECORD_SIZE;
+    }
+
+    OD_size_t length = (OD_size_t)log->readCount * CO_EMLOG_RECORD_SIZE;
+    OD_size_t remaining = stream->dataOffset < length
+                        ? length - stream->dataOffset : 0;
+    ODR_t returnCode = ODR_OK;
+
+    if (remaining > count) {
+        remaining = count;
+        returnCode = ODR_PARTIAL;
+    }
+
+    uint8_t *data = (uint8_t *)buf;
+    OD_size_t copied = 0;
+    while (copied < remaining) {
+        uint8_t record[CO_EMLOG_RECORD_SIZE];
+        OD_size_t offset = stream->dataOffset + copied;
+        OD_size_t recordOffset = offset % CO_EMLOG_RECORD_SIZE;
+        OD_size_t chunk = CO_EMLOG_RECORD_SIZE - recordOffset;
+        uint8_t index = (uint8_t)((log->readFirst
+                                   + offset / CO_EMLOG_RECORD_SIZE)
+                                  % CO_CONFIG_EM_LOG_SIZE);
+
+        if (chunk > remaining - copied) {
+            chunk = remaining - copied;
+        }
+        CO_EMlog_serialize(ram, index, record);
+        memcpy(&data[copied], &record[recordOffset], chunk);
+        copied += chunk;
+    }
+
+    stream->dataOffset = (returnCode == ODR_PARTIAL)
+                       ? stream->dataOffset + remaining : 0;
+    *countRead = remaining;
+    return returnCode;
+}
+
+static ODR_t OD_write_EMlog(OD_stream_t *stream, const void *buf,
+                            OD_size_t count, OD_size_t *countWritten)
+{
+    if (stream == NULL || buf == NULL || countWritten == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    /* one byte: 0 clears the log, 1 requests the flash write */
+    if (count != 1 || stream->dataOffset != 0) {
+        return ODR_TYPE_MISMATCH;
+    }
+
+    CO_EMlog_t *log = (CO_EMlog_t *)stream->object;
+    switch (CO_getUint8(buf)) {
+        case 0:
+            CO_EMlog_clear(log);
+            break;
+        case 1:
+            /* burst is over, CO_EMlog_process() writes as soon as the
+             * interval allows, so remote request does not wear the flash */
+            log->quietTimer_us = (uint32_t)CO_EMLOG_FLUSH_DELAY_MS * 1000;
+            break;
+        default:
+            return ODR_INVALID_VALUE;
+    }
+
+    *countWritten = count;
+    return ODR_OK;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_EMlog_init(CO_EMlog_t *log,
+                               CO_EMlogRam_t *ram,
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE
+                               CO_TIME_t *TIME,
+#endif
+                               OD_entry_t *OD_log)
+{
+    if (log == NULL || ram == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    /* first call after power-on or reset, log object is still zeroed */
+    if (log->ram != ram) {
+        log->ram = ram;
+        if (!CO_EMlog_valid(ram)) {
+            CO_EMlog_reset(ram, 0);
+            log->restorePending = true;
+        }
+        ram->bootCount++;
+        ram->crc = CO_EMlog_crc(ram);
+    }
+
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE
+    log->TIME = TIME;
+#endif
+    log->readCount = 0;
+
+    if (OD_log != NULL) {
+        log->OD_log_extension.object = log;
+        log->OD_log_extension.read = OD_read_EMlog;
+        log->OD_log_extension.write = OD_write_EMlog;
+        OD_extension_init(OD_log, &log->OD_log_extension);
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_EMlog_initFlash(CO_EMlog_t *log,
+                        void *object,
+                        bool_t (*flashWrite)(void *object,
+                                             const void *data,
+                                             size_t size),
+                        bool_t (*flashRead)(void *object,
+                                            void *data,
+                                            size_t size))
+{
+    if (log == NULL) {
+        return;
+    }
+
+    log->flashObject = object;
+    log->flashWrite = flashWrite;
+    log->flashRead = flashRead;
+
+    /* RAM image was lost, restore records from flash */
+    if (log->restorePending && log->ram != NULL && flashRead != NULL) {
+        CO_EMlogRam_t *ram = log->ram;
+        uint16_t bootCount = ram->bootCount;
+
+        log->restorePending = false;
+        if (flashRead(object, ram, sizeof(CO_EMlogRam_t))
+            && CO_EMlog_valid(ram)
+        ) {
+            ram->bootCount++;
+            ram->crc = CO_EMlog_crc(ram);
+        }
+        else {
+            CO_EMlog_reset(ram, bootCount);
+        }
+    }
+}
+
+
+/******************************************************************************/
+void CO_EMlog_record(void *object,
+                     uint16_t errorCode,
+                     uint8_t errorRegister,
+                     uint8_t errorBit,
+                     uint32_t infoCode)
+{
+    CO_EMlog_t *log = (CO_EMlog_t *)object;
+
+    if (log == NULL || log->ram == NULL) {
+        return;
+    }
+
+    CO_EMlogRam_t *ram = log->ram;
+    CO_EMlogRecord_t *rec = &ram->records[ram->head];
+
+    rec->ms = log->uptime_ms;
+    rec->days = log->uptimeDays;
+    rec->flags = 0;
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE
+    if (log->TIME != NULL) {
+        rec->ms = log->TIME->ms;
+        rec->days = log->TIME->days;
+        rec->flags = CO_EMLOG_FLAG_TIME;
+    }
+#endif
+    rec->errorCode = errorCode;
+    rec->infoCode = infoCode;
+    rec->errorRegister = errorRegister;
+    rec->errorBit = errorBit;
+    rec->bootCount = (uint8_t)ram->bootCount;
+
+    if (++ram->head >= CO_CONFIG_EM_LOG_SIZE) {
+        ram->head = 0;
+    }
+    if (ram->count < CO_CONFIG_EM_LOG_SIZE) {
+        ram->count++;
+    }
+    ram->crc = CO_EMlog_crc(ram);
+
+    CO_EMlog_changed(log);
+}
+
+
+/******************************************************************************/
+bool_t CO_EMlog_get(CO_EMlog_t *log, uint8_t n, CO_EMlogRecord_t *record) {
+    if (log == NULL || log->ram == NULL || record == NULL
+        || n >= log->ram->count
+    ) {
+        return false;
+    }
+
+    CO_EMlogRam_t *ram = log->ram;
+    uint8_t index = (uint8_t)((ram->head + CO_CONFIG_EM_LOG_SIZE - 1 - n)
+                              % CO_CONFIG_EM_LOG_SIZE);
+    *record = ram->records[index];
+    return true;
+}
+
+
+/******************************************************************************/
+void CO_EMlog_clear(CO_EMlog_t *log) {
+    if (log == NULL || log->ram == NULL) {
+        return;
+    }
+
+    CO_EMlog_reset(log->ram, log->ram->bootCount);
+    log->readCount = 0;
+    CO_EMlog_changed(log);
+}
+
+
+/******************************************************************************/
+bool_t CO_EMlog_flush(CO_EMlog_t *log) {
+    if (log == NULL || log->ram == NULL || log->flashWrite == NULL) {
+        return false;
+    }
+
+    return !log->dirty || CO_EMlog_write(log);
+}
+
+
+/******************************************************************************/
+void CO_EMlog_process(CO_EMlog_t *log,
+                      uint32_t timeDifference_us,
+                      uint32_t *timerNext_us)
+{
+    (void)timerNext_us; /* may be unused */
+
+    if (log == NULL) {
+        return;
+    }
+
+    /* update time since power-on */
+    uint32_t us = timeDifference_us + log->uptimeResidual_us;
+    log->uptime_ms += us / 1000;
+    log->uptimeResidual_us = (uint16_t)(us % 1000);
+    if (log->uptime_ms >= ((uint32_t)1000*60*60*24)) {
+        log->uptime_ms -= ((uint32_t)1000*60*60*24);
+        log->uptimeDays++;
+    }
+
+    const uint32_t delay_us = (uint32_t)CO_EMLOG_FLUSH_DELAY_MS * 1000;
+    const uint32_t interval_us = (uint32_t)CO_EMLOG_FLUSH_INTERVAL_MS * 1000;
+    log->writeTimer_us = CO_EMlog_timer(log->writeTimer_us,
+                                        timeDifference_us, interval_us);
+
+    if (!log->dirty || log->flashWrite == NULL) {
+        return;
+    }
+
+    log->quietTimer_us = CO_EMlog_timer(log->quietTimer_us,
+                                        timeDifference_us, delay_us);
+    log->dirtyTimer_us = CO_EMlog_timer(log->dirtyTimer_us,
+                                        timeDifference_us, interval_us);
+
+    /* lazy write to flash after the burst of records, at most once per
+     * interval, so flapping error does not wear out the flash */
+    if ((log->writeTimer_us >= interval_us && log->quietTimer_us >= delay_us)
+        || log->dirtyTimer_us >= interval_us
+    ) {
+        CO_EMlog_write(log);
+    }
+#if (CO_CONFIG_EM) & CO_CONFIG_FLAG_TIMERNEXT
+    if (log->dirty && timerNext_us != NULL) {
+        uint32_t diff = interval_us - log->dirtyTimer_us;
+        uint32_t diffQuiet = interval_us - log->writeTimer_us;
+        if (diffQuiet < delay_us - log->quietTimer_us) {
+            diffQuiet = delay_us - log->quietTimer_us;
+        }
+        if (diff > diffQuiet) {
+            diff = diffQuiet;
+        }
+        if (*timerNext_us > diff) {
+            *timerNext_us = diff;
+        }
+    }
+#endif
+}
+
+#endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_LOG */
@@ -0,0 +1,328 @@
+/**
+ * CANopen Emergency log, timestamped history which survives reset.
+ *
+ * @file        CO_EMlog.h
+ * @ingroup     CO_EMlog
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_EM_LOG_H
+#define CO_EM_LOG_H
+
+#include "301/CO_driver.h"
+#include "301/CO_ODinterface.h"
+#include "301/CO_Emergency.h"
+#include "301/CO_TIME.h"
+
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_LOG) || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_EMlog Emergency log
+ * Timestamped history of emergency messages, which survives reset.
+ *
+ * @ingroup CO_CANopen_301
+ * @{
+ * Emergency log records each emergency message sent by this device, together
+ * with its error register and time. Pre-defined error field (0x1003) keeps
+ * only error code and register, without time, and is cleared on each reset.
+ * That is usually just when history is needed after a field incident.
+ *
+ * Records are stored in a ring of @ref CO_CONFIG_EM_LOG_SIZE entries inside
+ * @ref CO_EMlogRam_t. Application places it into RAM, which is not cleared by
+ * the startup code (#CO_EMLOG_NOINIT), so the log survives software and
+ * watchdog resets. Ring is protected by CRC, invalid ring is discarded.
+ *
+ * The same image is lazily written to flash by the application callback,
+ * registered with CO_EMlog_initFlash(). Each write usually erases a flash page,
+ * so writes are rare: log is written, when no record was added for
+ * #CO_EMLOG_FLUSH_DELAY_MS (end of the error burst), but not earlier than
+ * #CO_EMLOG_FLUSH_INTERVAL_MS after the previous write or after power-on. If
+ * records keep coming, log is written #CO_EMLOG_FLUSH_INTERVAL_MS after the
+ * first unsaved record. So a fault, which flaps all the time, costs one write
+ * per interval. CO_EMlog_flush() writes the log at once, for example before a
+ * planned power-off. If RAM image is not valid after power-on, the flash image
+ * is restored.
+ *
+ * Time is taken from @ref CO_TIME (milliseconds after midnight and days since
+ * January 1, 1984), if TIME object is used. Otherwise it is the time since
+ * power-on in the same format. Each record also contains the low byte of the
+ * boot counter, so records from different runs can be distinguished.
+ *
+ * Whole log is read with one SDO upload of DOMAIN object
+ * #CO_EMLOG_OD_INDEX: consecutive records from @ref CO_EMlogRecord_t, oldest
+ * first, each 16 bytes, little endian. Writing one byte with value 0 clears
+ * the log, value 1 ends the flush delay, so the log is written as soon as
+ * #CO_EMLOG_FLUSH_INTERVAL_MS from the previous write expires.
+ *
+ * If enabled, Emergency log is initialized in CANopen.c file.
+ */
+
+/** Index of manufacturer specific DOMAIN object with emergency log. If object
+ * does not exist in Object Dictionary, log is still recorded. */
+#ifndef CO_EMLOG_OD_INDEX
+#define CO_EMLOG_OD_INDEX 0x2221
+#endif
+
+/** Attribute, which places @ref CO_EMlogRam_t into RAM, which is not cleared
+ * on reset. If empty, log is lost on reset and only restored from flash. */
+#ifndef CO_EMLOG_NOINIT
+#define CO_EMLOG_NOINIT
+#endif
+
+/** Time without new records before the flash write, in milliseconds */
+#ifndef CO_EMLOG_FLUSH_DELAY_MS
+#define CO_EMLOG_FLUSH_DELAY_MS 10000
+#endif
+
+/** Minimum time between two flash writes and maximum time of unsaved record,
+ * in milliseconds, up to 4000000. Default one hour: 10000 erase cycles last
+ * more than a year with fault, which flaps all the time. */
+#ifndef CO_EMLOG_FLUSH_INTERVAL_MS
+#define CO_EMLOG_FLUSH_INTERVAL_MS 3600000
+#endif
+
+/** Value of CO_EMlogRam_t::magic */
+#define CO_EMLOG_MAGIC 0x474C4D45UL
+
+/** Size of serialized record in the OD object, bytes */
+#define CO_EMLOG_RECORD_SIZE 16
+
+
+/** Flags in CO_EMlogRecord_t::flags */
+typedef enum {
+    CO_EMLOG_FLAG_TIME = 0x01U /**< Time is from @ref CO_TIME object */
+} CO_EMlog_flags_t;
+
+
+/**
+ * One record of the emergency log. Serialized in the same order.
+ */
+typedef struct {
+    /** Milliseconds after midnight */
+    uint32_t ms;
+    /** Days since January 1, 1984 or since power-on */
+    uint16_t days;
+    /** Error code from @ref CO_EM_errorCode_t */
+    uint16_t errorCode;
+    /** Additional information, bytes 4..7 of the emergency message */
+    uint32_t infoCode;
+    /** Error register, @ref CO_errorRegister_t */
+    uint8_t errorRegister;
+    /** Error status bit, @ref CO_EM_errorStatusBits_t */
+    uint8_t errorBit;
+    /** Flags from @ref CO_EMlog_flags_t */
+    uint8_t flags;
+    /** Low byte of CO_EMlogRam_t::bootCount */
+    uint8_t bootCount;
+} CO_EMlogRecord_t;
+
+
+/**
+ * Emergency log image in no-init RAM and in flash.
+ */
+typedef struct {
+    /** @ref CO_EMLOG_MAGIC, if image was written */
+    uint32_t magic;
+    /** CRC16-CCITT of all following members */
+    uint16_t crc;
+    /** Number of records, @ref CO_CONFIG_EM_LOG_SIZE, verified on init */
+    uint8_t size;
+    /** Index, where next record will be written */
+    uint8_t head;
+    /** Number of valid records */
+    uint8_t count;
+    /** Reserved, written as 0 */
+    uint8_t reserved;
+    /** Incremented on each power-on or reset */
+    uint16_t bootCount;
+    /** Ring of records */
+    CO_EMlogRecord_t records[CO_CONFIG_EM_LOG_SIZE];
+} CO_EMlogRam_t;
+
+
+/**
+ * Emergency log object.
+ */
+typedef struct {
+    /** From CO_EMlog_init() */
+    CO_EMlogRam_t *ram;
+#if ((CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE) || defined CO_DOXYGEN
+    /** From CO_EMlog_init() or NULL */
+    CO_TIME_t *TIME;
+#endif
+    /** Time since power-on, milliseconds after midnight */
+    uint32_t uptime_ms;
+    /** Time since power-on, days */
+    uint16_t uptimeDays;
+    /** Residual microseconds of uptime_ms */
+    uint16_t uptimeResidual_us;
+    /** True, if RAM image was not valid on init and flash was not read yet */
+    bool_t restorePending;
+    /** True, if records were added or cleared after the last flash write */
+    bool_t dirty;
+    /** Time from the last record, microseconds, stops at flush delay */
+    uint32_t quietTimer_us;
+    /** Time from the first unsaved record, microseconds, stops at interval */
+    uint32_t dirtyTimer_us;
+    /** Time from the last flash write or from power-on, microseconds, stops
+     * at interval */
+    uint32_t writeTimer_us;
+    /** First record (oldest first) of the OD upload in progress */
+    uint8_t readFirst;
+    /** Number of records of the OD upload in progress */
+    uint8_t readCount;
+    /** From CO_EMlog_initFlash() or NULL */
+    bool_t (*flashWrite)(void *object, const void *data, size_t size);
+    /** From CO_EMlog_initFlash() or NULL */
+    bool_t (*flashRead)(void *object, void *data, size_t size);
+    /** From CO_EMlog_initFlash() or NULL */
+    void *flashObject;
+    /** Extension for OD object */
+    OD_extension_t OD_log_extension;
+} CO_EMlog_t;
+
+
+/**
+ * Initialize Emergency log.
+ *
+ * Function must be called in the communication reset section. Valid image in
+ * ram is kept, otherwise it is cleared. Boot counter is incremented only on
+ * the first call after power-on or reset.
+ *
+ * @param log This object will be initialized. It must be zeroed before the
+ * first call and must not be cleared on communication reset.
+ * @param ram Log image, preferably in no-init RAM, see #CO_EMLOG_NOINIT.
+ * @param TIME TIME object for timestamps. May be NULL, then time since
+ * power-on is used. Only with CO_CONFIG_TIME_ENABLE.
+ * @param OD_log OD entry of type DOMAIN, see #CO_EMLOG_OD_INDEX. May be NULL.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_EMlog_init(CO_EMlog_t *log,
+                               CO_EMlogRam_t *ram,
+#if ((CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE) || defined CO_DOXYGEN
+                               CO_TIME_t *TIME,
+#endif
+                               OD_entry_t *OD_log);
+
+
+/**
+ * Initialize flash functions.
+ *
+ * Functions are target specific and write or read whole @ref CO_EMlogRam_t
+ * image. They are called from CO_EMlog_process(), CO_EMlog_flush() or from
+ * this function, never from interrupt. If RAM image was not valid in CO_EMlog_init(), flash image
+ * is read and restored here, if its CRC is correct.
+ *
+ * @param log This object.
+ * @param object Pointer to object, which will be passed to the functions.
+ * @param flashWrite Write image, return true on success. May be NULL.
+ * @param flashRead Read image, return true on success. May be NULL.
+ */
+void CO_EMlog_initFlash(CO_EMlog_t *log,
+                        void *object,
+                        bool_t (*flashWrite)(void *object,
+                                             const void *data,
+                                             size_t size),
+                        bool_t (*flashRead)(void *object,
+                                            void *data,
+                                            size_t size));
+
+
+/**
+ * Add record to the log.
+ *
+ * Function has the signature of the callback from CO_EM_initCallbackLog() and
+ * is called from CO_EM_process() for each sent emergency message. Oldest
+ * record is overwritten, if log is full.
+ *
+ * @param object Pointer to CO_EMlog_t.
+ * @param errorCode Error code from @ref CO_EM_errorCode_t.
+ * @param errorRegister Error register.
+ * @param errorBit Error status bit.
+ * @param infoCode Additional information.
+ */
+void CO_EMlog_record(void *object,
+                     uint16_t errorCode,
+                     uint8_t errorRegister,
+                     uint8_t errorBit,
+                     uint32_t infoCode);
+
+
+/**
+ * Get record from the log.
+ *
+ * @param log This object.
+ * @param n Record number, 0 is the newest.
+ * @param [out] record Copy of the record.
+ *
+ * @return True, if record exists.
+ */
+bool_t CO_EMlog_get(CO_EMlog_t *log, uint8_t n, CO_EMlogRecord_t *record);
+
+
+/**
+ * Clear all records. Boot counter is kept.
+ *
+ * @param log This object.
+ */
+void CO_EMlog_clear(CO_EMlog_t *log);
+
+
+/**
+ * Write the log to flash now.
+ *
+ * Flush delay and interval are ignored. Function is for the application, for
+ * example before a planned power-off. It blocks for the flash write, so it
+ * should not be called on each remote request, see #CO_EMLOG_OD_INDEX.
+ *
+ * @param log This object.
+ *
+ * @return True, if log was written or there was nothing to write.
+ */
+bool_t CO_EMlog_flush(CO_EMlog_t *log);
+
+
+/**
+ * Process Emergency log.
+ *
+ * Function must be called cyclically. It updates time since power-on and
+ * writes the log to flash, when flush delay and interval expire.
+ *
+ * @param log This object.
+ * @param timeDifference_us Time difference from previous function call in
+ * [microseconds].
+ * @param [out] timerNext_us info to OS - see CO_process().
+ */
+void CO_EMlog_process(CO_EMlog_t *log,
+                      uint32_t timeDifference_us,
+                      uint32_t *timerNext_us);
+
+/** @} */ /* CO_EMlog */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_LOG */
+
+#endif /* CO_EM_LOG_H */
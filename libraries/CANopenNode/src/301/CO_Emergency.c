@@ -33,6 +33,14 @@
     || (CO_CONFIG_EM_ERR_STATUS_BITS_COUNT % 8) != 0
  #error CO_CONFIG_EM_ERR_STATUS_BITS_COUNT is not correct
 #endif
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_COALESCE
+ #if !((CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER)
+  #error CO_CONFIG_EM_COALESCE requires CO_CONFIG_EM_PRODUCER
+ #endif
+ #if CO_CONFIG_EM_ERR_STATUS_BITS_COUNT > 248
+  #error CO_CONFIG_EM_ERR_STATUS_BITS_COUNT must not exceed 248 with coalescing
+ #endif
+#endif
 
 /* fifo buffer example for fifoSize = 7 (actual capacity = 6)                 *
  *                                                                            *
@@ -307,6 +315,170 @@ static ODR_t OD_write_statusBits(OD_stream_t *stream, const void *buf,
 }
 #endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_STATUS_BITS */
 
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_COALESCE
+/*
+ * Custom functions for read/write OD object with emergency counters
+ *
+ * For more information see file CO_ODinterface.h, OD_IO_t.
+ */
+static ODR_t OD_read_coalesce(OD_stream_t *stream, void *buf,
+                              OD_size_t count, OD_size_t *countRead)
+{
+    if (stream == NULL || buf == NULL || countRead == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    CO_EM_t *em = (CO_EM_t *)stream->object;
+
+    if (stream->subIndex == 0) {
+        if (count < sizeof(uint8_t)) {
+            return ODR_DEV_INCOMPAT;
+        }
+        CO_setUint8(buf, CO_CONFIG_EM_ERR_STATUS_BITS_COUNT + 1);
+        *countRead = sizeof(uint8_t);
+        return ODR_OK;
+    }
+    if (stream->subIndex > CO_CONFIG_EM_ERR_STATUS_BITS_COUNT + 1) {
+        return ODR_SUB_NOT_EXIST;
+    }
+    if (count < sizeof(uint16_t)) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    CO_setUint16(buf, stream->subIndex == 1 ? em->coalesceWindow_ms
+                      : em->coalesce[stream->subIndex - 2].count);
+    *countRead = sizeof(uint16_t);
+    return ODR_OK;
+}
+
+static ODR_t OD_write_coalesce(OD_stream_t *stream, const void *buf,
+                               OD_size_t count, OD_size_t *countWritten)
+{
+    if (stream == NULL || buf == NULL || countWritten == NULL
+        || count != sizeof(uint16_t)
+    ) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    CO_EM_t *em = (CO_EM_t *)stream->object;
+    uint16_t value = CO_getUint16(buf);
+
+    if (stream->subIndex == 0) {
+        return ODR_READONLY;
+    }
+    if (stream->subIndex > CO_CONFIG_EM_ERR_STATUS_BITS_COUNT + 1) {
+        return ODR_SUB_NOT_EXIST;
+    }
+    if (stream->subIndex == 1) {
+        if (value > 60000) {
+            return ODR_INVALID_VALUE;
+        }
+        em->coalesceWindow_ms = value;
+    }
+    else {
+        /* counters can only be cleared */
+        if (value != 0) {
+            return ODR_INVALID_VALUE;
+        }
+        em->coalesce[stream->subIndex - 2].count = 0;
+    }
+
+    *countWritten = sizeof(uint16_t);
+    return ODR_OK;
+}
+#endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_COALESCE */
+
+#if (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY)
+/*
+ * Write message into fifo buffer, must be called inside CO_LOCK_EMCY.
+ *
+ * Returns false, if fifo buffer is full.
+ */
+static bool_t CO_EM_fifoPut(CO_EM_t *em, uint32_t msg, uint32_t info) {
+    uint8_t fifoWrPtr = em->fifoWrPtr;
+    uint8_t fifoWrPtrNext = fifoWrPtr + 1;
+    if (fifoWrPtrNext >= em->fifoSize) {
+        fifoWrPtrNext = 0;
+    }
+
+    if (fifoWrPtrNext == em->fifoPpPtr) {
+        return false;
+    }
+
+    em->fifo[fifoWrPtr].msg = msg;
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER
+    em->fifo[fifoWrPtr].info = info;
+ #else
+    (void)info;
+ #endif
+    em->fifoWrPtr = fifoWrPtrNext;
+    if (em->fifoCount < (em->fifoSize - 1)) em->fifoCount++;
+    return true;
+}
+#endif
+
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_COALESCE
+/*
+ * Finish coalescing windows, which expired. If messages were suppressed within
+ * the window, queue summary message with current state of the error condition
+ * and start new window. Otherwise stop coalescing for the error condition.
+ */
+static void CO_EM_coalesceProcess(CO_EM_t *em, uint32_t *timerNext_us) {
+    (void)timerNext_us; /* may be unused */
+
+    for (uint8_t index = 0;
+         index < (CO_CONFIG_EM_ERR_STATUS_BITS_COUNT / 8); index++)
+    {
+        if (em->coalesceActive[index] == 0) {
+            continue;
+        }
+        for (uint8_t i = 0; i < 8; i++) {
+            uint8_t bitmask = 1 << i;
+            uint8_t errorBit = (index << 3) + i;
+            CO_EM_coalesce_t *coalesce = &em->coalesce[errorBit];
+
+            if ((em->coalesceActive[index] & bitmask) == 0) {
+                continue;
+            }
+
+            CO_LOCK_EMCY(em->CANdevTx);
+            uint16_t age_ms = em->coalesceClock_ms - coalesce->stamp_ms;
+            if (age_ms < em->coalesceWindow_ms) {
+ #if (CO_CONFIG_EM) & CO_CONFIG_FLAG_TIMERNEXT
+                if (coalesce->suppressed > 0 && timerNext_us != NULL) {
+                    uint32_t diff = (uint32_t)(em->coalesceWindow_ms - age_ms)
+                                    * 1000 - em->coalesceClock_us;
+                    if (*timerNext_us > diff) {
+                        *timerNext_us = diff;
+                    }
+                }
+ #endif
+            }
+            else if (coalesce->suppressed == 0) {
+                em->coalesceActive[index] &= ~bitmask;
+            }
+            else {
+                uint16_t errorCode =
+                    (em->errorStatusBits[index] & bitmask) != 0
+                    ? coalesce->errorCode : CO_EMC_NO_ERROR;
+                uint32_t errMsg = (uint32_t)errorBit << 24
+                                  | CO_SWAP_16(errorCode);
+
+                /* if fifo is full, try again later */
+                if (em->fifoSize < 2
+                    || CO_EM_fifoPut(em, errMsg,
+                                     CO_SWAP_32((uint32_t)coalesce->suppressed))
+                ) {
+                    coalesce->stamp_ms = em->coalesceClock_ms;
+                    coalesce->suppressed = 0;
+                }
+            }
+            CO_UNLOCK_EMCY(em->CANdevTx);
+        }
+    }
+}
+#endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_COALESCE */
+
 #if (CO_CONFIG_EM) & CO_CONFIG_EM_CONSUMER
 /*
  * Read received message from CAN module.
@@ -318,7 +490,11 @@ static ODR_t OD_write_statusBits(OD_stream_t *stream, const void *buf,
 static void CO_EM_receive(void *object, void *msg) {
     CO_EM_t *em = (CO_EM_t*)object;
 
-    if (em != NULL && em->pFunctSignalRx != NULL) {
+    if (em != NULL && (em->pFunctSignalRx != NULL
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_CONS_TABLE
+                       || em->pFunctRxTable != NULL
+ #endif
+    )) {
         uint16_t ident = CO_CANrxMsg_readIdent(msg);
 
         /* ignore sync messages (necessary if sync object is not used) */
@@ -329,11 +505,23 @@ static void CO_EM_receive(void *object, void *msg) {
 
             memcpy(&errorCode, &data[0], sizeof(errorCode));
             memcpy(&infoCode, &data[4], sizeof(infoCode));
-            em->pFunctSignalRx(ident,
-                               CO_SWAP_16(errorCode),
-                               data[2],
-                               data[3],
-                               CO_SWAP_32(infoCode));
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_CONS_TABLE
+            if (em->pFunctRxTable != NULL) {
+                em->pFunctRxTable(em->functRxTableObject,
+                                  ident,
+                                  CO_SWAP_16(errorCode),
+                                  data[2],
+                                  data[3],
+                                  CO_SWAP_32(infoCode));
+            }
+ #endif
+            if (em->pFunctSignalRx != NULL) {
+                em->pFunctSignalRx(ident,
+                                   CO_SWAP_16(errorCode),
+                                   data[2],
+                                   data[3],
+                                   CO_SWAP_32(infoCode));
+            }
         }
     }
 }
@@ -537,6 +725,61 @@ void CO_EM_initCallbackRx(CO_EM_t *em,
 }
 #endif
 
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_CONS_TABLE
+void CO_EM_initCallbackRxTable(CO_EM_t *em,
+                               void *object,
+                               void (*pFunctRxTable)(void *object,
+                                                     uint16_t ident,
+                                                     uint16_t errorCode,
+                                                     uint8_t errorRegister,
+                                                     uint8_t errorBit,
+                                                     uint32_t infoCode))
+{
+    if (em != NULL) {
+        em->functRxTableObject = object;
+        em->pFunctRxTable = pFunctRxTable;
+    }
+}
+#endif
+
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_COALESCE
+CO_ReturnError_t CO_EM_initCoalesce(CO_EM_t *em,
+                                    uint16_t window_ms,
+                                    OD_entry_t *OD_coalesce)
+{
+    if (em == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    em->coalesceWindow_ms = window_ms > 60000 ? 60000 : window_ms;
+
+    if (OD_coalesce != NULL) {
+        em->OD_coalesce_extension.object = em;
+        em->OD_coalesce_extension.read = OD_read_coalesce;
+        em->OD_coalesce_extension.write = OD_write_coalesce;
+        OD_extension_init(OD_coalesce, &em->OD_coalesce_extension);
+    }
+
+    return CO_ERROR_NO;
+}
+#endif
+
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_LOG
+void CO_EM_initCallbackLog(CO_EM_t *em,
+                           void *object,
+                           void (*pFunctLog)(void *object,
+                                             uint16_t errorCode,
+                                             uint8_t errorRegister,
+                                             uint8_t errorBit,
+                                             uint32_t infoCode))
+{
+    if (em != NULL) {
+        em->functLogObject = object;
+        em->pFunctLog = pFunctLog;
+    }
+}
+#endif
+
 #if (CO_CONFIG_EM) & CO_CONFIG_FLAG_CALLBACK_PRE
 void CO_EM_initCallbackPre(CO_EM_t *em,
                            void *object,
@@ -620,6 +863,15 @@ void CO_EM_process(CO_EM_t *em,
         errorRegister |= CO_ERR_REG_MANUFACTURER;
     *em->errorRegister = errorRegister;
 
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_COALESCE
+    em->coalesceClock_us += timeDifference_us;
+    if (em->coalesceClock_us >= 1000) {
+        em->coalesceClock_ms += (uint16_t)(em->coalesceClock_us / 1000);
+        em->coalesceClock_us %= 1000;
+    }
+    CO_EM_coalesceProcess(em, timerNext_us);
+#endif
+
     if (!NMTisPreOrOperational) {
         return;
     }
@@ -649,6 +901,17 @@ void CO_EM_process(CO_EM_t *em,
                 sizeof(em->CANtxBuff->data));
             CO_CANsend(em->CANdevTx, em->CANtxBuff);
 
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_LOG
+            if (em->pFunctLog != NULL) {
+                uint32_t errMsg = em->fifo[fifoPpPtr].msg;
+                em->pFunctLog(em->functLogObject,
+                              CO_SWAP_16((uint16_t) errMsg),
+                              errorRegister,
+                              (uint8_t) (errMsg >> 24),
+                              CO_SWAP_32(em->fifo[fifoPpPtr].info));
+            }
+ #endif
+
  #if (CO_CONFIG_EM) & CO_CONFIG_EM_CONSUMER
             /* report also own emergency messages */
             if (em->pFunctSignalRx != NULL) {
@@ -697,6 +960,17 @@ void CO_EM_process(CO_EM_t *em,
             /* add error register to emergency message and increment pointers */
             em->fifo[fifoPpPtr].msg |= (uint32_t) errorRegister << 16;
 
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_LOG
+            if (em->pFunctLog != NULL) {
+                uint32_t errMsg = em->fifo[fifoPpPtr].msg;
+                em->pFunctLog(em->functLogObject,
+                              CO_SWAP_16((uint16_t) errMsg),
+                              errorRegister,
+                              (uint8_t) (errMsg >> 24),
+                              0);
+            }
+ #endif
+
             if (++fifoPpPtr >= em->fifoSize) {
                 fifoPpPtr = 0;
             }
@@ -717,11 +991,18 @@ void CO_error(CO_EM_t *em, bool_t setError, const uint8_t errorBit,
 
     uint8_t index = errorBit >> 3;
     uint8_t bitmask = 1 << (errorBit & 0x7);
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_COALESCE
+    uint8_t coalesceIdx = errorBit;
+    bool_t suppress = false;
+#endif
 
     /* if unsupported errorBit, change to 'CO_EM_WRONG_ERROR_REPORT' */
     if (index >= (CO_CONFIG_EM_ERR_STATUS_BITS_COUNT / 8)) {
         index = CO_EM_WRONG_ERROR_REPORT >> 3;
         bitmask = 1 << (CO_EM_WRONG_ERROR_REPORT & 0x7);
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_COALESCE
+        coalesceIdx = CO_EM_WRONG_ERROR_REPORT;
+#endif
         errorCode = CO_EMC_SOFTWARE_INTERNAL;
         infoCode = errorBit;
     }
@@ -746,9 +1027,7 @@ void CO_error(CO_EM_t *em, bool_t setError, const uint8_t errorBit,
 #if (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY)
     /* prepare emergency message. Error register will be added in post-process*/
     uint32_t errMsg = (uint32_t)errorBit << 24 | CO_SWAP_16(errorCode);
- #if (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER
     uint32_t infoCodeSwapped = CO_SWAP_32(infoCode);
- #endif
 #endif
 
     /* safely write data, and increment pointers */
@@ -756,26 +1035,39 @@ void CO_error(CO_EM_t *em, bool_t setError, const uint8_t errorBit,
     if (setError) *errorStatusBits |= bitmask;
     else          *errorStatusBits &= ~bitmask;
 
-#if (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY)
-    if (em->fifoSize >= 2) {
-        uint8_t fifoWrPtr = em->fifoWrPtr;
-        uint8_t fifoWrPtrNext = fifoWrPtr + 1;
-        if (fifoWrPtrNext >= em->fifoSize) {
-            fifoWrPtrNext = 0;
-        }
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_COALESCE
+    CO_EM_coalesce_t *coalesce = &em->coalesce[coalesceIdx];
+    if (setError) {
+        if (coalesce->count < 0xFFFF) coalesce->count++;
+        coalesce->errorCode = errorCode;
+    }
 
-        if (fifoWrPtrNext == em->fifoPpPtr) {
-            em->fifoOverflow = 1;
+    /* suppress repeated message within the coalescing window, summary will
+     * be queued by CO_EM_process() after the window expires. */
+    if (em->coalesceWindow_ms != 0) {
+        uint16_t age_ms = em->coalesceClock_ms - coalesce->stamp_ms;
+        if ((em->coalesceActive[index] & bitmask) != 0
+            && age_ms < em->coalesceWindow_ms
+        ) {
+            if (coalesce->suppressed < 0xFFFF) coalesce->suppressed++;
+            suppress = true;
         }
         else {
-            em->fifo[fifoWrPtr].msg = errMsg;
- #if (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER
-            em->fifo[fifoWrPtr].info = infoCodeSwapped;
- #endif
-            em->fifoWrPtr = fifoWrPtrNext;
-            if (em->fifoCount < (em->fifoSize - 1)) em->fifoCount++;
+            em->coalesceActive[index] |= bitmask;
+            coalesce->stamp_ms = em->coalesceClock_ms;
         }
     }
+#endif
+
+#if (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY)
+    if (em->fifoSize >= 2
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_COALESCE
+        && !suppress
+ #endif
+        && !CO_EM_fifoPut(em, errMsg, infoCodeSwapped)
+    ) {
+        em->fifoOverflow = 1;
+    }
 #endif /* (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY) */
 
     CO_UNLOCK_EMCY(em->CANdevTx);
@@ -39,6 +39,15 @@
 #ifndef CO_CONFIG_EM_ERR_STATUS_BITS_COUNT
 #define CO_CONFIG_EM_ERR_STATUS_BITS_COUNT (10*8)
 #endif
+#ifndef CO_CONFIG_EM_LOG_SIZE
+#define CO_CONFIG_EM_LOG_SIZE 16
+#endif
+#ifndef CO_CONFIG_EM_CONS_NODES
+#define CO_CONFIG_EM_CONS_NODES 16
+#endif
+#ifndef CO_CONFIG_EM_CONS_ACTIVE
+#define CO_CONFIG_EM_CONS_ACTIVE 4
+#endif
 #ifndef CO_CONFIG_ERR_CONDITION_GENERIC
 #define CO_CONFIG_ERR_CONDITION_GENERIC (em->errorStatusBits[5] != 0)
 #endif
@@ -98,7 +107,28 @@ extern "C" {
  *
  * ### Emergency consumer
  * If @ref CO_CONFIG_EM has CO_CONFIG_EM_CONSUMER enabled, then callback can be
- * registered by @ref CO_EM_initCallbackRx() function.
+ * registered by @ref CO_EM_initCallbackRx() function. If CO_CONFIG_EM_CONS_TABLE
+ * is also enabled, received messages are aggregated into the table of active
+ * errors of each node, see @ref CO_EMcons.
+ *
+ * ### Emergency coalescing
+ * If @ref CO_CONFIG_EM has CO_CONFIG_EM_COALESCE enabled, then each error
+ * condition has its own occurrence counter and flapping conditions are
+ * rate limited. After emergency message for an error condition is queued,
+ * further changes of the same condition within the coalescing window are not
+ * queued, only counted. When the window expires and changes were suppressed,
+ * one summary emergency message is queued. It contains current state of the
+ * error condition (last error code or CO_EMC_NO_ERROR) and number of
+ * suppressed messages in bytes 4..7. So each error condition sends at most one
+ * emergency message per window and the last message always shows its actual
+ * state. Window is set by CO_EM_initCoalesce(), zero disables suppression.
+ *
+ * Counters and the window are accessible through manufacturer specific OD
+ * object #CO_EM_COALESCE_OD_INDEX, ARRAY of UNSIGNED16:
+ * - sub-index 0: highest sub-index, CO_CONFIG_EM_ERR_STATUS_BITS_COUNT + 1,
+ * - sub-index 1: coalescing window in milliseconds, read/write, 0 to 60000,
+ * - sub-index 2 + n: number of occurrences of error condition n (see
+ *   @ref CO_EM_errorStatusBits_t), saturates at 0xFFFF. Writing 0 clears it.
  */
 
 
@@ -374,6 +404,34 @@ typedef struct {
 #endif
 
 
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_COALESCE) || defined CO_DOXYGEN
+/** Index of manufacturer specific ARRAY object with emergency counters. If
+ * object does not exist in Object Dictionary, coalescing still works. */
+#ifndef CO_EM_COALESCE_OD_INDEX
+#define CO_EM_COALESCE_OD_INDEX 0x2220
+#endif
+
+/** Default coalescing window in milliseconds, used by CO_CANopenInit(). */
+#ifndef CO_EM_COALESCE_WINDOW_MS
+#define CO_EM_COALESCE_WINDOW_MS 1000
+#endif
+
+/**
+ * Coalescing state of one error condition
+ */
+typedef struct {
+    /** Number of times error condition was set, saturated */
+    uint16_t count;
+    /** Error code from last CO_errorReport() */
+    uint16_t errorCode;
+    /** Value of CO_EM_t::coalesceClock_ms, when message was last queued */
+    uint16_t stamp_ms;
+    /** Number of messages suppressed since stamp_ms, saturated */
+    uint16_t suppressed;
+} CO_EM_coalesce_t;
+#endif
+
+
 /**
  * Emergency object.
  */
@@ -446,6 +504,32 @@ typedef struct {
     OD_extension_t OD_statusBits_extension;
 #endif
 
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_COALESCE) || defined CO_DOXYGEN
+    /** Coalescing state for each error condition */
+    CO_EM_coalesce_t coalesce[CO_CONFIG_EM_ERR_STATUS_BITS_COUNT];
+    /** Bitfield of error conditions with running coalescing window */
+    uint8_t coalesceActive[CO_CONFIG_EM_ERR_STATUS_BITS_COUNT / 8];
+    /** Coalescing window in milliseconds, 0 disables suppression */
+    uint16_t coalesceWindow_ms;
+    /** Free running clock in milliseconds, advanced by CO_EM_process() */
+    uint16_t coalesceClock_ms;
+    /** Remainder of coalesceClock_ms in microseconds */
+    uint32_t coalesceClock_us;
+    /** Extension for OD object */
+    OD_extension_t OD_coalesce_extension;
+#endif
+
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_LOG) || defined CO_DOXYGEN
+    /** From CO_EM_initCallbackLog() or NULL */
+    void (*pFunctLog)(void *object,
+                      uint16_t errorCode,
+                      uint8_t errorRegister,
+                      uint8_t errorBit,
+                      uint32_t infoCode);
+    /** From CO_EM_initCallbackLog() or NULL */
+    void *functLogObject;
+#endif
+
 #if ((CO_CONFIG_EM) & CO_CONFIG_EM_CONSUMER) || defined CO_DOXYGEN
     /** From CO_EM_initCallbackRx() or NULL */
     void (*pFunctSignalRx)(const uint16_t ident,
@@ -455,6 +539,18 @@ typedef struct {
                            const uint32_t infoCode);
 #endif
 
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_CONS_TABLE) || defined CO_DOXYGEN
+    /** From CO_EM_initCallbackRxTable() or NULL */
+    void (*pFunctRxTable)(void *object,
+                          uint16_t ident,
+                          uint16_t errorCode,
+                          uint8_t errorRegister,
+                          uint8_t errorBit,
+                          uint32_t infoCode);
+    /** From CO_EM_initCallbackRxTable() or NULL */
+    void *functRxTableObject;
+#endif
+
 #if ((CO_CONFIG_EM) & CO_CONFIG_FLAG_CALLBACK_PRE) || defined CO_DOXYGEN
     /** From CO_EM_initCallbackPre() or NULL */
     void (*pFunctSignalPre)(void *object);
@@ -548,6 +644,64 @@ void CO_EM_initCallbackPre(CO_EM_t *em,
 #endif
 
 
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_COALESCE) || defined CO_DOXYGEN
+/**
+ * Initialize Emergency coalescing.
+ *
+ * Function must be called after CO_EM_init(). Until then, occurrences are
+ * counted, but no messages are suppressed.
+ *
+ * @param em This object.
+ * @param window_ms Coalescing window in milliseconds, 0 disables suppression.
+ * Values above 60000 are limited.
+ * @param OD_coalesce OD entry of type ARRAY with UNSIGNED16 sub-indexes, see
+ * #CO_EM_COALESCE_OD_INDEX. May be NULL.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_EM_initCoalesce(CO_EM_t *em,
+                                    uint16_t window_ms,
+                                    OD_entry_t *OD_coalesce);
+
+
+/**
+ * Get number of occurrences of error condition.
+ *
+ * @param em This object.
+ * @param errorBit from @ref CO_EM_errorStatusBits_t.
+ *
+ * @return Number of times error condition was set, saturated at 0xFFFF.
+ */
+static inline uint16_t CO_EM_getCount(CO_EM_t *em, const uint8_t errorBit) {
+    return (em == NULL || errorBit >= CO_CONFIG_EM_ERR_STATUS_BITS_COUNT)
+           ? 0 : em->coalesce[errorBit].count;
+}
+#endif
+
+
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_LOG) || defined CO_DOXYGEN
+/**
+ * Initialize Emergency log callback function.
+ *
+ * Callback is called from CO_EM_process() for each emergency message sent by
+ * this device (or added to the error history, if producer is disabled), after
+ * error register is known. It is usually CO_EMlog_record().
+ *
+ * @param em This object.
+ * @param object Pointer to object, which will be passed to pFunctLog(). Can be
+ * NULL
+ * @param pFunctLog Pointer to the callback function. Not called if NULL.
+ */
+void CO_EM_initCallbackLog(CO_EM_t *em,
+                           void *object,
+                           void (*pFunctLog)(void *object,
+                                             uint16_t errorCode,
+                                             uint8_t errorRegister,
+                                             uint8_t errorBit,
+                                             uint32_t infoCode));
+#endif
+
+
 #if ((CO_CONFIG_EM) & CO_CONFIG_EM_CONSUMER) || defined CO_DOXYGEN
 /**
  * Initialize Emergency received callback function.
@@ -573,6 +727,33 @@ void CO_EM_initCallbackRx(CO_EM_t *em,
 #endif
 
 
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_CONS_TABLE) || defined CO_DOXYGEN
+/**
+ * Initialize Emergency table callback function.
+ *
+ * Callback is called for each received emergency message, besides the
+ * callback from CO_EM_initCallbackRx(). Own emergency messages are not passed.
+ * It is usually CO_EMcons_receive().
+ *
+ * @remark Depending on the CAN driver implementation, this function is called
+ * inside an ISR or inside a mainline. Must be thread safe.
+ *
+ * @param em This object.
+ * @param object Pointer to object, which will be passed to pFunctRxTable().
+ * Can be NULL
+ * @param pFunctRxTable Pointer to the callback function. Not called if NULL.
+ */
+void CO_EM_initCallbackRxTable(CO_EM_t *em,
+                               void *object,
+                               void (*pFunctRxTable)(void *object,
+                                                     uint16_t ident,
+                                                     uint16_t errorCode,
+                                                     uint8_t errorRegister,
+                                                     uint8_t errorBit,
+                                                     uint32_t infoCode));
+#endif
+
+
 /**
  * Process Error control and Emergency object.
  *
@@ -601,6 +782,7 @@ void CO_EM_process(CO_EM_t *em,
  * true and error bit wasn't set or setError is false and error bit was set
  * before). If changed, then Emergency message is prepared and record in history
  * is added. Emergency message is later sent by CO_EM_process() function.
+ * With CO_CONFIG_EM_COALESCE, message may be suppressed and summarized later.
  *
  * Function is short and thread safe.
  *
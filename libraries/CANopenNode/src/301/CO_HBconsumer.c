@@ -40,6 +40,40 @@
  * message with correct identifier will be received. For more information and
  * description of parameters see file CO_driver.h.
  */
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_DEADLINE
+static void CO_HBcons_receive(void *object, void *msg) {
+    CO_HBconsumer_t *HBcons = object;
+    uint8_t DLC = CO_CANrxMsg_readDLC(msg);
+    uint8_t *data = CO_CANrxMsg_readData(msg);
+    uint8_t idx = HBcons->idxByNodeId[CO_CANrxMsg_readIdent(msg) & 0x7F];
+
+    if (DLC == 1 && idx < HBcons->numberOfMonitoredNodes) {
+        CO_HBconsNode_t *HBconsNode = &HBcons->monitoredNodes[idx];
+        uint8_t count = HBcons->numberOfMonitoredNodes;
+        uint8_t head = HBcons->rxQueueHead;
+        uint8_t queued = head >= HBcons->rxQueueTail
+                       ? head - HBcons->rxQueueTail
+                       : head + 2 * count - HBcons->rxQueueTail;
+
+        HBconsNode->NMTstateRx = (CO_NMT_internalState_t)data[0];
+
+        /* Put node into the queue, if it is not there yet. Each node is in the
+         * queue only once, so it never overflows. */
+        if (!CO_FLAG_READ(HBconsNode->CANrxNew) && queued < count) {
+            HBcons->monitoredNodes[head < count ? head : head - count]
+                .rxQueueItem = idx;
+            CO_FLAG_SET(HBconsNode->CANrxNew);
+            HBcons->rxQueueHead = (head + 1) < (2 * count) ? head + 1 : 0;
+        }
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_CALLBACK_PRE
+        /* Optional signal to RTOS, which can resume task, which handles HBcons. */
+        if (HBconsNode->pFunctSignalPre != NULL) {
+            HBconsNode->pFunctSignalPre(HBconsNode->functSignalObjectPre);
+        }
+#endif
+    }
+}
+#else
 static void CO_HBcons_receive(void *object, void *msg) {
     CO_HBconsNode_t *HBconsNode = object;
     uint8_t DLC = CO_CANrxMsg_readDLC(msg);
@@ -57,6 +91,153 @@ static void CO_HBcons_receive(void *object, void *msg) {
 #endif
     }
 }
+#endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_DEADLINE */
+
+
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_DEADLINE
+/*
+ * Count configured nodes, which are not active and not operational.
+ *
+ * Called after configuration changes, process function updates the counters.
+ */
+static void countStates(CO_HBconsumer_t *HBcons) {
+    HBcons->notActiveCount = 0;
+    HBcons->notOperationalCount = 0;
+
+    for (uint8_t i = 0; i < HBcons->numberOfMonitoredNodes; i++) {
+        CO_HBconsNode_t *monitoredNode = &HBcons->monitoredNodes[i];
+
+        if (monitoredNode->HBstate == CO_HBconsumer_UNCONFIGURED) {
+            continue;
+        }
+        if (monitoredNode->HBstate != CO_HBconsumer_ACTIVE) {
+            HBcons->notActiveCount++;
+        }
+        if (monitoredNode->NMTstate != CO_NMT_OPERATIONAL) {
+            HBcons->notOperationalCount++;
+        }
+    }
+}
+
+
+/*
+ * Set heartbeat state and NMT state of configured node and update counters.
+ */
+static void setStates(CO_HBconsumer_t *HBcons,
+                      CO_HBconsNode_t *monitoredNode,
+                      CO_HBconsumer_state_t HBstate,
+                      CO_NMT_internalState_t NMTstate)
+{
+    if (monitoredNode->HBstate != HBstate) {
+        if (HBstate == CO_HBconsumer_ACTIVE) {
+            HBcons->notActiveCount--;
+        }
+        else if (monitoredNode->HBstate == CO_HBconsumer_ACTIVE) {
+            HBcons->notActiveCount++;
+        }
+        monitoredNode->HBstate = HBstate;
+    }
+    if (monitoredNode->NMTstate != NMTstate) {
+        if (NMTstate == CO_NMT_OPERATIONAL) {
+            HBcons->notOperationalCount--;
+        }
+        else if (monitoredNode->NMTstate == CO_NMT_OPERATIONAL) {
+            HBcons->notOperationalCount++;
+        }
+        monitoredNode->NMTstate = NMTstate;
+    }
+}
+
+
+/*
+ * Binary min-heap of active nodes, ordered by deadline_us. Element at heap
+ * position 'pos' is monitoredNodes[pos].heapItem, position of the node 'idx'
+ * is monitoredNodes[idx].heapPos. Deadlines are compared as signed difference,
+ * so clock_us may wrap around.
+ */
+static inline bool_t heapBefore(CO_HBconsumer_t *HBcons, uint8_t idxA,
+                                uint8_t idxB)
+{
+    return (int32_t)(HBcons->monitoredNodes[idxA].deadline_us
+                     - HBcons->monitoredNodes[idxB].deadline_us) < 0;
+}
+
+static inline void heapSet(CO_HBconsumer_t *HBcons, uint8_t pos, uint8_t idx) {
+    HBcons->monitoredNodes[pos].heapItem = idx;
+    HBcons->monitoredNodes[idx].heapPos = pos;
+}
+
+static void heapSiftUp(CO_HBconsumer_t *HBcons, uint8_t pos) {
+    uint8_t idx = HBcons->monitoredNodes[pos].heapItem;
+
+    while (pos > 0) {
+        uint8_t parent = (pos - 1) / 2;
+        uint8_t idxParent = HBcons->monitoredNodes[parent].heapItem;
+
+        if (!heapBefore(HBcons, idx, idxParent)) {
+            break;
+        }
+        heapSet(HBcons, pos, idxParent);
+        pos = parent;
+    }
+    heapSet(HBcons, pos, idx);
+}
+
+static void heapSiftDown(CO_HBconsumer_t *HBcons, uint8_t pos) {
+    uint8_t idx = HBcons->monitoredNodes[pos].heapItem;
+
+    for (;;) {
+        uint16_t child = 2 * (uint16_t)pos + 1;
+        uint8_t idxChild;
+
+        if (child >= HBcons->heapCount) {
+            break;
+        }
+        idxChild = HBcons->monitoredNodes[child].heapItem;
+        if ((child + 1) < HBcons->heapCount) {
+            uint8_t idxRight = HBcons->monitoredNodes[child + 1].heapItem;
+            if (heapBefore(HBcons, idxRight, idxChild)) {
+                child++;
+                idxChild = idxRight;
+            }
+        }
+        if (!heapBefore(HBcons, idxChild, idx)) {
+            break;
+        }
+        heapSet(HBcons, pos, idxChild);
+        pos = (uint8_t)child;
+    }
+    heapSet(HBcons, pos, idx);
+}
+
+/* Insert the node or move it after its deadline_us was increased. */
+static void heapUpdate(CO_HBconsumer_t *HBcons, uint8_t idx) {
+    uint8_t pos = HBcons->monitoredNodes[idx].heapPos;
+
+    if (pos == CO_HB_CONS_NO_IDX) {
+        pos = HBcons->heapCount++;
+        heapSet(HBcons, pos, idx);
+        heapSiftUp(HBcons, pos);
+    }
+    else {
+        heapSiftDown(HBcons, pos);
+    }
+}
+
+static void heapRemove(CO_HBconsumer_t *HBcons, uint8_t idx) {
+    uint8_t pos = HBcons->monitoredNodes[idx].heapPos;
+
+    HBcons->monitoredNodes[idx].heapPos = CO_HB_CONS_NO_IDX;
+    HBcons->heapCount--;
+    if (pos < HBcons->heapCount) {
+        /* move the last element to the free position */
+        heapSet(HBcons, pos,
+                HBcons->monitoredNodes[HBcons->heapCount].heapItem);
+        heapSiftDown(HBcons, pos);
+        heapSiftUp(HBcons, pos);
+    }
+}
+#endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_DEADLINE */
 
 
 /*
@@ -142,6 +323,19 @@ CO_ReturnError_t CO_HBconsumer_init(CO_HBconsumer_t *HBcons,
         OD_1016_HBcons->subEntriesCount-1 < monitoredNodesCount ?
         OD_1016_HBcons->subEntriesCount-1 : monitoredNodesCount;
 
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_DEADLINE
+    if (HBcons->numberOfMonitoredNodes > 127) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    memset(HBcons->idxByNodeId, CO_HB_CONS_NO_IDX,
+           sizeof(HBcons->idxByNodeId));
+    for (uint8_t i = 0; i < HBcons->numberOfMonitoredNodes; i++) {
+        monitoredNodes[i].HBstate = CO_HBconsumer_UNCONFIGURED;
+        monitoredNodes[i].heapPos = CO_HB_CONS_NO_IDX;
+        CO_FLAG_CLEAR(monitoredNodes[i].CANrxNew);
+    }
+#endif
+
     for (uint8_t i = 0; i < HBcons->numberOfMonitoredNodes; i++) {
         uint32_t val;
         odRet = OD_get_u32(OD_1016_HBcons, i + 1, &val, true);
@@ -205,6 +399,17 @@ static CO_ReturnError_t CO_HBconsumer_initEntry(CO_HBconsumer_t *HBcons,
         uint16_t COB_ID;
 
         CO_HBconsNode_t * monitoredNode = &HBcons->monitoredNodes[idx];
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_DEADLINE
+        if (monitoredNode->heapPos != CO_HB_CONS_NO_IDX) {
+            heapRemove(HBcons, idx);
+        }
+        if (HBcons->idxByNodeId[monitoredNode->nodeId & 0x7F] == idx) {
+            HBcons->idxByNodeId[monitoredNode->nodeId & 0x7F] =
+                CO_HB_CONS_NO_IDX;
+        }
+        /* node may still be in the receive queue, it will be ignored there */
+        monitoredNode->NMTstateRx = CO_NMT_UNKNOWN;
+#endif
         monitoredNode->nodeId = nodeId;
         monitoredNode->time_us = (int32_t)consumerTime_ms * 1000;
         monitoredNode->NMTstate = CO_NMT_UNKNOWN;
@@ -212,7 +417,9 @@ static CO_ReturnError_t CO_HBconsumer_initEntry(CO_HBconsumer_t *HBcons,
     || (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
         monitoredNode->NMTstatePrev = CO_NMT_UNKNOWN;
 #endif
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_DEADLINE) == 0
         CO_FLAG_CLEAR(monitoredNode->CANrxNew);
+#endif
 
         /* is channel used */
         if (monitoredNode->nodeId != 0 && monitoredNode->time_us != 0) {
@@ -225,6 +432,21 @@ static CO_ReturnError_t CO_HBconsumer_initEntry(CO_HBconsumer_t *HBcons,
             monitoredNode->HBstate = CO_HBconsumer_UNCONFIGURED;
         }
 
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_DEADLINE
+        if (COB_ID != 0 && nodeId <= 127) {
+            HBcons->idxByNodeId[nodeId] = idx;
+        }
+        countStates(HBcons);
+
+        /* configure Heartbeat consumer (or disable) CAN reception */
+        ret = CO_CANrxBufferInit(HBcons->CANdevRx,
+                                 HBcons->CANdevRxIdxStart + idx,
+                                 COB_ID,
+                                 0x7FF,
+                                 0,
+                                 (void*)HBcons,
+                                 CO_HBcons_receive);
+#else
         /* configure Heartbeat consumer (or disable) CAN reception */
         ret = CO_CANrxBufferInit(HBcons->CANdevRx,
                                  HBcons->CANdevRxIdxStart + idx,
@@ -233,6 +455,7 @@ static CO_ReturnError_t CO_HBconsumer_initEntry(CO_HBconsumer_t *HBcons,
                                  0,
                                  (void*)&HBcons->monitoredNodes[idx],
                                  CO_HBcons_receive);
+#endif
     }
     return ret;
 }
@@ -355,6 +578,229 @@ void CO_HBconsumer_initCallbackRemoteReset(
 #endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI */
 
 
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_RESET
+/******************************************************************************/
+void CO_HBconsumer_initCallbackReset(
+    CO_HBconsumer_t        *HBcons,
+    void                   *object,
+    void                  (*pFunctSignal)(uint8_t nodeId, uint8_t idx, void *object))
+{
+    if (HBcons != NULL) {
+        HBcons->pFunctSignalReset = pFunctSignal;
+        HBcons->functSignalObjectReset = object;
+    }
+}
+#endif
+
+
+/*
+ * Call reset callback, if configured.
+ */
+static inline void nodeReset(CO_HBconsumer_t *HBcons, uint8_t idx) {
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_RESET
+    if (HBcons->pFunctSignalReset != NULL) {
+        HBcons->pFunctSignalReset(HBcons->monitoredNodes[idx].nodeId, idx,
+                                  HBcons->functSignalObjectReset);
+    }
+#else
+    (void)HBcons; (void)idx;
+#endif
+}
+
+
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_DEADLINE
+/*
+ * Call NMT changed callback, if NMT state of the node changed.
+ */
+static inline void nmtChanged(CO_HBconsumer_t *HBcons, uint8_t idx) {
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE \
+    || (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+    CO_HBconsNode_t * const monitoredNode = &HBcons->monitoredNodes[idx];
+
+    if (monitoredNode->NMTstate != monitoredNode->NMTstatePrev) {
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE
+        if (HBcons->pFunctSignalNmtChanged != NULL) {
+            HBcons->pFunctSignalNmtChanged(
+                monitoredNode->nodeId, idx, monitoredNode->NMTstate,
+                HBcons->pFunctSignalObjectNmtChanged);
+#else
+        if (monitoredNode->pFunctSignalNmtChanged != NULL) {
+            monitoredNode->pFunctSignalNmtChanged(
+                monitoredNode->nodeId, idx, monitoredNode->NMTstate,
+                monitoredNode->pFunctSignalObjectNmtChanged);
+#endif
+        }
+        monitoredNode->NMTstatePrev = monitoredNode->NMTstate;
+    }
+#else
+    (void)HBcons; (void)idx;
+#endif
+}
+
+
+/*
+ * Take next node from the receive queue. Returns CO_HB_CONS_NO_IDX, if queue
+ * is empty.
+ */
+static uint8_t rxQueueGet(CO_HBconsumer_t *HBcons) {
+    uint8_t count = HBcons->numberOfMonitoredNodes;
+    uint8_t tail = HBcons->rxQueueTail;
+    uint8_t idx;
+
+    if (tail == HBcons->rxQueueHead) {
+        return CO_HB_CONS_NO_IDX;
+    }
+    idx = HBcons->monitoredNodes[tail < count ? tail : tail - count]
+          .rxQueueItem;
+    HBcons->rxQueueTail = (tail + 1) < (2 * count) ? tail + 1 : 0;
+
+    /* Clear the flag before the message is read, so new message is queued
+     * again. */
+    CO_FLAG_CLEAR(HBcons->monitoredNodes[idx].CANrxNew);
+    return idx;
+}
+
+
+/******************************************************************************/
+void CO_HBconsumer_process(
+        CO_HBconsumer_t        *HBcons,
+        bool_t                  NMTisPreOrOperational,
+        uint32_t                timeDifference_us,
+        uint32_t               *timerNext_us)
+{
+    (void)timerNext_us; /* may be unused */
+
+    bool_t allMonitoredActiveCurrent = true;
+    bool_t allMonitoredOperationalCurrent = true;
+    uint8_t idx;
+
+    HBcons->clock_us += timeDifference_us;
+
+    if (NMTisPreOrOperational && HBcons->NMTisPreOrOperationalPrev) {
+        /* Received heartbeat or bootup messages */
+        while ((idx = rxQueueGet(HBcons)) != CO_HB_CONS_NO_IDX) {
+            CO_HBconsNode_t * const monitoredNode = &HBcons->monitoredNodes[idx];
+            CO_NMT_internalState_t NMTstate = monitoredNode->NMTstateRx;
+
+            if (monitoredNode->HBstate == CO_HBconsumer_UNCONFIGURED
+                || NMTstate == CO_NMT_UNKNOWN
+            ) {
+                /* node was re-configured after reception */
+                continue;
+            }
+            if (NMTstate == CO_NMT_INITIALIZING) {
+                /* bootup message*/
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+                if (monitoredNode->pFunctSignalRemoteReset != NULL) {
+                    monitoredNode->pFunctSignalRemoteReset(
+                        monitoredNode->nodeId, idx,
+                        monitoredNode->functSignalObjectRemoteReset);
+                }
+#endif
+                nodeReset(HBcons, idx);
+                if (monitoredNode->HBstate == CO_HBconsumer_ACTIVE) {
+                    CO_errorReport(HBcons->em,
+                                   CO_EM_HB_CONSUMER_REMOTE_RESET,
+                                   CO_EMC_HEARTBEAT, idx);
+                    heapRemove(HBcons, idx);
+                }
+                setStates(HBcons, monitoredNode, CO_HBconsumer_UNKNOWN,
+                          NMTstate);
+            }
+            else {
+                /* heartbeat message */
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+                if (monitoredNode->HBstate != CO_HBconsumer_ACTIVE &&
+                    monitoredNode->pFunctSignalHbStarted != NULL) {
+                    monitoredNode->pFunctSignalHbStarted(
+                        monitoredNode->nodeId, idx,
+                        monitoredNode->functSignalObjectHbStarted);
+                }
+#endif
+                setStates(HBcons, monitoredNode, CO_HBconsumer_ACTIVE,
+                          NMTstate);
+                /* restart timer */
+                monitoredNode->deadline_us = HBcons->clock_us
+                                           + monitoredNode->time_us;
+                heapUpdate(HBcons, idx);
+            }
+            nmtChanged(HBcons, idx);
+        }
+
+        /* Expired nodes, the earliest deadline is on the top of the heap */
+        while (HBcons->heapCount > 0) {
+            CO_HBconsNode_t * monitoredNode;
+            int32_t diff;
+
+            idx = HBcons->monitoredNodes[0].heapItem;
+            monitoredNode = &HBcons->monitoredNodes[idx];
+            diff = (int32_t)(monitoredNode->deadline_us - HBcons->clock_us);
+
+            if (diff > 0) {
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_TIMERNEXT
+                /* timerNext_us for the next timeout checking */
+                if (timerNext_us != NULL && *timerNext_us > (uint32_t)diff) {
+                    *timerNext_us = (uint32_t)diff;
+                }
+#endif
+                break;
+            }
+
+            /* timeout expired */
+            heapRemove(HBcons, idx);
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+            if (monitoredNode->pFunctSignalTimeout!=NULL) {
+                monitoredNode->pFunctSignalTimeout(
+                    monitoredNode->nodeId, idx,
+                    monitoredNode->functSignalObjectTimeout);
+            }
+#endif
+            nodeReset(HBcons, idx);
+            CO_errorReport(HBcons->em, CO_EM_HEARTBEAT_CONSUMER,
+                           CO_EMC_HEARTBEAT, idx);
+            setStates(HBcons, monitoredNode, CO_HBconsumer_TIMEOUT,
+                      CO_NMT_UNKNOWN);
+            nmtChanged(HBcons, idx);
+        }
+
+        allMonitoredActiveCurrent = HBcons->notActiveCount == 0;
+        allMonitoredOperationalCurrent = HBcons->notOperationalCount == 0;
+    }
+    else if (NMTisPreOrOperational || HBcons->NMTisPreOrOperationalPrev) {
+        /* (pre)operational state changed, clear variables */
+        while (rxQueueGet(HBcons) != CO_HB_CONS_NO_IDX) {}
+        for(uint8_t i=0; i<HBcons->numberOfMonitoredNodes; i++) {
+            CO_HBconsNode_t * const monitoredNode = &HBcons->monitoredNodes[i];
+            monitoredNode->NMTstate = CO_NMT_UNKNOWN;
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE \
+    || (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+            monitoredNode->NMTstatePrev = CO_NMT_UNKNOWN;
+#endif
+            monitoredNode->heapPos = CO_HB_CONS_NO_IDX;
+            if (monitoredNode->HBstate != CO_HBconsumer_UNCONFIGURED) {
+                monitoredNode->HBstate = CO_HBconsumer_UNKNOWN;
+            }
+        }
+        HBcons->heapCount = 0;
+        countStates(HBcons);
+        allMonitoredActiveCurrent = false;
+        allMonitoredOperationalCurrent = false;
+    }
+
+    /* Clear emergencies when all monitored nodes becomes active.
+     * We only have one emergency index for all monitored nodes! */
+    if (!HBcons->allMonitoredActive && allMonitoredActiveCurrent) {
+        CO_errorReset(HBcons->em, CO_EM_HEARTBEAT_CONSUMER, 0);
+        CO_errorReset(HBcons->em, CO_EM_HB_CONSUMER_REMOTE_RESET, 0);
+    }
+
+    HBcons->allMonitoredActive = allMonitoredActiveCurrent;
+    HBcons->allMonitoredOperational = allMonitoredOperationalCurrent;
+    HBcons->NMTisPreOrOperationalPrev = NMTisPreOrOperational;
+}
+
+#else /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_DEADLINE */
+
 /******************************************************************************/
 void CO_HBconsumer_process(
         CO_HBconsumer_t        *HBcons,
@@ -387,6 +833,7 @@ void CO_HBconsumer_process(
                             monitoredNode->functSignalObjectRemoteReset);
                     }
 #endif
+                    nodeReset(HBcons, i);
                     if (monitoredNode->HBstate == CO_HBconsumer_ACTIVE) {
                         CO_errorReport(HBcons->em,
                                        CO_EM_HB_CONSUMER_REMOTE_RESET,
@@ -426,6 +873,7 @@ void CO_HBconsumer_process(
                             monitoredNode->functSignalObjectTimeout);
                     }
 #endif
+                    nodeReset(HBcons, i);
                     CO_errorReport(HBcons->em, CO_EM_HEARTBEAT_CONSUMER,
                                    CO_EMC_HEARTBEAT, i);
                     monitoredNode->NMTstate = CO_NMT_UNKNOWN;
@@ -500,6 +948,7 @@ void CO_HBconsumer_process(
     HBcons->allMonitoredOperational = allMonitoredOperationalCurrent;
     HBcons->NMTisPreOrOperationalPrev = NMTisPreOrOperational;
 }
+#endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_DEADLINE */
 
 
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_QUERY_FUNCT
@@ -61,9 +61,22 @@ extern "C" {
  * To setup heartbeat consumer by application, use
  * @code ODR_t odRet = OD_set_u32(entry, subIndex, val, false); @endcode
  *
+ * By default CO_HBconsumer_process() checks all monitored nodes in each call.
+ * With CO_CONFIG_HB_CONS_DEADLINE it only handles received messages and
+ * expired nodes, so the time of a call does not depend on the number of
+ * monitored nodes. Receive function puts the node into a queue. Active nodes
+ * are in a binary min-heap, ordered by absolute time of heartbeat timeout.
+ * Both are stored inside the monitoredNodes array, no other memory is needed.
+ *
  * @see @ref CO_NMT_Heartbeat
  */
 
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_DEADLINE) || defined CO_DOXYGEN
+/** Value of CO_HBconsNode_t::heapPos, if node is not in the heap and of
+ * CO_HBconsumer_t::idxByNodeId, if node is not monitored */
+#define CO_HB_CONS_NO_IDX 0xFFU
+#endif
+
 /**
  * Heartbeat state of a node
  */
@@ -85,12 +98,30 @@ typedef struct {
     CO_NMT_internalState_t NMTstate;
     /** Current heartbeat monitoring state of the remote node */
     CO_HBconsumer_state_t HBstate;
+#if (((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_DEADLINE) == 0) \
+    || defined CO_DOXYGEN
     /** Time since last heartbeat received */
     uint32_t timeoutTimer;
+#endif
     /** Consumer heartbeat time from OD */
     uint32_t time_us;
     /** Indication if new Heartbeat message received from the CAN bus */
     volatile void *CANrxNew;
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_DEADLINE) || defined CO_DOXYGEN
+    /** Heartbeat payload, written by receive function, copied to NMTstate
+     * by CO_HBconsumer_process() */
+    volatile CO_NMT_internalState_t NMTstateRx;
+    /** Heartbeat timeout, absolute value of CO_HBconsumer_t::clock_us */
+    uint32_t deadline_us;
+    /** Position of this node in the heap or CO_HB_CONS_NO_IDX */
+    uint8_t heapPos;
+    /** Heap element at position equal to the index of this node: index of
+     * the node with that position */
+    uint8_t heapItem;
+    /** Receive queue element at position equal to the index of this node:
+     * index of the node with received message */
+    uint8_t rxQueueItem;
+#endif
 #if ((CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_CALLBACK_PRE) || defined CO_DOXYGEN
     /** From CO_HBconsumer_initCallbackPre() or NULL */
     void (*pFunctSignalPre)(void *object);
@@ -156,6 +187,24 @@ typedef struct {
     CO_CANmodule_t *CANdevRx;
     /** From CO_HBconsumer_init() */
     uint16_t CANdevRxIdxStart;
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_DEADLINE) || defined CO_DOXYGEN
+    /** Sum of timeDifference_us from CO_HBconsumer_process(), wraps around */
+    uint32_t clock_us;
+    /** Number of nodes in the heap */
+    uint8_t heapCount;
+    /** Position of the next element written to the receive queue, from 0 to
+     * 2 * numberOfMonitoredNodes - 1. Written by receive function only. */
+    volatile uint8_t rxQueueHead;
+    /** Position of the next element read from the receive queue. Written by
+     * CO_HBconsumer_process() only. */
+    volatile uint8_t rxQueueTail;
+    /** Number of configured nodes, which are not in CO_HBconsumer_ACTIVE */
+    uint8_t notActiveCount;
+    /** Number of configured nodes, which are not in CO_NMT_OPERATIONAL */
+    uint8_t notOperationalCount;
+    /** Index of configured monitored node by node-ID or CO_HB_CONS_NO_IDX */
+    uint8_t idxByNodeId[128];
+#endif
 #if ((CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_OD_DYNAMIC) || defined CO_DOXYGEN
     /** Extension for OD object */
     OD_extension_t OD_1016_extension;
@@ -169,6 +218,13 @@ typedef struct {
     /** Pointer to object */
     void *pFunctSignalObjectNmtChanged;
 #endif
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_RESET) || defined CO_DOXYGEN
+    /** Callback for boot-up or timeout of any monitored node.
+     *  From CO_HBconsumer_initCallbackReset() or NULL. */
+    void (*pFunctSignalReset)(uint8_t nodeId, uint8_t idx, void *object);
+    /** Pointer to object */
+    void *functSignalObjectReset;
+#endif
 } CO_HBconsumer_t;
 
 
@@ -300,6 +356,26 @@ void CO_HBconsumer_initCallbackRemoteReset(
         void                  (*pFunctSignal)(uint8_t nodeId, uint8_t idx, void *object));
 #endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI */
 
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_RESET) || defined CO_DOXYGEN
+/**
+ * Initialize Heartbeat consumer reset callback function.
+ *
+ * Callback is called from CO_HBconsumer_process(), when bootup message is
+ * received from any monitored node or its heartbeat times out. It is called
+ * besides the application callbacks from CO_HBconsumer_initCallbackRemoteReset()
+ * and CO_HBconsumer_initCallbackTimeout(). It is usually
+ * CO_SDOclientCache_nodeReset().
+ *
+ * @param HBcons This object.
+ * @param object Pointer to object, which will be passed to pFunctSignal(). Can be NULL
+ * @param pFunctSignal Pointer to the callback function. Not called if NULL.
+ */
+void CO_HBconsumer_initCallbackReset(
+        CO_HBconsumer_t        *HBcons,
+        void                   *object,
+        void                  (*pFunctSignal)(uint8_t nodeId, uint8_t idx, void *object));
+#endif
+
 /**
  * Process Heartbeat consumer object.
  *
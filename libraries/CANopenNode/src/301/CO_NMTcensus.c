@@ -0,0 +1,195 @@
+/*
+ * CANopen network state table, fed passively from received messages.
+ *
+ * @file        CO_NMTcensus.c
+ * @ingroup     CO_NMTcensus
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "301/CO_NMTcensus.h"
+
+#if (CO_CONFIG_NMT) & CO_CONFIG_NMT_CENSUS
+
+/*
+ * Read received message from CAN module.
+ *
+ * Function is called by CAN receive interrupt for every received message,
+ * see CO_CANrxMonitorInit(). For more information and description of
+ * parameters see file CO_driver.h.
+ */
+static void CO_NMTcensus_receive(void *object, void *msg) {
+    CO_NMTcensus_t *census = (CO_NMTcensus_t *)object;
+    uint16_t ident = CO_CANrxMsg_readIdent(msg);
+    uint8_t nodeId = (uint8_t)(ident & 0x7F);
+    uint8_t DLC = CO_CANrxMsg_readDLC(msg);
+    uint8_t *data = CO_CANrxMsg_readData(msg);
+    CO_NMTcensusNode_t *node;
+
+    if (nodeId == 0) {
+        return;
+    }
+    node = &census->nodes[nodeId - 1];
+
+    if ((ident & 0x780) == CO_CAN_ID_HEARTBEAT && DLC == 1) {
+        node->heartbeatTime_us = CO_CANrxMsg_readTimestamp(msg);
+        node->flags |= CO_NMT_CENSUS_HEARTBEAT;
+        if (data[0] == (uint8_t)CO_NMT_INITIALIZING) {
+            node->bootupCount++;
+            census->changeCount++;
+        }
+        else if (node->NMTstate != data[0]) {
+            census->changeCount++;
+        }
+        node->NMTstate = data[0];
+    }
+    else if ((ident & 0x780) == CO_CAN_ID_EMERGENCY && DLC == 8) {
+        node->emcyErrorCode = (uint16_t)data[0] | ((uint16_t)data[1] << 8);
+        node->errorRegister = data[2];
+        node->flags |= CO_NMT_CENSUS_EMCY;
+        census->changeCount++;
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_NMTcensus_init(CO_NMTcensus_t *census,
+                                   CO_CANmodule_t *CANdevRx)
+{
+    if (census == NULL || CANdevRx == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(census, 0, sizeof(CO_NMTcensus_t));
+    for (uint8_t i = 0; i < 127; i++) {
+        census->nodes[i].NMTstate = 0xFFU;
+    }
+    census->CANdevRx = CANdevRx;
+
+    CO_CANrxMonitorInit(CANdevRx, (void *)census, CO_NMTcensus_receive);
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+bool_t CO_NMTcensus_read(CO_NMTcensus_t *census,
+                         uint8_t nodeId,
+                         CO_NMTcensusNode_t *node)
+{
+    if (census == NULL || node == NULL || nodeId < 1 || nodeId > 127) {
+        return false;
+    }
+
+    CO_LOCK_OD(census->CANdevRx);
+    *node = census->nodes[nodeId - 1];
+    CO_UNLOCK_OD(census->CANdevRx);
+
+    return (node->flags & (CO_NMT_CENSUS_HEARTBEAT | CO_NMT_CENSUS_EMCY)) != 0;
+}
+
+
+/******************************************************************************/
+uint8_t CO_NMTcensus_snapshot(CO_NMTcensus_t *census,
+                              uint8_t firstNodeId,
+                              CO_NMTcensusNode_t *nodes,
+                              uint8_t count,
+                              uint32_t *changeCount)
+{
+    uint8_t copied = 0;
+
+    if (census == NULL || nodes == NULL || firstNodeId < 1
+        || firstNodeId > 127
+    ) {
+        return 0;
+    }
+    if (changeCount != NULL) {
+        *changeCount = census->changeCount;
+    }
+
+    /* lock only one entry at a time, not to delay CAN reception */
+    while (copied < count && (firstNodeId + copied) <= 127) {
+        CO_LOCK_OD(census->CANdevRx);
+        nodes[copied] = census->nodes[firstNodeId + copied - 1];
+        CO_UNLOCK_OD(census->CANdevRx);
+        copied++;
+    }
+
+    return copied;
+}
+
+
+/******************************************************************************/
+void CO_NMTcensus_setIdentity(CO_NMTcensus_t *census,
+                              uint8_t nodeId,
+                              const CO_NMTcensusIdentity_t *identity)
+{
+    if (census == NULL || nodeId < 1 || nodeId > 127) {
+        return;
+    }
+
+    CO_NMTcensusNode_t *node = &census->nodes[nodeId - 1];
+
+    CO_LOCK_OD(census->CANdevRx);
+    if (identity != NULL) {
+        node->identity = *identity;
+        node->flags |= CO_NMT_CENSUS_IDENTITY;
+    }
+    else {
+        node->flags &= (uint8_t)~CO_NMT_CENSUS_IDENTITY;
+    }
+    census->changeCount++;
+    CO_UNLOCK_OD(census->CANdevRx);
+}
+
+
+/******************************************************************************/
+uint8_t CO_NMTcensus_countLive(CO_NMTcensus_t *census,
+                               uint32_t now_us,
+                               uint32_t timeout_us,
+                               uint32_t live[4])
+{
+    uint8_t count = 0;
+
+    if (census == NULL) {
+        return 0;
+    }
+    if (live != NULL) {
+        memset(live, 0, 4 * sizeof(live[0]));
+    }
+
+    for (uint8_t nodeId = 1; nodeId <= 127; nodeId++) {
+        const CO_NMTcensusNode_t *node = &census->nodes[nodeId - 1];
+        uint32_t age_us = now_us - node->heartbeatTime_us;
+
+        /* heartbeat may be received after now_us was taken */
+        if ((node->flags & CO_NMT_CENSUS_HEARTBEAT) != 0
+            && (age_us <= timeout_us || (int32_t)age_us < 0)
+        ) {
+            count++;
+            if (live != NULL) {
+                live[nodeId >> 5] |= 1UL << (nodeId & 0x1F);
+            }
+        }
+    }
+
+    return count;
+}
+
+#endif /* (CO_CONFIG_NMT) & CO_CONFIG_NMT_CENSUS */
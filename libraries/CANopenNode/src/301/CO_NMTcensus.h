@@ -0,0 +1,231 @@
+/**
+ * CANopen network state table, fed passively from received messages.
+ *
+ * @file        CO_NMTcensus.h
+ * @ingroup     CO_NMTcensus
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_NMT_CENSUS_H
+#define CO_NMT_CENSUS_H
+
+#include "301/CO_driver.h"
+#include "301/CO_NMT_Heartbeat.h"
+
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_NMT
+#define CO_CONFIG_NMT (CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE | \
+                       CO_CONFIG_GLOBAL_FLAG_TIMERNEXT)
+#endif
+
+#if ((CO_CONFIG_NMT) & CO_CONFIG_NMT_CENSUS) || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_NMTcensus NMT census
+ * Network state table of all 127 nodes.
+ *
+ * @ingroup CO_CANopen_301
+ * @{
+ * NMT census records the state of each node on the network from the messages
+ * the node sends anyway: heartbeat and boot-up (CO_CAN_ID_HEARTBEAT + node-ID)
+ * and emergency (CO_CAN_ID_EMERGENCY + node-ID). Nothing is sent, no SDO
+ * polling is necessary. Messages are taken from the CAN receive dispatcher
+ * with CO_CANrxMonitorInit(), so nodes are seen regardless of the receive
+ * buffers of @ref CO_HBconsumer and emergency consumer. Reception time is
+ * from CO_CANrxMsg_readTimestamp().
+ *
+ * Identity (object 0x1018) is not sent by the nodes. It is written by the
+ * application or the boot-up manager with CO_NMTcensus_setIdentity().
+ *
+ * Table is indexed by node-ID, so all lookups are O(1). Receive function
+ * writes the table from the CAN receive interrupt, so consistent copies of
+ * entries are taken with CO_NMTcensus_read() or, for many nodes at once,
+ * CO_NMTcensus_snapshot(). CO_NMTcensus_t::changeCount tells the user
+ * interface, if anything changed since the last snapshot.
+ *
+ * If enabled, NMT census is initialized in CANopen.c file.
+ */
+
+
+/** Flags in CO_NMTcensusNode_t::flags */
+typedef enum {
+    CO_NMT_CENSUS_HEARTBEAT = 0x01U, /**< Heartbeat or boot-up was received */
+    CO_NMT_CENSUS_EMCY = 0x02U,      /**< Emergency was received */
+    CO_NMT_CENSUS_IDENTITY = 0x04U   /**< Identity is valid */
+} CO_NMTcensus_flags_t;
+
+
+/**
+ * Identity of the node, object 0x1018.
+ */
+typedef struct {
+    uint32_t vendorId;       /**< Sub-index 1 */
+    uint32_t productCode;    /**< Sub-index 2 */
+    uint32_t revisionNumber; /**< Sub-index 3 */
+    uint32_t serialNumber;   /**< Sub-index 4 */
+} CO_NMTcensusIdentity_t;
+
+
+/**
+ * State of one node inside CO_NMTcensus_t.
+ */
+typedef struct {
+    /** Reception time of the last heartbeat or boot-up in microseconds */
+    uint32_t heartbeatTime_us;
+    /** From CO_NMTcensus_setIdentity() */
+    CO_NMTcensusIdentity_t identity;
+    /** Number of received boot-up messages, wraps around */
+    uint16_t bootupCount;
+    /** Error code of the last emergency message, 0 after error reset */
+    uint16_t emcyErrorCode;
+    /** Heartbeat payload, @ref CO_NMT_internalState_t. 0xFF, if unknown */
+    uint8_t NMTstate;
+    /** Error register from the last emergency message */
+    uint8_t errorRegister;
+    /** Combination of @ref CO_NMTcensus_flags_t */
+    uint8_t flags;
+} CO_NMTcensusNode_t;
+
+
+/**
+ * NMT census object.
+ */
+typedef struct {
+    /** State of nodes, nodes[nodeId - 1] */
+    CO_NMTcensusNode_t nodes[127];
+    /** Incremented on each change of NMT state, boot-up, emergency and
+     * identity, wraps around */
+    volatile uint32_t changeCount;
+    /** From CO_NMTcensus_init() */
+    CO_CANmodule_t *CANdevRx;
+} CO_NMTcensus_t;
+
+
+/**
+ * Initialize NMT census object.
+ *
+ * All nodes are set to unknown and receive monitor is registered in CAN
+ * module with CO_CANrxMonitorInit().
+ *
+ * @param census This object will be initialized.
+ * @param CANdevRx CAN device for reception.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_NMTcensus_init(CO_NMTcensus_t *census,
+                                   CO_CANmodule_t *CANdevRx);
+
+
+/**
+ * Get NMT state of the node.
+ *
+ * @param census This object.
+ * @param nodeId Node-ID, 1 to 127.
+ *
+ * @return NMT state from the last heartbeat or CO_NMT_UNKNOWN.
+ */
+static inline CO_NMT_internalState_t CO_NMTcensus_getNMTstate(
+        const CO_NMTcensus_t *census, uint8_t nodeId)
+{
+    if (census == NULL || nodeId < 1 || nodeId > 127
+        || census->nodes[nodeId - 1].NMTstate == 0xFFU
+    ) {
+        return CO_NMT_UNKNOWN;
+    }
+    return (CO_NMT_internalState_t)census->nodes[nodeId - 1].NMTstate;
+}
+
+
+/**
+ * Copy state of one node.
+ *
+ * @param census This object.
+ * @param nodeId Node-ID, 1 to 127.
+ * @param [out] node Copy of the node state.
+ *
+ * @return true, if anything was received from the node.
+ */
+bool_t CO_NMTcensus_read(CO_NMTcensus_t *census,
+                         uint8_t nodeId,
+                         CO_NMTcensusNode_t *node);
+
+
+/**
+ * Copy state of consecutive nodes.
+ *
+ * @param census This object.
+ * @param firstNodeId Node-ID of nodes[0], 1 to 127.
+ * @param [out] nodes Array for copies of the node states.
+ * @param count Size of the nodes array. Copying stops at node-ID 127.
+ * @param [out] changeCount Value of CO_NMTcensus_t::changeCount before the
+ * copy, may be NULL. If it is the same as at the previous snapshot, nothing
+ * changed except heartbeat times.
+ *
+ * @return Number of copied nodes.
+ */
+uint8_t CO_NMTcensus_snapshot(CO_NMTcensus_t *census,
+                              uint8_t firstNodeId,
+                              CO_NMTcensusNode_t *nodes,
+                              uint8_t count,
+                              uint32_t *changeCount);
+
+
+/**
+ * Set identity of the node.
+ *
+ * @param census This object.
+ * @param nodeId Node-ID, 1 to 127.
+ * @param identity Identity, read from object 0x1018 of the node. If NULL,
+ * identity is marked invalid.
+ */
+void CO_NMTcensus_setIdentity(CO_NMTcensus_t *census,
+                              uint8_t nodeId,
+                              const CO_NMTcensusIdentity_t *identity);
+
+
+/**
+ * Count live nodes.
+ *
+ * Node is live, if its heartbeat or boot-up was received within timeout_us.
+ *
+ * @param census This object.
+ * @param now_us Current time in the time base of CO_CANrxMsg_readTimestamp().
+ * @param timeout_us Maximum age of the last heartbeat.
+ * @param [out] live Bitmap of live nodes, bit (nodeId & 0x1F) of
+ * live[nodeId >> 5]. May be NULL.
+ *
+ * @return Number of live nodes.
+ */
+uint8_t CO_NMTcensus_countLive(CO_NMTcensus_t *census,
+                               uint32_t now_us,
+                               uint32_t timeout_us,
+                               uint32_t live[4]);
+
+/** @} */ /* CO_NMTcensus */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_NMT) & CO_CONFIG_NMT_CENSUS */
+
+#endif /* CO_NMT_CENSUS_H */
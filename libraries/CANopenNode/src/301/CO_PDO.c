@@ -29,7 +29,9 @@
 
 #include <stdio.h>
 
+#ifndef log_printf
 #define log_printf(macropar_message, ...) printf(macropar_message, ##__VA_ARGS__)
+#endif
 
 #if (CO_CONFIG_PDO) & (CO_CONFIG_RPDO_ENABLE | CO_CONFIG_TPDO_ENABLE)
 
@@ -39,6 +41,18 @@
  #endif
 #endif
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_SYNC_SCHEDULER
+ #if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_ENABLE) == 0
+  #error TPDO SYNC scheduler is not possible without CO_CONFIG_PDO_SYNC_ENABLE
+ #endif
+#endif
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_MAILBOX
+ #ifndef CO_MemoryBarrier
+  #error RPDO mailbox is not possible without CO_MemoryBarrier() from the target
+ #endif
+#endif
+
 #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS
 /*
  * Custom function for write dummy OD object. Will be used only from RPDO.
@@ -226,6 +240,53 @@ static CO_ReturnError_t PDO_initMapping(CO_PDO_common_t *PDO,
     return CO_ERROR_NO;
 }
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_REMAP
+/*
+ * Configure complete PDO mapping from array of mapping parameters
+ *
+ * @param PDO This object will be configured. If map is erroneous, then it may
+ * be partially modified, so use a copy for validation.
+ * @param maps Mapping parameters, count * 4 bytes, little endian.
+ * @param count Number of mapped objects.
+ * @param isRPDO True for RPDO and false for TPDO.
+ * @param OD Object Dictionary.
+ *
+ * @return ODR_OK on success, otherwise error reason.
+ */
+static ODR_t PDO_configMapArray(CO_PDO_common_t *PDO,
+                                const uint8_t *maps,
+                                uint8_t count,
+                                bool_t isRPDO,
+                                OD_t *OD)
+{
+    size_t pdoDataLength = 0;
+
+    if (count > CO_PDO_MAX_MAPPED_ENTRIES) {
+        return ODR_MAP_LEN;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        ODR_t odRet = PDOconfigMap(PDO, CO_getUint32(&maps[i * 4]), i,
+                                   isRPDO, OD);
+        if (odRet != ODR_OK) {
+            return odRet;
+        }
+        pdoDataLength += PDO->OD_IO[i].stream.dataOffset;
+    }
+
+    if (pdoDataLength > CO_PDO_MAX_SIZE) {
+        return ODR_MAP_LEN;
+    }
+    if (pdoDataLength == 0 && count > 0) {
+        return ODR_INVALID_VALUE;
+    }
+
+    PDO->dataLength = (CO_PDO_size_t)pdoDataLength;
+    PDO->mappedObjectsCount = count;
+    return ODR_OK;
+}
+#endif /* (CO_CONFIG_PDO) & CO_CONFIG_PDO_REMAP */
+
 #if (CO_CONFIG_PDO) & CO_CONFIG_FLAG_OD_DYNAMIC
 /*
  * Custom function for writing OD object "PDO mapping parameter"
@@ -298,6 +359,92 @@ static ODR_t OD_write_PDO_mapping(OD_stream_t *stream, const void *buf,
 
 
 #if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS) == 0
+/*
+ * Find mapped variable in Object Dictionary and configure map pointers
+ *
+ * @param PDO This object will be configured.
+ * @param map PDO mapping parameter.
+ * @param pdoDataStart Position of the mapped variable inside PDO data.
+ * @param isRPDO True for RPDO and false for TPDO.
+ * @param OD Object Dictionary.
+ *
+ * @return ODR_OK on success, otherwise error reason.
+ */
+static ODR_t PDOconfigMapPointers(CO_PDO_common_t *PDO,
+                                  uint32_t map,
+                                  uint8_t pdoDataStart,
+                                  bool_t isRPDO,
+                                  OD_t *OD)
+{
+    static uint8_t dummyTX = 0;
+    static uint8_t dummyRX;
+    uint16_t index = (uint16_t) (map >> 16);
+    uint8_t subIndex = (uint8_t) (map >> 8);
+    uint8_t mappedLengthBits = (uint8_t) map;
+    uint8_t mappedLength = mappedLengthBits >> 3;
+    size_t pdoDataLength = (size_t)pdoDataStart + mappedLength;
+
+    if ((mappedLengthBits & 0x07) != 0) {
+        return ODR_NO_MAP;
+    }
+    if (pdoDataLength > CO_PDO_MAX_SIZE) {
+        return ODR_MAP_LEN;
+    }
+
+    /* is there a reference to the dummy entry */
+    if (index < 0x20 && subIndex == 0) {
+        for (size_t j = pdoDataStart; j < pdoDataLength; j++) {
+            PDO->mapPointer[j] = isRPDO ? &dummyRX : &dummyTX;
+        }
+        return ODR_OK;
+    }
+
+    /* find entry in the Object Dictionary, original location */
+    OD_IO_t OD_IO;
+    OD_entry_t *entry = OD_find(OD, index);
+    OD_attr_t testAttribute = isRPDO ? ODA_RPDO : ODA_TPDO;
+
+    ODR_t odRet = OD_getSub(entry, subIndex, &OD_IO, true);
+    if (odRet != ODR_OK
+        || (OD_IO.stream.attribute & testAttribute) == 0
+        || OD_IO.stream.dataLength < mappedLength
+        || OD_IO.stream.dataOrig == NULL
+    ) {
+        return ODR_NO_MAP;
+    }
+
+    /* write locations to OD variable data bytes into PDO map pointers */
+#ifdef CO_BIG_ENDIAN
+    if((OD_IO.stream.attribute & ODA_MB) != 0) {
+        uint8_t *odDataPointer = OD_IO.stream.dataOrig
+                               + OD_IO.stream.dataLength - 1;
+        for (size_t j = pdoDataStart; j < pdoDataLength; j++) {
+            PDO->mapPointer[j] = odDataPointer--;
+        }
+    }
+    else
+#endif
+    {
+        uint8_t *odDataPointer = OD_IO.stream.dataOrig;
+        for (size_t j = pdoDataStart; j < pdoDataLength; j++) {
+            PDO->mapPointer[j] = odDataPointer++;
+        }
+    }
+
+    /* get TPDO request flag byte from extension */
+#if OD_FLAGS_PDO_SIZE > 0
+    if (!isRPDO && subIndex < (OD_FLAGS_PDO_SIZE * 8)
+        && entry->extension != NULL
+    ) {
+        PDO->flagPDObyte[pdoDataStart] =
+                &entry->extension->flagsPDO[subIndex >> 3];
+        PDO->flagPDObitmask[pdoDataStart] = 1 << (subIndex & 0x07);
+    }
+#endif
+
+    return ODR_OK;
+}
+
 static CO_ReturnError_t PDO_initMapping(CO_PDO_common_t *PDO,
                                         OD_t *OD,
                                         OD_entry_t *OD_PDOMapPar,
@@ -333,76 +480,55 @@ static CO_ReturnError_t PDO_initMapping(CO_PDO_common_t *PDO,
             }
             return CO_ERROR_OD_PARAMETERS;
         }
-        uint16_t index = (uint16_t) (map >> 16);
-        uint8_t subIndex = (uint8_t) (map >> 8);
-        uint8_t mappedLengthBits = (uint8_t) map;
-        uint8_t mappedLength = mappedLengthBits >> 3;
-        uint8_t pdoDataStart = pdoDataLength;
-        pdoDataLength += mappedLength;
-
-        if ((mappedLengthBits & 0x07) != 0 || pdoDataLength > CO_PDO_MAX_SIZE) {
+
+        if (PDOconfigMapPointers(PDO, map, (uint8_t)pdoDataLength, isRPDO, OD)
+            != ODR_OK
+        ) {
             *erroneousMap = map;
             return CO_ERROR_NO;
         }
+        pdoDataLength += ((uint8_t) map) >> 3;
+    }
 
-        /* is there a reference to the dummy entry */
-        if (index < 0x20 && subIndex == 0) {
-            for (uint8_t j = pdoDataStart; j < pdoDataLength; j++) {
-                static uint8_t dummyTX = 0;
-                static uint8_t dummyRX;
-                PDO->mapPointer[j] = isRPDO ? &dummyRX : &dummyTX;
-            }
-            continue;
-        }
+    PDO->dataLength = PDO->mappedObjectsCount = pdoDataLength;
+    return CO_ERROR_NO;
+}
 
-        /* find entry in the Object Dictionary, original location */
-        OD_IO_t OD_IO;
-        OD_entry_t *entry = OD_find(OD, index);
-        OD_attr_t testAttribute = isRPDO ? ODA_RPDO : ODA_TPDO;
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_REMAP
+/* Configure complete PDO mapping, see PDO_configMapArray() above. */
+static ODR_t PDO_configMapArray(CO_PDO_common_t *PDO,
+                                const uint8_t *maps,
+                                uint8_t count,
+                                bool_t isRPDO,
+                                OD_t *OD)
+{
+    uint8_t pdoDataLength = 0;
 
-        ODR_t odRet = OD_getSub(entry, subIndex, &OD_IO, true);
-        if (odRet != ODR_OK
-            || (OD_IO.stream.attribute & testAttribute) == 0
-            || OD_IO.stream.dataLength < mappedLength
-            || OD_IO.stream.dataOrig == NULL
-        ) {
-            *erroneousMap = map;
-            return CO_ERROR_NO;
-        }
+    if (count > CO_PDO_MAX_MAPPED_ENTRIES) {
+        return ODR_MAP_LEN;
+    }
 
-        /* write locations to OD variable data bytes into PDO map pointers */
-#ifdef CO_BIG_ENDIAN
-        if((OD_IO.stream.attribute & ODA_MB) != 0) {
-            uint8_t *odDataPointer = OD_IO.stream.dataOrig
-                                   + OD_IO.stream.dataLength - 1;
-            for (uint8_t j = pdoDataStart; j < pdoDataLength; j++) {
-                PDO->mapPointer[j] = odDataPointer--;
-            }
-        }
-        else
+#if OD_FLAGS_PDO_SIZE > 0
+    memset(PDO->flagPDObyte, 0, sizeof(PDO->flagPDObyte));
 #endif
-        {
-            uint8_t *odDataPointer = OD_IO.stream.dataOrig;
-            for (uint8_t j = pdoDataStart; j < pdoDataLength; j++) {
-                PDO->mapPointer[j] = odDataPointer++;
-            }
+    for (uint8_t i = 0; i < count; i++) {
+        uint32_t map = CO_getUint32(&maps[i * 4]);
+        ODR_t odRet = PDOconfigMapPointers(PDO, map, pdoDataLength,
+                                           isRPDO, OD);
+        if (odRet != ODR_OK) {
+            return odRet;
         }
+        pdoDataLength += ((uint8_t) map) >> 3;
+    }
 
-        /* get TPDO request flag byte from extension */
-#if OD_FLAGS_PDO_SIZE > 0
-        if (!isRPDO && subIndex < (OD_FLAGS_PDO_SIZE * 8)
-            && entry->extension != NULL
-        ) {
-            PDO->flagPDObyte[pdoDataStart] =
-                    &entry->extension->flagsPDO[subIndex >> 3];
-            PDO->flagPDObitmask[pdoDataStart] = 1 << (subIndex & 0x07);
-        }
-#endif
+    if (pdoDataLength == 0 && count > 0) {
+        return ODR_INVALID_VALUE;
     }
 
     PDO->dataLength = PDO->mappedObjectsCount = pdoDataLength;
-    return CO_ERROR_NO;
+    return ODR_OK;
 }
+#endif /* (CO_CONFIG_PDO) & CO_CONFIG_PDO_REMAP */
 
 #endif /* ((CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS) == 0 */
 
@@ -445,6 +571,7 @@ static ODR_t OD_read_PDO_commParam(OD_stream_t *stream, void *buf,
  *      R P D O
  ******************************************************************************/
 #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
+
 /*
  * States for RPDO->receiveError indicates received RPDOs with wrong length.
  */
@@ -499,6 +626,19 @@ static void CO_PDO_receive(void *object, void *msg) {
             memcpy(RPDO->CANrxData[bufNo], data,sizeof(RPDO->CANrxData[bufNo]));
             CO_FLAG_SET(RPDO->CANrxNew[bufNo]);
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_MAILBOX
+            /* update latest-value mailbox, readers retry on odd sequence */
+            CO_RPDO_mailbox_t *mailbox = &RPDO->mailbox;
+            uint32_t sequence = mailbox->sequence + 1;
+            mailbox->sequence = sequence;
+            CO_MemoryBarrier();
+            mailbox->timestamp_us = CO_CANrxMsg_readTimestamp(msg);
+            mailbox->dataLength = DLC < CO_PDO_MAX_SIZE ? DLC : CO_PDO_MAX_SIZE;
+            memcpy((void *)mailbox->data, data, sizeof(mailbox->data));
+            CO_MemoryBarrier();
+            mailbox->sequence = sequence + 1;
+#endif
+
 #if (CO_CONFIG_PDO) & CO_CONFIG_FLAG_CALLBACK_PRE
             /* Optional signal to RTOS, which can resume task, which handles
              * the RPDO. */
@@ -788,6 +928,49 @@ void CO_RPDO_initCallbackPre(CO_RPDO_t *RPDO,
 #endif
 
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_MAILBOX
+bool_t CO_RPDO_mailboxRead(CO_RPDO_t *RPDO,
+                           uint32_t now_us,
+                           uint32_t *lastCount,
+                           CO_RPDO_mailboxValue_t *value)
+{
+    if (RPDO == NULL || value == NULL) {
+        return false;
+    }
+
+    CO_RPDO_mailbox_t *mailbox = &RPDO->mailbox;
+
+    for (uint8_t i = 0; i < CO_RPDO_MAILBOX_READ_RETRIES; i++) {
+        uint32_t sequence = mailbox->sequence;
+        if ((sequence & 1) != 0) {
+            continue;
+        }
+        CO_MemoryBarrier();
+        value->timestamp_us = mailbox->timestamp_us;
+        value->dataLength = mailbox->dataLength;
+        memcpy(value->data, (const void *)mailbox->data, sizeof(value->data));
+        CO_MemoryBarrier();
+        if (sequence != mailbox->sequence) {
+            continue;
+        }
+
+        /* consistent copy */
+        uint32_t count = sequence >> 1;
+        uint32_t previous = (lastCount != NULL) ? *lastCount : count - 1;
+        value->count = count;
+        value->age_us = now_us - value->timestamp_us;
+        value->missed = (count != previous) ? count - previous - 1 : 0;
+        if (lastCount != NULL) {
+            *lastCount = count;
+        }
+        return count != 0 && count != previous;
+    }
+
+    return false;
+}
+#endif
+
+
 /******************************************************************************/
 void CO_RPDO_process(CO_RPDO_t *RPDO,
 #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_TIMERS_ENABLE
@@ -1235,16 +1418,15 @@ CO_ReturnError_t CO_TPDO_init(CO_TPDO_t *TPDO,
 
 
 /*
- * Send TPDO message.
+ * Prepare TPDO data.
  *
- * Function prepares TPDO data from Object Dictionary variables. It is called
- * from CO_TPDO_process() according to TPDO communication parameters.
+ * Function copies data from Object Dictionary variables into TPDO CAN transmit
+ * buffer and restarts TPDO timers. It is called from CO_TPDOsend() or, with
+ * SYNC scheduler, at the SYNC, before delayed transmission.
  *
  * @param TPDO TPDO object.
- *
- * @return Same as CO_CANsend().
  */
-static CO_ReturnError_t CO_TPDOsend(CO_TPDO_t *TPDO) {
+static void CO_TPDObuild(CO_TPDO_t *TPDO) {
     CO_PDO_common_t *PDO = &TPDO->PDO_common;
     uint8_t *dataTPDO = &TPDO->CANtxBuff->data[0];
 #if OD_FLAGS_PDO_SIZE > 0
@@ -1331,10 +1513,130 @@ static CO_ReturnError_t CO_TPDOsend(CO_TPDO_t *TPDO) {
     TPDO->eventTimer = TPDO->eventTime_us;
     TPDO->inhibitTimer = TPDO->inhibitTime_us;
 #endif
-    return CO_CANsend(PDO->CANdev, TPDO->CANtxBuff);
 }
 
 
+/*
+ * Send TPDO message.
+ *
+ * Function prepares TPDO data from Object Dictionary variables and sends them.
+ * It is called from CO_TPDO_process() according to TPDO communication
+ * parameters.
+ *
+ * @param TPDO TPDO object.
+ *
+ * @return Same as CO_CANsend().
+ */
+static CO_ReturnError_t CO_TPDOsend(CO_TPDO_t *TPDO) {
+    CO_TPDObuild(TPDO);
+    return CO_CANsend(TPDO->PDO_common.CANdev, TPDO->CANtxBuff);
+}
+
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_SYNC_SCHEDULER
+/*
+ * Transmit offset of the synchronous TPDO, wrapped into synchronous window or
+ * communication cycle period. Offset is limited, so that one
+ * @ref CO_TPDO_SYNC_SLOT_US for the frame itself remains before the end.
+ *
+ * @param TPDO TPDO object.
+ *
+ * @return Offset in microseconds, 0 if neither window nor period is known.
+ */
+static uint32_t CO_TPDOsyncOffset(CO_TPDO_t *TPDO) {
+    CO_SYNC_t *SYNC = TPDO->SYNC;
+    uint32_t window = (SYNC->OD_1007_window != NULL)
+                    ? *SYNC->OD_1007_window : 0;
+    if (window == 0 && SYNC->OD_1006_period != NULL) {
+        window = *SYNC->OD_1006_period;
+    }
+
+    /* Without the window SYNC may come before the offset elapses, and the
+     * TPDO would be dropped each cycle. Send it at the SYNC instead. */
+    if (window <= CO_TPDO_SYNC_SLOT_US) {
+        return 0;
+    }
+    uint32_t offset = TPDO->syncOffset_us % window;
+    uint32_t offsetMax = window - CO_TPDO_SYNC_SLOT_US;
+    return (offset < offsetMax) ? offset : offsetMax;
+}
+
+
+/*
+ * Send synchronous TPDO or schedule it for transmission at its offset.
+ *
+ * Data are sampled immediately (at the SYNC). If TPDO from the previous SYNC
+ * is still waiting, it is discarded.
+ *
+ * @param TPDO TPDO object.
+ */
+static void CO_TPDOsendSync(CO_TPDO_t *TPDO) {
+    if (TPDO->syncTxPending) {
+        TPDO->syncStats.droppedCount++;
+    }
+
+    if (CO_TPDOsyncOffset(TPDO) == 0) {
+        TPDO->syncTxPending = false;
+        if (CO_TPDOsend(TPDO) == CO_ERROR_NO) {
+            TPDO->syncStats.sentCount++;
+            TPDO->syncStats.latenessLast_us = 0;
+        }
+        else {
+            TPDO->syncStats.droppedCount++;
+        }
+    }
+    else {
+        CO_TPDObuild(TPDO);
+        TPDO->syncTxPending = true;
+    }
+}
+
+
+/*
+ * Transmit scheduled synchronous TPDO, if its offset elapsed.
+ *
+ * @param TPDO TPDO object.
+ *
+ * @return Time in microseconds until transmission, 0 if none is pending.
+ */
+static uint32_t CO_TPDOsyncPending(CO_TPDO_t *TPDO) {
+    CO_SYNC_t *SYNC = TPDO->SYNC;
+    CO_TPDO_syncStats_t *stats = &TPDO->syncStats;
+
+    uint32_t offset = CO_TPDOsyncOffset(TPDO);
+
+    if (SYNC->syncIsOutsideWindow) {
+        /* synchronous PDO is not allowed outside the window */
+        TPDO->syncTxPending = false;
+        stats->droppedCount++;
+        return 0;
+    }
+    if (SYNC->timer < offset) {
+        return offset - SYNC->timer;
+    }
+
+    TPDO->syncTxPending = false;
+    if (CO_CANsend(TPDO->PDO_common.CANdev, TPDO->CANtxBuff) != CO_ERROR_NO) {
+        stats->droppedCount++;
+        return 0;
+    }
+
+    uint32_t lateness = SYNC->timer - offset;
+    stats->sentCount++;
+    stats->latenessLast_us = lateness;
+    if (lateness > stats->latenessMax_us) {
+        stats->latenessMax_us = lateness;
+    }
+    if (lateness > CO_TPDO_SYNC_SLOT_US) {
+        stats->lateCount++;
+    }
+    return 0;
+}
+#else
+#define CO_TPDOsendSync(TPDO) CO_TPDOsend(TPDO)
+#endif /* (CO_CONFIG_PDO) & CO_CONFIG_TPDO_SYNC_SCHEDULER */
+
+
 /******************************************************************************/
 void CO_TPDO_process(CO_TPDO_t *TPDO,
 #if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_TIMERS_ENABLE) || defined CO_DOXYGEN
@@ -1422,7 +1724,7 @@ void CO_TPDO_process(CO_TPDO_t *TPDO,
         else if (TPDO->SYNC != NULL && syncWas) {
             /* send synchronous acyclic TPDO */
             if (TPDO->transmissionType == CO_PDO_TRANSM_TYPE_SYNC_ACYCLIC) {
-                if (TPDO->sendRequest) CO_TPDOsend(TPDO);
+                if (TPDO->sendRequest) CO_TPDOsendSync(TPDO);
             }
             /* send synchronous cyclic TPDO */
             else {
@@ -1444,18 +1746,32 @@ void CO_TPDO_process(CO_TPDO_t *TPDO,
                 if (TPDO->syncCounter == 254) {
                     if (TPDO->SYNC->counter == TPDO->syncStartValue) {
                         TPDO->syncCounter = TPDO->transmissionType;
-                        CO_TPDOsend(TPDO);
+                        CO_TPDOsendSync(TPDO);
                     }
                 }
                 /* Send TPDO after every N-th Sync */
                 else if (--TPDO->syncCounter == 0) {
                     TPDO->syncCounter = TPDO->transmissionType;
-                    CO_TPDOsend(TPDO);
+                    CO_TPDOsendSync(TPDO);
                 }
             }
         } /* else if (TPDO->SYNC && syncWas) */
 #endif
 
+        /* Synchronous PDO waiting for its transmit offset */
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_SYNC_SCHEDULER
+        if (TPDO->syncTxPending && TPDO->SYNC != NULL) {
+            uint32_t diff = CO_TPDOsyncPending(TPDO);
+            (void) diff;
+ #if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_TIMERS_ENABLE) \
+     && ((CO_CONFIG_PDO) & CO_CONFIG_FLAG_TIMERNEXT)
+            if (diff > 0 && timerNext_us != NULL && *timerNext_us > diff) {
+                *timerNext_us = diff;
+            }
+ #endif
+        }
+#endif
+
     }
     else {
         /* Not operational or valid, reset triggers */
@@ -1465,8 +1781,360 @@ void CO_TPDO_process(CO_TPDO_t *TPDO,
 #endif
 #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_ENABLE
         TPDO->syncCounter = 255;
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_SYNC_SCHEDULER
+        TPDO->syncTxPending = false;
 #endif
     }
 }
 #endif /* (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE */
+
+
+/*******************************************************************************
+ *      P D O   R E M A P
+ ******************************************************************************/
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_REMAP
+/*
+ * Get next record from the remap DOMAIN
+ *
+ * @param remap This object.
+ * @param [in,out] pos Position of the record inside remap->buf.
+ * @param [out] index Index of the PDO mapping parameter.
+ * @param [out] count Number of mapped objects.
+ * @param [out] maps Pointer to mapping parameters.
+ *
+ * @return True, if complete record was read.
+ */
+static bool_t PDOremap_nextRecord(CO_PDOremap_t *remap, size_t *pos,
+                                  uint16_t *index, uint8_t *count,
+                                  const uint8_t **maps)
+{
+    size_t p = *pos;
+
+    if (p + 3 > remap->bufLength) {
+        return false;
+    }
+    *index = CO_getUint16(&remap->buf[p]);
+    *count = remap->buf[p + 2];
+    *maps = &remap->buf[p + 3];
+    p += 3 + (size_t)(*count) * 4;
+    if (p > remap->bufLength) {
+        return false;
+    }
+    *pos = p;
+    return true;
+}
+
+/*
+ * Find PDO, which belongs to the mapping parameter index
+ *
+ * @return PDO common object or NULL, if not found.
+ */
+static CO_PDO_common_t *PDOremap_getPDO(CO_PDOremap_t *remap, uint16_t index,
+                                        bool_t *isRPDO)
+{
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
+    if (index >= OD_H1600_RXPDO_1_MAPPING
+        && index < OD_H1600_RXPDO_1_MAPPING + remap->RPDOcount
+        && remap->RPDO != NULL
+    ) {
+        *isRPDO = true;
+        return &remap->RPDO[index - OD_H1600_RXPDO_1_MAPPING].PDO_common;
+    }
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
+    if (index >= OD_H1A00_TXPDO_1_MAPPING
+        && index < OD_H1A00_TXPDO_1_MAPPING + remap->TPDOcount
+        && remap->TPDO != NULL
+    ) {
+        *isRPDO = false;
+        return &remap->TPDO[index - OD_H1A00_TXPDO_1_MAPPING].PDO_common;
+    }
+#endif
+    return NULL;
+}
+
+/*
+ * Validate all records in the remap DOMAIN, PDOs are not changed
+ *
+ * @return ODR_OK on success, otherwise error reason.
+ */
+static ODR_t PDOremap_validate(CO_PDOremap_t *remap) {
+    size_t pos = 1;
+    uint16_t index;
+    uint8_t count;
+    const uint8_t *maps;
+    bool_t anyRPDO = false, anyTPDO = false;
+
+    if (remap->bufLength < 1 + 3) {
+        return ODR_DATA_SHORT;
+    }
+
+    while (PDOremap_nextRecord(remap, &pos, &index, &count, &maps)) {
+        bool_t isRPDO;
+        CO_PDO_common_t *PDO = PDOremap_getPDO(remap, index, &isRPDO);
+        if (PDO == NULL) {
+            return ODR_IDX_NOT_EXIST;
+        }
+        if (count == 0 && PDO->valid) {
+            return ODR_INVALID_VALUE;
+        }
+
+        /* each PDO only once */
+        size_t posPrev = 1;
+        uint16_t indexPrev;
+        uint8_t countPrev;
+        const uint8_t *mapsPrev;
+        while (posPrev < pos - 3 - (size_t)count * 4
+               && PDOremap_nextRecord(remap, &posPrev, &indexPrev, &countPrev,
+                                      &mapsPrev)
+        ) {
+            if (indexPrev == index) {
+                return ODR_INVALID_VALUE;
+            }
+        }
+
+        /* configure a copy, so original PDO stays untouched */
+        CO_PDO_common_t PDOcopy = *PDO;
+        ODR_t odRet = PDO_configMapArray(&PDOcopy, maps, count, isRPDO,
+                                         remap->OD);
+        if (odRet != ODR_OK) {
+            return odRet;
+        }
+
+        if (isRPDO) anyRPDO = true;
+        else anyTPDO = true;
+    }
+
+    if (pos != remap->bufLength) {
+        return ODR_TYPE_MISMATCH;
+    }
+
+    remap->pendingRPDO = anyRPDO;
+    remap->pendingTPDO = anyTPDO;
+    return ODR_OK;
+}
+
+/*
+ * Apply records from the validated remap DOMAIN to RPDOs or TPDOs
+ */
+static void PDOremap_apply(CO_PDOremap_t *remap, bool_t applyRPDO) {
+    size_t pos = 1;
+    uint16_t index;
+    uint8_t count;
+    const uint8_t *maps;
+
+    while (PDOremap_nextRecord(remap, &pos, &index, &count, &maps)) {
+        bool_t isRPDO;
+        CO_PDO_common_t *PDO = PDOremap_getPDO(remap, index, &isRPDO);
+        if (PDO == NULL || isRPDO != applyRPDO) {
+            continue;
+        }
+
+        /* mapping was validated, it can not fail here */
+        (void)PDO_configMapArray(PDO, maps, count, isRPDO, remap->OD);
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
+        if (!isRPDO) {
+            ((CO_TPDO_t *)PDO)->CANtxBuff->DLC = PDO->dataLength;
+        }
+#endif
+
+        /* update mapping parameters in Object Dictionary */
+        OD_entry_t *entry = OD_find(remap->OD, index);
+        CO_LOCK_OD(PDO->CANdev);
+        for (uint8_t i = 0; i < count; i++) {
+            OD_set_u32(entry, i + 1, CO_getUint32(&maps[i * 4]), true);
+        }
+        OD_set_u8(entry, 0, count, true);
+        CO_UNLOCK_OD(PDO->CANdev);
+    }
+}
+
+/*
+ * Cancel pending remap. PDO processing may run in other thread and must not
+ * see a half applied remap, so pending flags are cleared with OD locked.
+ */
+static void PDOremap_cancel(CO_PDOremap_t *remap) {
+    CO_CANmodule_t *CANdev = NULL;
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
+    if (remap->RPDO != NULL && remap->RPDOcount > 0) {
+        CANdev = remap->RPDO[0].PDO_common.CANdev;
+    }
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
+    if (CANdev == NULL && remap->TPDO != NULL && remap->TPDOcount > 0) {
+        CANdev = remap->TPDO[0].PDO_common.CANdev;
+    }
+#endif
+    (void)CANdev; /* may be unused */
+
+    CO_LOCK_OD(CANdev);
+    remap->pendingRPDO = false;
+    remap->pendingTPDO = false;
+    remap->bufLength = 0;
+    CO_UNLOCK_OD(CANdev);
+}
+
+/*
+ * Custom function for writing OD object "PDO remap"
+ *
+ * For more information see file CO_ODinterface.h, OD_IO_t.
+ */
+static ODR_t OD_write_PDOremap(OD_stream_t *stream, const void *buf,
+                               OD_size_t count, OD_size_t *countWritten)
+{
+    if (stream == NULL || buf == NULL || countWritten == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    CO_PDOremap_t *remap = stream->object;
+
+    /* DOMAIN with flags byte only cancels pending remap */
+    if (stream->dataOffset == 0 && count == 1 && stream->dataLength == 1) {
+        PDOremap_cancel(remap);
+        *countWritten = count;
+        return ODR_OK;
+    }
+
+    if (remap->pendingRPDO || remap->pendingTPDO) {
+        return ODR_DATA_DEV_STATE;
+    }
+
+    /* start of new download */
+    if (stream->dataOffset == 0) {
+        remap->bufLength = 0;
+    }
+    if (remap->bufLength + count > sizeof(remap->buf)) {
+        remap->bufLength = 0;
+        return ODR_DATA_LONG;
+    }
+    memcpy(&remap->buf[remap->bufLength], buf, count);
+    remap->bufLength += count;
+    stream->dataOffset += count;
+    *countWritten = count;
+
+    /* SDO server indicates data size at the end of download */
+    if (stream->dataLength == 0 || stream->dataOffset < stream->dataLength) {
+        return ODR_PARTIAL;
+    }
+    stream->dataOffset = 0;
+
+    ODR_t odRet = PDOremap_validate(remap);
+    if (odRet != ODR_OK) {
+        remap->bufLength = 0;
+    }
+    return odRet;
+}
+
+/*
+ * Custom function for reading OD object "PDO remap", returns last written
+ * DOMAIN.
+ *
+ * For more information see file CO_ODinterface.h, OD_IO_t.
+ */
+static ODR_t OD_read_PDOremap(OD_stream_t *stream, void *buf,
+                              OD_size_t count, OD_size_t *countRead)
+{
+    if (stream == NULL || buf == NULL || countRead == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    CO_PDOremap_t *remap = stream->object;
+    size_t remaining = remap->bufLength - stream->dataOffset;
+    ODR_t returnCode = ODR_OK;
+
+    if (remaining > count) {
+        remaining = count;
+        returnCode = ODR_PARTIAL;
+    }
+    memcpy(buf, &remap->buf[stream->dataOffset], remaining);
+    stream->dataOffset = (returnCode == ODR_PARTIAL)
+                       ? stream->dataOffset + remaining : 0;
+    *countRead = remaining;
+    return returnCode;
+}
+
+
+CO_ReturnError_t CO_PDOremap_init(CO_PDOremap_t *remap,
+                                  OD_t *OD,
+                                  OD_entry_t *OD_remap,
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
+                                  CO_RPDO_t *RPDO,
+                                  uint16_t RPDOcount,
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
+                                  CO_TPDO_t *TPDO,
+                                  uint16_t TPDOcount,
+#endif
+                                  uint32_t *errInfo)
+{
+    /* verify arguments */
+    if (remap == NULL || OD == NULL || OD_remap == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    /* clear object */
+    memset(remap, 0, sizeof(CO_PDOremap_t));
+
+    remap->OD = OD;
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
+    remap->RPDO = RPDO;
+    remap->RPDOcount = RPDOcount;
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
+    remap->TPDO = TPDO;
+    remap->TPDOcount = TPDOcount;
+#endif
+
+    remap->OD_remap_extension.object = remap;
+    remap->OD_remap_extension.read = OD_read_PDOremap;
+    remap->OD_remap_extension.write = OD_write_PDOremap;
+    ODR_t odRet = OD_extension_init(OD_remap, &remap->OD_remap_extension);
+    if (odRet != ODR_OK) {
+        if (errInfo != NULL) *errInfo = OD_getIndex(OD_remap);
+        return CO_ERROR_OD_PARAMETERS;
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
+void CO_PDOremap_processRPDO(CO_PDOremap_t *remap, bool_t syncWas) {
+    if (remap == NULL || !remap->pendingRPDO) {
+        return;
+    }
+
+    if (syncWas || (remap->buf[0] & CO_PDO_REMAP_FLAG_IMMEDIATE) != 0) {
+        PDOremap_apply(remap, true);
+        remap->pendingRPDO = false;
+    }
+}
+#endif
+
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
+void CO_PDOremap_processTPDO(CO_PDOremap_t *remap, bool_t syncWas) {
+    if (remap == NULL || !remap->pendingTPDO) {
+        return;
+    }
+
+    if (syncWas || (remap->buf[0] & CO_PDO_REMAP_FLAG_IMMEDIATE) != 0) {
+ #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_SYNC_SCHEDULER
+        /* Don't change TPDO, which waits for its transmit offset. At the SYNC
+         * such TPDO is built again by CO_TPDO_process() anyway. */
+        if (!syncWas) {
+            for (uint16_t i = 0; i < remap->TPDOcount; i++) {
+                if (remap->TPDO[i].syncTxPending) {
+                    return;
+                }
+            }
+        }
+ #endif
+        PDOremap_apply(remap, false);
+        remap->pendingTPDO = false;
+    }
+}
+#endif
+#endif /* (CO_CONFIG_PDO) & CO_CONFIG_PDO_REMAP */
 #endif /* (CO_CONFIG_PDO) & (CO_CONFIG_RPDO_ENABLE | CO_CONFIG_TPDO_ENABLE) */
@@ -164,6 +164,33 @@ extern "C" {
 #define CO_TPDO_DEFAULT_CANID_COUNT 4
 #endif
 
+#if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_SYNC_SCHEDULER) || defined CO_DOXYGEN
+/** Length of one transmit slot inside the SYNC period in microseconds, used by
+ * @ref CO_CONFIG_TPDO_SYNC_SCHEDULER. Default value is a little more than the
+ * worst case transmission time of a CAN frame with 8 data bytes at 500 kbps. */
+#ifndef CO_TPDO_SYNC_SLOT_US
+#define CO_TPDO_SYNC_SLOT_US 300
+#endif
+
+/** Number of transmit slots reserved for each node-ID, when default transmit
+ * offsets are calculated from node-ID, see @ref CO_TPDO_SYNC_OFFSET_DEFAULT */
+#ifndef CO_TPDO_SYNC_SLOTS_PER_NODE
+#define CO_TPDO_SYNC_SLOTS_PER_NODE 4
+#endif
+
+/** Default transmit offset for the TPDO with index tpdoIdx on the device with
+ * nodeId. Nodes get consecutive groups of slots, so synchronous TPDOs from
+ * different producers don't compete for the bus just after the SYNC. Offset is
+ * later wrapped into the synchronous window by CO_TPDO_process(). Wrapped
+ * offsets of nodes, which are more than window / (slot * slots per node)
+ * apart, fall into the same slot again. */
+#ifndef CO_TPDO_SYNC_OFFSET_DEFAULT
+#define CO_TPDO_SYNC_OFFSET_DEFAULT(nodeId, tpdoIdx) \
+    ((uint32_t)CO_TPDO_SYNC_SLOT_US \
+     * ((((uint32_t)(nodeId) - 1) * CO_TPDO_SYNC_SLOTS_PER_NODE) + (tpdoIdx)))
+#endif
+#endif
+
 #ifndef CO_PDO_OWN_TYPES
 /** Variable of type CO_PDO_size_t contains data length in bytes of PDO */
 typedef uint8_t CO_PDO_size_t;
@@ -252,6 +279,52 @@ typedef struct {
 #endif
 
 
+#if ((CO_CONFIG_PDO) & CO_CONFIG_RPDO_MAILBOX) || defined CO_DOXYGEN
+/** Number of attempts of CO_RPDO_mailboxRead() to get consistent copy, if
+ * mailbox is updated by CAN receive interrupt during the read. */
+#ifndef CO_RPDO_MAILBOX_READ_RETRIES
+#define CO_RPDO_MAILBOX_READ_RETRIES 4
+#endif
+
+/**
+ * Latest-value mailbox of the RPDO, see @ref CO_CONFIG_RPDO_MAILBOX.
+ *
+ * Mailbox is written only by CO_PDO_receive() in CAN receive context. Member
+ * sequence is used as sequence lock: it is odd while mailbox is being updated
+ * and it is incremented by two for each received message.
+ */
+typedef struct {
+    /** Sequence lock and counter of received messages (sequence / 2) */
+    volatile uint32_t sequence;
+    /** Reception time in microseconds, see CO_CANrxMsg_readTimestamp() */
+    volatile uint32_t timestamp_us;
+    /** Length of the received message, limited to CO_PDO_MAX_SIZE */
+    volatile uint8_t dataLength;
+    /** Data bytes of the last received message */
+    volatile uint8_t data[CO_PDO_MAX_SIZE];
+} CO_RPDO_mailbox_t;
+
+/**
+ * Copy of the RPDO mailbox, returned by CO_RPDO_mailboxRead().
+ */
+typedef struct {
+    /** Data bytes of the last received message */
+    uint8_t data[CO_PDO_MAX_SIZE];
+    /** Length of the received message */
+    uint8_t dataLength;
+    /** Reception time in microseconds */
+    uint32_t timestamp_us;
+    /** Time elapsed since reception in microseconds */
+    uint32_t age_us;
+    /** Number of messages received since CO_RPDO_init() */
+    uint32_t count;
+    /** Number of messages overwritten since previous read by the same reader,
+     * before the reader could see them */
+    uint32_t missed;
+} CO_RPDO_mailboxValue_t;
+#endif
+
+
 /**
  * RPDO object.
  */
@@ -264,6 +337,10 @@ typedef struct {
     uint8_t CANrxData[CO_RPDO_CAN_BUFFERS_COUNT][CO_PDO_MAX_SIZE];
     /** Indication of RPDO length errors, use with CO_PDO_receiveErrors_t */
     uint8_t receiveError;
+#if ((CO_CONFIG_PDO) & CO_CONFIG_RPDO_MAILBOX) || defined CO_DOXYGEN
+    /** Latest received message with timestamp, see CO_RPDO_mailboxRead() */
+    CO_RPDO_mailbox_t mailbox;
+#endif
 #if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_ENABLE) || defined CO_DOXYGEN
     /** From CO_RPDO_init() */
     CO_SYNC_t *SYNC;
@@ -341,6 +418,38 @@ void CO_RPDO_initCallbackPre(CO_RPDO_t *RPDO,
 #endif
 
 
+#if ((CO_CONFIG_PDO) & CO_CONFIG_RPDO_MAILBOX) || defined CO_DOXYGEN
+/**
+ * Read latest received message from the RPDO mailbox.
+ *
+ * Function does not disable interrupts and may be called from any context,
+ * for example from control loop running in timer interrupt. Data are raw
+ * bytes of the CAN message, stored on reception, independent of NMT state and
+ * of CO_RPDO_process(). Consistent copy is obtained with sequence lock, see
+ * @ref CO_RPDO_mailbox_t.
+ *
+ * Each reader keeps its own lastCount variable, initialized to zero. It is
+ * used to calculate the number of missed updates and is updated by the
+ * function.
+ *
+ * @param RPDO This object.
+ * @param now_us Current time in microseconds, on the same time base as
+ * CO_CANrxMsg_readTimestamp().
+ * @param [in,out] lastCount Message count seen by the reader at previous call,
+ * may be NULL.
+ * @param [out] value Copy of the mailbox, age and counters.
+ *
+ * @return True, if value contains message, which was not yet read with the
+ * lastCount. False, if no new message or consistent copy was not possible in
+ * @ref CO_RPDO_MAILBOX_READ_RETRIES attempts.
+ */
+bool_t CO_RPDO_mailboxRead(CO_RPDO_t *RPDO,
+                           uint32_t now_us,
+                           uint32_t *lastCount,
+                           CO_RPDO_mailboxValue_t *value);
+#endif
+
+
 /**
  * Process received PDO messages.
  *
@@ -370,6 +479,28 @@ void CO_RPDO_process(CO_RPDO_t *RPDO,
  *      T P D O
  ******************************************************************************/
 #if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE) || defined CO_DOXYGEN
+#if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_SYNC_SCHEDULER) || defined CO_DOXYGEN
+/**
+ * Lateness statistics of the synchronous TPDO, see
+ * @ref CO_CONFIG_TPDO_SYNC_SCHEDULER.
+ */
+typedef struct {
+    /** Number of synchronous TPDOs passed to CO_CANsend() */
+    uint32_t sentCount;
+    /** Number of TPDOs sent more than @ref CO_TPDO_SYNC_SLOT_US after their
+     * transmit offset */
+    uint32_t lateCount;
+    /** Number of TPDOs discarded, because synchronous window expired, next
+     * SYNC arrived before transmission or CAN transmit buffer was full */
+    uint32_t droppedCount;
+    /** Lateness of the last sent TPDO in microseconds, relative to offset */
+    uint32_t latenessLast_us;
+    /** Maximum lateness in microseconds, relative to offset */
+    uint32_t latenessMax_us;
+} CO_TPDO_syncStats_t;
+#endif
+
+
 /**
  * TPDO object.
  */
@@ -391,6 +522,15 @@ typedef struct {
     /** SYNC counter used for PDO sending */
     uint8_t syncCounter;
 #endif
+#if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_SYNC_SCHEDULER) || defined CO_DOXYGEN
+    /** Transmit offset after the SYNC in microseconds, from
+     * CO_TPDO_setSyncOffset() */
+    uint32_t syncOffset_us;
+    /** True, if synchronous TPDO data are prepared and wait for the offset */
+    bool_t syncTxPending;
+    /** Lateness statistics */
+    CO_TPDO_syncStats_t syncStats;
+#endif
 #if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_TIMERS_ENABLE) || defined CO_DOXYGEN
     /** Inhibit time from object dictionary translated to microseconds */
     uint32_t inhibitTime_us;
@@ -455,6 +595,59 @@ static inline void CO_TPDOsendRequest(CO_TPDO_t *TPDO) {
 }
 
 
+#if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_SYNC_SCHEDULER) || defined CO_DOXYGEN
+/**
+ * Set transmit offset of the synchronous TPDO.
+ *
+ * Data of the synchronous TPDO are still sampled from the Object Dictionary at
+ * the SYNC, but CAN message is sent by CO_TPDO_process() when syncOffset_us
+ * elapses after the SYNC. If synchronous window length (OD 0x1007) is
+ * configured, offset is wrapped into it, otherwise into communication cycle
+ * period (OD 0x1006) and limited to leave @ref CO_TPDO_SYNC_SLOT_US for the
+ * frame before its end. If neither is known, offset is not used and TPDO is
+ * sent immediately after the SYNC. Offset is measured from the SYNC on the bus
+ * only with CO_SYNC_initTimestamp(). Wrapped offsets may collide, see
+ * @ref CO_TPDO_SYNC_OFFSET_DEFAULT. If window expires before transmission,
+ * TPDO is discarded and counted in @ref CO_TPDO_syncStats_t.
+ *
+ * CO_CANopenInitPDO() sets default offset with
+ * @ref CO_TPDO_SYNC_OFFSET_DEFAULT. Offset 0 means transmission immediately
+ * after the SYNC, as without the scheduler.
+ *
+ * @param TPDO TPDO object.
+ * @param syncOffset_us Transmit offset after the SYNC in microseconds.
+ */
+static inline void CO_TPDO_setSyncOffset(CO_TPDO_t *TPDO,
+                                         uint32_t syncOffset_us)
+{
+    if (TPDO != NULL) TPDO->syncOffset_us = syncOffset_us;
+}
+
+
+/**
+ * Get lateness statistics of the synchronous TPDO.
+ *
+ * @param TPDO TPDO object.
+ *
+ * @return Pointer to statistics, may be NULL.
+ */
+static inline const CO_TPDO_syncStats_t *CO_TPDO_getSyncStats(CO_TPDO_t *TPDO)
+{
+    return (TPDO != NULL) ? &TPDO->syncStats : NULL;
+}
+
+
+/**
+ * Clear lateness statistics of the synchronous TPDO.
+ *
+ * @param TPDO TPDO object.
+ */
+static inline void CO_TPDO_resetSyncStats(CO_TPDO_t *TPDO) {
+    if (TPDO != NULL) memset(&TPDO->syncStats, 0, sizeof(TPDO->syncStats));
+}
+#endif
+
+
 /**
  * Process transmitting PDO messages.
  *
@@ -477,6 +670,158 @@ void CO_TPDO_process(CO_TPDO_t *TPDO,
                      bool_t syncWas);
 #endif /* (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE */
 
+
+/*******************************************************************************
+ *      P D O   R E M A P
+ ******************************************************************************/
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_REMAP) || defined CO_DOXYGEN
+/** Index of manufacturer specific DOMAIN object used for PDO remap. If object
+ * does not exist in Object Dictionary, remap is not available. */
+#ifndef CO_PDO_REMAP_OD_INDEX
+#define CO_PDO_REMAP_OD_INDEX 0x2200
+#endif
+
+/** Size of buffer for the remap DOMAIN in bytes. Default is large enough for
+ * complete mapping of eight PDOs. */
+#ifndef CO_PDO_REMAP_BUF_SIZE
+#define CO_PDO_REMAP_BUF_SIZE (1 + 8 * (3 + 4 * CO_PDO_MAX_MAPPED_ENTRIES))
+#endif
+
+/** Flag in the first byte of the remap DOMAIN: apply new mapping on the next
+ * call to CO_PDOremap_processRPDO() / CO_PDOremap_processTPDO(), don't wait
+ * for the SYNC. Use it, if PDOs are not synchronous or SYNC is not used. */
+#define CO_PDO_REMAP_FLAG_IMMEDIATE 0x01
+
+/**
+ * PDO remap object.
+ *
+ * Complete new mapping of one or more PDOs is written as single DOMAIN into
+ * OD object @ref CO_PDO_REMAP_OD_INDEX, for example with SDO block transfer.
+ * Contents of the DOMAIN (little endian):
+ * - byte 0: flags, see @ref CO_PDO_REMAP_FLAG_IMMEDIATE.
+ * - for each PDO, one record:
+ *   - UNSIGNED16: index of "PDO mapping parameter" (0x16xx or 0x1Axx),
+ *   - UNSIGNED8: number of mapped objects,
+ *   - UNSIGNED32 for each mapped object: mapping parameter, the same as in
+ *     sub-indexes 1..8 of 0x16xx or 0x1Axx.
+ *
+ * Whole DOMAIN is validated when download finishes. If any entry is not
+ * valid, SDO is aborted with corresponding abort code and no PDO is changed.
+ * Otherwise new mapping is applied at the next SYNC: RPDOs after CO_RPDO_process()
+ * handles data received before the SYNC, TPDOs before they are sampled for the
+ * SYNC. PDOs stay enabled, so no message is lost. Values of the mapping
+ * parameters in Object Dictionary are updated too.
+ *
+ * If producer and consumers are remapped for the same SYNC, synchronous PDOs
+ * stay consistent: frames sent before the SYNC are decoded with the old
+ * mapping, frames sampled at the SYNC with the new one. Event driven PDOs,
+ * which are on the bus around the SYNC, may be decoded with the wrong mapping;
+ * only the change of their length is detected by the consumer. Remap them
+ * while they are not used.
+ *
+ * New remap is not accepted (SDO abort 0x08000022), until previous one is
+ * applied. If SYNC does not come, pending remap is cancelled by writing
+ * DOMAIN of one byte (flags only), then no PDO is changed.
+ */
+typedef struct {
+    /** From CO_PDOremap_init() */
+    OD_t *OD;
+#if ((CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE) || defined CO_DOXYGEN
+    /** From CO_PDOremap_init() */
+    CO_RPDO_t *RPDO;
+    /** From CO_PDOremap_init() */
+    uint16_t RPDOcount;
+#endif
+#if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE) || defined CO_DOXYGEN
+    /** From CO_PDOremap_init() */
+    CO_TPDO_t *TPDO;
+    /** From CO_PDOremap_init() */
+    uint16_t TPDOcount;
+#endif
+    /** Contents of the remap DOMAIN */
+    uint8_t buf[CO_PDO_REMAP_BUF_SIZE];
+    /** Number of bytes in buf */
+    size_t bufLength;
+    /** True, if validated mapping for RPDOs waits to be applied */
+    bool_t pendingRPDO;
+    /** True, if validated mapping for TPDOs waits to be applied */
+    bool_t pendingTPDO;
+    /** Extension for OD object */
+    OD_extension_t OD_remap_extension;
+} CO_PDOremap_t;
+
+
+/**
+ * Initialize PDO remap object.
+ *
+ * Function must be called after CO_RPDO_init() and CO_TPDO_init() of all PDOs.
+ * PDO objects must be in arrays, in the same order as their OD objects.
+ *
+ * @param remap This object will be initialized.
+ * @param OD Object Dictionary.
+ * @param OD_remap OD entry for the remap DOMAIN, @ref CO_PDO_REMAP_OD_INDEX.
+ * @param RPDO Array of RPDO objects, may be NULL.
+ * @param RPDOcount Number of RPDO objects.
+ * @param TPDO Array of TPDO objects, may be NULL.
+ * @param TPDOcount Number of TPDO objects.
+ * @param [out] errInfo Additional information in case of error, may be NULL.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO on success.
+ */
+CO_ReturnError_t CO_PDOremap_init(CO_PDOremap_t *remap,
+                                  OD_t *OD,
+                                  OD_entry_t *OD_remap,
+#if ((CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE) || defined CO_DOXYGEN
+                                  CO_RPDO_t *RPDO,
+                                  uint16_t RPDOcount,
+#endif
+#if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE) || defined CO_DOXYGEN
+                                  CO_TPDO_t *TPDO,
+                                  uint16_t TPDOcount,
+#endif
+                                  uint32_t *errInfo);
+
+
+/**
+ * Check if remap waits to be applied.
+ *
+ * @param remap This object.
+ *
+ * @return True, if mapping of any PDO is not yet applied.
+ */
+static inline bool_t CO_PDOremap_isPending(CO_PDOremap_t *remap) {
+    return remap != NULL && (remap->pendingRPDO || remap->pendingTPDO);
+}
+
+
+#if ((CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE) || defined CO_DOXYGEN
+/**
+ * Apply pending RPDO remap.
+ *
+ * Function must be called after CO_RPDO_process() for all RPDOs.
+ *
+ * @param remap This object.
+ * @param syncWas True, if CANopen SYNC message was just received or
+ * transmitted.
+ */
+void CO_PDOremap_processRPDO(CO_PDOremap_t *remap, bool_t syncWas);
+#endif
+
+
+#if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE) || defined CO_DOXYGEN
+/**
+ * Apply pending TPDO remap.
+ *
+ * Function must be called before CO_TPDO_process() for all TPDOs.
+ *
+ * @param remap This object.
+ * @param syncWas True, if CANopen SYNC message was just received or
+ * transmitted.
+ */
+void CO_PDOremap_processTPDO(CO_PDOremap_t *remap, bool_t syncWas);
+#endif
+#endif /* (CO_CONFIG_PDO) & CO_CONFIG_PDO_REMAP */
+
 /** @} */ /* CO_PDO */
 
 #ifdef __cplusplus
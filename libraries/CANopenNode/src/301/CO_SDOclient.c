@@ -279,6 +279,9 @@ CO_ReturnError_t CO_SDOclient_init(CO_SDOclient_t *SDO_C,
     SDO_C->pFunctSignal = NULL;
     SDO_C->functSignalObject = NULL;
 #endif
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS
+    SDO_C->stats = NULL;
+#endif
 
     /* prepare circular fifo buffer */
     CO_fifo_init(&SDO_C->bufFifo, SDO_C->buf,
@@ -341,6 +344,34 @@ void CO_SDOclient_initCallbackPre(CO_SDOclient_t *SDOclient,
 }
 #endif
 
+
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS
+/******************************************************************************/
+void CO_SDOclient_initStats(CO_SDOclient_t *SDOclient, CO_SDOstats_t *stats) {
+    if (SDOclient != NULL) {
+        SDOclient->stats = stats;
+    }
+}
+
+
+/* Record transfer, which was finished in this call, into statistics. */
+static void statsEnd(CO_SDOclient_t *SDO_C,
+                     CO_SDO_return_t ret,
+                     CO_SDO_abortCode_t abortCode)
+{
+    if (ret == CO_SDO_RT_ok_communicationEnd) {
+        CO_SDOstats_transfer(SDO_C->stats, (uint32_t)SDO_C->sizeTran,
+                             SDO_C->statsTime_us);
+    }
+    else if (ret == CO_SDO_RT_endedWithClientAbort) {
+        CO_SDOstats_abort(SDO_C->stats, (uint32_t)abortCode);
+    }
+    else if (ret == CO_SDO_RT_endedWithServerAbort) {
+        CO_SDOstats_peerAbort(SDO_C->stats);
+    }
+}
+#endif
+
 #if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL) && defined CO_BIG_ENDIAN
 static inline void reverseBytes(void *start, OD_size_t size) {
     uint8_t *lo = (uint8_t *)start;
@@ -354,6 +385,42 @@ static inline void reverseBytes(void *start, OD_size_t size) {
 }
 #endif
 
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL
+/*
+ * Find the object in the Object Dictionary of this node and verify access,
+ * same as SDO server does.
+ *
+ * @return CO_SDO_AB_NONE, if OD_IO is ready for reading or writing.
+ */
+static CO_SDO_abortCode_t localOpen(OD_t *OD,
+                                    uint16_t index,
+                                    uint8_t subIndex,
+                                    OD_IO_t *OD_IO,
+                                    bool_t upload)
+{
+    ODR_t odRet = OD_getSub(OD_find(OD, index), subIndex, OD_IO, false);
+
+    if (odRet != ODR_OK) {
+        return (CO_SDO_abortCode_t)OD_getSDOabCode(odRet);
+    }
+
+    OD_attr_t attribute = OD_IO->stream.attribute;
+    if ((attribute & ODA_SDO_RW) == 0) {
+        return CO_SDO_AB_UNSUPPORTED_ACCESS;
+    }
+    if (upload && (attribute & ODA_SDO_R) == 0) {
+        return CO_SDO_AB_WRITEONLY;
+    }
+    if (!upload && (attribute & ODA_SDO_W) == 0) {
+        return CO_SDO_AB_READONLY;
+    }
+    if ((upload && OD_IO->read == NULL) || (!upload && OD_IO->write == NULL)) {
+        return CO_SDO_AB_DEVICE_INCOMPAT;
+    }
+    return CO_SDO_AB_NONE;
+}
+#endif
+
 
 /******************************************************************************/
 CO_SDO_return_t CO_SDOclient_setup(CO_SDOclient_t *SDO_C,
@@ -449,14 +516,15 @@ CO_SDO_return_t CO_SDOclientDownloadInitiate(CO_SDOclient_t *SDO_C,
     SDO_C->finished = false;
     SDO_C->SDOtimeoutTime_us = (uint32_t)SDOtimeoutTime_ms * 1000;
     SDO_C->timeoutTimer = 0;
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS
+    SDO_C->statsTime_us = 0;
+#endif
     CO_fifo_reset(&SDO_C->bufFifo);
 
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL
     /* if node-ID of the SDO server is the same as node-ID of this node, then
      * transfer data within this node */
-    if (SDO_C->OD != NULL && SDO_C->nodeId != 0
-        && SDO_C->nodeIDOfTheSDOServer == SDO_C->nodeId
-    ) {
+    if (CO_SDOclientIsLocal(SDO_C, SDO_C->nodeIDOfTheSDOServer)) {
         SDO_C->OD_IO.write = NULL;
         SDO_C->state = CO_SDO_ST_DOWNLOAD_LOCAL_TRANSFER;
     }
@@ -522,6 +590,12 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
 
     CO_SDO_return_t ret = CO_SDO_RT_waitingResponse;
     CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS
+    bool_t statsActive = SDO_C != NULL && SDO_C->state != CO_SDO_ST_IDLE;
+    if (statsActive) {
+        SDO_C->statsTime_us += timeDifference_us;
+    }
+#endif
 
     if (SDO_C == NULL || !SDO_C->valid) {
         abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
@@ -535,25 +609,10 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
     else if (SDO_C->state == CO_SDO_ST_DOWNLOAD_LOCAL_TRANSFER && !abort) {
         /* search object dictionary in first pass */
         if (SDO_C->OD_IO.write == NULL) {
-            ODR_t odRet;
-
-            odRet = OD_getSub(OD_find(SDO_C->OD, SDO_C->index), SDO_C->subIndex,
-                              &SDO_C->OD_IO, false);
-
-            if (odRet != ODR_OK) {
-                abortCode = (CO_SDO_abortCode_t)OD_getSDOabCode(odRet);
-                ret = CO_SDO_RT_endedWithClientAbort;
-            }
-            else if ((SDO_C->OD_IO.stream.attribute & ODA_SDO_RW) == 0) {
-                abortCode = CO_SDO_AB_UNSUPPORTED_ACCESS;
-                ret = CO_SDO_RT_endedWithClientAbort;
-            }
-            else if ((SDO_C->OD_IO.stream.attribute & ODA_SDO_W) == 0) {
-                abortCode = CO_SDO_AB_READONLY;
-                ret = CO_SDO_RT_endedWithClientAbort;
-            }
-            else if (SDO_C->OD_IO.write == NULL) {
-                abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
+            abortCode = localOpen(SDO_C->OD, SDO_C->index, SDO_C->subIndex,
+                                  &SDO_C->OD_IO, false);
+            if (abortCode != CO_SDO_AB_NONE) {
+                SDO_C->OD_IO.write = NULL;
                 ret = CO_SDO_RT_endedWithClientAbort;
             }
         }
@@ -672,6 +731,11 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
 #endif /* CO_CONFIG_SDO_CLI_LOCAL */
     /* CAN data received ******************************************************/
     else if (CO_FLAG_READ(SDO_C->CANrxNew)) {
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS
+        /* server response to the last message of this client */
+        CO_SDOstats_turnaround(SDO_C->stats,
+                               SDO_C->timeoutTimer + timeDifference_us);
+#endif
         /* is SDO abort */
         if (SDO_C->CANrxData[0] == 0x80) {
             uint32_t code;
@@ -793,6 +857,9 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
                         CO_fifo_altBegin(&SDO_C->bufFifo,
                                          (size_t)SDO_C->CANrxData[1] * 7);
                         SDO_C->finished = false;
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS
+                        CO_SDOstats_retry(SDO_C->stats);
+#endif
                     }
                     else if (SDO_C->CANrxData[1] > SDO_C->block_seqno) {
                         /* something strange from server, break transmission */
@@ -1091,6 +1158,11 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
     if (SDOabortCode != NULL) {
         *SDOabortCode = abortCode;
     }
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS
+    if (statsActive && SDO_C->state == CO_SDO_ST_IDLE) {
+        statsEnd(SDO_C, ret, abortCode);
+    }
+#endif
 
     return ret;
 }
@@ -1119,6 +1191,9 @@ CO_SDO_return_t CO_SDOclientUploadInitiate(CO_SDOclient_t *SDO_C,
     CO_fifo_reset(&SDO_C->bufFifo);
     SDO_C->SDOtimeoutTime_us = (uint32_t)SDOtimeoutTime_ms * 1000;
     SDO_C->timeoutTimer = 0;
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS
+    SDO_C->statsTime_us = 0;
+#endif
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK
     SDO_C->block_SDOtimeoutTime_us = (uint32_t)SDOtimeoutTime_ms * 700;
 #endif
@@ -1126,9 +1201,7 @@ CO_SDO_return_t CO_SDOclientUploadInitiate(CO_SDOclient_t *SDO_C,
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL
     /* if node-ID of the SDO server is the same as node-ID of this node, then
      * transfer data within this node */
-    if (SDO_C->OD != NULL && SDO_C->nodeId != 0
-        && SDO_C->nodeIDOfTheSDOServer == SDO_C->nodeId
-    ) {
+    if (CO_SDOclientIsLocal(SDO_C, SDO_C->nodeIDOfTheSDOServer)) {
         SDO_C->OD_IO.read = NULL;
         SDO_C->state = CO_SDO_ST_UPLOAD_LOCAL_TRANSFER;
     }
@@ -1163,6 +1236,12 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
 
     CO_SDO_return_t ret = CO_SDO_RT_waitingResponse;
     CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS
+    bool_t statsActive = SDO_C != NULL && SDO_C->state != CO_SDO_ST_IDLE;
+    if (statsActive) {
+        SDO_C->statsTime_us += timeDifference_us;
+    }
+#endif
 
     if (SDO_C == NULL || !SDO_C->valid) {
         abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
@@ -1176,25 +1255,10 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
     else if (SDO_C->state == CO_SDO_ST_UPLOAD_LOCAL_TRANSFER && !abort) {
         /* search object dictionary in first pass */
         if (SDO_C->OD_IO.read == NULL) {
-            ODR_t odRet;
-
-            odRet = OD_getSub(OD_find(SDO_C->OD, SDO_C->index), SDO_C->subIndex,
-                              &SDO_C->OD_IO, false);
-
-            if (odRet != ODR_OK) {
-                abortCode = (CO_SDO_abortCode_t)OD_getSDOabCode(odRet);
-                ret = CO_SDO_RT_endedWithClientAbort;
-            }
-            else if ((SDO_C->OD_IO.stream.attribute & ODA_SDO_RW) == 0) {
-                abortCode = CO_SDO_AB_UNSUPPORTED_ACCESS;
-                ret = CO_SDO_RT_endedWithClientAbort;
-            }
-            else if ((SDO_C->OD_IO.stream.attribute & ODA_SDO_R) == 0) {
-                abortCode = CO_SDO_AB_WRITEONLY;
-                ret = CO_SDO_RT_endedWithClientAbort;
-            }
-            else if (SDO_C->OD_IO.read == NULL) {
-                abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
+            abortCode = localOpen(SDO_C->OD, SDO_C->index, SDO_C->subIndex,
+                                  &SDO_C->OD_IO, true);
+            if (abortCode != CO_SDO_AB_NONE) {
+                SDO_C->OD_IO.read = NULL;
                 ret = CO_SDO_RT_endedWithClientAbort;
             }
         }
@@ -1284,6 +1348,11 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
 #endif /* CO_CONFIG_SDO_CLI_LOCAL */
     /* CAN data received ******************************************************/
     else if (CO_FLAG_READ(SDO_C->CANrxNew)) {
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS
+        /* server response to the last message of this client */
+        CO_SDOstats_turnaround(SDO_C->stats,
+                               SDO_C->timeoutTimer + timeDifference_us);
+#endif
         /* is SDO abort */
         if (SDO_C->CANrxData[0] == 0x80) {
             uint32_t code;
@@ -1693,8 +1762,11 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
         case CO_SDO_ST_UPLOAD_BLK_SUBBLOCK_CRSP: {
             SDO_C->CANtxBuff->data[0] = 0xA2;
             SDO_C->CANtxBuff->data[1] = SDO_C->block_seqno;
-#ifdef CO_DEBUG_SDO_CLIENT
+#if defined CO_DEBUG_SDO_CLIENT \
+    || ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS)
             bool_t transferShort = SDO_C->block_seqno != SDO_C->block_blksize;
+#endif
+#ifdef CO_DEBUG_SDO_CLIENT
             uint8_t seqnoStart = SDO_C->block_seqno;
 #endif
 
@@ -1748,6 +1820,11 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
             /* reset block_timeoutTimer, but not SDO_C->timeoutTimer */
             SDO_C->block_timeoutTimer = 0;
             CO_CANsend(SDO_C->CANdevTx, SDO_C->CANtxBuff);
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS
+            if (transferShort && !SDO_C->finished) {
+                CO_SDOstats_retry(SDO_C->stats);
+            }
+#endif
 #ifdef CO_DEBUG_SDO_CLIENT
             if (transferShort && !SDO_C->finished) {
                 char msg[80];
@@ -1806,6 +1883,11 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
     if (SDOabortCode != NULL) {
         *SDOabortCode = abortCode;
     }
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS
+    if (statsActive && SDO_C->state == CO_SDO_ST_IDLE) {
+        statsEnd(SDO_C, ret, abortCode);
+    }
+#endif
 
     return ret;
 }
@@ -1831,4 +1913,394 @@ void CO_SDOclientClose(CO_SDOclient_t *SDO_C) {
     }
 }
 
+
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL
+/******************************************************************************/
+CO_SDO_return_t CO_SDOclientLocalDownload(CO_SDOclient_t *SDO_C,
+                                          uint16_t index,
+                                          uint8_t subIndex,
+                                          const uint8_t *buf,
+                                          size_t size,
+                                          CO_SDO_abortCode_t *SDOabortCode)
+{
+    CO_SDO_return_t ret = CO_SDO_RT_endedWithClientAbort;
+    CO_SDO_abortCode_t abortCode;
+    OD_IO_t OD_IO;
+
+    if (SDO_C == NULL || SDO_C->OD == NULL || buf == NULL) {
+        if (SDOabortCode != NULL) {
+            *SDOabortCode = CO_SDO_AB_DEVICE_INCOMPAT;
+        }
+        return CO_SDO_RT_wrongArguments;
+    }
+
+    abortCode = localOpen(SDO_C->OD, index, subIndex, &OD_IO, false);
+
+    if (abortCode == CO_SDO_AB_NONE) {
+        OD_size_t sizeInOd = OD_IO.stream.dataLength;
+        /* zero bytes, which terminate the shorter (unicode) string */
+        uint8_t countZero = 0;
+
+        if (size == 0) {
+            abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
+        }
+        else if ((OD_IO.stream.attribute & ODA_STR) != 0
+                 && (sizeInOd == 0 || size < sizeInOd)
+        ) {
+            countZero = (sizeInOd == 0 || sizeInOd > (size + 1)) ? 2 : 1;
+            OD_IO.stream.dataLength = (OD_size_t)(size + countZero);
+        }
+        else if (sizeInOd == 0) {
+            OD_IO.stream.dataLength = (OD_size_t)size;
+        }
+        else if (size != sizeInOd) {
+            abortCode = (size > sizeInOd) ? CO_SDO_AB_DATA_LONG
+                                          : CO_SDO_AB_DATA_SHORT;
+        }
+#ifdef CO_BIG_ENDIAN
+        /* swap int16_t .. uint64_t data, multi-byte objects are small */
+        uint8_t bufSwapped[8];
+        if (abortCode == CO_SDO_AB_NONE
+            && (OD_IO.stream.attribute & ODA_MB) != 0
+        ) {
+            if (size > sizeof(bufSwapped)) {
+                abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
+            }
+            else {
+                memcpy(bufSwapped, buf, size);
+                reverseBytes(bufSwapped, (OD_size_t)size);
+                buf = bufSwapped;
+            }
+        }
+#endif
+
+        if (abortCode == CO_SDO_AB_NONE) {
+            static const uint8_t zero[2] = {0, 0};
+            OD_size_t countWritten = 0;
+            bool_t lock = OD_mappable(&OD_IO.stream);
+
+            /* write data and terminating zeros to the Object Dictionary */
+            if (lock) { CO_LOCK_OD(SDO_C->CANdevTx); }
+            ODR_t odRet = OD_IO.write(&OD_IO.stream, buf,
+                                      (OD_size_t)size, &countWritten);
+            if (odRet == ODR_PARTIAL && countZero > 0) {
+                odRet = OD_IO.write(&OD_IO.stream, zero, countZero,
+                                    &countWritten);
+            }
+            if (lock) { CO_UNLOCK_OD(SDO_C->CANdevTx); }
+
+            if (odRet == ODR_PARTIAL) {
+                abortCode = CO_SDO_AB_DATA_SHORT;
+            }
+            else if (odRet != ODR_OK) {
+                abortCode = (CO_SDO_abortCode_t)OD_getSDOabCode(odRet);
+                ret = CO_SDO_RT_endedWithServerAbort;
+            }
+            else {
+                ret = CO_SDO_RT_ok_communicationEnd;
+            }
+        }
+    }
+
+    if (SDOabortCode != NULL) {
+        *SDOabortCode = abortCode;
+    }
+    return ret;
+}
+
+
+/******************************************************************************/
+CO_SDO_return_t CO_SDOclientLocalUpload(CO_SDOclient_t *SDO_C,
+                                        uint16_t index,
+                                        uint8_t subIndex,
+                                        uint8_t *buf,
+                                        size_t bufSize,
+                                        CO_SDO_abortCode_t *SDOabortCode,
+                                        size_t *sizeTransferred)
+{
+    CO_SDO_return_t ret = CO_SDO_RT_endedWithClientAbort;
+    CO_SDO_abortCode_t abortCode;
+    size_t sizeTran = 0;
+    OD_IO_t OD_IO;
+
+    if (SDO_C == NULL || SDO_C->OD == NULL || buf == NULL) {
+        if (SDOabortCode != NULL) {
+            *SDOabortCode = CO_SDO_AB_DEVICE_INCOMPAT;
+        }
+        return CO_SDO_RT_wrongArguments;
+    }
+
+    abortCode = localOpen(SDO_C->OD, index, subIndex, &OD_IO, true);
+
+    if (abortCode == CO_SDO_AB_NONE) {
+        bool_t lock = OD_mappable(&OD_IO.stream);
+        ODR_t odRet = ODR_OK;
+
+        /* read data into buf, in several calls if read function needs it */
+        if (lock) { CO_LOCK_OD(SDO_C->CANdevTx); }
+        do {
+            OD_size_t countRd = 0;
+
+            if (sizeTran >= bufSize) {
+                abortCode = CO_SDO_AB_OUT_OF_MEM;
+                break;
+            }
+            odRet = OD_IO.read(&OD_IO.stream, buf + sizeTran,
+                               (OD_size_t)(bufSize - sizeTran), &countRd);
+
+            if (odRet != ODR_OK && odRet != ODR_PARTIAL) {
+                abortCode = (CO_SDO_abortCode_t)OD_getSDOabCode(odRet);
+                ret = CO_SDO_RT_endedWithServerAbort;
+                break;
+            }
+            /* if data is string, transfer only data up to null termination */
+            if (countRd > 0 && (OD_IO.stream.attribute & ODA_STR) != 0) {
+                uint8_t *zero = memchr(buf + sizeTran, 0, countRd);
+                if (zero != NULL) {
+                    countRd = (OD_size_t)(zero - (buf + sizeTran));
+                    if (sizeTran == 0 && countRd == 0) {
+                        countRd = 1; /* no zero length */
+                    }
+                    odRet = ODR_OK;
+                    OD_IO.stream.dataLength = (OD_size_t)(sizeTran + countRd);
+                }
+            }
+            /* no progress, data is not available without waiting */
+            if (odRet == ODR_PARTIAL && countRd == 0) {
+                abortCode = CO_SDO_AB_DATA_DEV_STATE;
+                break;
+            }
+            sizeTran += countRd;
+        } while (odRet == ODR_PARTIAL);
+        if (lock) { CO_UNLOCK_OD(SDO_C->CANdevTx); }
+
+        /* verify size of data uploaded */
+        OD_size_t sizeInOd = OD_IO.stream.dataLength;
+        if (abortCode == CO_SDO_AB_NONE
+            && sizeInOd > 0 && sizeTran != sizeInOd
+        ) {
+            abortCode = (sizeTran > sizeInOd) ? CO_SDO_AB_DATA_LONG
+                                              : CO_SDO_AB_DATA_SHORT;
+        }
+        if (abortCode == CO_SDO_AB_NONE) {
+#ifdef CO_BIG_ENDIAN
+            /* swap int16_t .. uint64_t data if necessary */
+            if ((OD_IO.stream.attribute & ODA_MB) != 0) {
+                reverseBytes(buf, (OD_size_t)sizeTran);
+            }
+#endif
+            ret = CO_SDO_RT_ok_communicationEnd;
+        }
+    }
+
+    if (SDOabortCode != NULL) {
+        *SDOabortCode = abortCode;
+    }
+    if (sizeTransferred != NULL) {
+        *sizeTransferred = sizeTran;
+    }
+    return ret;
+}
+#endif /* (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL */
+
+
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BATCH
+/******************************************************************************/
+CO_SDO_return_t CO_SDOclientBatchInit(CO_SDOclientBatch_t *batch,
+                                      CO_SDOclientBatchEntry_t entries[],
+                                      uint16_t entriesCount,
+                                      uint16_t SDOtimeoutTime_ms)
+{
+    if (batch == NULL || (entries == NULL && entriesCount > 0)) {
+        return CO_SDO_RT_wrongArguments;
+    }
+
+    batch->entries = entries;
+    batch->entriesCount = entriesCount;
+    batch->SDOtimeoutTime_ms = SDOtimeoutTime_ms;
+    batch->current = 0;
+    batch->active = false;
+    batch->dataOffset = 0;
+    batch->nodeIdSetup = 0;
+    batch->errors = 0;
+
+    for (uint16_t i = 0; i < entriesCount; i++) {
+        entries[i].sizeTransferred = 0;
+        entries[i].abortCode = CO_SDO_AB_NONE;
+    }
+
+    return CO_SDO_RT_ok_communicationEnd;
+}
+
+
+/* Initiate transfer of the batch entry, set up SDO client if server changes */
+static CO_SDO_return_t CO_SDOclientBatchStart(CO_SDOclient_t *SDO_C,
+                                              CO_SDOclientBatch_t *batch,
+                                              CO_SDOclientBatchEntry_t *entry)
+{
+    CO_SDO_return_t ret = CO_SDO_RT_ok_communicationEnd;
+
+    if (entry->nodeId < 1 || entry->nodeId > 127 || entry->data == NULL) {
+        return CO_SDO_RT_wrongArguments;
+    }
+
+    if (entry->nodeId != batch->nodeIdSetup) {
+        ret = CO_SDOclient_setup(SDO_C,
+                                 CO_CAN_ID_SDO_CLI + entry->nodeId,
+                                 CO_CAN_ID_SDO_SRV + entry->nodeId,
+                                 entry->nodeId);
+        batch->nodeIdSetup = (ret == CO_SDO_RT_ok_communicationEnd)
+                           ? entry->nodeId : 0;
+    }
+
+    if (ret == CO_SDO_RT_ok_communicationEnd) {
+        if (entry->download) {
+            ret = CO_SDOclientDownloadInitiate(SDO_C, entry->index,
+                                               entry->subIndex,
+                                               entry->dataSize,
+                                               batch->SDOtimeoutTime_ms,
+                                               false);
+        }
+        else {
+            ret = CO_SDOclientUploadInitiate(SDO_C, entry->index,
+                                             entry->subIndex,
+                                             batch->SDOtimeoutTime_ms,
+                                             false);
+        }
+    }
+
+    return ret;
+}
+
+
+/******************************************************************************/
+CO_SDO_return_t CO_SDOclientBatch(CO_SDOclient_t *SDO_C,
+                                  CO_SDOclientBatch_t *batch,
+                                  uint32_t timeDifference_us,
+                                  bool_t abort,
+                                  uint32_t *timerNext_us)
+{
+    if (SDO_C == NULL || batch == NULL) {
+        return CO_SDO_RT_wrongArguments;
+    }
+
+    while (batch->current < batch->entriesCount) {
+        CO_SDOclientBatchEntry_t *entry = &batch->entries[batch->current];
+        uint8_t *data = (uint8_t *)entry->data;
+        CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
+        CO_SDO_return_t ret;
+
+        if (abort) {
+            if (batch->active) {
+                abortCode = CO_SDO_AB_GENERAL;
+                if (entry->download) {
+                    CO_SDOclientDownload(SDO_C, 0, true, false, &abortCode,
+                                         NULL, NULL);
+                }
+                else {
+                    CO_SDOclientUpload(SDO_C, 0, true, &abortCode,
+                                       NULL, NULL, NULL);
+                }
+                batch->active = false;
+            }
+            entry->abortCode = CO_SDO_AB_GENERAL;
+            batch->errors++;
+            batch->current++;
+            continue;
+        }
+
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL
+        /* entry for this node is finished with a function call */
+        if (!batch->active && entry->data != NULL
+            && CO_SDOclientIsLocal(SDO_C, entry->nodeId)
+        ) {
+            if (entry->download) {
+                ret = CO_SDOclientLocalDownload(SDO_C, entry->index,
+                                                entry->subIndex, data,
+                                                entry->dataSize, &abortCode);
+                entry->sizeTransferred = (ret == CO_SDO_RT_ok_communicationEnd)
+                                       ? entry->dataSize : 0;
+            }
+            else {
+                ret = CO_SDOclientLocalUpload(SDO_C, entry->index,
+                                              entry->subIndex, data,
+                                              entry->dataSize, &abortCode,
+                                              &entry->sizeTransferred);
+            }
+            entry->abortCode = abortCode;
+            if (ret != CO_SDO_RT_ok_communicationEnd) {
+                batch->errors++;
+            }
+            batch->current++;
+            continue;
+        }
+#endif
+
+        if (!batch->active) {
+            if (CO_SDOclientBatchStart(SDO_C, batch, entry)
+                != CO_SDO_RT_ok_communicationEnd
+            ) {
+                entry->abortCode = CO_SDO_AB_GENERAL;
+                batch->errors++;
+                batch->current++;
+                continue;
+            }
+            batch->active = true;
+            batch->dataOffset = 0;
+            /* time elapsed before belongs to the previous entry */
+            timeDifference_us = 0;
+        }
+
+        if (entry->download) {
+            if (batch->dataOffset < entry->dataSize) {
+                batch->dataOffset += CO_SDOclientDownloadBufWrite(SDO_C,
+                                        data + batch->dataOffset,
+                                        entry->dataSize - batch->dataOffset);
+            }
+            ret = CO_SDOclientDownload(SDO_C, timeDifference_us, false,
+                                       batch->dataOffset < entry->dataSize,
+                                       &abortCode, &entry->sizeTransferred,
+                                       timerNext_us);
+        }
+        else {
+            ret = CO_SDOclientUpload(SDO_C, timeDifference_us, false,
+                                     &abortCode, NULL, NULL, timerNext_us);
+            batch->dataOffset += CO_SDOclientUploadBufRead(SDO_C,
+                                        data + batch->dataOffset,
+                                        entry->dataSize - batch->dataOffset);
+            entry->sizeTransferred = batch->dataOffset;
+            if (CO_fifo_getOccupied(&SDO_C->bufFifo) > 0) {
+                /* destination is full */
+                abortCode = CO_SDO_AB_OUT_OF_MEM;
+                if (ret > 0) {
+                    CO_SDOclientUpload(SDO_C, 0, true, &abortCode,
+                                       NULL, NULL, NULL);
+                }
+                ret = CO_SDO_RT_endedWithClientAbort;
+            }
+        }
+
+        if (ret > 0) {
+            return ret;
+        }
+
+        /* entry finished, continue with the next one without delay */
+        if (ret == CO_SDO_RT_ok_communicationEnd) {
+            entry->abortCode = CO_SDO_AB_NONE;
+        }
+        else {
+            entry->abortCode = (abortCode != CO_SDO_AB_NONE)
+                             ? abortCode : CO_SDO_AB_GENERAL;
+            batch->errors++;
+        }
+        batch->active = false;
+        batch->current++;
+        timeDifference_us = 0;
+    }
+
+    CO_SDOclientClose(SDO_C);
+    return CO_SDO_RT_ok_communicationEnd;
+}
+#endif /* (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BATCH */
+
 #endif /* (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE */
@@ -262,6 +262,12 @@ typedef struct {
     /** Calculated CRC checksum */
     uint16_t block_crc;
 #endif
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS) || defined CO_DOXYGEN
+    /** From CO_SDOclient_initStats() or NULL */
+    CO_SDOstats_t *stats;
+    /** Time from the start of the current transfer in microseconds */
+    uint32_t statsTime_us;
+#endif
 } CO_SDOclient_t;
 
 
@@ -318,6 +324,21 @@ void CO_SDOclient_initCallbackPre(CO_SDOclient_t *SDOclient,
 #endif
 
 
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS) || defined CO_DOXYGEN
+/**
+ * Record transfers of SDO client into statistics object.
+ *
+ * Transfer is recorded, when CO_SDOclientDownload() or CO_SDOclientUpload()
+ * ends it. Several SDO clients may share the same statistics object, if they
+ * are processed from the same thread.
+ *
+ * @param SDOclient This object.
+ * @param stats Statistics object, initialized by CO_SDOstats_init(), or NULL.
+ */
+void CO_SDOclient_initStats(CO_SDOclient_t *SDOclient, CO_SDOstats_t *stats);
+#endif
+
+
 /**
  * Setup SDO client object.
  *
@@ -547,6 +568,190 @@ size_t CO_SDOclientUploadBufRead(CO_SDOclient_t *SDO_C,
  */
 void CO_SDOclientClose(CO_SDOclient_t *SDO_C);
 
+
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL) || defined CO_DOXYGEN
+/**
+ * Check, if SDO server with the node-ID is this node.
+ *
+ * CO_SDOclientDownloadInitiate() and CO_SDOclientUploadInitiate() transfer
+ * data locally, if this is true for the node-ID from CO_SDOclient_setup().
+ * SDO client manager, SDO client batch and gateway do the same.
+ *
+ * @param SDO_C This object.
+ * @param nodeId Node-ID of the SDO server.
+ *
+ * @return true, if data are transferred within this node, without CAN.
+ */
+static inline bool_t CO_SDOclientIsLocal(const CO_SDOclient_t *SDO_C,
+                                         uint8_t nodeId)
+{
+    return SDO_C != NULL && SDO_C->OD != NULL
+           && SDO_C->nodeId != 0 && nodeId == SDO_C->nodeId;
+}
+
+
+/**
+ * Download data into the Object Dictionary of this node.
+ *
+ * Data are written with OD_IO write function of the object, in one call.
+ * There are no CAN messages, no segments and SDO client buffer is not used,
+ * so transfer in progress on SDO_C is not affected. Object access and data
+ * size are verified and abort codes are the same as with SDO server.
+ *
+ * @param SDO_C This object, initialized by CO_SDOclient_init().
+ * @param index Index of object in object dictionary of this node.
+ * @param subIndex Subindex of object in object dictionary of this node.
+ * @param buf Data to write.
+ * @param size Size of data in buf.
+ * @param [out] SDOabortCode SDO abort code, CO_SDO_AB_NONE on success.
+ * Ignored if NULL.
+ *
+ * @return #CO_SDO_return_t: CO_SDO_RT_ok_communicationEnd,
+ * CO_SDO_RT_endedWithClientAbort if object is not accessible or data size does
+ * not match, CO_SDO_RT_endedWithServerAbort if write function returned error
+ * or CO_SDO_RT_wrongArguments.
+ */
+CO_SDO_return_t CO_SDOclientLocalDownload(CO_SDOclient_t *SDO_C,
+                                          uint16_t index,
+                                          uint8_t subIndex,
+                                          const uint8_t *buf,
+                                          size_t size,
+                                          CO_SDO_abortCode_t *SDOabortCode);
+
+
+/**
+ * Upload data from the Object Dictionary of this node.
+ *
+ * Same as CO_SDOclientLocalDownload(), data are read directly into buf. String
+ * is read up to the null termination. If buf is too small, transfer is aborted
+ * with CO_SDO_AB_OUT_OF_MEM. Objects, which read function needs to be called
+ * again later to provide the data, are aborted with CO_SDO_AB_DATA_DEV_STATE.
+ *
+ * @param SDO_C This object, initialized by CO_SDOclient_init().
+ * @param index Index of object in object dictionary of this node.
+ * @param subIndex Subindex of object in object dictionary of this node.
+ * @param buf Buffer for data.
+ * @param bufSize Size of buf.
+ * @param [out] SDOabortCode SDO abort code, CO_SDO_AB_NONE on success.
+ * Ignored if NULL.
+ * @param [out] sizeTransferred Size of data read. Ignored if NULL.
+ *
+ * @return #CO_SDO_return_t, same as CO_SDOclientLocalDownload().
+ */
+CO_SDO_return_t CO_SDOclientLocalUpload(CO_SDOclient_t *SDO_C,
+                                        uint16_t index,
+                                        uint8_t subIndex,
+                                        uint8_t *buf,
+                                        size_t bufSize,
+                                        CO_SDO_abortCode_t *SDOabortCode,
+                                        size_t *sizeTransferred);
+#endif /* (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL */
+
+
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BATCH) || defined CO_DOXYGEN
+/**
+ * One entry of the SDO client batch, see CO_SDOclientBatchInit().
+ *
+ * Members from nodeId to dataSize are set by application, sizeTransferred and
+ * abortCode are results. Numeric values are transferred in CANopen (little
+ * endian) byte order, so data can point directly to a variable of matching
+ * type on little endian target.
+ */
+typedef struct {
+    /** Node-ID of the SDO server, 1..127. Default SDO COB-IDs are used. */
+    uint8_t nodeId;
+    /** true for download (write to the server), false for upload */
+    bool_t download;
+    /** Index of the object in the server's Object Dictionary */
+    uint16_t index;
+    /** Sub-index of the object */
+    uint8_t subIndex;
+    /** Data for download or destination for upload */
+    void *data;
+    /** Size of data for download or size of destination for upload */
+    size_t dataSize;
+    /** Result: number of bytes transferred */
+    size_t sizeTransferred;
+    /** Result: CO_SDO_AB_NONE on success. If upload data does not fit into
+     * destination, transfer is aborted with CO_SDO_AB_OUT_OF_MEM. */
+    CO_SDO_abortCode_t abortCode;
+} CO_SDOclientBatchEntry_t;
+
+
+/**
+ * SDO client batch object, list of SDO transfers executed back-to-back.
+ */
+typedef struct {
+    /** From CO_SDOclientBatchInit() */
+    CO_SDOclientBatchEntry_t *entries;
+    /** From CO_SDOclientBatchInit() */
+    uint16_t entriesCount;
+    /** From CO_SDOclientBatchInit() */
+    uint16_t SDOtimeoutTime_ms;
+    /** Index of the entry in progress, entriesCount if batch is finished */
+    uint16_t current;
+    /** True, if transfer of the current entry is initiated */
+    bool_t active;
+    /** Number of bytes copied from or into current entry data */
+    size_t dataOffset;
+    /** Node-ID, for which SDO client was set up by the batch, or 0 */
+    uint8_t nodeIdSetup;
+    /** Number of entries finished with abort code */
+    uint16_t errors;
+} CO_SDOclientBatch_t;
+
+
+/**
+ * Initialize SDO client batch.
+ *
+ * Batch can be started again with the same function, when previous batch is
+ * finished or aborted.
+ *
+ * @param batch This object will be initialized.
+ * @param entries Array of entries, filled by application. It must stay valid
+ * until the batch is finished.
+ * @param entriesCount Number of entries.
+ * @param SDOtimeoutTime_ms Timeout time for the server response.
+ *
+ * @return #CO_SDO_return_t, CO_SDO_RT_ok_communicationEnd or
+ * CO_SDO_RT_wrongArguments.
+ */
+CO_SDO_return_t CO_SDOclientBatchInit(CO_SDOclientBatch_t *batch,
+                                      CO_SDOclientBatchEntry_t entries[],
+                                      uint16_t entriesCount,
+                                      uint16_t SDOtimeoutTime_ms);
+
+
+/**
+ * Process SDO client batch.
+ *
+ * Function must be called cyclically until it returns <=0. Function is
+ * non-blocking. When response for one entry is received, transfer of the next
+ * entry is initiated and its request is sent within the same call. SDO client
+ * is set up only if Node-ID differs from the previous entry.
+ *
+ * Results are written into each entry. Error in one entry does not stop the
+ * batch.
+ *
+ * @param SDO_C SDO client object, initialized by CO_SDOclient_init(). It must
+ * not be used for other transfers while batch is in progress.
+ * @param batch This object.
+ * @param timeDifference_us Time difference from previous function call.
+ * @param abort If true, transfer in progress is aborted and batch finishes.
+ * Remaining entries get CO_SDO_AB_GENERAL.
+ * @param [out] timerNext_us info to OS, see CO_SDOclientUpload().
+ *
+ * @return #CO_SDO_return_t, CO_SDO_RT_waitingResponse while in progress,
+ * CO_SDO_RT_ok_communicationEnd, when all entries are finished or
+ * CO_SDO_RT_wrongArguments.
+ */
+CO_SDO_return_t CO_SDOclientBatch(CO_SDOclient_t *SDO_C,
+                                  CO_SDOclientBatch_t *batch,
+                                  uint32_t timeDifference_us,
+                                  bool_t abort,
+                                  uint32_t *timerNext_us);
+#endif /* (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BATCH */
+
 /** @} */ /* CO_SDOclient */
 
 #ifdef __cplusplus
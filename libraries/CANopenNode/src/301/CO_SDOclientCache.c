@@ -0,0 +1,303 @@
+/*
+ * CANopen Service Data Object - client cache.
+ *
+ * @file        CO_SDOclientCache.c
+ * @ingroup     CO_SDOclientCache
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "301/CO_SDOclientCache.h"
+
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE) \
+    && ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE)
+
+const CO_SDOclientCachePolicy_t CO_SDOclientCache_defaultPolicy[] = {
+    {0x1000, 0, 0, CO_SDO_CLI_CACHE_TTL_IMMUTABLE},
+    {0x1008, 0, 0, CO_SDO_CLI_CACHE_TTL_IMMUTABLE},
+    {0x1009, 0, 0, CO_SDO_CLI_CACHE_TTL_IMMUTABLE},
+    {0x100A, 0, 0, CO_SDO_CLI_CACHE_TTL_IMMUTABLE},
+    {0x1018, CO_SDO_CLI_CACHE_SUB_ALL, 0, CO_SDO_CLI_CACHE_TTL_IMMUTABLE}
+};
+
+const uint16_t CO_SDOclientCache_defaultPolicyCount =
+    sizeof(CO_SDOclientCache_defaultPolicy)
+    / sizeof(CO_SDOclientCache_defaultPolicy[0]);
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_SDOclientCache_init(CO_SDOclientCache_t *cache,
+                                        CO_SDOclientCacheEntry_t entries[],
+                                        uint16_t entriesCount)
+{
+    if (cache == NULL || entries == NULL || entriesCount == 0) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(cache, 0, sizeof(CO_SDOclientCache_t));
+    cache->entries = entries;
+    cache->entriesCount = entriesCount;
+    CO_SDOclientCache_initPolicy(cache, NULL, 0);
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_SDOclientCache_initPolicy(CO_SDOclientCache_t *cache,
+                                  const CO_SDOclientCachePolicy_t *policy,
+                                  uint16_t policyCount)
+{
+    if (cache == NULL) {
+        return;
+    }
+
+    if (policy == NULL) {
+        cache->policy = CO_SDOclientCache_defaultPolicy;
+        cache->policyCount = CO_SDOclientCache_defaultPolicyCount;
+    }
+    else {
+        cache->policy = policy;
+        cache->policyCount = policyCount;
+    }
+    CO_SDOclientCache_invalidateNode(cache, 0);
+}
+
+
+/******************************************************************************/
+uint32_t CO_SDOclientCache_getTtl(CO_SDOclientCache_t *cache,
+                                  uint8_t nodeId,
+                                  uint16_t index,
+                                  uint8_t subIndex)
+{
+    for (uint16_t i = 0; i < cache->policyCount; i++) {
+        const CO_SDOclientCachePolicy_t *p = &cache->policy[i];
+        if (p->index == index
+            && (p->subIndex == subIndex
+                || p->subIndex == CO_SDO_CLI_CACHE_SUB_ALL)
+            && (p->nodeId == nodeId || p->nodeId == 0)
+        ) {
+            return p->ttl_ms;
+        }
+    }
+    return 0;
+}
+
+
+/*
+ * Find entry with the value of the object, nodeId must not be 0.
+ *
+ * @return Entry or NULL.
+ */
+static CO_SDOclientCacheEntry_t *CO_SDOclientCache_find(
+                                            CO_SDOclientCache_t *cache,
+                                            uint8_t nodeId,
+                                            uint16_t index,
+                                            uint8_t subIndex)
+{
+    for (uint16_t i = 0; i < cache->entriesCount; i++) {
+        CO_SDOclientCacheEntry_t *e = &cache->entries[i];
+        if (e->nodeId == nodeId && e->index == index
+            && e->subIndex == subIndex
+        ) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+
+/* Entry is expired, if time to live passed. */
+static bool_t CO_SDOclientCache_expired(CO_SDOclientCache_t *cache,
+                                        CO_SDOclientCacheEntry_t *e)
+{
+    return e->ttl_ms != CO_SDO_CLI_CACHE_TTL_IMMUTABLE
+        && (uint32_t)(cache->time_ms - e->stored_ms) >= e->ttl_ms;
+}
+
+
+/*
+ * Entry a should be replaced before entry b. Entries with time to live go
+ * before immutable entries, then older before newer.
+ */
+static bool_t CO_SDOclientCache_replaceBefore(CO_SDOclientCache_t *cache,
+                                              CO_SDOclientCacheEntry_t *a,
+                                              CO_SDOclientCacheEntry_t *b)
+{
+    bool_t aImmutable = a->ttl_ms == CO_SDO_CLI_CACHE_TTL_IMMUTABLE;
+    bool_t bImmutable = b->ttl_ms == CO_SDO_CLI_CACHE_TTL_IMMUTABLE;
+
+    if (aImmutable != bImmutable) {
+        return bImmutable;
+    }
+    return (uint32_t)(cache->time_ms - a->stored_ms)
+           > (uint32_t)(cache->time_ms - b->stored_ms);
+}
+
+
+/******************************************************************************/
+bool_t CO_SDOclientCache_read(CO_SDOclientCache_t *cache,
+                              uint8_t nodeId,
+                              uint16_t index,
+                              uint8_t subIndex,
+                              uint8_t *buf,
+                              size_t bufSize,
+                              size_t *dataSize)
+{
+    if (cache == NULL || nodeId == 0 || buf == NULL || dataSize == NULL) {
+        return false;
+    }
+
+    CO_SDOclientCacheEntry_t *e = CO_SDOclientCache_find(cache, nodeId,
+                                                         index, subIndex);
+    if (e != NULL && CO_SDOclientCache_expired(cache, e)) {
+        e->nodeId = 0;
+        e = NULL;
+    }
+
+    if (e == NULL || e->dataSize > bufSize) {
+        if (CO_SDOclientCache_getTtl(cache, nodeId, index, subIndex) != 0) {
+            cache->misses++;
+        }
+        return false;
+    }
+
+    memcpy(buf, e->data, e->dataSize);
+    *dataSize = e->dataSize;
+    cache->hits++;
+    return true;
+}
+
+
+/******************************************************************************/
+void CO_SDOclientCache_store(CO_SDOclientCache_t *cache,
+                             uint8_t nodeId,
+                             uint16_t index,
+                             uint8_t subIndex,
+                             const uint8_t *data,
+                             size_t dataSize)
+{
+    if (cache == NULL || nodeId == 0 || data == NULL
+        || dataSize > CO_CONFIG_SDO_CLI_CACHE_DATA_SIZE
+    ) {
+        return;
+    }
+
+    uint32_t ttl_ms = CO_SDOclientCache_getTtl(cache, nodeId, index, subIndex);
+    if (ttl_ms == 0) {
+        return;
+    }
+
+    CO_SDOclientCacheEntry_t *e = CO_SDOclientCache_find(cache, nodeId,
+                                                         index, subIndex);
+    if (e == NULL) {
+        /* free or expired entry, else the oldest, immutable ones last */
+        CO_SDOclientCacheEntry_t *oldest = NULL;
+        for (uint16_t i = 0; i < cache->entriesCount; i++) {
+            CO_SDOclientCacheEntry_t *c = &cache->entries[i];
+            if (c->nodeId == 0 || CO_SDOclientCache_expired(cache, c)) {
+                e = c;
+                break;
+            }
+            if (oldest == NULL
+                || CO_SDOclientCache_replaceBefore(cache, c, oldest)
+            ) {
+                oldest = c;
+            }
+        }
+        if (e == NULL) {
+            e = oldest;
+        }
+    }
+
+    e->nodeId = nodeId;
+    e->subIndex = subIndex;
+    e->index = index;
+    e->ttl_ms = ttl_ms;
+    e->stored_ms = cache->time_ms;
+    e->dataSize = (uint8_t)dataSize;
+    memcpy(e->data, data, dataSize);
+}
+
+
+/******************************************************************************/
+void CO_SDOclientCache_invalidate(CO_SDOclientCache_t *cache,
+                                  uint8_t nodeId,
+                                  uint16_t index,
+                                  uint8_t subIndex)
+{
+    if (cache == NULL || nodeId == 0) {
+        return;
+    }
+
+    CO_SDOclientCacheEntry_t *e = CO_SDOclientCache_find(cache, nodeId,
+                                                         index, subIndex);
+    if (e != NULL) {
+        e->nodeId = 0;
+    }
+}
+
+
+/******************************************************************************/
+void CO_SDOclientCache_invalidateNode(CO_SDOclientCache_t *cache,
+                                      uint8_t nodeId)
+{
+    if (cache == NULL) {
+        return;
+    }
+
+    for (uint16_t i = 0; i < cache->entriesCount; i++) {
+        if (nodeId == 0 || cache->entries[i].nodeId == nodeId) {
+            cache->entries[i].nodeId = 0;
+        }
+    }
+}
+
+
+/******************************************************************************/
+void CO_SDOclientCache_nodeReset(uint8_t nodeId, uint8_t idx, void *object) {
+    (void)idx;
+    if (nodeId != 0) {
+        CO_SDOclientCache_invalidateNode((CO_SDOclientCache_t *)object, nodeId);
+    }
+}
+
+
+/******************************************************************************/
+void CO_SDOclientCache_process(CO_SDOclientCache_t *cache,
+                               uint32_t timeDifference_us)
+{
+    cache->time_us += timeDifference_us;
+    if (cache->time_us < 1000) {
+        return;
+    }
+    cache->time_ms += cache->time_us / 1000;
+    cache->time_us %= 1000;
+
+    /* free expired entries, so they don't become valid again, when time_ms
+     * overflows */
+    for (uint16_t i = 0; i < cache->entriesCount; i++) {
+        CO_SDOclientCacheEntry_t *e = &cache->entries[i];
+        if (e->nodeId != 0 && CO_SDOclientCache_expired(cache, e)) {
+            e->nodeId = 0;
+        }
+    }
+}
+
+#endif /* CO_CONFIG_SDO_CLI_ENABLE && CO_CONFIG_SDO_CLI_CACHE */
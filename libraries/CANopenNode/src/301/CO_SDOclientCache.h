@@ -0,0 +1,312 @@
+/**
+ * CANopen Service Data Object - client cache.
+ *
+ * @file        CO_SDOclientCache.h
+ * @ingroup     CO_SDOclientCache
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_SDO_CLIENT_CACHE_H
+#define CO_SDO_CLIENT_CACHE_H
+
+#include "301/CO_SDOclient.h"
+
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_SDO_CLI_CACHE_ENTRIES
+#define CO_CONFIG_SDO_CLI_CACHE_ENTRIES 16
+#endif
+#ifndef CO_CONFIG_SDO_CLI_CACHE_DATA_SIZE
+#define CO_CONFIG_SDO_CLI_CACHE_DATA_SIZE 24
+#endif
+
+#if (((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE) \
+     && ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE)) \
+    || defined CO_DOXYGEN
+
+#if CO_CONFIG_SDO_CLI_CACHE_DATA_SIZE > 255
+ #error CO_CONFIG_SDO_CLI_CACHE_DATA_SIZE must not be larger than 255!
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_SDOclientCache SDO client cache
+ * Cached SDO uploads of constant and slow-changing objects.
+ *
+ * @ingroup CO_CANopen_301
+ * @{
+ * Master reads objects like 0x1000 (device type), 0x1008..0x100A (names) or
+ * 0x1018 (identity) from every node again and again, for example for each
+ * diagnostics view. SDO client cache keeps values of such objects, keyed by
+ * node-ID, index and sub-index. @ref CO_SDOclientMgr serves uploads from the
+ * cache without communication on CAN, stores the results of successful
+ * uploads and drops the entry after successful download to the same object.
+ *
+ * Policy table decides, which objects are cached and for how long. Each
+ * policy entry gives time to live in milliseconds or
+ * #CO_SDO_CLI_CACHE_TTL_IMMUTABLE. Objects without matching policy entry are
+ * not cached. Default policy caches constant objects from CiA 301 only.
+ * Policy for the objects of the actual nodes can be generated from their EDS
+ * files with tools/sdo_cache_policy.py: objects with AccessType=const are
+ * immutable, read-only objects, which are not PDO mappable, get a time to
+ * live.
+ *
+ * All entries of a node are invalidated with CO_SDOclientCache_nodeReset(),
+ * which is used as a heartbeat consumer callback for remote reset (boot-up
+ * message) and for heartbeat timeout. So a node, which was replaced or
+ * reconfigured, is read again. If CO_CONFIG_HB_CONS_CALLBACK_RESET is enabled,
+ * CANopen.c sets it with CO_HBconsumer_initCallbackReset(), so the per-node
+ * callbacks stay free for the application.
+ *
+ * If all entries are used, expired or oldest entry is replaced, entries with
+ * time to live before immutable entries.
+ */
+
+
+/** Time to live of the entry, which does not expire. */
+#define CO_SDO_CLI_CACHE_TTL_IMMUTABLE 0xFFFFFFFFUL
+
+/** Value of CO_SDOclientCachePolicy_t::subIndex for all sub-indexes. */
+#define CO_SDO_CLI_CACHE_SUB_ALL 0x100U
+
+
+/**
+ * One entry of the SDO client cache policy.
+ */
+typedef struct {
+    /** Index of the object */
+    uint16_t index;
+    /** Sub-index of the object or #CO_SDO_CLI_CACHE_SUB_ALL */
+    uint16_t subIndex;
+    /** Node-ID of the SDO server or 0 for all nodes */
+    uint8_t nodeId;
+    /** Time to live of the cached value in milliseconds or
+     * #CO_SDO_CLI_CACHE_TTL_IMMUTABLE. */
+    uint32_t ttl_ms;
+} CO_SDOclientCachePolicy_t;
+
+
+/**
+ * One cached value inside CO_SDOclientCache_t.
+ */
+typedef struct {
+    /** Node-ID of the SDO server, 0 if entry is free */
+    uint8_t nodeId;
+    /** Sub-index of the object */
+    uint8_t subIndex;
+    /** Index of the object */
+    uint16_t index;
+    /** Time to live from the policy */
+    uint32_t ttl_ms;
+    /** Value of CO_SDOclientCache_t::time_ms, when value was stored */
+    uint32_t stored_ms;
+    /** Size of the value */
+    uint8_t dataSize;
+    /** Value */
+    uint8_t data[CO_CONFIG_SDO_CLI_CACHE_DATA_SIZE];
+} CO_SDOclientCacheEntry_t;
+
+
+/**
+ * SDO client cache object.
+ */
+typedef struct {
+    /** Array of entries, from CO_SDOclientCache_init() */
+    CO_SDOclientCacheEntry_t *entries;
+    /** Number of entries, from CO_SDOclientCache_init() */
+    uint16_t entriesCount;
+    /** Policy table, from CO_SDOclientCache_initPolicy() */
+    const CO_SDOclientCachePolicy_t *policy;
+    /** Number of policy entries */
+    uint16_t policyCount;
+    /** Time in milliseconds, counted by CO_SDOclientCache_process() */
+    uint32_t time_ms;
+    /** Microseconds not yet added to time_ms */
+    uint32_t time_us;
+    /** Number of values read from the cache, counted by
+     * CO_SDOclientCache_read() */
+    uint32_t hits;
+    /** Number of reads of objects with cache policy, which found no valid
+     * value, counted by CO_SDOclientCache_read() */
+    uint32_t misses;
+} CO_SDOclientCache_t;
+
+
+/**
+ * Default policy, constant objects from CiA 301.
+ *
+ * 0x1000, 0x1008, 0x1009, 0x100A and 0x1018 are immutable.
+ */
+extern const CO_SDOclientCachePolicy_t CO_SDOclientCache_defaultPolicy[];
+
+/** Number of entries in @ref CO_SDOclientCache_defaultPolicy. */
+extern const uint16_t CO_SDOclientCache_defaultPolicyCount;
+
+
+/**
+ * Initialize SDO client cache object.
+ *
+ * All entries are free and default policy is used.
+ *
+ * @param cache This object will be initialized.
+ * @param entries Array of entries, defined externally.
+ * @param entriesCount Number of entries.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_SDOclientCache_init(CO_SDOclientCache_t *cache,
+                                        CO_SDOclientCacheEntry_t entries[],
+                                        uint16_t entriesCount);
+
+
+/**
+ * Set the policy table and invalidate all entries.
+ *
+ * @param cache This object.
+ * @param policy Policy table, must stay valid. If NULL, default policy is
+ * used. First matching entry is used, so specific entries must be before
+ * general ones.
+ * @param policyCount Number of policy entries.
+ */
+void CO_SDOclientCache_initPolicy(CO_SDOclientCache_t *cache,
+                                  const CO_SDOclientCachePolicy_t *policy,
+                                  uint16_t policyCount);
+
+
+/**
+ * Get time to live of the object from the policy.
+ *
+ * @param cache This object.
+ * @param nodeId Node-ID of the SDO server.
+ * @param index Index of the object.
+ * @param subIndex Sub-index of the object.
+ *
+ * @return Time to live in milliseconds, #CO_SDO_CLI_CACHE_TTL_IMMUTABLE or 0,
+ * if object is not cached.
+ */
+uint32_t CO_SDOclientCache_getTtl(CO_SDOclientCache_t *cache,
+                                  uint8_t nodeId,
+                                  uint16_t index,
+                                  uint8_t subIndex);
+
+
+/**
+ * Read value from the cache.
+ *
+ * @param cache This object.
+ * @param nodeId Node-ID of the SDO server.
+ * @param index Index of the object.
+ * @param subIndex Sub-index of the object.
+ * @param buf Buffer for the value.
+ * @param bufSize Size of the buffer.
+ * @param [out] dataSize Size of the value, written on success.
+ *
+ * Each call counts a hit or, if object has cache policy, a miss.
+ *
+ * @return true, if valid value was found and copied into buf. False, if
+ * value is not cached, expired or larger than bufSize.
+ */
+bool_t CO_SDOclientCache_read(CO_SDOclientCache_t *cache,
+                              uint8_t nodeId,
+                              uint16_t index,
+                              uint8_t subIndex,
+                              uint8_t *buf,
+                              size_t bufSize,
+                              size_t *dataSize);
+
+
+/**
+ * Store uploaded value into the cache.
+ *
+ * Value is stored only, if the policy allows it and if it is not larger than
+ * @ref CO_CONFIG_SDO_CLI_CACHE_DATA_SIZE.
+ *
+ * @param cache This object.
+ * @param nodeId Node-ID of the SDO server.
+ * @param index Index of the object.
+ * @param subIndex Sub-index of the object.
+ * @param data Value.
+ * @param dataSize Size of the value.
+ */
+void CO_SDOclientCache_store(CO_SDOclientCache_t *cache,
+                             uint8_t nodeId,
+                             uint16_t index,
+                             uint8_t subIndex,
+                             const uint8_t *data,
+                             size_t dataSize);
+
+
+/**
+ * Invalidate cached value of one object.
+ *
+ * @param cache This object.
+ * @param nodeId Node-ID of the SDO server.
+ * @param index Index of the object.
+ * @param subIndex Sub-index of the object.
+ */
+void CO_SDOclientCache_invalidate(CO_SDOclientCache_t *cache,
+                                  uint8_t nodeId,
+                                  uint16_t index,
+                                  uint8_t subIndex);
+
+
+/**
+ * Invalidate all cached values of the node.
+ *
+ * @param cache This object.
+ * @param nodeId Node-ID of the SDO server or 0 for all nodes.
+ */
+void CO_SDOclientCache_invalidateNode(CO_SDOclientCache_t *cache,
+                                      uint8_t nodeId);
+
+
+/**
+ * Invalidate all cached values of the node, heartbeat consumer callback.
+ *
+ * Signature matches CO_HBconsumer_initCallbackReset().
+ *
+ * @param nodeId Node-ID of the remote node.
+ * @param idx Index of the monitored node, not used.
+ * @param object Pointer to CO_SDOclientCache_t.
+ */
+void CO_SDOclientCache_nodeReset(uint8_t nodeId, uint8_t idx, void *object);
+
+
+/**
+ * Process SDO client cache.
+ *
+ * Function counts time and frees expired entries. It is called from
+ * CO_SDOclientMgr_process().
+ *
+ * @param cache This object.
+ * @param timeDifference_us Time difference from previous function call.
+ */
+void CO_SDOclientCache_process(CO_SDOclientCache_t *cache,
+                               uint32_t timeDifference_us);
+
+/** @} */ /* CO_SDOclientCache */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* CO_CONFIG_SDO_CLI_ENABLE && CO_CONFIG_SDO_CLI_CACHE */
+
+#endif /* CO_SDO_CLIENT_CACHE_H */
@@ -0,0 +1,569 @@
+/*
+ * CANopen Service Data Object - client manager.
+ *
+ * @file        CO_SDOclientMgr.c
+ * @ingroup     CO_SDOclientMgr
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "301/CO_SDOclientMgr.h"
+
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE) \
+    && ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_MANAGER)
+
+/******************************************************************************/
+CO_ReturnError_t CO_SDOclientMgr_init(CO_SDOclientMgr_t *SDOmgr,
+                                      CO_SDOclientMgrChannel_t channels[],
+                                      CO_SDOclient_t SDOclients[],
+                                      uint8_t channelsCount,
+                                      uint16_t SDOtimeoutTime_ms,
+                                      bool_t blockEnable)
+{
+    if (SDOmgr == NULL || channels == NULL || SDOclients == NULL
+        || channelsCount == 0
+    ) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    SDOmgr->channels = channels;
+    SDOmgr->channelsCount = channelsCount;
+    SDOmgr->SDOtimeoutTime_ms = SDOtimeoutTime_ms;
+    SDOmgr->blockEnable = blockEnable;
+    SDOmgr->first = NULL;
+    SDOmgr->last = NULL;
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE
+    SDOmgr->cache = NULL;
+#endif
+
+    for (uint8_t i = 0; i < channelsCount; i++) {
+        channels[i].SDO_C = &SDOclients[i];
+        channels[i].req = NULL;
+        channels[i].dataOffset = 0;
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE
+/******************************************************************************/
+void CO_SDOclientMgr_initCache(CO_SDOclientMgr_t *SDOmgr,
+                               CO_SDOclientCache_t *cache)
+{
+    if (SDOmgr != NULL) {
+        SDOmgr->cache = cache;
+    }
+}
+#endif
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_SDOclientMgr_request(CO_SDOclientMgr_t *SDOmgr,
+                                         CO_SDOclientMgrReq_t *req)
+{
+    if (SDOmgr == NULL || req == NULL
+        || req->nodeId < 1 || req->nodeId > 127
+        || req->data == NULL
+        || req->state != CO_SDOclientMgr_REQ_IDLE
+    ) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    req->sizeTransferred = 0;
+    req->abortCode = CO_SDO_AB_NONE;
+    req->state = CO_SDOclientMgr_REQ_QUEUED;
+    req->next = NULL;
+
+    if (SDOmgr->last == NULL) {
+        SDOmgr->first = req;
+    }
+    else {
+        SDOmgr->last->next = req;
+    }
+    SDOmgr->last = req;
+
+    return CO_ERROR_NO;
+}
+
+
+/*
+ * Remove request from the queue.
+ *
+ * @param prev Request before req in the queue or NULL, if req is first.
+ */
+static void CO_SDOclientMgr_unlink(CO_SDOclientMgr_t *SDOmgr,
+                                   CO_SDOclientMgrReq_t *prev,
+                                   CO_SDOclientMgrReq_t *req)
+{
+    if (prev == NULL) {
+        SDOmgr->first = req->next;
+    }
+    else {
+        prev->next = req->next;
+    }
+    if (SDOmgr->last == req) {
+        SDOmgr->last = prev;
+    }
+    req->next = NULL;
+}
+
+
+/*
+ * Close the transfer and disable reception of the channel. CAN drivers pass a
+ * received message to the first matching receive buffer only, so an idle
+ * channel, still configured for a node, would take responses for the channel
+ * which serves that node next.
+ */
+static void CO_SDOclientMgr_release(CO_SDOclientMgrChannel_t *ch) {
+    CO_SDOclientClose(ch->SDO_C);
+    CO_SDOclient_setup(ch->SDO_C, 0x80000000UL, 0x80000000UL, 0);
+    ch->req = NULL;
+}
+
+
+/******************************************************************************/
+bool_t CO_SDOclientMgr_cancel(CO_SDOclientMgr_t *SDOmgr,
+                              CO_SDOclientMgrReq_t *req)
+{
+    if (SDOmgr == NULL || req == NULL) {
+        return false;
+    }
+
+    if (req->state == CO_SDOclientMgr_REQ_QUEUED) {
+        CO_SDOclientMgrReq_t *prev = NULL;
+        for (CO_SDOclientMgrReq_t *r = SDOmgr->first; r != NULL; r = r->next) {
+            if (r == req) {
+                CO_SDOclientMgr_unlink(SDOmgr, prev, req);
+                break;
+            }
+            prev = r;
+        }
+    }
+    else if (req->state == CO_SDOclientMgr_REQ_ACTIVE) {
+        for (uint8_t i = 0; i < SDOmgr->channelsCount; i++) {
+            CO_SDOclientMgrChannel_t *ch = &SDOmgr->channels[i];
+            if (ch->req == req) {
+                CO_SDO_abortCode_t abortCode = CO_SDO_AB_GENERAL;
+                if (req->upload) {
+                    CO_SDOclientUpload(ch->SDO_C, 0, true, &abortCode,
+                                       NULL, NULL, NULL);
+                }
+                else {
+                    CO_SDOclientDownload(ch->SDO_C, 0, true, false,
+                                         &abortCode, NULL, NULL);
+                }
+                CO_SDOclientMgr_release(ch);
+                break;
+            }
+        }
+    }
+    else {
+        return false;
+    }
+
+    req->abortCode = CO_SDO_AB_GENERAL;
+    req->state = CO_SDOclientMgr_REQ_IDLE;
+    return true;
+}
+
+
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE
+/*
+ * Download to the same object as req is in progress or queued before req.
+ */
+static bool_t CO_SDOclientMgr_downloadPending(CO_SDOclientMgr_t *SDOmgr,
+                                              CO_SDOclientMgrReq_t *req)
+{
+    for (uint8_t i = 0; i < SDOmgr->channelsCount; i++) {
+        CO_SDOclientMgrReq_t *r = SDOmgr->channels[i].req;
+        if (r != NULL && !r->upload && r->nodeId == req->nodeId
+            && r->index == req->index && r->subIndex == req->subIndex
+        ) {
+            return true;
+        }
+    }
+    for (CO_SDOclientMgrReq_t *r = SDOmgr->first; r != req; r = r->next) {
+        if (!r->upload && r->nodeId == req->nodeId
+            && r->index == req->index && r->subIndex == req->subIndex
+        ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/*
+ * Finish queued upload with the value from the cache.
+ *
+ * @param prev Request before req in the queue or NULL, if req is first.
+ *
+ * @return true, if value was in the cache and req was removed from the queue.
+ */
+static bool_t CO_SDOclientMgr_fromCache(CO_SDOclientMgr_t *SDOmgr,
+                                        CO_SDOclientMgrReq_t *prev,
+                                        CO_SDOclientMgrReq_t *req)
+{
+    size_t dataSize;
+
+    if (!req->upload
+        || CO_SDOclientMgr_downloadPending(SDOmgr, req)
+        || !CO_SDOclientCache_read(SDOmgr->cache, req->nodeId, req->index,
+                                   req->subIndex, req->data, req->dataSize,
+                                   &dataSize)
+    ) {
+        return false;
+    }
+
+    CO_SDOclientMgr_unlink(SDOmgr, prev, req);
+    req->sizeTransferred = dataSize;
+    req->abortCode = CO_SDO_AB_NONE;
+    req->state = CO_SDOclientMgr_REQ_IDLE;
+    if (req->pFunctSignal != NULL) {
+        req->pFunctSignal(req->functSignalObject, req);
+    }
+    return true;
+}
+
+
+#endif
+
+
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL
+/*
+ * Finish queued request to this node with direct access to its Object
+ * Dictionary, see CO_SDOclientLocalUpload().
+ *
+ * @param prev Request before req in the queue or NULL, if req is first.
+ *
+ * @return true, if req was for this node and was removed from the queue.
+ */
+static bool_t CO_SDOclientMgr_local(CO_SDOclientMgr_t *SDOmgr,
+                                    CO_SDOclientMgrReq_t *prev,
+                                    CO_SDOclientMgrReq_t *req)
+{
+    CO_SDOclient_t *SDO_C = SDOmgr->channels[0].SDO_C;
+
+    if (!CO_SDOclientIsLocal(SDO_C, req->nodeId)) {
+        return false;
+    }
+
+    CO_SDOclientMgr_unlink(SDOmgr, prev, req);
+    if (req->upload) {
+        CO_SDOclientLocalUpload(SDO_C, req->index, req->subIndex, req->data,
+                                req->dataSize, &req->abortCode,
+                                &req->sizeTransferred);
+    }
+    else {
+        CO_SDOclientLocalDownload(SDO_C, req->index, req->subIndex,
+                                  req->data, req->dataSize, &req->abortCode);
+        req->sizeTransferred = (req->abortCode == CO_SDO_AB_NONE)
+                             ? req->dataSize : 0;
+    }
+    req->state = CO_SDOclientMgr_REQ_IDLE;
+    if (req->pFunctSignal != NULL) {
+        req->pFunctSignal(req->functSignalObject, req);
+    }
+    return true;
+}
+#endif
+
+
+/*
+ * Get request, from which the scan of the queue continues after a request was
+ * finished and its callback was called. Callback may cancel or add requests,
+ * so the scan starts again from the first request, up to the last request from
+ * the start of the scan. Requests added by callbacks are served later.
+ *
+ * @param last Last request from the start of the scan.
+ * @param lastFinished True, if finished request was last.
+ *
+ * @return First request in the queue or NULL, if the scan is complete.
+ */
+static CO_SDOclientMgrReq_t *CO_SDOclientMgr_rescan(CO_SDOclientMgr_t *SDOmgr,
+                                                    CO_SDOclientMgrReq_t *last,
+                                                    bool_t lastFinished)
+{
+    if (lastFinished || last->state != CO_SDOclientMgr_REQ_QUEUED) {
+        return NULL;
+    }
+    return SDOmgr->first;
+}
+
+
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL
+/*
+ * Finish all queued requests to this node, also if no channel is free.
+ */
+static void CO_SDOclientMgr_serveLocal(CO_SDOclientMgr_t *SDOmgr) {
+    CO_SDOclientMgrReq_t *prev = NULL;
+    CO_SDOclientMgrReq_t *req = SDOmgr->first;
+    CO_SDOclientMgrReq_t *last = SDOmgr->last;
+
+    while (req != NULL) {
+        bool_t isLast = req == last;
+
+        if (CO_SDOclientMgr_local(SDOmgr, prev, req)) {
+            prev = NULL;
+            req = CO_SDOclientMgr_rescan(SDOmgr, last, isLast);
+            continue;
+        }
+        prev = req;
+        req = isLast ? NULL : req->next;
+    }
+}
+#endif
+
+
+/*
+ * Start the first queued request, which node has no transfer in progress.
+ *
+ * @return true, if transfer was started on the channel.
+ */
+static bool_t CO_SDOclientMgr_start(CO_SDOclientMgr_t *SDOmgr,
+                                    CO_SDOclientMgrChannel_t *ch)
+{
+    CO_SDOclientMgrReq_t *prev = NULL;
+    CO_SDOclientMgrReq_t *req = SDOmgr->first;
+    /* requests added by callbacks from here are started in the next call */
+    CO_SDOclientMgrReq_t *last = SDOmgr->last;
+
+    while (req != NULL) {
+        bool_t isLast = req == last;
+
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL
+        if (CO_SDOclientMgr_local(SDOmgr, prev, req)) {
+            prev = NULL;
+            req = CO_SDOclientMgr_rescan(SDOmgr, last, isLast);
+            continue;
+        }
+#endif
+
+        bool_t nodeBusy = false;
+        for (uint8_t i = 0; i < SDOmgr->channelsCount; i++) {
+            CO_SDOclientMgrReq_t *r = SDOmgr->channels[i].req;
+            if (r != NULL && r->nodeId == req->nodeId) {
+                nodeBusy = true;
+                break;
+            }
+        }
+        if (nodeBusy) {
+            prev = req;
+            req = isLast ? NULL : req->next;
+            continue;
+        }
+
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE
+        /* cache is looked up once per request, just before it would start */
+        if (SDOmgr->cache != NULL
+            && CO_SDOclientMgr_fromCache(SDOmgr, prev, req)
+        ) {
+            prev = NULL;
+            req = CO_SDOclientMgr_rescan(SDOmgr, last, isLast);
+            continue;
+        }
+#endif
+
+        CO_SDOclientMgr_unlink(SDOmgr, prev, req);
+
+        uint16_t timeout_ms = req->timeout_ms != 0
+                            ? req->timeout_ms : SDOmgr->SDOtimeoutTime_ms;
+        CO_SDO_return_t ret = CO_SDOclient_setup(ch->SDO_C,
+                                            CO_CAN_ID_SDO_CLI + req->nodeId,
+                                            CO_CAN_ID_SDO_SRV + req->nodeId,
+                                            req->nodeId);
+        if (ret == CO_SDO_RT_ok_communicationEnd) {
+            if (req->upload) {
+                ret = CO_SDOclientUploadInitiate(ch->SDO_C, req->index,
+                                                 req->subIndex, timeout_ms,
+                                                 SDOmgr->blockEnable);
+            }
+            else {
+                ret = CO_SDOclientDownloadInitiate(ch->SDO_C, req->index,
+                                                   req->subIndex,
+                                                   req->dataSize, timeout_ms,
+                                                   SDOmgr->blockEnable);
+            }
+        }
+
+        if (ret == CO_SDO_RT_ok_communicationEnd) {
+            req->state = CO_SDOclientMgr_REQ_ACTIVE;
+            ch->req = req;
+            ch->dataOffset = 0;
+            return true;
+        }
+
+        /* request can not be started, finish it */
+        CO_SDOclientMgr_release(ch);
+        req->abortCode = CO_SDO_AB_GENERAL;
+        req->state = CO_SDOclientMgr_REQ_IDLE;
+        if (req->pFunctSignal != NULL) {
+            req->pFunctSignal(req->functSignalObject, req);
+        }
+        prev = NULL;
+        req = CO_SDOclientMgr_rescan(SDOmgr, last, isLast);
+    }
+
+    return false;
+}
+
+
+/*
+ * Process transfer in progress on the channel.
+ *
+ * @return true, if transfer finished.
+ */
+static bool_t CO_SDOclientMgr_transfer(CO_SDOclientMgr_t *SDOmgr,
+                                       CO_SDOclientMgrChannel_t *ch,
+                                       uint32_t timeDifference_us,
+                                       uint32_t *timerNext_us)
+{
+    (void)SDOmgr; /* may be unused */
+    CO_SDOclientMgrReq_t *req = ch->req;
+    CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
+    size_t sizeTransferred = 0;
+    CO_SDO_return_t ret;
+
+    if (req->upload) {
+        ret = CO_SDOclientUpload(ch->SDO_C, timeDifference_us, false,
+                                 &abortCode, NULL, &sizeTransferred,
+                                 timerNext_us);
+
+        /* empty the SDO client buffer into the request buffer, not allowed
+         * during reception of a sub-block */
+        if (ret != CO_SDO_RT_blockUploadInProgress) {
+            ch->dataOffset += CO_SDOclientUploadBufRead(ch->SDO_C,
+                                        req->data + ch->dataOffset,
+                                        req->dataSize - ch->dataOffset);
+        }
+        if (ret != CO_SDO_RT_blockUploadInProgress
+            && CO_fifo_getOccupied(&ch->SDO_C->bufFifo) > 0
+        ) {
+            abortCode = CO_SDO_AB_OUT_OF_MEM;
+            if (ret > 0) {
+                ret = CO_SDOclientUpload(ch->SDO_C, 0, true, &abortCode,
+                                         NULL, NULL, NULL);
+            }
+            else {
+                ret = CO_SDO_RT_endedWithClientAbort;
+            }
+        }
+    }
+    else {
+        /* refill the SDO client buffer from the request data */
+        if (ch->dataOffset < req->dataSize) {
+            ch->dataOffset += CO_SDOclientDownloadBufWrite(ch->SDO_C,
+                                        req->data + ch->dataOffset,
+                                        req->dataSize - ch->dataOffset);
+        }
+        ret = CO_SDOclientDownload(ch->SDO_C, timeDifference_us, false,
+                                   ch->dataOffset < req->dataSize,
+                                   &abortCode, &sizeTransferred,
+                                   timerNext_us);
+    }
+
+    if (ret > 0) {
+        return false;
+    }
+
+    CO_SDOclientMgr_release(ch);
+    req->sizeTransferred = req->upload ? ch->dataOffset : sizeTransferred;
+    req->abortCode = (ret == CO_SDO_RT_ok_communicationEnd)
+                   ? CO_SDO_AB_NONE
+                   : (abortCode != CO_SDO_AB_NONE ? abortCode
+                                                  : CO_SDO_AB_GENERAL);
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE
+    if (SDOmgr->cache != NULL && req->abortCode == CO_SDO_AB_NONE) {
+        if (req->upload) {
+            CO_SDOclientCache_store(SDOmgr->cache, req->nodeId, req->index,
+                                    req->subIndex, req->data,
+                                    req->sizeTransferred);
+        }
+        else {
+            CO_SDOclientCache_invalidate(SDOmgr->cache, req->nodeId,
+                                         req->index, req->subIndex);
+        }
+    }
+#endif
+    req->state = CO_SDOclientMgr_REQ_IDLE;
+    if (req->pFunctSignal != NULL) {
+        req->pFunctSignal(req->functSignalObject, req);
+    }
+    return true;
+}
+
+
+/******************************************************************************/
+void CO_SDOclientMgr_process(CO_SDOclientMgr_t *SDOmgr,
+                             uint32_t timeDifference_us,
+                             uint32_t *timerNext_us)
+{
+    (void)timerNext_us; /* may be unused */
+
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE
+    if (SDOmgr->cache != NULL) {
+        CO_SDOclientCache_process(SDOmgr->cache, timeDifference_us);
+    }
+#endif
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL
+    if (SDOmgr->first != NULL) {
+        CO_SDOclientMgr_serveLocal(SDOmgr);
+    }
+#endif
+
+    for (uint8_t i = 0; i < SDOmgr->channelsCount; i++) {
+        CO_SDOclientMgrChannel_t *ch = &SDOmgr->channels[i];
+        uint32_t dt = timeDifference_us;
+
+        if (ch->req == NULL) {
+            if (SDOmgr->first == NULL
+                || !CO_SDOclientMgr_start(SDOmgr, ch)
+            ) {
+                continue;
+            }
+            dt = 0;
+        }
+
+        if (CO_SDOclientMgr_transfer(SDOmgr, ch, dt, timerNext_us)
+            && SDOmgr->first != NULL
+        ) {
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_FLAG_TIMERNEXT
+            /* start next request without delay */
+            if (timerNext_us != NULL) {
+                *timerNext_us = 0;
+            }
+#endif
+        }
+    }
+}
+
+
+/******************************************************************************/
+bool_t CO_SDOclientMgr_isIdle(CO_SDOclientMgr_t *SDOmgr) {
+    if (SDOmgr->first != NULL) {
+        return false;
+    }
+    for (uint8_t i = 0; i < SDOmgr->channelsCount; i++) {
+        if (SDOmgr->channels[i].req != NULL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif /* CO_CONFIG_SDO_CLI_ENABLE && CO_CONFIG_SDO_CLI_MANAGER */
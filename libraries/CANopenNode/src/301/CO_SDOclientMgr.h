@@ -0,0 +1,281 @@
+/**
+ * CANopen Service Data Object - client manager.
+ *
+ * @file        CO_SDOclientMgr.h
+ * @ingroup     CO_SDOclientMgr
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_SDO_CLIENT_MGR_H
+#define CO_SDO_CLIENT_MGR_H
+
+#include "301/CO_SDOclient.h"
+#include "301/CO_SDOclientCache.h"
+
+#if (((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE) \
+     && ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_MANAGER)) \
+    || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_SDOclientMgr SDO client manager
+ * Asynchronous SDO transfers to many SDO servers.
+ *
+ * @ingroup CO_CANopen_301
+ * @{
+ * SDO client manager runs queued SDO requests over a set of SDO client
+ * objects (channels). Each channel runs one transfer, at most one transfer is
+ * in progress for each SDO server node. So transfers to different nodes run
+ * concurrently and waiting for the response of one node does not delay the
+ * others. CO_SDOclientMgr_process() is non-blocking and is called from
+ * CO_process().
+ *
+ * Request objects are owned by the application and must stay valid, until
+ * the transfer ends. Data of the download must stay valid also. Callback is
+ * called from CO_SDOclientMgr_process(), after the result is written into the
+ * request object.
+ *
+ * Example, configure heartbeat time on nodes 2..5:
+ * @code{.c}
+static CO_SDOclientMgrReq_t req[4];
+static uint8_t hbTime[2] = {0xF4, 0x01}; // 500 ms
+
+static void hbConfigured(void *object, CO_SDOclientMgrReq_t *req) {
+    if (req->abortCode != CO_SDO_AB_NONE) {
+        // node req->nodeId did not accept the value
+    }
+}
+
+for (uint8_t i = 0; i < 4; i++) {
+    req[i].nodeId = 2 + i;
+    req[i].upload = false;
+    req[i].index = 0x1017;
+    req[i].subIndex = 0;
+    req[i].data = hbTime;
+    req[i].dataSize = sizeof(hbTime);
+    req[i].timeout_ms = 0;
+    req[i].pFunctSignal = hbConfigured;
+    req[i].functSignalObject = NULL;
+    CO_SDOclientMgr_request(CO->SDOclientMgr, &req[i]);
+}
+ * @endcode
+ *
+ * If enabled, SDO client manager is initialized in CANopen.c file with all
+ * SDO clients from the Object Dictionary (except the first one, if it is used
+ * by the gateway). Application must not use these SDO client objects
+ * directly.
+ *
+ * If CO_CONFIG_SDO_CLI_CACHE is enabled, uploads are served from
+ * @ref CO_SDOclientCache, if value is there. Cache is read once per request,
+ * when it would start on a free channel. If value is there, request finishes
+ * without CAN communication and the channel stays free. Upload is not served
+ * from the cache, while download to the same object is queued before it or in
+ * progress.
+ *
+ * If CO_CONFIG_SDO_CLI_LOCAL is enabled, requests to the node-ID of this node
+ * are finished in the next CO_SDOclientMgr_process() with
+ * CO_SDOclientLocalUpload() or CO_SDOclientLocalDownload(). They take no
+ * channel and are not served from the cache.
+ */
+
+
+/**
+ * State of the SDO client manager request
+ */
+typedef enum {
+    CO_SDOclientMgr_REQ_IDLE = 0,   /**< Not used or transfer finished */
+    CO_SDOclientMgr_REQ_QUEUED = 1, /**< Waiting for free channel */
+    CO_SDOclientMgr_REQ_ACTIVE = 2  /**< Transfer in progress */
+} CO_SDOclientMgr_reqState_t;
+
+
+/**
+ * SDO client manager request, one SDO upload or download.
+ *
+ * Members from nodeId to functSignalObject are set by application before
+ * CO_SDOclientMgr_request(), other members are set by the manager.
+ */
+typedef struct CO_SDOclientMgrReq {
+    /** Node-ID of the SDO server, 1..127. Default SDO COB-IDs are used. */
+    uint8_t nodeId;
+    /** true for upload (read from the server), false for download */
+    bool_t upload;
+    /** Index of the object in the server's Object Dictionary */
+    uint16_t index;
+    /** Sub-index of the object */
+    uint8_t subIndex;
+    /** Data for download or buffer for uploaded data */
+    uint8_t *data;
+    /** Size of data to download or size of the upload buffer */
+    size_t dataSize;
+    /** Timeout for the server response in milliseconds. If 0, default from
+     * CO_SDOclientMgr_init() is used. */
+    uint16_t timeout_ms;
+    /** Callback after the transfer ends or NULL */
+    void (*pFunctSignal)(void *object, struct CO_SDOclientMgrReq *req);
+    /** Object passed to pFunctSignal */
+    void *functSignalObject;
+    /** Number of bytes transferred, valid after end of transfer */
+    size_t sizeTransferred;
+    /** CO_SDO_AB_NONE on success, valid after end of transfer. If upload
+     * buffer is too small, transfer is aborted with CO_SDO_AB_OUT_OF_MEM. */
+    CO_SDO_abortCode_t abortCode;
+    /** Internal state */
+    CO_SDOclientMgr_reqState_t state;
+    /** Next request in the queue, internal */
+    struct CO_SDOclientMgrReq *next;
+} CO_SDOclientMgrReq_t;
+
+
+/**
+ * One SDO client channel inside CO_SDOclientMgr_t.
+ */
+typedef struct {
+    /** SDO client object, from CO_SDOclientMgr_init() */
+    CO_SDOclient_t *SDO_C;
+    /** Request in progress or NULL */
+    CO_SDOclientMgrReq_t *req;
+    /** Number of bytes copied from or into req->data */
+    size_t dataOffset;
+} CO_SDOclientMgrChannel_t;
+
+
+/**
+ * SDO client manager object.
+ */
+typedef struct {
+    /** Array of channels, from CO_SDOclientMgr_init() */
+    CO_SDOclientMgrChannel_t *channels;
+    /** Number of channels, from CO_SDOclientMgr_init() */
+    uint8_t channelsCount;
+    /** Default response timeout, from CO_SDOclientMgr_init() */
+    uint16_t SDOtimeoutTime_ms;
+    /** Use block transfer, from CO_SDOclientMgr_init() */
+    bool_t blockEnable;
+    /** First request waiting in the queue or NULL */
+    CO_SDOclientMgrReq_t *first;
+    /** Last request waiting in the queue or NULL */
+    CO_SDOclientMgrReq_t *last;
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE) || defined CO_DOXYGEN
+    /** From CO_SDOclientMgr_initCache() or NULL */
+    CO_SDOclientCache_t *cache;
+#endif
+} CO_SDOclientMgr_t;
+
+
+/**
+ * Initialize SDO client manager object.
+ *
+ * @param SDOmgr This object will be initialized.
+ * @param channels Array of channel objects, defined externally.
+ * @param SDOclients Array of SDO client objects, initialized by
+ * CO_SDOclient_init(). One for each channel.
+ * @param channelsCount Number of channels (1..255).
+ * @param SDOtimeoutTime_ms Default timeout for the server response.
+ * @param blockEnable Try to use block transfer, see
+ * CO_SDOclientDownloadInitiate().
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_SDOclientMgr_init(CO_SDOclientMgr_t *SDOmgr,
+                                      CO_SDOclientMgrChannel_t channels[],
+                                      CO_SDOclient_t SDOclients[],
+                                      uint8_t channelsCount,
+                                      uint16_t SDOtimeoutTime_ms,
+                                      bool_t blockEnable);
+
+
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE) || defined CO_DOXYGEN
+/**
+ * Use SDO client cache for uploads.
+ *
+ * @param SDOmgr This object.
+ * @param cache Cache object, initialized by CO_SDOclientCache_init(), or NULL.
+ */
+void CO_SDOclientMgr_initCache(CO_SDOclientMgr_t *SDOmgr,
+                               CO_SDOclientCache_t *cache);
+#endif
+
+
+/**
+ * Add request to the queue.
+ *
+ * Requests are started in queue order, as soon as a channel is free and no
+ * other transfer with the same node is in progress.
+ *
+ * @param SDOmgr This object.
+ * @param req Request, filled by application. It must not be in the queue.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_SDOclientMgr_request(CO_SDOclientMgr_t *SDOmgr,
+                                         CO_SDOclientMgrReq_t *req);
+
+
+/**
+ * Cancel the request.
+ *
+ * Queued request is removed from the queue, transfer in progress is aborted.
+ * Callback is not called.
+ *
+ * @param SDOmgr This object.
+ * @param req Request.
+ *
+ * @return true, if request was queued or in progress.
+ */
+bool_t CO_SDOclientMgr_cancel(CO_SDOclientMgr_t *SDOmgr,
+                              CO_SDOclientMgrReq_t *req);
+
+
+/**
+ * Process SDO client manager.
+ *
+ * Function is called cyclically from CO_process(). It starts queued
+ * requests on free channels, processes transfers in progress and calls
+ * callbacks of finished requests. Function is non-blocking.
+ *
+ * @param SDOmgr This object.
+ * @param timeDifference_us Time difference from previous function call.
+ * @param [out] timerNext_us info to OS - see CO_process().
+ */
+void CO_SDOclientMgr_process(CO_SDOclientMgr_t *SDOmgr,
+                             uint32_t timeDifference_us,
+                             uint32_t *timerNext_us);
+
+
+/**
+ * Check if SDO client manager has no work.
+ *
+ * @param SDOmgr This object.
+ *
+ * @return true, if queue is empty and no transfer is in progress.
+ */
+bool_t CO_SDOclientMgr_isIdle(CO_SDOclientMgr_t *SDOmgr);
+
+/** @} */ /* CO_SDOclientMgr */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* CO_CONFIG_SDO_CLI_ENABLE && CO_CONFIG_SDO_CLI_MANAGER */
+
+#endif /* CO_SDO_CLIENT_MGR_H */
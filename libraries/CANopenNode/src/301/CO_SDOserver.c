@@ -41,8 +41,28 @@
  #if !((CO_CONFIG_CRC16) & CO_CONFIG_CRC16_ENABLE)
   #error CO_CONFIG_CRC16_ENABLE must be enabled.
  #endif
- #if CO_CONFIG_SDO_SRV_BUFFER_SIZE < 900
-  #error CO_CONFIG_SDO_SRV_BUFFER_SIZE must be greater or equal than 900.
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_SHARED
+ #if !((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_SEGMENTED)
+  #error CO_CONFIG_SDO_SRV_SEGMENTED must be enabled.
+ #endif
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STREAM
+ #if !((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_SEGMENTED)
+  #error CO_CONFIG_SDO_SRV_SEGMENTED must be enabled.
+ #endif
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+ #if !((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_SEGMENTED)
+  #error CO_CONFIG_SDO_SRV_SEGMENTED must be enabled.
+ #endif
+ #if CO_CONFIG_SDO_SRV_POOL_SIZE < 1 || CO_CONFIG_SDO_SRV_POOL_SIZE > 32
+  #error CO_CONFIG_SDO_SRV_POOL_SIZE must be 1..32.
+ #endif
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS
+ #if !((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_SEGMENTED)
+  #error CO_CONFIG_SDO_SRV_SEGMENTED must be enabled.
  #endif
 #endif
 
@@ -62,6 +82,9 @@ static void CO_SDO_receive(void *object, void *msg) {
     if (DLC == 8) {
         if (data[0] == 0x80) {
             /* abort from client, just make idle */
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS
+            SDO->statsPeerAbort = true;
+#endif
             SDO->state = CO_SDO_ST_IDLE;
         }
         else if (CO_FLAG_READ(SDO->CANrxNew)) {
@@ -336,6 +359,21 @@ CO_ReturnError_t CO_SDOserver_init(CO_SDOserver_t *SDO,
 #endif
 #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK
     SDO->block_SDOtimeoutTime_us = (uint32_t)SDOtimeoutTime_ms * 700;
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_SHARED
+    SDO->bufAcquired = false;
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STREAM
+    SDO->streamData = NULL;
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+    SDO->pool = NULL;
+    SDO->buf = NULL;
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS
+    SDO->stats = NULL;
+    SDO->statsBusy = false;
+    SDO->statsPeerAbort = false;
 #endif
     SDO->state = CO_SDO_ST_IDLE;
 
@@ -448,6 +486,140 @@ void CO_SDOserver_initCallbackPre(CO_SDOserver_t *SDO,
 #endif
 
 
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS
+/******************************************************************************/
+void CO_SDOserver_initStats(CO_SDOserver_t *SDO, CO_SDOstats_t *stats) {
+    if (SDO != NULL) {
+        SDO->stats = stats;
+        SDO->statsBusy = false;
+    }
+}
+
+
+/* Record finished transfer into statistics. Abort from the client may also
+ * come between processing calls. */
+static void statsEnd(CO_SDOserver_t *SDO,
+                     CO_SDO_return_t ret,
+                     CO_SDO_abortCode_t abortCode)
+{
+    if (SDO->statsPeerAbort) {
+        CO_SDOstats_peerAbort(SDO->stats);
+    }
+    else if (ret == CO_SDO_RT_endedWithServerAbort) {
+        CO_SDOstats_abort(SDO->stats, (uint32_t)abortCode);
+    }
+    else {
+        CO_SDOstats_transfer(SDO->stats, SDO->sizeTran, SDO->statsTime_us);
+    }
+    SDO->statsBusy = false;
+}
+#endif
+
+
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+/******************************************************************************/
+CO_ReturnError_t CO_SDOserverPool_init(CO_SDOserverPool_t *pool,
+                                       uint8_t *buffers,
+                                       uint8_t count)
+{
+    if (pool == NULL || buffers == NULL || count == 0 || count > 32) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    pool->buffers = buffers;
+    pool->count = count;
+    pool->users = 0;
+    pool->used = 0;
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_SDOserver_initPool(CO_SDOserver_t *SDO, CO_SDOserverPool_t *pool) {
+    if (SDO != NULL && pool != NULL) {
+        SDO->pool = pool;
+        SDO->buf = NULL;
+        pool->users++;
+    }
+}
+
+
+/*
+ * Take free buffer from the pool into SDO->buf, if SDO server has none yet.
+ *
+ * If pool has more than one buffer, but less buffers than users, transfer,
+ * which takes several messages (longTransfer), does not get the last free
+ * buffer.
+ *
+ * @return true, if SDO->buf is available.
+ */
+static bool_t poolTake(CO_SDOserver_t *SDO, bool_t longTransfer) {
+    CO_SDOserverPool_t *pool = SDO->pool;
+    uint8_t freeCount = 0;
+    uint8_t freeIdx = 0;
+
+    if (SDO->buf != NULL) {
+        return true;
+    }
+    if (pool == NULL) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < pool->count; i++) {
+        if ((pool->used & (1UL << i)) == 0) {
+            if (freeCount == 0) {
+                freeIdx = i;
+            }
+            freeCount++;
+        }
+    }
+    if (freeCount == 0
+        || (longTransfer && freeCount == 1
+            && pool->count > 1 && pool->count < pool->users)
+    ) {
+        return false;
+    }
+
+    pool->used |= 1UL << freeIdx;
+    SDO->buf = pool->buffers
+             + (size_t)freeIdx * (CO_CONFIG_SDO_SRV_BUFFER_SIZE + 1);
+    return true;
+}
+
+
+/* Return SDO->buf to the pool. */
+static void poolGive(CO_SDOserver_t *SDO) {
+    size_t i = (size_t)(SDO->buf - SDO->pool->buffers)
+               / (CO_CONFIG_SDO_SRV_BUFFER_SIZE + 1);
+
+    SDO->pool->used &= ~(1UL << i);
+    SDO->buf = NULL;
+}
+#endif /* (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL */
+
+
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_SHARED
+/******************************************************************************/
+uint8_t *CO_SDOserver_bufferAcquire(CO_SDOserver_t *SDO, OD_size_t *size) {
+    if (SDO == NULL || size == NULL || SDO->bufAcquired
+        || SDO->state != CO_SDO_ST_IDLE
+    ) {
+        return NULL;
+    }
+ #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+    if (!poolTake(SDO, false)) {
+        return NULL;
+    }
+ #endif
+
+    SDO->bufAcquired = true;
+    *size = CO_CONFIG_SDO_SRV_BUFFER_SIZE;
+    return SDO->buf;
+}
+#endif
+
+
 #ifdef CO_BIG_ENDIAN
 static inline void reverseBytes(void *start, OD_size_t size) {
     uint8_t *lo = (uint8_t *)start;
@@ -601,6 +773,13 @@ static bool_t readFromOd(CO_SDOserver_t *SDO,
 {
     OD_size_t countRemain = SDO->bufOffsetWr - SDO->bufOffsetRd;
 
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STREAM
+    if (SDO->streamData != NULL) {
+        /* data are copied directly from OD variable in uploadCopy() */
+        return true;
+    }
+#endif
+
     if (!SDO->finished && countRemain < countMinimum) {
         /* first move remaining data to the start of the buffer */
         memmove(SDO->buf, SDO->buf + SDO->bufOffsetRd, countRemain);
@@ -678,7 +857,104 @@ static bool_t readFromOd(CO_SDOserver_t *SDO,
     }
     return true;
 }
+
+
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STREAM
+/* Get original data of the OD variable, if its upload can be streamed directly
+ * into CAN messages. This is possible, if variable is in memory and has no
+ * custom read function. Short variables are transferred expedited, strings are
+ * shortened to null termination and multibyte variables on big endian
+ * machines need swapping, so they go through the buffer.
+ *
+ * Returns pointer to data or NULL. */
+static const uint8_t *uploadStreamData(CO_SDOserver_t *SDO) {
+    OD_stream_t *stream = &SDO->OD_IO.stream;
+
+    if (SDO->OD_IO.read != OD_readOriginal || stream->dataOrig == NULL
+        || stream->dataLength <= 4 || (stream->attribute & ODA_STR) != 0
+ #ifdef CO_BIG_ENDIAN
+        || (stream->attribute & ODA_MB) != 0
+ #endif
+    ) {
+        return NULL;
+    }
+    return (const uint8_t *)stream->dataOrig;
+}
+#endif
+
+
+/* Number of upload data bytes, which are ready to be sent. */
+static OD_size_t uploadCount(CO_SDOserver_t *SDO) {
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STREAM
+    if (SDO->streamData != NULL) {
+        return SDO->sizeInd - SDO->sizeTran;
+    }
 #endif
+    return SDO->bufOffsetWr - SDO->bufOffsetRd;
+}
+
+
+/* Copy count bytes of upload data into CAN message. If data are streamed from
+ * OD variable, crc is updated in the same pass, if calculateCrc is true. Bytes,
+ * which are re-transmitted, are already included in crc. */
+static void uploadCopy(CO_SDOserver_t *SDO,
+                       uint8_t *dest,
+                       OD_size_t count,
+                       bool_t calculateCrc)
+{
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STREAM
+    if (SDO->streamData != NULL) {
+        bool_t lock = OD_mappable(&SDO->OD_IO.stream);
+
+        if (lock) { CO_LOCK_OD(SDO->CANdevTx); }
+        memcpy(dest, SDO->streamData + SDO->sizeTran, count);
+        if (lock) { CO_UNLOCK_OD(SDO->CANdevTx); }
+
+ #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK
+        OD_size_t crcEnd = SDO->sizeTran + count;
+        if (calculateCrc && SDO->block_crcEnabled
+            && crcEnd > SDO->streamCrcSize
+        ) {
+            OD_size_t skip = SDO->streamCrcSize - SDO->sizeTran;
+            SDO->block_crc = crc16_ccitt(dest + skip, count - skip,
+                                         SDO->block_crc);
+            SDO->streamCrcSize = crcEnd;
+        }
+ #endif
+    }
+    else
+#endif
+    {
+        memcpy(dest, SDO->buf + SDO->bufOffsetRd, count);
+    }
+    (void)calculateCrc; /* may be unused */
+
+    SDO->bufOffsetRd += count;
+    SDO->sizeTran += count;
+}
+
+
+#if (CO_CONFIG_SDO_SRV) & (CO_CONFIG_SDO_SRV_BUFFER_SHARED \
+                          | CO_CONFIG_SDO_SRV_BUFFER_POOL)
+/* New request needs the buffer, except expedited download and streamed
+ * upload. */
+static bool_t needsBuffer(CO_SDOserver_t *SDO, bool_t upload) {
+    if (SDO->state == CO_SDO_ST_DOWNLOAD_INITIATE_REQ
+        && (SDO->CANrxData[0] & 0x02) != 0
+    ) {
+        return false;
+    }
+ #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STREAM
+    if (upload && uploadStreamData(SDO) != NULL) {
+        return false;
+    }
+ #else
+    (void)upload;
+ #endif
+    return true;
+}
+#endif
+#endif /* (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_SEGMENTED */
 
 
 /******************************************************************************/
@@ -697,6 +973,16 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
     CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
     bool_t isNew = CO_FLAG_READ(SDO->CANrxNew);
 
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS
+    if (SDO->statsBusy) {
+        SDO->statsTime_us += timeDifference_us;
+        /* Transfer was aborted by the client or block upload was ended by
+         * CAN receive function */
+        if (SDO->state == CO_SDO_ST_IDLE) {
+            statsEnd(SDO, CO_SDO_RT_ok_communicationEnd, CO_SDO_AB_NONE);
+        }
+    }
+#endif
 
     if (SDO->valid && SDO->state == CO_SDO_ST_IDLE && !isNew) {
         /* Idle and nothing new */
@@ -708,9 +994,24 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
         SDO->state = CO_SDO_ST_IDLE;
         CO_FLAG_CLEAR(SDO->CANrxNew);
         ret = CO_SDO_RT_ok_communicationEnd;
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS
+        SDO->statsBusy = false;
+#endif
     }
     /* CAN data received ******************************************************/
     else if (isNew) {
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS
+        if (SDO->state == CO_SDO_ST_IDLE) {
+            SDO->statsBusy = SDO->stats != NULL;
+            SDO->statsTime_us = 0;
+            SDO->statsPeerAbort = false;
+        }
+        else {
+            /* client response to the last message of this server */
+            CO_SDOstats_turnaround(SDO->stats,
+                                   SDO->timeoutTimer + timeDifference_us);
+        }
+#endif
         if (SDO->state == CO_SDO_ST_IDLE) { /* new SDO communication? */
             bool_t upload = false;
 
@@ -768,6 +1069,30 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                 }
             }
 
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_SHARED
+            /* buffer is used by application, only expedited download, which
+             * does not need the buffer, is possible */
+            if (SDO->bufAcquired && abortCode == CO_SDO_AB_NONE
+                && needsBuffer(SDO, upload)
+            ) {
+                abortCode = CO_SDO_AB_OUT_OF_MEM;
+                SDO->state = CO_SDO_ST_ABORT;
+            }
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+            /* take buffer from the pool. Only upload of up to 4 bytes is
+             * short, other transfers take several messages. */
+            if (abortCode == CO_SDO_AB_NONE && needsBuffer(SDO, upload)) {
+                OD_size_t len = SDO->OD_IO.stream.dataLength;
+                bool_t longTransfer = SDO->state!=CO_SDO_ST_UPLOAD_INITIATE_REQ
+                                      || len == 0 || len > 4;
+                if (!poolTake(SDO, longTransfer)) {
+                    abortCode = CO_SDO_AB_OUT_OF_MEM;
+                    SDO->state = CO_SDO_ST_ABORT;
+                }
+            }
+#endif
+
 #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_SEGMENTED
             /* load data from object dictionary, if upload and no error */
             if (upload && abortCode == CO_SDO_AB_NONE) {
@@ -775,6 +1100,18 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                 SDO->sizeTran = 0;
                 SDO->finished = false;
 
+ #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STREAM
+                /* stream data directly from OD variable, if possible */
+                SDO->streamData = uploadStreamData(SDO);
+  #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK
+                SDO->streamCrcSize = 0;
+  #endif
+                if (SDO->streamData != NULL) {
+                    SDO->sizeInd = SDO->OD_IO.stream.dataLength;
+                    SDO->finished = true;
+                }
+                else
+ #endif
                 if (readFromOd(SDO, &abortCode, 7, false)) {
                     /* Size of variable in OD (may not be known yet) */
                     if (SDO->finished) {
@@ -866,6 +1203,7 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                     SDO->state = CO_SDO_ST_DOWNLOAD_INITIATE_RSP;
 #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_SEGMENTED
                     SDO->finished = true;
+                    SDO->sizeTran = dataSizeToWrite;
 #endif
                 }
             }
@@ -1072,9 +1410,14 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                     SDO->block_crcEnabled = false;
                 }
 
-                /* get blksize and verify it */
+                /* get blksize and verify it. If OD variable is larger than
+                 * buffer, sub-block must fit into the buffer for possible
+                 * re-transmission. */
                 SDO->block_blksize = SDO->CANrxData[4];
-                if (SDO->block_blksize < 1 || SDO->block_blksize > 127) {
+                if (SDO->block_blksize < 1 || SDO->block_blksize > 127
+                    || (!SDO->finished && SDO->block_blksize * 7U
+                                          > CO_CONFIG_SDO_SRV_BUFFER_SIZE)
+                ) {
                     abortCode = CO_SDO_AB_BLOCK_SIZE;
                     SDO->state = CO_SDO_ST_ABORT;
                     break;
@@ -1107,7 +1450,10 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
         case CO_SDO_ST_UPLOAD_BLK_SUBBLOCK_CRSP: {
             if (SDO->CANrxData[0] == 0xA2) {
                 SDO->block_blksize = SDO->CANrxData[2];
-                if (SDO->block_blksize < 1 || SDO->block_blksize > 127) {
+                if (SDO->block_blksize < 1 || SDO->block_blksize > 127
+                    || (!SDO->finished && SDO->block_blksize * 7U
+                                          > CO_CONFIG_SDO_SRV_BUFFER_SIZE)
+                ) {
                     abortCode = CO_SDO_AB_BLOCK_SIZE;
                     SDO->state = CO_SDO_ST_ABORT;
                     break;
@@ -1121,6 +1467,9 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                     cntFailed = cntFailed * 7 - SDO->block_noData;
                     SDO->bufOffsetRd -= cntFailed;
                     SDO->sizeTran -= cntFailed;
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS
+                    CO_SDOstats_retry(SDO->stats);
+#endif
                 }
                 else if (SDO->CANrxData[1] > SDO->block_seqno) {
                     /* something strange from server, break transmission */
@@ -1134,7 +1483,7 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                     break;
 
 
-                if (SDO->bufOffsetWr == SDO->bufOffsetRd) {
+                if (uploadCount(SDO) == 0) {
                     SDO->state = CO_SDO_ST_UPLOAD_BLK_END_SREQ;
                 }
                 else {
@@ -1275,7 +1624,8 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
             if (SDO->sizeInd > 0 && SDO->sizeInd <= 4) {
                 /* expedited transfer */
                 SDO->CANtxBuff->data[0] = (uint8_t)(0x43|((4-SDO->sizeInd)<<2));
-                memcpy(&SDO->CANtxBuff->data[4], &SDO->buf, SDO->sizeInd);
+                memcpy(&SDO->CANtxBuff->data[4], SDO->buf, SDO->sizeInd);
+                SDO->sizeTran = SDO->sizeInd;
                 SDO->state = CO_SDO_ST_IDLE;
                 ret = CO_SDO_RT_ok_communicationEnd;
             }
@@ -1349,7 +1699,7 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
             SDO->CANtxBuff->data[0] = SDO->toggle;
             SDO->toggle = (SDO->toggle == 0x00) ? 0x10 : 0x00;
 
-            OD_size_t count = SDO->bufOffsetWr - SDO->bufOffsetRd;
+            OD_size_t count = uploadCount(SDO);
             /* verify, if this is the last segment */
             if (count < 7 || (SDO->finished && count == 7)) {
                 /* indicate last segment and nnn */
@@ -1364,10 +1714,7 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
             }
 
             /* copy data segment to CAN message */
-            memcpy(&SDO->CANtxBuff->data[1], SDO->buf + SDO->bufOffsetRd,
-                   count);
-            SDO->bufOffsetRd += count;
-            SDO->sizeTran += count;
+            uploadCopy(SDO, &SDO->CANtxBuff->data[1], count, false);
 
             /* verify if sizeTran is too large or too short if last segment */
             if (SDO->sizeInd > 0) {
@@ -1428,8 +1775,11 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
         case CO_SDO_ST_DOWNLOAD_BLK_SUBBLOCK_RSP: {
             SDO->CANtxBuff->data[0] = 0xA2;
             SDO->CANtxBuff->data[1] = SDO->block_seqno;
-#ifdef CO_DEBUG_SDO_SERVER
+#if defined CO_DEBUG_SDO_SERVER \
+    || ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS)
             bool_t transferShort = SDO->block_seqno != SDO->block_blksize;
+#endif
+#ifdef CO_DEBUG_SDO_SERVER
             uint8_t seqnoStart = SDO->block_seqno;
 #endif
 
@@ -1468,6 +1818,11 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
             /* reset block_timeoutTimer, but not SDO->timeoutTimer */
             SDO->block_timeoutTimer = 0;
             CO_CANsend(SDO->CANdevTx, SDO->CANtxBuff);
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS
+            if (transferShort && !SDO->finished) {
+                CO_SDOstats_retry(SDO->stats);
+            }
+#endif
 #ifdef CO_DEBUG_SDO_SERVER
             if (transferShort && !SDO->finished) {
                 char msg[80];
@@ -1512,7 +1867,7 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
         case CO_SDO_ST_UPLOAD_BLK_SUBBLOCK_SREQ: {
             /* write header and get current count */
             SDO->CANtxBuff->data[0] = ++SDO->block_seqno;
-            OD_size_t count = SDO->bufOffsetWr - SDO->bufOffsetRd;
+            OD_size_t count = uploadCount(SDO);
             /* verify, if this is the last segment */
             if (count < 7 || (SDO->finished && count == 7)) {
                 SDO->CANtxBuff->data[0] |= 0x80;
@@ -1522,11 +1877,8 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
             }
 
             /* copy data segment to CAN message */
-            memcpy(&SDO->CANtxBuff->data[1], SDO->buf + SDO->bufOffsetRd,
-                   count);
-            SDO->bufOffsetRd += count;
+            uploadCopy(SDO, &SDO->CANtxBuff->data[1], count, true);
             SDO->block_noData = (uint8_t)(7 - count);
-            SDO->sizeTran += count;
 
             /* verify if sizeTran is too large or too short if last segment */
             if (SDO->sizeInd > 0) {
@@ -1535,7 +1887,7 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                     SDO->state = CO_SDO_ST_ABORT;
                     break;
                 }
-                else if (SDO->bufOffsetWr == SDO->bufOffsetRd
+                else if (uploadCount(SDO) == 0
                          && SDO->sizeTran < SDO->sizeInd
                 ) {
                     abortCode = CO_SDO_AB_DATA_SHORT;
@@ -1545,7 +1897,7 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
             }
 
             /* is last segment or all segments in current block transferred? */
-            if (SDO->bufOffsetWr == SDO->bufOffsetRd
+            if (uploadCount(SDO) == 0
                 || SDO->block_seqno >= SDO->block_blksize
             ) {
                 SDO->state = CO_SDO_ST_UPLOAD_BLK_SUBBLOCK_CRSP;
@@ -1607,5 +1959,21 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
 #endif
     }
 
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+    /* return buffer to the pool, when transfer is finished */
+    if (SDO->state == CO_SDO_ST_IDLE && SDO->buf != NULL
+ #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_SHARED
+        && !SDO->bufAcquired
+ #endif
+    ) {
+        poolGive(SDO);
+    }
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS
+    if (SDO->statsBusy && SDO->state == CO_SDO_ST_IDLE) {
+        statsEnd(SDO, ret, abortCode);
+    }
+#endif
+
     return ret;
 }
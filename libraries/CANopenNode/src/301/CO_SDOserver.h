@@ -28,6 +28,7 @@
 
 #include "301/CO_driver.h"
 #include "301/CO_ODinterface.h"
+#include "301/CO_SDOstats.h"
 
 /* default configuration, see CO_config.h */
 #ifndef CO_CONFIG_SDO_SRV
@@ -39,6 +40,9 @@
 #ifndef CO_CONFIG_SDO_SRV_BUFFER_SIZE
 #define CO_CONFIG_SDO_SRV_BUFFER_SIZE 32
 #endif
+#ifndef CO_CONFIG_SDO_SRV_POOL_SIZE
+#define CO_CONFIG_SDO_SRV_POOL_SIZE 2
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -436,6 +440,34 @@ typedef enum {
 } CO_SDO_return_t;
 
 
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL) || defined CO_DOXYGEN
+/**
+ * Pool of SDO server buffers, shared by several SDO servers.
+ *
+ * SDO server takes a buffer from the pool at the start of a transfer, which
+ * needs it, and returns it, when SDO server becomes idle again. Expedited
+ * download and streamed upload do not need the buffer. If pool has less
+ * buffers than SDO servers, transfer, which takes several messages, does not
+ * get the last free buffer. It stays reserved for expedited uploads. If no
+ * buffer is available, transfer is aborted with CO_SDO_AB_OUT_OF_MEM.
+ *
+ * All SDO servers of the pool must be processed from the same thread.
+ */
+typedef struct {
+    /** From CO_SDOserverPool_init(), count * (#CO_CONFIG_SDO_SRV_BUFFER_SIZE
+     * + 1) bytes */
+    uint8_t *buffers;
+    /** From CO_SDOserverPool_init(), 1..32 */
+    uint8_t count;
+    /** Number of SDO servers, which use the pool, see
+     * CO_SDOserver_initPool() */
+    uint8_t users;
+    /** Bit n is set, if buffer n is in use */
+    uint32_t used;
+} CO_SDOserverPool_t;
+#endif
+
+
 /**
  * SDO server object.
  */
@@ -495,13 +527,37 @@ typedef struct {
     uint32_t SDOtimeoutTime_us;
     /** Timeout timer for SDO communication */
     uint32_t timeoutTimer;
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL) || defined CO_DOXYGEN
+    /** From CO_SDOserver_initPool() */
+    CO_SDOserverPool_t *pool;
+    /** Interim data buffer for segmented or block transfer + byte for '\0',
+     * taken from the pool during transfer, NULL otherwise */
+    uint8_t *buf;
+#else
     /** Interim data buffer for segmented or block transfer + byte for '\0' */
     uint8_t buf[CO_CONFIG_SDO_SRV_BUFFER_SIZE + 1];
+#endif
     /** Offset of next free data byte available for write in the buffer. */
     OD_size_t bufOffsetWr;
     /** Offset of first data available for read in the buffer */
     OD_size_t bufOffsetRd;
 #endif
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STREAM) || defined CO_DOXYGEN
+    /** If not NULL, upload is streamed directly from this memory (original
+     * data of the OD variable) and buf is not used. Data offset is sizeTran,
+     * data size is sizeInd. */
+    const uint8_t *streamData;
+ #if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK) || defined CO_DOXYGEN
+    /** Number of streamed bytes, already included in block_crc. It differs
+     * from sizeTran after re-transmission of a sub-block. */
+    OD_size_t streamCrcSize;
+ #endif
+#endif
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_SHARED) || defined CO_DOXYGEN
+    /** True, if buffer is in use by application, see
+     * CO_SDOserver_bufferAcquire() */
+    bool_t bufAcquired;
+#endif
 #if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK) || defined CO_DOXYGEN
     /** Timeout time for SDO sub-block download, half of #SDOtimeoutTime_us */
     uint32_t block_SDOtimeoutTime_us;
@@ -518,6 +574,16 @@ typedef struct {
     /** Calculated CRC checksum */
     uint16_t block_crc;
 #endif
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS) || defined CO_DOXYGEN
+    /** From CO_SDOserver_initStats() or NULL */
+    CO_SDOstats_t *stats;
+    /** Time from the start of the current transfer in microseconds */
+    uint32_t statsTime_us;
+    /** True, if transfer, which will be recorded, is in progress */
+    bool_t statsBusy;
+    /** Set by CAN receive function, if client aborted the transfer */
+    volatile bool_t statsPeerAbort;
+#endif
 #if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_FLAG_CALLBACK_PRE) || defined CO_DOXYGEN
     /** From CO_SDOserver_initCallbackPre() or NULL */
     void (*pFunctSignalPre)(void *object);
@@ -561,6 +627,53 @@ CO_ReturnError_t CO_SDOserver_init(CO_SDOserver_t *SDO,
                                    uint32_t *errInfo);
 
 
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL) || defined CO_DOXYGEN
+/**
+ * Initialize pool of SDO server buffers.
+ *
+ * Function must be called in the communication reset section, before
+ * CO_SDOserver_initPool(). All buffers become free.
+ *
+ * @param pool This object will be initialized.
+ * @param buffers Array of count * (#CO_CONFIG_SDO_SRV_BUFFER_SIZE + 1) bytes,
+ * defined externally.
+ * @param count Number of buffers, 1..32.
+ *
+ * @return @ref CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_SDOserverPool_init(CO_SDOserverPool_t *pool,
+                                       uint8_t *buffers,
+                                       uint8_t count);
+
+
+/**
+ * Use buffers from the pool in SDO server.
+ *
+ * Function must be called after CO_SDOserver_init(). Without the pool SDO
+ * server aborts all transfers, which need the buffer.
+ *
+ * @param SDO This object.
+ * @param pool Pool, initialized by CO_SDOserverPool_init().
+ */
+void CO_SDOserver_initPool(CO_SDOserver_t *SDO, CO_SDOserverPool_t *pool);
+#endif
+
+
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS) || defined CO_DOXYGEN
+/**
+ * Record transfers of SDO server into statistics object.
+ *
+ * Function must be called after CO_SDOserver_init(). Several SDO servers may
+ * share the same statistics object, if they are processed from the same
+ * thread.
+ *
+ * @param SDO This object.
+ * @param stats Statistics object, initialized by CO_SDOstats_init(), or NULL.
+ */
+void CO_SDOserver_initStats(CO_SDOserver_t *SDO, CO_SDOstats_t *stats);
+#endif
+
+
 #if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_FLAG_CALLBACK_PRE) || defined CO_DOXYGEN
 /**
  * Initialize SDOrx callback function.
@@ -581,6 +694,42 @@ void CO_SDOserver_initCallbackPre(CO_SDOserver_t *SDO,
 #endif
 
 
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_SHARED) || defined CO_DOXYGEN
+/**
+ * Acquire SDO server buffer for other use.
+ *
+ * Large SDO server buffer (see #CO_CONFIG_SDO_SRV_BUFFER_SIZE) is used only
+ * during segmented or block transfer. While SDO server is idle, application
+ * may use it as a temporary work buffer, for example for writing data to
+ * flash, instead of reserving own RAM. While buffer is acquired, SDO server
+ * aborts all transfers except expedited download with CO_SDO_AB_OUT_OF_MEM.
+ * With #CO_CONFIG_SDO_SRV_BUFFER_POOL buffer is taken from the pool and
+ * returned to it by the next CO_SDOserver_process() after the release.
+ *
+ * Function must be called from the same thread as CO_SDOserver_process().
+ *
+ * @param SDO This object.
+ * @param [out] size Size of the buffer in bytes.
+ *
+ * @return Pointer to the buffer or NULL, if SDO transfer is in progress,
+ * buffer is already acquired or pool has no free buffer.
+ */
+uint8_t *CO_SDOserver_bufferAcquire(CO_SDOserver_t *SDO, OD_size_t *size);
+
+
+/**
+ * Release SDO server buffer, acquired by CO_SDOserver_bufferAcquire().
+ *
+ * @param SDO This object.
+ */
+static inline void CO_SDOserver_bufferRelease(CO_SDOserver_t *SDO) {
+    if (SDO != NULL) {
+        SDO->bufAcquired = false;
+    }
+}
+#endif
+
+
 /**
  * Process SDO communication.
  *
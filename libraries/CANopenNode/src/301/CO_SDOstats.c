@@ -0,0 +1,275 @@
+/*
+ * CANopen Service Data Object - transfer statistics.
+ *
+ * @file        CO_SDOstats.c
+ * @ingroup     CO_SDOstats
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "301/CO_SDOstats.h"
+
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS) \
+    || ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS)
+
+/*
+ * Custom functions for read/write OD object with statistics.
+ *
+ * For more information see file CO_ODinterface.h, OD_IO_t.
+ */
+static ODR_t OD_read_SDOstats(OD_stream_t *stream, void *buf,
+                              OD_size_t count, OD_size_t *countRead)
+{
+    if (stream == NULL || buf == NULL || countRead == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    CO_SDOstats_t *stats = (CO_SDOstats_t *)stream->object;
+
+    if (stream->subIndex == CO_SDO_STATS_SUB_COUNT) {
+        if (count < sizeof(uint8_t)) {
+            return ODR_DEV_INCOMPAT;
+        }
+        CO_setUint8(buf, CO_SDO_STATS_SUB_LAST);
+        *countRead = sizeof(uint8_t);
+        return ODR_OK;
+    }
+    if (stream->subIndex > CO_SDO_STATS_SUB_LAST) {
+        return ODR_SUB_NOT_EXIST;
+    }
+    if (count < sizeof(uint32_t)) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    CO_setUint32(buf, CO_SDOstats_get(stats, stream->subIndex));
+    *countRead = sizeof(uint32_t);
+    return ODR_OK;
+}
+
+static ODR_t OD_write_SDOstats(OD_stream_t *stream, const void *buf,
+                               OD_size_t count, OD_size_t *countWritten)
+{
+    if (stream == NULL || buf == NULL || countWritten == NULL
+        || count != sizeof(uint32_t)
+    ) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    /* only reset by writing 0 to the number of transfers */
+    if (stream->subIndex != CO_SDO_STATS_SUB_TRANSFERS) {
+        return ODR_READONLY;
+    }
+    if (CO_getUint32(buf) != 0) {
+        return ODR_INVALID_VALUE;
+    }
+
+    CO_SDOstats_reset((CO_SDOstats_t *)stream->object);
+
+    *countWritten = sizeof(uint32_t);
+    return ODR_OK;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_SDOstats_init(CO_SDOstats_t *stats, OD_entry_t *OD_stats) {
+    if (stats == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    CO_SDOstats_reset(stats);
+
+    if (OD_stats != NULL) {
+        stats->OD_statsExtension.object = stats;
+        stats->OD_statsExtension.read = OD_read_SDOstats;
+        stats->OD_statsExtension.write = OD_write_SDOstats;
+        OD_extension_init(OD_stats, &stats->OD_statsExtension);
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_SDOstats_reset(CO_SDOstats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+
+    stats->transfers = 0;
+    stats->bytes = 0;
+    memset(stats->aborts, 0, sizeof(stats->aborts));
+    stats->peerAborts = 0;
+    stats->retries = 0;
+    stats->maxDuration_ms = 0;
+    stats->maxTurnaround_us = 0;
+    memset(stats->duration, 0, sizeof(stats->duration));
+    memset(stats->throughput, 0, sizeof(stats->throughput));
+    memset(stats->turnaround, 0, sizeof(stats->turnaround));
+}
+
+
+/******************************************************************************/
+uint32_t CO_SDOstats_get(const CO_SDOstats_t *stats, uint8_t subIndex) {
+    if (stats == NULL) {
+        return 0;
+    }
+
+    if (subIndex >= CO_SDO_STATS_SUB_TURNAROUND
+        && subIndex <= CO_SDO_STATS_SUB_LAST
+    ) {
+        return stats->turnaround[subIndex - CO_SDO_STATS_SUB_TURNAROUND];
+    }
+    if (subIndex >= CO_SDO_STATS_SUB_THROUGHPUT) {
+        return stats->throughput[subIndex - CO_SDO_STATS_SUB_THROUGHPUT];
+    }
+    if (subIndex >= CO_SDO_STATS_SUB_DURATION) {
+        return stats->duration[subIndex - CO_SDO_STATS_SUB_DURATION];
+    }
+    if (subIndex >= CO_SDO_STATS_SUB_ABORTS
+        && subIndex < CO_SDO_STATS_SUB_PEER_ABORTS
+    ) {
+        return stats->aborts[subIndex - CO_SDO_STATS_SUB_ABORTS];
+    }
+
+    switch (subIndex) {
+        case CO_SDO_STATS_SUB_TRANSFERS: return stats->transfers;
+        case CO_SDO_STATS_SUB_BYTES: return stats->bytes;
+        case CO_SDO_STATS_SUB_PEER_ABORTS: return stats->peerAborts;
+        case CO_SDO_STATS_SUB_RETRIES: return stats->retries;
+        case CO_SDO_STATS_SUB_MAX_DURATION: return stats->maxDuration_ms;
+        case CO_SDO_STATS_SUB_MAX_TURNAROUND: return stats->maxTurnaround_us;
+        default: return 0;
+    }
+}
+
+
+/*
+ * Histogram bucket of the value. First bucket is below firstLimit, limits of
+ * the next buckets grow by factor 4, last bucket has no limit.
+ */
+static uint8_t bucket(uint32_t value, uint32_t firstLimit) {
+    uint8_t i;
+    uint32_t limit = firstLimit;
+
+    for (i = 0; i < (CO_SDO_STATS_BUCKETS - 1); i++) {
+        if (value < limit) {
+            break;
+        }
+        limit <<= 2;
+    }
+    return i;
+}
+
+
+/*
+ * Throughput in bytes per second, calculated without 64-bit division.
+ * Returns 0xFFFFFFFF, if it does not fit into 32 bits.
+ */
+static uint32_t bytesPerSecond(uint32_t size, uint32_t duration_us) {
+    uint32_t duration_ms = duration_us / 1000;
+
+    if (size <= (0xFFFFFFFFUL / 1000000U)) {
+        return size * 1000000U / duration_us;
+    }
+    if (duration_ms == 0) {
+        return 0xFFFFFFFFUL;
+    }
+    if (size <= (0xFFFFFFFFUL / 1000U)) {
+        return size * 1000U / duration_ms;
+    }
+    if ((size / duration_ms) > (0xFFFFFFFFUL / 1000U)) {
+        return 0xFFFFFFFFUL;
+    }
+    return size / duration_ms * 1000U;
+}
+
+
+/******************************************************************************/
+void CO_SDOstats_transfer(CO_SDOstats_t *stats,
+                          uint32_t size,
+                          uint32_t duration_us)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+    uint32_t duration_ms = duration_us / 1000;
+
+    stats->transfers++;
+    stats->bytes += size;
+    if (duration_ms > stats->maxDuration_ms) {
+        stats->maxDuration_ms = duration_ms;
+    }
+    stats->duration[bucket(duration_ms, 1)]++;
+
+    /* expedited transfers say nothing about throughput */
+    if (size > 4 && duration_us > 0) {
+        stats->throughput[bucket(bytesPerSecond(size, duration_us), 64)]++;
+    }
+}
+
+
+/******************************************************************************/
+void CO_SDOstats_abort(CO_SDOstats_t *stats, uint32_t abortCode) {
+    if (stats == NULL) {
+        return;
+    }
+
+    CO_SDOstats_abortClass_t abortClass;
+
+    switch (abortCode >> 16) {
+        case 0x0503U:
+            abortClass = CO_SDO_STATS_AB_PROTOCOL;
+            break;
+        case 0x0504U:
+            abortClass = abortCode == 0x05040000UL ? CO_SDO_STATS_AB_TIMEOUT
+                                                   : CO_SDO_STATS_AB_PROTOCOL;
+            break;
+        case 0x0601U:
+            abortClass = CO_SDO_STATS_AB_ACCESS;
+            break;
+        case 0x0602U:
+        case 0x0604U:
+        case 0x0609U:
+            abortClass = CO_SDO_STATS_AB_OBJECT;
+            break;
+        case 0x0607U:
+            abortClass = CO_SDO_STATS_AB_LENGTH;
+            break;
+        default:
+            abortClass = CO_SDO_STATS_AB_DEVICE;
+            break;
+    }
+    stats->aborts[abortClass]++;
+}
+
+
+/******************************************************************************/
+void CO_SDOstats_turnaround(CO_SDOstats_t *stats, uint32_t turnaround_us) {
+    if (stats == NULL) {
+        return;
+    }
+
+    if (turnaround_us > stats->maxTurnaround_us) {
+        stats->maxTurnaround_us = turnaround_us;
+    }
+    stats->turnaround[bucket(turnaround_us, 250)]++;
+}
+
+#endif /* CO_CONFIG_SDO_SRV_STATS || CO_CONFIG_SDO_CLI_STATS */
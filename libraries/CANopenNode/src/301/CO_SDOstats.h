@@ -0,0 +1,262 @@
+/**
+ * CANopen Service Data Object - transfer statistics.
+ *
+ * @file        CO_SDOstats.h
+ * @ingroup     CO_SDOstats
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_SDO_STATS_H
+#define CO_SDO_STATS_H
+
+#include "301/CO_driver.h"
+#include "301/CO_ODinterface.h"
+
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_SDO_SRV
+#define CO_CONFIG_SDO_SRV (CO_CONFIG_SDO_SRV_SEGMENTED | \
+                           CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE | \
+                           CO_CONFIG_GLOBAL_FLAG_TIMERNEXT | \
+                           CO_CONFIG_GLOBAL_FLAG_OD_DYNAMIC)
+#endif
+#ifndef CO_CONFIG_SDO_CLI
+#define CO_CONFIG_SDO_CLI (0)
+#endif
+
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS) \
+    || ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS) \
+    || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_SDOstats SDO statistics
+ * Counters and histograms of SDO transfers.
+ *
+ * @ingroup CO_CANopen_301
+ * @{
+ * SDO server and SDO client record each finished transfer into the
+ * statistics object: number of transfers and bytes, aborts by class,
+ * retransmitted block transfer sub-blocks and histograms of transfer
+ * duration, throughput and turnaround time. Turnaround time is the time from
+ * the last message sent to the response of the other side. It shows, how
+ * much of SDOserverTimeoutTime_ms or SDOclientTimeoutTime_ms is really used.
+ * Retries and throughput show, if block size is appropriate for the bus.
+ *
+ * Times are accumulated from timeDifference_us arguments of the process
+ * functions, so their resolution is the period of the process calls.
+ *
+ * Statistics are readable from OD object of type ARRAY of UNSIGNED32
+ * (#CO_SDO_SRV_STATS_OD_INDEX for SDO servers and #CO_SDO_CLI_STATS_OD_INDEX
+ * for SDO clients) with sub-indexes from @ref CO_SDOstats_sub_t. Writing 0 to sub-index 1 resets
+ * the statistics. Gateway command "sdo_stats" prints the same values.
+ * CO_CANopenInit() initializes statistics objects, so they are cleared on
+ * communication reset.
+ */
+
+
+/** Number of buckets in each histogram. */
+#define CO_SDO_STATS_BUCKETS 8
+
+/** Index of manufacturer specific ARRAY object with SDO server statistics.
+ * If object does not exist in Object Dictionary, statistics are still
+ * recorded, but not readable by SDO. */
+#ifndef CO_SDO_SRV_STATS_OD_INDEX
+#define CO_SDO_SRV_STATS_OD_INDEX 0x2210
+#endif
+
+/** Index of manufacturer specific ARRAY object with SDO client statistics. */
+#ifndef CO_SDO_CLI_STATS_OD_INDEX
+#define CO_SDO_CLI_STATS_OD_INDEX 0x2211
+#endif
+
+
+/**
+ * Abort classes, index of CO_SDOstats_t::aborts.
+ */
+typedef enum {
+    CO_SDO_STATS_AB_TIMEOUT = 0, /**< 0x05040000, SDO protocol timed out */
+    CO_SDO_STATS_AB_PROTOCOL = 1, /**< other 0x0503xxxx and 0x0504xxxx */
+    CO_SDO_STATS_AB_ACCESS = 2, /**< 0x0601xxxx, unsupported access */
+    CO_SDO_STATS_AB_OBJECT = 3, /**< 0x0602xxxx, 0x0604xxxx, 0x0609xxxx,
+                                     object, sub-index or mapping */
+    CO_SDO_STATS_AB_LENGTH = 4, /**< 0x0607xxxx, length or data type */
+    CO_SDO_STATS_AB_DEVICE = 5, /**< 0x0606xxxx, 0x08xxxxxx and others */
+    CO_SDO_STATS_AB_COUNT = 6 /**< number of abort classes */
+} CO_SDOstats_abortClass_t;
+
+
+/**
+ * Sub-indexes of the statistics OD object, all UNSIGNED32.
+ *
+ * Histogram bucket n (0 to 7) is at sub-index of the histogram + n. Bucket
+ * limits grow by factor 4, last bucket counts all larger values:
+ * - duration: < 1 ms, < 4 ms, < 16 ms, ... < 16384 ms, larger,
+ * - throughput: < 64 B/s, < 256 B/s, ... < 1048576 B/s, larger. Only
+ *   transfers with more than 4 bytes and non-zero duration are counted.
+ * - turnaround: < 250 us, < 1 ms, < 4 ms, ... < 4096 ms, larger.
+ */
+typedef enum {
+    CO_SDO_STATS_SUB_COUNT = 0, /**< highest sub-index, 36 */
+    CO_SDO_STATS_SUB_TRANSFERS = 1, /**< successful transfers */
+    CO_SDO_STATS_SUB_BYTES = 2, /**< bytes of successful transfers */
+    CO_SDO_STATS_SUB_ABORTS = 3, /**< 6 aborts sent by this side, by
+                                      @ref CO_SDOstats_abortClass_t */
+    CO_SDO_STATS_SUB_PEER_ABORTS = 9, /**< aborts received from other side */
+    CO_SDO_STATS_SUB_RETRIES = 10, /**< repeated block transfer sub-blocks */
+    CO_SDO_STATS_SUB_MAX_DURATION = 11, /**< longest transfer in ms */
+    CO_SDO_STATS_SUB_MAX_TURNAROUND = 12, /**< longest turnaround in us */
+    CO_SDO_STATS_SUB_DURATION = 13, /**< duration histogram */
+    CO_SDO_STATS_SUB_THROUGHPUT = 21, /**< throughput histogram */
+    CO_SDO_STATS_SUB_TURNAROUND = 29, /**< turnaround histogram */
+    CO_SDO_STATS_SUB_LAST = 36 /**< last sub-index */
+} CO_SDOstats_sub_t;
+
+
+/**
+ * SDO statistics object.
+ *
+ * Counters wrap around. Order of the members matches @ref CO_SDOstats_sub_t.
+ */
+typedef struct {
+    /** Successful transfers */
+    uint32_t transfers;
+    /** Bytes of successful transfers */
+    uint32_t bytes;
+    /** Aborts sent by this side, by @ref CO_SDOstats_abortClass_t */
+    uint32_t aborts[CO_SDO_STATS_AB_COUNT];
+    /** Aborts received from the other side */
+    uint32_t peerAborts;
+    /** Block transfer sub-blocks, which were not received completely and
+     * were repeated from the first missing segment */
+    uint32_t retries;
+    /** Longest successful transfer in milliseconds */
+    uint32_t maxDuration_ms;
+    /** Longest turnaround time in microseconds */
+    uint32_t maxTurnaround_us;
+    /** Histogram of transfer duration */
+    uint32_t duration[CO_SDO_STATS_BUCKETS];
+    /** Histogram of transfer throughput */
+    uint32_t throughput[CO_SDO_STATS_BUCKETS];
+    /** Histogram of turnaround time */
+    uint32_t turnaround[CO_SDO_STATS_BUCKETS];
+    /** Extension for OD object */
+    OD_extension_t OD_statsExtension;
+} CO_SDOstats_t;
+
+
+/**
+ * Initialize SDO statistics object.
+ *
+ * All counters are cleared.
+ *
+ * @param stats This object will be initialized.
+ * @param OD_stats OD entry of type ARRAY with 36 UNSIGNED32 sub-indexes,
+ * through which statistics are read. May be NULL.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_SDOstats_init(CO_SDOstats_t *stats, OD_entry_t *OD_stats);
+
+
+/**
+ * Clear all counters.
+ *
+ * @param stats This object.
+ */
+void CO_SDOstats_reset(CO_SDOstats_t *stats);
+
+
+/**
+ * Get value by sub-index.
+ *
+ * @param stats This object.
+ * @param subIndex Sub-index from @ref CO_SDOstats_sub_t, 1 to 36.
+ *
+ * @return Value or 0 for invalid sub-index.
+ */
+uint32_t CO_SDOstats_get(const CO_SDOstats_t *stats, uint8_t subIndex);
+
+
+/**
+ * Record successful transfer.
+ *
+ * @param stats This object. If NULL, function does nothing, same for other
+ * recording functions.
+ * @param size Number of transferred bytes.
+ * @param duration_us Time from the initiate request to the end in
+ * microseconds.
+ */
+void CO_SDOstats_transfer(CO_SDOstats_t *stats,
+                          uint32_t size,
+                          uint32_t duration_us);
+
+
+/**
+ * Record abort, sent by this side.
+ *
+ * @param stats This object.
+ * @param abortCode SDO abort code, CO_SDO_abortCode_t.
+ */
+void CO_SDOstats_abort(CO_SDOstats_t *stats, uint32_t abortCode);
+
+
+/**
+ * Record abort, received from the other side.
+ *
+ * @param stats This object.
+ */
+static inline void CO_SDOstats_peerAbort(CO_SDOstats_t *stats) {
+    if (stats != NULL) {
+        stats->peerAborts++;
+    }
+}
+
+
+/**
+ * Record repeated block transfer sub-block.
+ *
+ * @param stats This object.
+ */
+static inline void CO_SDOstats_retry(CO_SDOstats_t *stats) {
+    if (stats != NULL) {
+        stats->retries++;
+    }
+}
+
+
+/**
+ * Record turnaround time.
+ *
+ * @param stats This object.
+ * @param turnaround_us Time from the last sent message to the response in
+ * microseconds.
+ */
+void CO_SDOstats_turnaround(CO_SDOstats_t *stats, uint32_t turnaround_us);
+
+/** @} */ /* CO_SDOstats */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* CO_CONFIG_SDO_SRV_STATS || CO_CONFIG_SDO_CLI_STATS */
+
+#endif /* CO_SDO_STATS_H */
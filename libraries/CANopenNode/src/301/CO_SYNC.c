@@ -27,6 +27,117 @@
 
 #if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_ENABLE
 
+/* verify configuration */
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_PRODUCER_HW
+ #if !((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_PRODUCER)
+  #error CO_CONFIG_SYNC_PRODUCER_HW requires CO_CONFIG_SYNC_PRODUCER!
+ #endif
+ #if CO_SYNC_JITTER_WINDOW < 2 || CO_SYNC_JITTER_WINDOW > 1024
+  #error CO_SYNC_JITTER_WINDOW is not correct!
+ #endif
+/* Jitter is clamped to this many ticks inside sums, so that the sum of squares
+ * of CO_SYNC_JITTER_WINDOW samples, multiplied by 256, does not overflow. */
+#define CO_SYNC_JITTER_CLAMP 0x01FFFFFF
+#endif
+
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_CLOCK
+/*
+ * Update recovered SYNC clock with reception time of SYNC message.
+ *
+ * Called from CO_SYNC_receive(), see @ref CO_SYNC for the description.
+ *
+ * @param SYNC This object.
+ * @param rx_us Reception time of SYNC message.
+ */
+static void CO_SYNC_clockUpdate(CO_SYNC_t *SYNC, uint32_t rx_us) {
+    uint32_t rx_q8 = rx_us << 8;
+    CO_SYNC_clockParam_t clk = SYNC->clkParam[SYNC->clkSeq & 1];
+    bool_t reset = SYNC->clkReset;
+
+    if (reset) {
+        clk.state = 0;
+    }
+    /* errors in 1/256 us must fit into int32_t */
+    if (clk.state != 0 && (rx_us - clk.rx_us) > 0x007FFFFFU) {
+        clk.state = 1;
+    }
+
+    if (clk.state == 2) {
+        int32_t period = clk.period_q8;
+        int32_t error = (int32_t)(rx_q8 - clk.next_q8);
+
+        /* skip missing SYNC messages by whole periods */
+        if (error > period / 2) {
+            uint32_t n = ((uint32_t)error + (uint32_t)(period / 2))
+                       / (uint32_t)period;
+            clk.next_q8 += n * (uint32_t)period;
+            error -= (int32_t)(n * (uint32_t)period);
+            clk.missed += (uint16_t)n;
+        }
+
+        if (error > period / 4 || error < -(period / 4)) {
+            /* Outlier does not correct the loop. Late SYNC is the predicted
+             * one, early SYNC is not. Repeated outliers restart the loop. */
+            clk.good = 0;
+            if (++SYNC->clkBad >= 3) {
+                clk.state = 1;
+            }
+            else if (error > 0) {
+                clk.next_q8 += (uint32_t)period;
+            }
+        }
+        else {
+            const int32_t lock_q8 = (int32_t)CO_SYNC_CLOCK_LOCK_US << 8;
+
+            SYNC->clkBad = 0;
+            clk.error_q8 = error;
+            clk.period_q8 = period + error / CO_SYNC_CLOCK_KI;
+            clk.next_q8 += (uint32_t)(error / CO_SYNC_CLOCK_KP)
+                              + (uint32_t)clk.period_q8;
+            if (error > lock_q8 || error < -lock_q8) {
+                clk.good = 0;
+            }
+            else if (clk.good < 0xFF) {
+                clk.good++;
+            }
+        }
+    }
+    else {
+        /* initial period from OD 0x1006 or from two successive SYNCs */
+        uint32_t period_us = 0;
+
+        if (clk.state == 1) {
+            period_us = rx_us - clk.rx_us;
+        }
+        else if (SYNC->OD_1006_period != NULL) {
+            period_us = *SYNC->OD_1006_period;
+        }
+
+        if (period_us > 0 && period_us <= 0x007FFFFFU) {
+            clk.period_q8 = (int32_t)(period_us << 8);
+            clk.next_q8 = rx_q8 + (period_us << 8);
+            clk.error_q8 = 0;
+            clk.good = 0;
+            SYNC->clkBad = 0;
+            clk.state = 2;
+        }
+        else {
+            clk.state = 1;
+        }
+    }
+    clk.rx_us = rx_us;
+
+    /* publish into the copy not in use, readers do not wait */
+    SYNC->clkParam[(SYNC->clkSeq + 1) & 1] = clk;
+    CO_MemoryBarrier();
+    SYNC->clkSeq++;
+    if (reset) {
+        SYNC->clkReset = false;
+    }
+}
+#endif /* (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_CLOCK */
+
+
 /*
  * Read received message from CAN module.
  *
@@ -59,6 +170,13 @@ static void CO_SYNC_receive(void *object, void *msg) {
     }
 
     if (syncReceived) {
+        if (SYNC->pFunctLocal_us != NULL) {
+            SYNC->event_us = SYNC->pFunctLocal_us();
+        }
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_CLOCK
+        CO_SYNC_clockUpdate(SYNC, CO_CANrxMsg_readTimestamp(msg));
+#endif
+
         /* toggle PDO receive buffer */
         SYNC->CANrxToggle = SYNC->CANrxToggle ? false : true;
 
@@ -201,6 +319,50 @@ static ODR_t OD_write_1019(OD_stream_t *stream, const void *buf,
 #endif /* (CO_CONFIG_SYNC) & CO_CONFIG_FLAG_OD_DYNAMIC */
 
 
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_PRODUCER_HW
+/*
+ * Custom function for reading OD object with SYNC jitter statistics
+ *
+ * For more information see file CO_ODinterface.h, OD_IO_t.
+ */
+static ODR_t OD_read_SYNCjitter(OD_stream_t *stream, void *buf,
+                                OD_size_t count, OD_size_t *countRead)
+{
+    if (stream == NULL || buf == NULL || countRead == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    CO_SYNC_jitter_t jitter;
+    int32_t value;
+
+    CO_SYNC_getJitter(stream->object, &jitter);
+
+    switch (stream->subIndex) {
+        case 0:
+            if (count < sizeof(uint8_t)) {
+                return ODR_DEV_INCOMPAT;
+            }
+            CO_setUint8(buf, 6);
+            *countRead = sizeof(uint8_t);
+            return ODR_OK;
+        case 1: value = (int32_t)jitter.samples; break;
+        case 2: value = jitter.min_ns; break;
+        case 3: value = jitter.max_ns; break;
+        case 4: value = jitter.mean_ns; break;
+        case 5: value = jitter.stddev_ns; break;
+        case 6: value = (int32_t)(jitter.missed & 0x7FFFFFFF); break;
+        default: return ODR_SUB_NOT_EXIST;
+    }
+    if (count < sizeof(int32_t)) {
+        return ODR_DEV_INCOMPAT;
+    }
+    CO_setUint32(buf, (uint32_t)value);
+    *countRead = sizeof(int32_t);
+    return ODR_OK;
+}
+#endif /* (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_PRODUCER_HW */
+
+
 /******************************************************************************/
 CO_ReturnError_t CO_SYNC_init(CO_SYNC_t *SYNC,
                               CO_EM_t *em,
@@ -352,6 +514,289 @@ void CO_SYNC_initCallbackPre(
 #endif
 
 
+/******************************************************************************/
+void CO_SYNC_initTimestamp(CO_SYNC_t *SYNC, uint32_t (*pFunctLocal_us)(void)) {
+    if (SYNC != NULL) {
+        SYNC->pFunctLocal_us = pFunctLocal_us;
+    }
+}
+
+
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_PRODUCER_HW
+/******************************************************************************/
+CO_ReturnError_t CO_SYNC_initHwProducer(CO_SYNC_t *SYNC,
+                                        void *object,
+                                        bool_t (*pFunctHwSend)(void *object,
+                                                    const CO_CANtx_t *buffer),
+                                        void (*pFunctHwPeriod)(void *object,
+                                                    uint32_t period_us),
+                                        uint32_t timestampFreq_Hz,
+                                        OD_entry_t *OD_jitter)
+{
+    if (SYNC == NULL || pFunctHwSend == NULL || pFunctHwPeriod == NULL
+        || timestampFreq_Hz == 0
+    ) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    SYNC->hwRunning = false;
+    SYNC->hwObject = object;
+    SYNC->pFunctHwSend = pFunctHwSend;
+    SYNC->pFunctHwPeriod = pFunctHwPeriod;
+    SYNC->hwTimestampFreq_Hz = timestampFreq_Hz;
+    SYNC->hwPeriod_us = 0;
+    SYNC->hwPeriodTicks = 0;
+    SYNC->hwHaveLast = false;
+    SYNC->hwMissed = 0;
+    SYNC->hwCount = 0;
+    SYNC->hwWindowReady = false;
+    memset(&SYNC->jitter, 0, sizeof(SYNC->jitter));
+
+    if (OD_jitter != NULL) {
+        SYNC->OD_jitter_extension.object = SYNC;
+        SYNC->OD_jitter_extension.read = OD_read_SYNCjitter;
+        SYNC->OD_jitter_extension.write = NULL;
+        OD_extension_init(OD_jitter, &SYNC->OD_jitter_extension);
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_SYNC_hwTimerIsr(CO_SYNC_t *SYNC) {
+    if (SYNC == NULL || !SYNC->hwRunning) {
+        return;
+    }
+
+    uint8_t counter = SYNC->counter;
+    if (++SYNC->counter > SYNC->counterOverflowValue) SYNC->counter = 1;
+    SYNC->CANtxBuff->data[0] = SYNC->counter;
+
+    if (!SYNC->pFunctHwSend(SYNC->hwObject, SYNC->CANtxBuff)) {
+        /* Previous SYNC is still in the mailbox. It is counted as missed by
+         * CO_SYNC_hwTxComplete() from the longer interval. */
+        SYNC->counter = counter;
+        return;
+    }
+
+    if (SYNC->pFunctLocal_us != NULL) {
+        SYNC->event_us = SYNC->pFunctLocal_us();
+    }
+
+    /* toggle PDO receive buffer, CO_SYNC_process() handles it as received */
+    SYNC->CANrxToggle = SYNC->CANrxToggle ? false : true;
+    CO_FLAG_SET(SYNC->CANrxNew);
+
+#if (CO_CONFIG_SYNC) & CO_CONFIG_FLAG_CALLBACK_PRE
+    if (SYNC->pFunctSignalPre != NULL) {
+        SYNC->pFunctSignalPre(SYNC->functSignalObjectPre);
+    }
+#endif
+}
+
+
+/******************************************************************************/
+void CO_SYNC_hwTxComplete(CO_SYNC_t *SYNC, uint32_t timestamp) {
+    if (SYNC == NULL) {
+        return;
+    }
+
+    uint32_t period = SYNC->hwPeriodTicks;
+    uint32_t last = SYNC->hwLastTimestamp;
+    bool_t haveLast = SYNC->hwHaveLast;
+
+    SYNC->hwLastTimestamp = timestamp;
+    SYNC->hwHaveLast = period > 0;
+    if (!haveLast || period == 0) {
+        return;
+    }
+
+    /* jitter is the distance to the nearest multiple of period, more than one
+     * period means SYNC messages, which were not transmitted */
+    uint32_t interval = timestamp - last;
+    uint32_t n = interval / period;
+    uint32_t rem = interval - n * period;
+    int32_t jitter;
+
+    if (rem > (period >> 1)) {
+        n++;
+        jitter = -(int32_t)(period - rem);
+    }
+    else {
+        jitter = (int32_t)rem;
+    }
+    if (n != 1) {
+        if (n > 1) {
+            SYNC->hwMissed += n - 1;
+        }
+        return;
+    }
+
+    if (SYNC->hwCount == 0) {
+        SYNC->hwMin = SYNC->hwMax = jitter;
+        SYNC->hwSum = 0;
+        SYNC->hwSumSq = 0;
+    }
+    else if (jitter < SYNC->hwMin) {
+        SYNC->hwMin = jitter;
+    }
+    else if (jitter > SYNC->hwMax) {
+        SYNC->hwMax = jitter;
+    }
+
+    if (jitter > CO_SYNC_JITTER_CLAMP) jitter = CO_SYNC_JITTER_CLAMP;
+    else if (jitter < -CO_SYNC_JITTER_CLAMP) jitter = -CO_SYNC_JITTER_CLAMP;
+    SYNC->hwSum += jitter;
+    SYNC->hwSumSq += (uint64_t)((int64_t)jitter * jitter);
+
+    if (++SYNC->hwCount >= CO_SYNC_JITTER_WINDOW) {
+        /* if the previous window was not yet published, this one is lost */
+        if (!SYNC->hwWindowReady) {
+            SYNC->hwWinMin = SYNC->hwMin;
+            SYNC->hwWinMax = SYNC->hwMax;
+            SYNC->hwWinSum = SYNC->hwSum;
+            SYNC->hwWinSumSq = SYNC->hwSumSq;
+            CO_MemoryBarrier();
+            SYNC->hwWindowReady = true;
+        }
+        SYNC->hwCount = 0;
+    }
+}
+
+
+/******************************************************************************/
+void CO_SYNC_getJitter(CO_SYNC_t *SYNC, CO_SYNC_jitter_t *jitter) {
+    if (SYNC == NULL || jitter == NULL) {
+        return;
+    }
+
+    *jitter = SYNC->jitter;
+    jitter->missed = SYNC->hwMissed;
+}
+
+
+/* Integer square root, rounded down. */
+static uint32_t CO_SYNC_isqrt64(uint64_t x) {
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while (bit > x) bit >>= 2;
+    while (bit != 0) {
+        if (x >= root + bit) {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)root;
+}
+
+/* Convert signed value in 1/16 timestamp ticks to nanoseconds. */
+static int32_t CO_SYNC_ticks16ToNs(CO_SYNC_t *SYNC, int64_t ticks16) {
+    int64_t ns = ticks16 * 1000000000 / ((int64_t)SYNC->hwTimestampFreq_Hz * 16);
+    if (ns > INT32_MAX) ns = INT32_MAX;
+    else if (ns < INT32_MIN) ns = INT32_MIN;
+    return (int32_t)ns;
+}
+
+/*
+ * Start, retune or stop the hardware timer and publish completed window of
+ * jitter statistics.
+ *
+ * @param SYNC This object.
+ * @param period_us SYNC period, 0 if this node must not produce SYNC.
+ */
+static void CO_SYNC_processHw(CO_SYNC_t *SYNC, uint32_t period_us) {
+    if (period_us != SYNC->hwPeriod_us) {
+        uint64_t ticks = (uint64_t)period_us * SYNC->hwTimestampFreq_Hz
+                       / 1000000;
+
+        SYNC->hwRunning = false;
+        SYNC->hwPeriod_us = period_us;
+        /* interval of one period must fit into 32-bit timestamp */
+        SYNC->hwPeriodTicks = ticks <= 0x7FFFFFFF ? (uint32_t)ticks : 0;
+        SYNC->hwHaveLast = false;
+        SYNC->hwCount = 0;
+        SYNC->pFunctHwPeriod(SYNC->hwObject, period_us);
+        SYNC->hwRunning = period_us > 0;
+    }
+
+    if (SYNC->hwWindowReady) {
+        const int64_t n = CO_SYNC_JITTER_WINDOW;
+        int64_t mean16 = SYNC->hwWinSum * 16 / n;
+        uint64_t sumSq = SYNC->hwWinSumSq;
+        /* variance in 1/256 ticks^2, sum of squares is split to not overflow */
+        int64_t var256 = (int64_t)(sumSq / (uint64_t)n) * 256
+                       + (int64_t)((sumSq % (uint64_t)n) * 256 / (uint64_t)n)
+                       - mean16 * mean16;
+
+        SYNC->jitter.samples = (uint32_t)n;
+        SYNC->jitter.min_ns = CO_SYNC_ticks16ToNs(SYNC, (int64_t)SYNC->hwWinMin * 16);
+        SYNC->jitter.max_ns = CO_SYNC_ticks16ToNs(SYNC, (int64_t)SYNC->hwWinMax * 16);
+        SYNC->jitter.mean_ns = CO_SYNC_ticks16ToNs(SYNC, mean16);
+        SYNC->jitter.stddev_ns = CO_SYNC_ticks16ToNs(SYNC,
+                            var256 > 0 ? CO_SYNC_isqrt64((uint64_t)var256) : 0);
+        CO_MemoryBarrier();
+        SYNC->hwWindowReady = false;
+    }
+}
+#endif /* (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_PRODUCER_HW */
+
+
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_CLOCK
+/******************************************************************************/
+bool_t CO_SYNC_clockPredict(CO_SYNC_t *SYNC,
+                            uint32_t now_us,
+                            CO_SYNC_clock_t *clock)
+{
+    CO_SYNC_clockParam_t clk;
+    uint32_t seq;
+
+    if (SYNC == NULL || clock == NULL) {
+        return false;
+    }
+
+    /* copy in use, retry only if receive interrupt published a new one */
+    do {
+        seq = SYNC->clkSeq;
+        CO_MemoryBarrier();
+        clk = SYNC->clkParam[seq & 1];
+        CO_MemoryBarrier();
+    } while (seq != SYNC->clkSeq);
+
+    memset(clock, 0, sizeof(*clock));
+    clock->missed = clk.missed;
+    if (clk.state != 2 || SYNC->clkReset) {
+        return false;
+    }
+
+    /* times relative to the last SYNC, in 1/256 us */
+    int64_t next = (int32_t)(clk.next_q8 - (clk.rx_us << 8));
+    int32_t nowRel_us = (int32_t)(now_us - clk.rx_us);
+    int64_t now = nowRel_us > 0 ? (int64_t)nowRel_us * 256 : 0;
+    int64_t n = 0;
+
+    if (now >= next) {
+        n = (now - next) / clk.period_q8 + 1;
+        next += n * clk.period_q8;
+    }
+
+    uint64_t period_ns = (uint64_t)clk.period_q8 * 1000 / 256;
+    clock->nextSync_us = clk.rx_us + (uint32_t)((next + 128) / 256);
+    clock->period_us = ((uint32_t)clk.period_q8 + 128) >> 8;
+    clock->period_ns = period_ns > UINT32_MAX ? UINT32_MAX : (uint32_t)period_ns;
+    clock->phaseError_ns = (int32_t)((int64_t)clk.error_q8 * 1000 / 256);
+    clock->locked = clk.good >= CO_SYNC_CLOCK_LOCK_COUNT && n < 2;
+
+    return clock->locked;
+}
+#endif /* (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_CLOCK */
+
+
 /******************************************************************************/
 CO_SYNC_status_t CO_SYNC_process(CO_SYNC_t *SYNC,
                                  bool_t NMTisPreOrOperational,
@@ -362,14 +807,29 @@ CO_SYNC_status_t CO_SYNC_process(CO_SYNC_t *SYNC,
 
     CO_SYNC_status_t syncStatus = CO_SYNC_NONE;
 
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_PRODUCER_HW
+    if (SYNC->pFunctHwPeriod != NULL) {
+        uint32_t hwPeriod_us = (NMTisPreOrOperational && SYNC->isProducer
+                                && SYNC->OD_1006_period != NULL)
+                             ? *SYNC->OD_1006_period : 0;
+        CO_SYNC_processHw(SYNC, hwPeriod_us);
+    }
+#endif
+
     if (NMTisPreOrOperational) {
         /* update sync timer, no overflow */
         uint32_t timerNew = SYNC->timer + timeDifference_us;
         if (timerNew > SYNC->timer) SYNC->timer = timerNew;
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_CLOCK
+        /* recovered clock is not valid after long time without SYNC */
+        if (SYNC->timer > 0x007FFFFFU) SYNC->clkReset = true;
+#endif
 
         /* was SYNC just received */
         if (CO_FLAG_READ(SYNC->CANrxNew)) {
-            SYNC->timer = 0;
+            /* time elapsed since the SYNC, if it was timestamped */
+            SYNC->timer = (SYNC->pFunctLocal_us != NULL)
+                        ? SYNC->pFunctLocal_us() - SYNC->event_us : 0;
             syncStatus = CO_SYNC_RX_TX;
             CO_FLAG_CLEAR(SYNC->CANrxNew);
         }
@@ -380,7 +840,12 @@ CO_SYNC_status_t CO_SYNC_process(CO_SYNC_t *SYNC,
         if (OD_1006_period > 0) {
 #if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_PRODUCER
             if (SYNC->isProducer) {
-                if (SYNC->timer >= OD_1006_period) {
+                /* with hardware timer SYNC is sent from CO_SYNC_hwTimerIsr() */
+                if (SYNC->timer >= OD_1006_period
+ #if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_PRODUCER_HW
+                    && !SYNC->hwRunning
+ #endif
+                ) {
                     syncStatus = CO_SYNC_RX_TX;
                     CO_SYNCsend(SYNC);
                 }
@@ -444,6 +909,9 @@ CO_SYNC_status_t CO_SYNC_process(CO_SYNC_t *SYNC,
         SYNC->receiveError = 0;
         SYNC->counter = 0;
         SYNC->timer = 0;
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_CLOCK
+        SYNC->clkReset = true;
+#endif
     }
 
     if (syncStatus == CO_SYNC_RX_TX) {
@@ -72,7 +72,137 @@ extern "C" {
  * transmitted, internal variable CANrxToggle toggles. That variable is then
  * used by synchronous RPDO to determine, which of the two buffers is used for
  * RPDO reception and which for RPDO processing.
+ *
+ * ####Hardware timed SYNC producer
+ * If @ref CO_CONFIG_SYNC_PRODUCER_HW is enabled and CO_SYNC_initHwProducer()
+ * is called, SYNC producer is not timed by CO_SYNC_process(), which runs from
+ * the main loop with the jitter of the loop. The target runs a hardware timer
+ * with period from OD 0x1006 instead and calls CO_SYNC_hwTimerIsr() from its
+ * compare interrupt. There the message is written into a transmit mailbox,
+ * which is reserved for SYNC, so it does not wait behind other queued
+ * messages. CO_SYNC_process() only starts, retunes and stops the timer, when
+ * NMT state, producer flag or period change.
+ *
+ * The target calls CO_SYNC_hwTxComplete() from the transmit complete interrupt
+ * of the reserved mailbox with the time of the interrupt. Difference between
+ * successive intervals and the period is the jitter of the SYNC producer.
+ * Statistics of each #CO_SYNC_JITTER_WINDOW messages are published by
+ * CO_SYNC_process() and are read with CO_SYNC_getJitter() or from OD object
+ * #CO_SYNC_JITTER_OD_INDEX.
+ *
+ * ####SYNC clock recovery
+ * If @ref CO_CONFIG_SYNC_CLOCK is enabled, SYNC consumer recovers the time
+ * base of the SYNC producer. Each received SYNC is timestamped with
+ * CO_CANrxMsg_readTimestamp() and passed to a second order phase locked loop,
+ * which estimates the SYNC period and the time of the next SYNC. Phase error
+ * corrects the phase by 1/#CO_SYNC_CLOCK_KP and the period by
+ * 1/#CO_SYNC_CLOCK_KI, both in 1/256 microseconds. Missing SYNC messages are
+ * skipped by whole periods, single late messages do not disturb the loop.
+ *
+ * CO_SYNC_clockPredict() returns the predicted time of the next SYNC, so the
+ * application can sample its inputs just before SYNC and synchronous TPDOs
+ * carry fresh data, aligned on all nodes. Accuracy depends on the timestamp,
+ * ideally taken in the CAN receive interrupt.
+ */
+
+#if ((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_PRODUCER_HW) || defined CO_DOXYGEN
+/** Number of SYNC messages in one window of jitter statistics */
+#ifndef CO_SYNC_JITTER_WINDOW
+#define CO_SYNC_JITTER_WINDOW 1000
+#endif
+
+/** Index of manufacturer specific ARRAY object with jitter statistics, sub 1
+ * to 6 are members of CO_SYNC_jitter_t in order. If object does not exist in
+ * Object Dictionary, statistics are still calculated. */
+#ifndef CO_SYNC_JITTER_OD_INDEX
+#define CO_SYNC_JITTER_OD_INDEX 0x2230
+#endif
+
+
+/**
+ * Jitter statistics of hardware timed SYNC producer.
+ */
+typedef struct {
+    /** Number of intervals in the last window */
+    uint32_t samples;
+    /** Minimum jitter in the last window, nanoseconds */
+    int32_t min_ns;
+    /** Maximum jitter in the last window, nanoseconds */
+    int32_t max_ns;
+    /** Mean jitter in the last window, nanoseconds */
+    int32_t mean_ns;
+    /** Standard deviation of jitter in the last window, nanoseconds */
+    int32_t stddev_ns;
+    /** SYNC messages not sent or without transmit complete interrupt, since
+     * CO_SYNC_initHwProducer(), wraps around */
+    uint32_t missed;
+} CO_SYNC_jitter_t;
+#endif
+
+#if ((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_CLOCK) || defined CO_DOXYGEN
+/** Phase gain divisor of SYNC clock recovery */
+#ifndef CO_SYNC_CLOCK_KP
+#define CO_SYNC_CLOCK_KP 4
+#endif
+
+/** Period gain divisor of SYNC clock recovery, KP * KP / 4 for critical
+ * damping */
+#ifndef CO_SYNC_CLOCK_KI
+#define CO_SYNC_CLOCK_KI 64
+#endif
+
+/** SYNC clock is locked after this many consecutive SYNC messages with phase
+ * error within #CO_SYNC_CLOCK_LOCK_US */
+#ifndef CO_SYNC_CLOCK_LOCK_COUNT
+#define CO_SYNC_CLOCK_LOCK_COUNT 8
+#endif
+
+/** Maximum phase error of locked SYNC clock in microseconds */
+#ifndef CO_SYNC_CLOCK_LOCK_US
+#define CO_SYNC_CLOCK_LOCK_US 50
+#endif
+
+
+/**
+ * Recovered SYNC clock, see CO_SYNC_clockPredict().
  */
+typedef struct {
+    /** Predicted reception time of the first SYNC after now_us, microseconds
+     * in the time base of CO_CANrxMsg_readTimestamp() */
+    uint32_t nextSync_us;
+    /** Estimated SYNC period, microseconds */
+    uint32_t period_us;
+    /** Estimated SYNC period, nanoseconds, saturated */
+    uint32_t period_ns;
+    /** Phase error of the last received SYNC against prediction, nanoseconds */
+    int32_t phaseError_ns;
+    /** Number of SYNC messages, which were skipped as missing, wraps around */
+    uint16_t missed;
+    /** True, if clock is locked */
+    bool_t locked;
+} CO_SYNC_clock_t;
+
+
+/**
+ * State of the recovered SYNC clock, written by the receive function.
+ */
+typedef struct {
+    /** Reception time of the last SYNC, microseconds */
+    uint32_t rx_us;
+    /** Predicted time of the next SYNC, 1/256 microseconds, wraps around */
+    uint32_t next_q8;
+    /** Estimated SYNC period, 1/256 microseconds */
+    int32_t period_q8;
+    /** Phase error of the last SYNC, 1/256 microseconds */
+    int32_t error_q8;
+    /** Skipped SYNC messages, wraps around */
+    uint16_t missed;
+    /** 0 = no SYNC, 1 = period unknown, 2 = tracking */
+    uint8_t state;
+    /** Consecutive SYNC messages within #CO_SYNC_CLOCK_LOCK_US, saturated */
+    uint8_t good;
+} CO_SYNC_clockParam_t;
+#endif
 
 
 /**
@@ -139,6 +269,73 @@ typedef struct {
     void (*pFunctSignalPre)(void *object);
     /** From CO_SYNC_initCallbackPre() or NULL */
     void *functSignalObjectPre;
+#endif
+    /** From CO_SYNC_initTimestamp() or NULL */
+    uint32_t (*pFunctLocal_us)(void);
+    /** Value of pFunctLocal_us() when the last SYNC was received or sent by
+     * CO_SYNC_hwTimerIsr() */
+    volatile uint32_t event_us;
+
+#if ((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_PRODUCER_HW) || defined CO_DOXYGEN
+    /** From CO_SYNC_initHwProducer() or NULL */
+    bool_t (*pFunctHwSend)(void *object, const CO_CANtx_t *buffer);
+    /** From CO_SYNC_initHwProducer() or NULL */
+    void (*pFunctHwPeriod)(void *object, uint32_t period_us);
+    /** From CO_SYNC_initHwProducer() */
+    void *hwObject;
+    /** From CO_SYNC_initHwProducer() */
+    uint32_t hwTimestampFreq_Hz;
+    /** Period of the running hardware timer in microseconds, 0 if stopped */
+    uint32_t hwPeriod_us;
+    /** hwPeriod_us in timestamp ticks, 0 if jitter is not measured */
+    uint32_t hwPeriodTicks;
+    /** True, if CO_SYNC_hwTimerIsr() sends SYNC */
+    volatile bool_t hwRunning;
+    /** True, if hwLastTimestamp is valid */
+    volatile bool_t hwHaveLast;
+    /** Timestamp of the previous transmit complete interrupt */
+    uint32_t hwLastTimestamp;
+    /** Counted SYNC messages without transmit complete interrupt */
+    volatile uint32_t hwMissed;
+    /** Number of samples in the window being accumulated */
+    uint32_t hwCount;
+    /** Minimum jitter in the window being accumulated, ticks */
+    int32_t hwMin;
+    /** Maximum jitter in the window being accumulated, ticks */
+    int32_t hwMax;
+    /** Sum of jitter in the window being accumulated, ticks */
+    int64_t hwSum;
+    /** Sum of squared jitter in the window being accumulated, ticks^2 */
+    uint64_t hwSumSq;
+    /** Completed window, valid if hwWindowReady, ticks */
+    int32_t hwWinMin;
+    /** Completed window, valid if hwWindowReady, ticks */
+    int32_t hwWinMax;
+    /** Completed window, valid if hwWindowReady, ticks */
+    int64_t hwWinSum;
+    /** Completed window, valid if hwWindowReady, ticks^2 */
+    uint64_t hwWinSumSq;
+    /** Set in interrupt when window is completed, cleared in
+     * CO_SYNC_process() after it is published */
+    volatile bool_t hwWindowReady;
+    /** Published statistics of the last completed window */
+    CO_SYNC_jitter_t jitter;
+    /** Extension for OD object */
+    OD_extension_t OD_jitter_extension;
+#endif
+
+#if ((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_CLOCK) || defined CO_DOXYGEN
+    /** Clock state, clkParam[clkSeq & 1] is in use, the other one is
+     * written by the receive function */
+    CO_SYNC_clockParam_t clkParam[2];
+    /** Incremented after each update of clkParam, readers retry if it
+     * changes */
+    volatile uint32_t clkSeq;
+    /** Set by CO_SYNC_process() to restart the clock, applied by the receive
+     * function on the next SYNC. Clock is not valid while set. */
+    volatile bool_t clkReset;
+    /** Consecutive SYNC messages rejected as outliers */
+    uint8_t clkBad;
 #endif
 } CO_SYNC_t;
 
@@ -210,6 +407,23 @@ void CO_SYNC_initCallbackPre(CO_SYNC_t *SYNC,
 #endif
 
 
+/**
+ * Initialize timestamp of the SYNC event.
+ *
+ * Without it, @ref CO_SYNC_t::timer starts from zero when CO_SYNC_process()
+ * finds the received SYNC, so it lags behind the SYNC by the delay of the
+ * mainline. With pFunctLocal_us, receive function and CO_SYNC_hwTimerIsr()
+ * record the time of the SYNC and CO_SYNC_process() starts the timer from the
+ * time elapsed since then. Transmit offsets of synchronous TPDOs are then
+ * measured from the SYNC on the bus.
+ *
+ * @param SYNC This object.
+ * @param pFunctLocal_us Free running microsecond counter, callable from
+ * interrupts, or NULL.
+ */
+void CO_SYNC_initTimestamp(CO_SYNC_t *SYNC, uint32_t (*pFunctLocal_us)(void));
+
+
 #if ((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_PRODUCER) || defined CO_DOXYGEN
 /**
  * Send SYNC message.
@@ -232,6 +446,98 @@ static inline CO_ReturnError_t CO_SYNCsend(CO_SYNC_t *SYNC) {
 #endif
 
 
+#if ((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_PRODUCER_HW) || defined CO_DOXYGEN
+/**
+ * Initialize hardware timed SYNC producer.
+ *
+ * Function must be called after CO_SYNC_init(), before the first
+ * CO_SYNC_process(). Hardware timer is started by CO_SYNC_process(), when
+ * device is SYNC producer in NMT pre-operational or operational state and
+ * period in OD 0x1006 is not zero.
+ *
+ * @param SYNC This object.
+ * @param object Pointer to object, which will be passed to pFunctHwSend() and
+ * pFunctHwPeriod(). Can be NULL.
+ * @param pFunctHwSend Pointer to function, which writes SYNC message into the
+ * reserved transmit mailbox. It is called from CO_SYNC_hwTimerIsr(). It must
+ * return false, if mailbox is still occupied by the previous SYNC.
+ * @param pFunctHwPeriod Pointer to function, which (re)starts the hardware
+ * timer with period_us or stops it, if period_us is 0. It is called from
+ * CO_SYNC_process().
+ * @param timestampFreq_Hz Frequency of the timestamps passed to
+ * CO_SYNC_hwTxComplete().
+ * @param OD_jitter OD entry for jitter statistics, see
+ * #CO_SYNC_JITTER_OD_INDEX. May be NULL.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_SYNC_initHwProducer(CO_SYNC_t *SYNC,
+                                        void *object,
+                                        bool_t (*pFunctHwSend)(void *object,
+                                                    const CO_CANtx_t *buffer),
+                                        void (*pFunctHwPeriod)(void *object,
+                                                    uint32_t period_us),
+                                        uint32_t timestampFreq_Hz,
+                                        OD_entry_t *OD_jitter);
+
+
+/**
+ * Send SYNC message from hardware timer interrupt.
+ *
+ * Function must be called from the compare interrupt of the timer, started by
+ * pFunctHwPeriod(). It prepares SYNC message like CO_SYNCsend(), writes it
+ * with pFunctHwSend() and signals CO_SYNC_process() like received SYNC.
+ *
+ * @param SYNC This object.
+ */
+void CO_SYNC_hwTimerIsr(CO_SYNC_t *SYNC);
+
+
+/**
+ * Register transmission of SYNC message.
+ *
+ * Function must be called from the transmit complete interrupt of the reserved
+ * mailbox.
+ *
+ * @param SYNC This object.
+ * @param timestamp Free running counter with frequency timestampFreq_Hz from
+ * CO_SYNC_initHwProducer(), read inside the interrupt.
+ */
+void CO_SYNC_hwTxComplete(CO_SYNC_t *SYNC, uint32_t timestamp);
+
+
+/**
+ * Get jitter statistics of the last completed window.
+ *
+ * @param SYNC This object.
+ * @param [out] jitter Copy of statistics.
+ */
+void CO_SYNC_getJitter(CO_SYNC_t *SYNC, CO_SYNC_jitter_t *jitter);
+#endif
+
+
+#if ((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_CLOCK) || defined CO_DOXYGEN
+/**
+ * Get the recovered SYNC clock and predicted time of the next SYNC.
+ *
+ * Clock state is kept in two copies, receive function writes the one not in
+ * use, so this function never waits for it. It may be called from mainline or
+ * from any interrupt.
+ *
+ * @param SYNC This object.
+ * @param now_us Current time in the time base of CO_CANrxMsg_readTimestamp().
+ * @param [out] clock Recovered clock, nextSync_us is after now_us. Valid if
+ * SYNC period is already known, even if not locked.
+ *
+ * @return True, if clock is locked and no more than one SYNC is missing since
+ * the last received SYNC.
+ */
+bool_t CO_SYNC_clockPredict(CO_SYNC_t *SYNC,
+                            uint32_t now_us,
+                            CO_SYNC_clock_t *clock);
+#endif
+
+
 /**
  * Process SYNC communication.
  *
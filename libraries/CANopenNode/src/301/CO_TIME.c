@@ -29,6 +29,112 @@
 
 #if (CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE
 
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK
+/* microseconds in one day */
+#define CO_TIME_DAY_US ((uint64_t)86400000U * 1000U)
+/* drift limit, 2^-32 */
+#define CO_TIME_DRIFT_MAX \
+    ((int32_t)(((int64_t)CO_TIME_CLOCK_DRIFT_MAX_PPM << 32) / 1000000))
+
+/* Network time at local_us, local_us may also be slightly before the anchor */
+static uint64_t CO_TIME_clockEval(const CO_TIME_clockParam_t *param,
+                                  uint32_t local_us)
+{
+    int64_t dt = (int32_t)(local_us - param->local_us);
+
+    return param->time_us + (uint64_t)(dt + ((dt * param->drift_q32) >> 32));
+}
+
+
+/* Write inactive copy of clock parameters and make it active */
+static void CO_TIME_clockWrite(CO_TIME_t *TIME,
+                               uint32_t local_us,
+                               uint64_t time_us,
+                               int32_t drift_q32)
+{
+    CO_TIME_clockParam_t *param = &TIME->clkParam[(TIME->clkSeq + 1) & 1];
+
+    param->time_us = time_us;
+    param->local_us = local_us;
+    param->drift_q32 = drift_q32;
+    CO_MemoryBarrier();
+    TIME->clkSeq++;
+}
+
+
+/* Update ms, days and residual_us from network time */
+static void CO_TIME_clockToMsDays(CO_TIME_t *TIME, uint64_t time_us) {
+    uint16_t days = (uint16_t)(time_us / CO_TIME_DAY_US);
+    uint64_t dayTime_us = time_us - (uint64_t)days * CO_TIME_DAY_US;
+
+    TIME->days = days;
+    TIME->ms = (uint32_t)(dayTime_us / 1000U);
+    TIME->residual_us = (uint16_t)(dayTime_us - (uint64_t)TIME->ms * 1000U);
+}
+
+
+/* Correct the clock with received time, see CO_TIME_process() */
+static void CO_TIME_clockUpdate(CO_TIME_t *TIME,
+                                uint32_t rx_us,
+                                uint64_t time_us)
+{
+    const CO_TIME_clockParam_t *param = &TIME->clkParam[TIME->clkSeq & 1];
+    int32_t drift = param->drift_q32;
+    uint32_t interval_us = rx_us - TIME->clkRx_us;
+
+    if (TIME->clkState == 2 && interval_us > 0 && interval_us <= 0x7FFFFFFFU) {
+        uint64_t predicted_us = CO_TIME_clockEval(param, rx_us);
+        int64_t error = (int64_t)(time_us - predicted_us);
+
+        if (error <= CO_TIME_CLOCK_STEP_US && error >= -CO_TIME_CLOCK_STEP_US) {
+            int64_t correction = (error * 4294967296LL)
+                               / ((int64_t)CO_TIME_CLOCK_KI * interval_us);
+
+            correction += drift;
+            if (correction > CO_TIME_DRIFT_MAX) {
+                correction = CO_TIME_DRIFT_MAX;
+            }
+            else if (correction < -CO_TIME_DRIFT_MAX) {
+                correction = -CO_TIME_DRIFT_MAX;
+            }
+
+            TIME->clkBad = 0;
+            TIME->clkError_us = (int32_t)error;
+            if (error > CO_TIME_CLOCK_LOCK_US || error < -CO_TIME_CLOCK_LOCK_US) {
+                TIME->clkGood = 0;
+            }
+            else if (TIME->clkGood < 0xFF) {
+                TIME->clkGood++;
+            }
+            CO_TIME_clockWrite(TIME, rx_us,
+                               predicted_us
+                               + (uint64_t)(error / CO_TIME_CLOCK_KP),
+                               (int32_t)correction);
+            TIME->clkRx_us = rx_us;
+            return;
+        }
+
+        /* outlier does not correct the clock, repeated outliers step it */
+        TIME->clkGood = 0;
+        if (++TIME->clkBad < 3) {
+            return;
+        }
+    }
+
+    /* set or step the clock to received time */
+    if (TIME->clkState != 0) {
+        TIME->clkSteps++;
+    }
+    TIME->clkError_us = 0;
+    TIME->clkGood = 0;
+    TIME->clkBad = 0;
+    CO_TIME_clockWrite(TIME, rx_us, time_us, drift);
+    TIME->clkRx_us = rx_us;
+    TIME->clkState = 2;
+}
+#endif /* (CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK */
+
+
 /*
  * Read received message from CAN module.
  *
@@ -43,6 +149,9 @@ static void CO_TIME_receive(void *object, void *msg) {
 
     if (DLC == CO_TIME_MSG_LENGTH) {
         memcpy(TIME->timeStamp, data, sizeof(TIME->timeStamp));
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK
+        TIME->rxTimestamp_us = CO_CANrxMsg_readTimestamp(msg);
+#endif
         CO_FLAG_SET(TIME->CANrxNew);
 
 #if (CO_CONFIG_TIME) & CO_CONFIG_FLAG_CALLBACK_PRE
@@ -177,6 +286,70 @@ void CO_TIME_initCallbackPre(CO_TIME_t *TIME,
 #endif
 
 
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK
+void CO_TIME_initClock(CO_TIME_t *TIME, uint32_t (*pFunctLocal_us)(void)) {
+    if (TIME != NULL) {
+        TIME->pFunctLocal_us = pFunctLocal_us;
+        TIME->clkState = 0;
+    }
+}
+
+
+void CO_TIME_clockSet(CO_TIME_t *TIME, uint64_t time_us) {
+    if (TIME == NULL || TIME->pFunctLocal_us == NULL) {
+        return;
+    }
+
+    if (TIME->clkState != 0) {
+        TIME->clkSteps++;
+    }
+    TIME->clkError_us = 0;
+    TIME->clkGood = 0;
+    TIME->clkBad = 0;
+    CO_TIME_clockWrite(TIME, TIME->pFunctLocal_us(), time_us,
+                       TIME->clkParam[TIME->clkSeq & 1].drift_q32);
+    TIME->clkState = 1;
+}
+
+
+uint64_t CO_TIME_now(CO_TIME_t *TIME) {
+    CO_TIME_clockParam_t param;
+    uint32_t seq;
+
+    if (TIME->pFunctLocal_us == NULL || TIME->clkState == 0) {
+        return ((uint64_t)TIME->days * 86400000U + TIME->ms) * 1000U
+               + TIME->residual_us;
+    }
+
+    do {
+        seq = TIME->clkSeq;
+        CO_MemoryBarrier();
+        param = TIME->clkParam[seq & 1];
+        CO_MemoryBarrier();
+    } while (seq != TIME->clkSeq);
+
+    return CO_TIME_clockEval(&param, TIME->pFunctLocal_us());
+}
+
+
+bool_t CO_TIME_getClock(CO_TIME_t *TIME, CO_TIME_clock_t *clock) {
+    int64_t drift = TIME->clkParam[TIME->clkSeq & 1].drift_q32;
+
+    clock->drift_ppb = (int32_t)((drift * 1000000000) >> 32);
+    clock->error_us = TIME->clkError_us;
+    clock->steps = TIME->clkSteps;
+    if (TIME->clkState == 2) {
+        clock->locked = TIME->clkGood >= CO_TIME_CLOCK_LOCK_COUNT;
+    }
+    else {
+        clock->locked = TIME->clkState == 1;
+    }
+
+    return clock->locked;
+}
+#endif
+
+
 bool_t CO_TIME_process(CO_TIME_t *TIME,
                        bool_t NMTisPreOrOperational,
                        uint32_t timeDifference_us)
@@ -192,6 +365,16 @@ bool_t CO_TIME_process(CO_TIME_t *TIME,
             TIME->days = CO_SWAP_16(days_swapped);
             TIME->residual_us = 0;
             timestampReceived = true;
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK
+            if (TIME->pFunctLocal_us != NULL) {
+                /* received time is truncated to milliseconds */
+                CO_TIME_clockUpdate(TIME, TIME->rxTimestamp_us,
+                                    ((uint64_t)TIME->days * 86400000U
+                                     + TIME->ms) * 1000U
+                                    + 500U + CO_TIME_CLOCK_DELAY_US);
+                CO_TIME_clockToMsDays(TIME, CO_TIME_now(TIME));
+            }
+#endif
 
             CO_FLAG_CLEAR(TIME->CANrxNew);
         }
@@ -213,6 +396,20 @@ bool_t CO_TIME_process(CO_TIME_t *TIME,
         }
     }
 
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK
+    /* move clock parameters forward, before local time difference overflows */
+    if (TIME->pFunctLocal_us != NULL && TIME->clkState != 0) {
+        const CO_TIME_clockParam_t *param = &TIME->clkParam[TIME->clkSeq & 1];
+        uint32_t local_us = TIME->pFunctLocal_us();
+
+        if ((local_us - param->local_us) > 0x40000000U) {
+            uint64_t time_us = CO_TIME_clockEval(param, local_us);
+            CO_TIME_clockWrite(TIME, local_us, time_us, param->drift_q32);
+            CO_TIME_clockToMsDays(TIME, time_us);
+        }
+    }
+#endif
+
 #if (CO_CONFIG_TIME) & CO_CONFIG_TIME_PRODUCER
     if (NMTisPreOrOperational && TIME->isProducer
         && TIME->producerInterval_ms > 0
@@ -220,6 +417,11 @@ bool_t CO_TIME_process(CO_TIME_t *TIME,
         if (TIME->producerTimer_ms >= TIME->producerInterval_ms) {
             TIME->producerTimer_ms -= TIME->producerInterval_ms;
 
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK
+            if (TIME->pFunctLocal_us != NULL && TIME->clkState != 0) {
+                CO_TIME_clockToMsDays(TIME, CO_TIME_now(TIME));
+            }
+#endif
             uint32_t ms_swapped = CO_SWAP_32(TIME->ms);
             uint16_t days_swapped = CO_SWAP_16(TIME->days);
             CO_setUint32(&TIME->CANtxBuff->data[0], ms_swapped);
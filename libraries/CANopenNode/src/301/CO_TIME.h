@@ -68,12 +68,104 @@ extern "C" {
  * Current time can be set with @ref CO_TIME_set() function, which is necessary
  * at least once, if time producer. If configured, time stamp message is
  * send from @ref CO_TIME_process() in intervals specified by @ref CO_TIME_set()
+ *
+ * ####Network time
+ * If @ref CO_CONFIG_TIME_CLOCK is enabled and local microsecond counter is
+ * configured with CO_TIME_initClock(), CO_TIME_now() returns network time in
+ * microseconds since January 1, 1984. It is the local counter, scaled by the
+ * estimated drift and offset to the time of the producer.
+ *
+ * Producer is the reference, its clock is set by CO_TIME_set() and sent with
+ * the time of CO_TIME_now(). Consumer timestamps each received TIME message
+ * with CO_CANrxMsg_readTimestamp() and passes the error of its clock at that
+ * instant to a second order loop in CO_TIME_process(). Error corrects the
+ * offset by 1/#CO_TIME_CLOCK_KP and the drift by 1/#CO_TIME_CLOCK_KI per
+ * microsecond of the message interval. Time in TIME message is truncated to
+ * milliseconds, so received time is taken in the middle of the millisecond;
+ * the loop averages the truncation noise out. Error beyond
+ * #CO_TIME_CLOCK_STEP_US is an outlier, three consecutive outliers step the
+ * clock to the received time. Between messages the clock runs with the
+ * estimated drift.
+ *
+ * Clock parameters are written only by CO_TIME_process(), into a second copy,
+ * so CO_TIME_now() is a short lock-free read, usable also from interrupts.
+ * @p CO_TIME_t->ms and @p CO_TIME_t->days follow the network time.
  */
 
 
 /** Length of the TIME message */
 #define CO_TIME_MSG_LENGTH 6
 
+#if ((CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK) || defined CO_DOXYGEN
+/** Offset gain divisor of network time */
+#ifndef CO_TIME_CLOCK_KP
+#define CO_TIME_CLOCK_KP 16
+#endif
+
+/** Drift gain divisor of network time, 4 * KP * KP for critical damping */
+#ifndef CO_TIME_CLOCK_KI
+#define CO_TIME_CLOCK_KI 1024
+#endif
+
+/** TIME message with larger clock error in microseconds is an outlier */
+#ifndef CO_TIME_CLOCK_STEP_US
+#define CO_TIME_CLOCK_STEP_US 10000
+#endif
+
+/** Network time is locked after this many consecutive TIME messages with
+ * clock error within #CO_TIME_CLOCK_LOCK_US */
+#ifndef CO_TIME_CLOCK_LOCK_COUNT
+#define CO_TIME_CLOCK_LOCK_COUNT 8
+#endif
+
+/** Maximum clock error of locked network time in microseconds, includes
+ * truncation of TIME message to milliseconds */
+#ifndef CO_TIME_CLOCK_LOCK_US
+#define CO_TIME_CLOCK_LOCK_US 1000
+#endif
+
+/** Limit of estimated drift in ppm */
+#ifndef CO_TIME_CLOCK_DRIFT_MAX_PPM
+#define CO_TIME_CLOCK_DRIFT_MAX_PPM 1000
+#endif
+
+/** Delay from CO_TIME_now() in producer to reception timestamp in consumer in
+ * microseconds, added to the received time. Duration of TIME message on the
+ * bus, if producer sends it immediately and consumer timestamps it at the end
+ * of frame. */
+#ifndef CO_TIME_CLOCK_DELAY_US
+#define CO_TIME_CLOCK_DELAY_US 0
+#endif
+
+
+/**
+ * Network time at one instant of the local counter, see CO_TIME_now().
+ */
+typedef struct {
+    /** Network time at local_us, microseconds since January 1, 1984 */
+    uint64_t time_us;
+    /** Local time, microseconds */
+    uint32_t local_us;
+    /** Drift of network time relative to local time, 2^-32 */
+    int32_t drift_q32;
+} CO_TIME_clockParam_t;
+
+
+/**
+ * State of network time, see CO_TIME_getClock().
+ */
+typedef struct {
+    /** Estimated drift of network time relative to local time, ppb */
+    int32_t drift_ppb;
+    /** Clock error of the last received TIME message, microseconds */
+    int32_t error_us;
+    /** Number of clock steps since CO_TIME_init(), wraps around */
+    uint16_t steps;
+    /** True, if clock is set and, if consumer, locked to received TIME */
+    bool_t locked;
+} CO_TIME_clock_t;
+#endif
+
 
 /**
  * TIME producer and consumer object.
@@ -95,6 +187,30 @@ typedef struct {
     bool_t isProducer;
     /** Variable indicates, if new TIME message received from CAN bus */
     volatile void *CANrxNew;
+#if ((CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK) || defined CO_DOXYGEN
+    /** Reception time of timeStamp, microseconds */
+    uint32_t rxTimestamp_us;
+    /** From CO_TIME_initClock() or NULL */
+    uint32_t (*pFunctLocal_us)(void);
+    /** Clock parameters, clkParam[clkSeq & 1] is in use, the other one is
+     * written by CO_TIME_process() */
+    CO_TIME_clockParam_t clkParam[2];
+    /** Incremented after each update of clkParam, readers retry if it
+     * changes */
+    volatile uint32_t clkSeq;
+    /** Reception time of the last TIME message used by the clock */
+    uint32_t clkRx_us;
+    /** Clock error of the last TIME message, microseconds */
+    int32_t clkError_us;
+    /** Number of clock steps, wraps around */
+    uint16_t clkSteps;
+    /** 0 = not set, 1 = set locally, 2 = following received TIME */
+    volatile uint8_t clkState;
+    /** Consecutive TIME messages within #CO_TIME_CLOCK_LOCK_US, saturated */
+    uint8_t clkGood;
+    /** Consecutive TIME messages rejected as outliers */
+    uint8_t clkBad;
+#endif
 #if ((CO_CONFIG_TIME) & CO_CONFIG_TIME_PRODUCER) || defined CO_DOXYGEN
     /** Interval for time producer in milli seconds */
     uint32_t producerInterval_ms;
@@ -163,6 +279,58 @@ void CO_TIME_initCallbackPre(CO_TIME_t *TIME,
 #endif
 
 
+#if ((CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK) || defined CO_DOXYGEN
+/**
+ * Initialize network time.
+ *
+ * Function must be called after CO_TIME_init() and before CO_TIME_set().
+ *
+ * @param TIME This object.
+ * @param pFunctLocal_us Pointer to function, which returns free-running
+ * microsecond counter in the time base of CO_CANrxMsg_readTimestamp(). It is
+ * called from CO_TIME_now() and CO_TIME_process(). If NULL, network time is
+ * disabled and CO_TIME_now() returns time from ms and days.
+ */
+void CO_TIME_initClock(CO_TIME_t *TIME, uint32_t (*pFunctLocal_us)(void));
+
+
+/**
+ * Set network time.
+ *
+ * Called from CO_TIME_set(). Consumer steps the clock to the next received
+ * TIME message.
+ *
+ * @param TIME This object.
+ * @param time_us Current time in microseconds since January 1, 1984.
+ */
+void CO_TIME_clockSet(CO_TIME_t *TIME, uint64_t time_us);
+
+
+/**
+ * Get current network time.
+ *
+ * Function is lock-free and may be called from mainline or from interrupts.
+ *
+ * @param TIME This object.
+ *
+ * @return Network time in microseconds since January 1, 1984. If clock is not
+ * set or not initialized, time from ms, days and residual microseconds.
+ */
+uint64_t CO_TIME_now(CO_TIME_t *TIME);
+
+
+/**
+ * Get state of network time.
+ *
+ * @param TIME This object.
+ * @param [out] clock State of the clock.
+ *
+ * @return True, if clock is locked, same as clock->locked.
+ */
+bool_t CO_TIME_getClock(CO_TIME_t *TIME, CO_TIME_clock_t *clock);
+#endif
+
+
 /**
  * Set current time
  *
@@ -184,6 +352,9 @@ static inline void CO_TIME_set(CO_TIME_t *TIME,
         TIME->days = days;
 #if ((CO_CONFIG_TIME) & CO_CONFIG_TIME_PRODUCER)
         TIME->producerTimer_ms = TIME->producerInterval_ms =producerInterval_ms;
+#endif
+#if ((CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK)
+        CO_TIME_clockSet(TIME, ((uint64_t)days * 86400000U + ms) * 1000U);
 #endif
     }
 }
@@ -137,6 +137,9 @@ extern "C" {
  *   state changes. Callback is configured by
  *   CO_NMT_initCallbackChanged().
  * - CO_CONFIG_NMT_MASTER - Enable simple NMT master
+ * - CO_CONFIG_NMT_CENSUS - Enable @ref CO_NMTcensus, table of NMT states,
+ *   boot-ups and emergencies of all nodes on the network. CAN driver must
+ *   implement CO_CANrxMonitorInit().
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received NMT CAN message.
  *   Callback is configured by CO_NMT_initCallbackPre().
@@ -148,6 +151,7 @@ extern "C" {
 #endif
 #define CO_CONFIG_NMT_CALLBACK_CHANGE 0x01
 #define CO_CONFIG_NMT_MASTER 0x02
+#define CO_CONFIG_NMT_CENSUS 0x04
 
 /**
  * Configuration of @ref CO_HBconsumer
@@ -165,6 +169,13 @@ extern "C" {
  *   CO_HBconsumer_initCallbackRemoteReset() functions.
  * - CO_CONFIG_HB_CONS_QUERY_FUNCT - Enable functions for query HB state or
  *   NMT state of the specific monitored node.
+ * - CO_CONFIG_HB_CONS_DEADLINE - CO_HBconsumer_process() handles only received
+ *   heartbeats and expired nodes, which are ordered by time of timeout. Use it
+ *   for many monitored nodes, up to 127.
+ * - CO_CONFIG_HB_CONS_CALLBACK_RESET - Enable callback on boot-up or heartbeat
+ *   timeout of any monitored node, for stack modules which track remote nodes,
+ *   for example @ref CO_SDOclientCache. It is independent of the application
+ *   callbacks. Callback is configured by CO_HBconsumer_initCallbackReset().
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received heartbeat CAN message.
  *   Callback is configured by CO_HBconsumer_initCallbackPre().
@@ -183,6 +194,8 @@ extern "C" {
 #define CO_CONFIG_HB_CONS_CALLBACK_CHANGE 0x02
 #define CO_CONFIG_HB_CONS_CALLBACK_MULTI 0x04
 #define CO_CONFIG_HB_CONS_QUERY_FUNCT 0x08
+#define CO_CONFIG_HB_CONS_DEADLINE 0x10
+#define CO_CONFIG_HB_CONS_CALLBACK_RESET 0x20
 /** @} */ /* CO_STACK_CONFIG_NMT_HB */
 
 
@@ -205,6 +218,14 @@ extern "C" {
  *   "Pre-defined error field"
  * - CO_CONFIG_EM_CONSUMER - Enable simple emergency consumer with callback.
  * - CO_CONFIG_EM_STATUS_BITS - Access @ref CO_EM_errorStatusBits_t from OD.
+ * - CO_CONFIG_EM_COALESCE - Count occurrences of each error condition and
+ *   suppress repeated emergency messages of the same condition within a
+ *   window, see CO_EM_initCoalesce(). Requires CO_CONFIG_EM_PRODUCER.
+ * - CO_CONFIG_EM_LOG - Enable timestamped emergency log, which survives
+ *   reset, see @ref CO_EMlog. Requires CO_CONFIG_CRC16_ENABLE.
+ * - CO_CONFIG_EM_CONS_TABLE - Aggregate received emergency messages into the
+ *   table of active errors of each node, see @ref CO_EMcons. Requires
+ *   CO_CONFIG_EM_CONSUMER.
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   emergency condition by CO_errorReport() or CO_errorReset() call.
  *   Callback is configured by CO_EM_initCallbackPre().
@@ -220,6 +241,9 @@ extern "C" {
 #define CO_CONFIG_EM_HISTORY 0x08
 #define CO_CONFIG_EM_STATUS_BITS 0x10
 #define CO_CONFIG_EM_CONSUMER 0x20
+#define CO_CONFIG_EM_COALESCE 0x40
+#define CO_CONFIG_EM_LOG 0x80
+#define CO_CONFIG_EM_CONS_TABLE 0x100
 
 /**
  * Maximum number of @ref CO_EM_errorStatusBits_t
@@ -232,6 +256,29 @@ extern "C" {
 #define CO_CONFIG_EM_ERR_STATUS_BITS_COUNT (10*8)
 #endif
 
+/**
+ * Number of records in @ref CO_EMlog, from 1 to 255. Default is 16.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_EM_LOG_SIZE 16
+#endif
+
+/**
+ * Number of nodes in @ref CO_EMcons, which may have emergency entries at the
+ * same time, from 1 to 127. Default is 16.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_EM_CONS_NODES 16
+#endif
+
+/**
+ * Number of active errors kept for each node in @ref CO_EMcons, from 1 to 255.
+ * Default is 4.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_EM_CONS_ACTIVE 4
+#endif
+
 /**
  * Condition for calculating CANopen Error register, "generic" error bit.
  *
@@ -321,6 +368,28 @@ extern "C" {
  * Possible flags, can be ORed:
  * - CO_CONFIG_SDO_SRV_SEGMENTED - Enable SDO server segmented transfer.
  * - CO_CONFIG_SDO_SRV_BLOCK - Enable SDO server block transfer. If set, then
+ *   CO_CONFIG_SDO_SRV_SEGMENTED and CO_CONFIG_CRC16_ENABLE must also be set.
+ *   Block size follows from #CO_CONFIG_SDO_SRV_BUFFER_SIZE.
+ * - CO_CONFIG_SDO_SRV_BUFFER_SHARED - Enable CO_SDOserver_bufferAcquire(), so
+ *   application can use SDO server buffer, while SDO server is idle. If set,
+ *   then CO_CONFIG_SDO_SRV_SEGMENTED must also be set.
+ * - CO_CONFIG_SDO_SRV_STREAM - Enable streaming upload. Segmented and block
+ *   upload of OD variable with original data in memory (no custom read
+ *   function) and longer than 4 bytes copies data directly from the variable
+ *   into CAN messages, without the buffer. Block CRC is calculated during
+ *   the same copy. Block size is then not limited by the buffer size. Strings
+ *   are not streamed, because their length is known only after reading. If
+ *   set, then CO_CONFIG_SDO_SRV_SEGMENTED must also be set.
+ * - CO_CONFIG_SDO_SRV_BUFFER_POOL - SDO servers don't have own buffers, they
+ *   take them from the shared @ref CO_SDOserverPool_t during the transfer, see
+ *   #CO_CONFIG_SDO_SRV_POOL_SIZE. CO_process() then processes idle SDO
+ *   servers with new requests first, so expedited requests are answered
+ *   between segments of long transfers on other servers. If set, then
+ *   CO_CONFIG_SDO_SRV_SEGMENTED must also be set.
+ * - CO_CONFIG_SDO_SRV_STATS - Enable @ref CO_SDOstats for SDO servers:
+ *   transfer counters and histograms of duration, throughput and client
+ *   turnaround time. CANopen.c shares one statistics object between all SDO
+ *   servers and attaches it to OD object 0x2210, if it exists. If set, then
  *   CO_CONFIG_SDO_SRV_SEGMENTED must also be set.
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received SDO CAN message.
@@ -335,18 +404,45 @@ extern "C" {
 #endif
 #define CO_CONFIG_SDO_SRV_SEGMENTED 0x02
 #define CO_CONFIG_SDO_SRV_BLOCK 0x04
+#define CO_CONFIG_SDO_SRV_BUFFER_SHARED 0x08
+#define CO_CONFIG_SDO_SRV_STREAM 0x10
+#define CO_CONFIG_SDO_SRV_BUFFER_POOL 0x20
+#define CO_CONFIG_SDO_SRV_STATS 0x40
 
 /**
  * Size of the internal data buffer for the SDO server.
  *
  * If size is less than size of some variables in Object Dictionary, then data
  * will be transferred to internal buffer in several segments. Minimum size is
- * 8 or 899 (127*7) for block transfer.
+ * 20.
+ *
+ * In block transfer buffer size determines the number of segments per block:
+ * - block download: server uses blksize = (size - 2) / 7, maximum 127, reduced
+ *   by the data still waiting in the buffer,
+ * - block upload: client selects blksize. If OD variable does not fit into the
+ *   buffer, then blksize must not be larger than size / 7, otherwise transfer
+ *   is aborted with CO_SDO_AB_BLOCK_SIZE.
+ *
+ * Size 891 (127 * 7 + 2) gives full 127 segment blocks. Smaller buffer, for
+ * example 450 (64 segments), keeps most of the block transfer throughput on
+ * devices with little RAM.
  */
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_SDO_SRV_BUFFER_SIZE 32
 #endif
 
+/**
+ * Number of buffers in the SDO server buffer pool.
+ *
+ * Used with CO_CONFIG_SDO_SRV_BUFFER_POOL. CANopen.c allocates the smaller of
+ * this and the number of SDO servers, maximum is 32. With less buffers than
+ * SDO servers only so many segmented or block transfers run concurrently, one
+ * buffer is kept for expedited uploads.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_SDO_SRV_POOL_SIZE 2
+#endif
+
 /**
  * Configuration of @ref CO_SDOclient
  *
@@ -359,6 +455,22 @@ extern "C" {
  * - CO_CONFIG_SDO_CLI_LOCAL - Enable local transfer, if Node-ID of the SDO
  *   server is the same as node-ID of the SDO client. (SDO client is the same
  *   device as SDO server.) Transfer data directly without communication on CAN.
+ *   CO_SDOclientLocalDownload() and CO_SDOclientLocalUpload() access the
+ *   Object Dictionary of this node with one function call. SDO client manager
+ *   and SDO client batch use them for requests to this node.
+ * - CO_CONFIG_SDO_CLI_MANAGER - Enable @ref CO_SDOclientMgr, which runs queued
+ *   SDO requests concurrently to different nodes over all SDO clients. It is
+ *   initialized in CANopen.c and processed from CO_process().
+ * - CO_CONFIG_SDO_CLI_BATCH - Enable CO_SDOclientBatch(), which runs a list of
+ *   SDO transfers back-to-back with one SDO client.
+ * - CO_CONFIG_SDO_CLI_CACHE - Enable @ref CO_SDOclientCache, which keeps
+ *   uploaded values of constant and slow-changing objects of remote nodes.
+ *   CO_SDOclientMgr serves uploads from the cache without CAN communication.
+ *   Requires CO_CONFIG_SDO_CLI_MANAGER. Entries of a node are invalidated on
+ *   its boot-up, if CO_CONFIG_HB_CONS_CALLBACK_RESET is set.
+ * - CO_CONFIG_SDO_CLI_STATS - Enable @ref CO_SDOstats for SDO clients, see
+ *   CO_CONFIG_SDO_SRV_STATS. Statistics object is shared between all SDO
+ *   clients and attached to OD object 0x2211, if it exists.
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received SDO CAN message.
  *   Callback is configured by CO_SDOclient_initCallbackPre().
@@ -375,6 +487,10 @@ extern "C" {
 #define CO_CONFIG_SDO_CLI_SEGMENTED 0x02
 #define CO_CONFIG_SDO_CLI_BLOCK 0x04
 #define CO_CONFIG_SDO_CLI_LOCAL 0x08
+#define CO_CONFIG_SDO_CLI_MANAGER 0x10
+#define CO_CONFIG_SDO_CLI_BATCH 0x20
+#define CO_CONFIG_SDO_CLI_CACHE 0x40
+#define CO_CONFIG_SDO_CLI_STATS 0x80
 
 /**
  * Size of the internal data buffer for the SDO client.
@@ -390,6 +506,21 @@ extern "C" {
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_SDO_CLI_BUFFER_SIZE 32
 #endif
+
+/**
+ * Number of entries in the SDO client cache, see @ref CO_SDOclientCache.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_SDO_CLI_CACHE_ENTRIES 16
+#endif
+
+/**
+ * Maximum size of the value, stored in one SDO client cache entry. Longer
+ * values are not cached.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_SDO_CLI_CACHE_DATA_SIZE 24
+#endif
 /** @} */ /* CO_STACK_CONFIG_SDO */
 
 
@@ -404,6 +535,10 @@ extern "C" {
  * Possible flags, can be ORed:
  * - CO_CONFIG_TIME_ENABLE - Enable TIME object and TIME consumer.
  * - CO_CONFIG_TIME_PRODUCER - Enable TIME producer.
+ * - CO_CONFIG_TIME_CLOCK - Enable drift compensated network time, see
+ *   CO_TIME_now(). Received TIME messages are timestamped with
+ *   CO_CANrxMsg_readTimestamp(), local time is read with the function from
+ *   CO_TIME_initClock().
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received TIME CAN message.
  *   Callback is configured by CO_TIME_initCallbackPre().
@@ -415,6 +550,7 @@ extern "C" {
 #endif
 #define CO_CONFIG_TIME_ENABLE 0x01
 #define CO_CONFIG_TIME_PRODUCER 0x02
+#define CO_CONFIG_TIME_CLOCK 0x04
 /** @} */ /* CO_STACK_CONFIG_TIME */
 
 
@@ -429,6 +565,12 @@ extern "C" {
  * Possible flags, can be ORed:
  * - CO_CONFIG_SYNC_ENABLE - Enable SYNC object and SYNC consumer.
  * - CO_CONFIG_SYNC_PRODUCER - Enable SYNC producer.
+ * - CO_CONFIG_SYNC_PRODUCER_HW - Enable SYNC producer timed by hardware timer
+ *   interrupt with jitter statistics, see CO_SYNC_initHwProducer(). If set,
+ *   then CO_CONFIG_SYNC_PRODUCER must also be set.
+ * - CO_CONFIG_SYNC_CLOCK - Enable recovery of SYNC period and phase from
+ *   received SYNC messages, see CO_SYNC_clockPredict(). Driver must provide
+ *   CO_CANrxMsg_readTimestamp().
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received SYNC CAN message.
  *   Callback is configured by CO_SYNC_initCallbackPre().
@@ -441,6 +583,8 @@ extern "C" {
 #endif
 #define CO_CONFIG_SYNC_ENABLE 0x01
 #define CO_CONFIG_SYNC_PRODUCER 0x02
+#define CO_CONFIG_SYNC_PRODUCER_HW 0x04
+#define CO_CONFIG_SYNC_CLOCK 0x08
 
 /**
  * Configuration of @ref CO_PDO
@@ -458,6 +602,16 @@ extern "C" {
  *   flexibility for application program, but consumes some additional memory
  *   and processor resources. If this option is not enabled, then data from OD
  *   variables are fetched directly from memory allocated by Object dictionary.
+ * - CO_CONFIG_TPDO_SYNC_SCHEDULER - Enable transmit offset for synchronous
+ *   TPDOs inside the SYNC period and per-TPDO lateness statistics. If set, then
+ *   CO_CONFIG_PDO_SYNC_ENABLE must also be set. See @ref CO_TPDO_setSyncOffset().
+ * - CO_CONFIG_RPDO_MAILBOX - Enable latest-value mailbox in each RPDO: last
+ *   received data with reception timestamp and sequence counter, readable
+ *   lock-free from any context. See @ref CO_RPDO_mailboxRead().
+ * - CO_CONFIG_PDO_REMAP - Enable atomic remapping of PDOs through single
+ *   write into manufacturer specific DOMAIN object. New mapping is validated
+ *   at once and applied at the next SYNC, without disabling the PDOs. See
+ *   @ref CO_PDOremap_t.
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received RPDO CAN message.
  *   Callback is configured by CO_RPDO_initCallbackPre().
@@ -474,6 +628,9 @@ extern "C" {
 #define CO_CONFIG_TPDO_TIMERS_ENABLE 0x08
 #define CO_CONFIG_PDO_SYNC_ENABLE 0x10
 #define CO_CONFIG_PDO_OD_IO_ACCESS 0x20
+#define CO_CONFIG_TPDO_SYNC_SCHEDULER 0x40
+#define CO_CONFIG_RPDO_MAILBOX 0x80
+#define CO_CONFIG_PDO_REMAP 0x100
 /** @} */ /* CO_STACK_CONFIG_SYNC_PDO */
 
 
@@ -571,6 +728,29 @@ extern "C" {
 /** @} */ /* CO_STACK_CONFIG_SRDO */
 
 
+/**
+ * @defgroup CO_STACK_CONFIG_BOOTUP_MGR Network boot-up manager
+ * Specified in standard CiA 302-2
+ * @{
+ */
+/**
+ * Configuration of @ref CO_bootupMgr
+ *
+ * Possible flags, can be ORed:
+ * - CO_CONFIG_BOOTUP_MGR_ENABLE - Enable boot-up manager, which verifies
+ *   identity and configures slaves over SDO and then starts the network.
+ *   Requires CO_CONFIG_NMT_MASTER, CO_CONFIG_NMT_CENSUS and
+ *   CO_CONFIG_SDO_CLI_MANAGER.
+ * - #CO_CONFIG_FLAG_TIMERNEXT - Enable calculation of timerNext_us variable
+ *   inside CO_bootupMgr_process().
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_BOOTUP_MGR (0)
+#endif
+#define CO_CONFIG_BOOTUP_MGR_ENABLE 0x01
+/** @} */ /* CO_STACK_CONFIG_BOOTUP_MGR */
+
+
 /**
  * @defgroup CO_STACK_CONFIG_LSS LSS master/slave
  * Specified in standard CiA 305
@@ -584,6 +764,11 @@ extern "C" {
  * - CO_CONFIG_LSS_SLAVE_FASTSCAN_DIRECT_RESPOND - Send LSS fastscan respond
  *   directly from CO_LSSslave_receive() function.
  * - CO_CONFIG_LSS_MASTER - Enable LSS master
+ * - CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE - Each step of LSS master fastscan
+ *   ends after a window derived from the measured response time of slaves,
+ *   instead of after the full LSS timeout. See CO_LSSmaster_IdentifyFastscan().
+ * - CO_CONFIG_LSS_MASTER_COMMISSION - Enable @ref CO_LSScommission, automatic
+ *   node-ID assignment of unconfigured slaves by the LSS master.
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received CAN message.
  *   Callback is configured by CO_LSSmaster_initCallbackPre().
@@ -594,6 +779,8 @@ extern "C" {
 #define CO_CONFIG_LSS_SLAVE 0x01
 #define CO_CONFIG_LSS_SLAVE_FASTSCAN_DIRECT_RESPOND 0x02
 #define CO_CONFIG_LSS_MASTER 0x10
+#define CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE 0x20
+#define CO_CONFIG_LSS_MASTER_COMMISSION 0x40
 /** @} */ /* CO_STACK_CONFIG_LSS */
 
 
@@ -679,13 +866,20 @@ extern "C" {
  *
  * Possible flags, can be ORed:
  * - CO_CONFIG_CRC16_ENABLE - Enable CRC16 calculation
- * - CO_CONFIG_CRC16_EXTERNAL - CRC functions are defined externally
+ * - CO_CONFIG_CRC16_EXTERNAL - CRC functions are defined externally, for
+ *   example by the driver, which uses CRC unit of the microcontroller.
+ * - CO_CONFIG_CRC16_SLICE4 - crc16_ccitt() processes four bytes per step with
+ *   slicing-by-4 tables. Needs 1536 bytes of additional constant tables.
+ * - CO_CONFIG_CRC16_SLICE8 - crc16_ccitt() processes eight bytes per step with
+ *   slicing-by-8 tables. Needs 3584 bytes of additional constant tables.
  */
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_CRC16 (0)
 #endif
 #define CO_CONFIG_CRC16_ENABLE 0x01
 #define CO_CONFIG_CRC16_EXTERNAL 0x02
+#define CO_CONFIG_CRC16_SLICE4 0x04
+#define CO_CONFIG_CRC16_SLICE8 0x08
 /** @} */ /* CO_STACK_CONFIG_CRC16 */
 
 
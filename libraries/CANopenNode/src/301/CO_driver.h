@@ -249,6 +249,25 @@ static inline uint8_t *CO_CANrxMsg_readData(void *rxMsg) {
     return NULL;
 }
 
+/**
+ * CANrx_callback() can read reception time of received CAN message
+ *
+ * Required only if @ref CO_CONFIG_RPDO_MAILBOX, @ref CO_CONFIG_SYNC_CLOCK or
+ * @ref CO_CONFIG_TIME_CLOCK is enabled. Time base is
+ * free-running microsecond counter of the target, the same one, which
+ * application later passes to CO_RPDO_mailboxRead(). If CAN controller
+ * provides hardware timestamp, it should be converted to that time base,
+ * otherwise time of message retrieval may be used.
+ *
+ * See also CO_CANrxMsg_readIdent():
+ *
+ * @param rxMsg Pointer to received message
+ * @return reception time in microseconds
+ */
+static inline uint32_t CO_CANrxMsg_readTimestamp(void *rxMsg) {
+    return 0;
+}
+
 /**
  * Configuration object for CAN received message for specific \ref CO_obj
  * "CANopenNode Object".
@@ -344,6 +363,9 @@ typedef struct {
     volatile uint16_t CANtxCount;      /**< Number of messages in transmit
             buffer, which are waiting to be copied to the CAN module */
     uint32_t errOld;                   /**< Previous state of CAN errors */
+    void *rxMonitorObject;             /**< From CO_CANrxMonitorInit() */
+    void (*rxMonitor)(void *object, void *message); /**< From
+            CO_CANrxMonitorInit() or NULL */
 } CO_CANmodule_t;
 
 
@@ -464,6 +486,9 @@ typedef struct {
 #define CO_FLAG_SET(rxNew) { __sync_synchronize(); rxNew = (void *)1L; }
 /** Clear new message flag */
 #define CO_FLAG_CLEAR(rxNew) { __sync_synchronize(); rxNew = NULL; }
+/** Full memory barrier, used by lock-free readers of data written from
+ * CANrx_callback(), for example RPDO mailbox */
+#define CO_MemoryBarrier() __sync_synchronize()
 
 /** @} */
 #endif /* CO_DOXYGEN */
@@ -663,6 +688,27 @@ CO_ReturnError_t CO_CANrxBufferInit(CO_CANmodule_t *CANmodule,
                                                            void *message));
 
 
+/**
+ * Configure CAN receive monitor.
+ *
+ * Receive monitor is called from the CAN receive interrupt for every received
+ * message, before the message is dispatched to the matching receive buffer.
+ * It must be a fast function. It does not consume the message. CAN module
+ * hardware filters must pass all messages, which monitor needs. Only one
+ * monitor is supported, CO_CANmodule_init() clears it.
+ *
+ * Required only if @ref CO_CONFIG_NMT_CENSUS is enabled.
+ *
+ * @param CANmodule This object.
+ * @param object Object, which will be passed to CANrx_callback.
+ * @param CANrx_callback Pointer to function, same as in CO_CANrxBufferInit(),
+ * or NULL to disable the monitor.
+ */
+void CO_CANrxMonitorInit(CO_CANmodule_t *CANmodule,
+                         void *object,
+                         void (*CANrx_callback)(void *object, void *message));
+
+
 /**
  * Configure CAN message transmit buffer.
  *
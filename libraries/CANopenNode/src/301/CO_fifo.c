@@ -85,51 +85,48 @@ size_t CO_fifo_write(CO_fifo_t *fifo,
                      size_t count,
                      uint16_t *crc)
 {
-    size_t i;
-    uint8_t *bufDest;
+    size_t written = 0;
+    size_t space;
 
     if (fifo == NULL || fifo->buf == NULL || buf == NULL) {
         return 0;
     }
 
-    bufDest = &fifo->buf[fifo->writePtr];
-    for (i = count; i > 0; i--) {
-        size_t writePtrNext = fifo->writePtr + 1;
-
-        /* is circular buffer full */
-        if (writePtrNext == fifo->readPtr ||
-            (writePtrNext == fifo->bufSize && fifo->readPtr == 0)) {
-            break;
-        }
-
-        *bufDest = *buf;
+    space = CO_fifo_getSpace(fifo);
+    if (count > space) {
+        count = space;
+    }
 
-#if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_CRC16_CCITT
-        if (crc != NULL) {
-            crc16_ccitt_single(crc, *buf);
+    /* copy at most two spans: up to the end of the buffer and from its start */
+    while (written < count) {
+        size_t span = fifo->bufSize - fifo->writePtr;
+        if (span > count - written) {
+            span = count - written;
         }
-#endif
 
-        /* increment variables */
-        if (writePtrNext == fifo->bufSize) {
+        memcpy(&fifo->buf[fifo->writePtr], &buf[written], span);
+        written += span;
+        fifo->writePtr += span;
+        if (fifo->writePtr == fifo->bufSize) {
             fifo->writePtr = 0;
-            bufDest = &fifo->buf[0];
-        }
-        else {
-            fifo->writePtr++;
-            bufDest++;
         }
-        buf++;
     }
 
-    return count - i;
+#if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_CRC16_CCITT
+    /* source data are contiguous, update crc on all of them at once */
+    if (crc != NULL) {
+        *crc = crc16_ccitt(buf, written, *crc);
+    }
+#endif
+
+    return written;
 }
 
 
 /******************************************************************************/
 size_t CO_fifo_read(CO_fifo_t *fifo, uint8_t *buf, size_t count, bool_t *eof) {
-    size_t i;
-    const uint8_t *bufSrc;
+    size_t read = 0;
+    size_t occupied;
 
     if (eof != NULL) {
         *eof = false;
@@ -138,63 +135,63 @@ size_t CO_fifo_read(CO_fifo_t *fifo, uint8_t *buf, size_t count, bool_t *eof) {
         return 0;
     }
 
-    bufSrc = &fifo->buf[fifo->readPtr];
-    for (i = count; i > 0; ) {
-        const uint8_t c = *bufSrc;
-
-        /* is circular buffer empty */
-        if (fifo->readPtr == fifo->writePtr) {
-            break;
-        }
-
-        *(buf++) = c;
+    occupied = CO_fifo_getOccupied(fifo);
+    if (count > occupied) {
+        count = occupied;
+    }
 
-        /* increment variables */
-        if (++fifo->readPtr == fifo->bufSize) {
-            fifo->readPtr = 0;
-            bufSrc = &fifo->buf[0];
-        }
-        else {
-            bufSrc++;
+    /* copy at most two spans: up to the end of the buffer and from its start */
+    while (read < count) {
+        const uint8_t *bufSrc = &fifo->buf[fifo->readPtr];
+        size_t span = fifo->bufSize - fifo->readPtr;
+        if (span > count - read) {
+            span = count - read;
         }
-        i--;
 
 #if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ASCII_COMMANDS
-        /* is delimiter? */
-        if (eof != NULL && c == DELIM_COMMAND) {
-            *eof = true;
-            break;
+        /* stop after delimiter */
+        if (eof != NULL) {
+            const uint8_t *delim = memchr(bufSrc, DELIM_COMMAND, span);
+            if (delim != NULL) {
+                span = (size_t)(delim - bufSrc) + 1;
+                count = read + span;
+                *eof = true;
+            }
         }
 #endif
+
+        memcpy(&buf[read], bufSrc, span);
+        read += span;
+        fifo->readPtr += span;
+        if (fifo->readPtr == fifo->bufSize) {
+            fifo->readPtr = 0;
+        }
     }
 
-    return count - i;
+    return read;
 }
 
 
 #if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ALT_READ
 /******************************************************************************/
 size_t CO_fifo_altBegin(CO_fifo_t *fifo, size_t offset) {
-    size_t i;
+    size_t occupied;
 
     if (fifo == NULL) {
         return 0;
     }
 
-    fifo->altReadPtr = fifo->readPtr;
-    for (i = offset; i > 0; i--) {
-        /* is circular buffer empty */
-        if (fifo->altReadPtr == fifo->writePtr) {
-            break;
-        }
+    occupied = CO_fifo_getOccupied(fifo);
+    if (offset > occupied) {
+        offset = occupied;
+    }
 
-        /* increment variable */
-        if (++fifo->altReadPtr == fifo->bufSize) {
-            fifo->altReadPtr = 0;
-        }
+    fifo->altReadPtr = fifo->readPtr + offset;
+    if (fifo->altReadPtr >= fifo->bufSize) {
+        fifo->altReadPtr -= fifo->bufSize;
     }
 
-    return offset - i;
+    return offset;
 }
 
 void CO_fifo_altFinish(CO_fifo_t *fifo, uint16_t *crc) {
@@ -207,49 +204,47 @@ void CO_fifo_altFinish(CO_fifo_t *fifo, uint16_t *crc) {
         fifo->readPtr = fifo->altReadPtr;
     }
     else {
-        const uint8_t *bufSrc = &fifo->buf[fifo->readPtr];
-        while (fifo->readPtr != fifo->altReadPtr) {
 #if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_CRC16_CCITT
-            crc16_ccitt_single(crc, *bufSrc);
-#endif
-            /* increment variable */
-            if (++fifo->readPtr == fifo->bufSize) {
-                fifo->readPtr = 0;
-                bufSrc = &fifo->buf[0];
-            }
-            else {
-                bufSrc++;
-            }
+        /* update crc on consumed data, which are in one or two spans */
+        if (fifo->altReadPtr < fifo->readPtr) {
+            *crc = crc16_ccitt(&fifo->buf[fifo->readPtr],
+                               fifo->bufSize - fifo->readPtr, *crc);
+            fifo->readPtr = 0;
         }
+        *crc = crc16_ccitt(&fifo->buf[fifo->readPtr],
+                           fifo->altReadPtr - fifo->readPtr, *crc);
+#endif
+        fifo->readPtr = fifo->altReadPtr;
     }
 }
 
 size_t CO_fifo_altRead(CO_fifo_t *fifo, uint8_t *buf, size_t count) {
-    size_t i;
-    const uint8_t *bufSrc;
+    size_t read = 0;
+    size_t available = fifo->writePtr - fifo->altReadPtr;
 
-    bufSrc = &fifo->buf[fifo->altReadPtr];
-    for (i = count; i > 0; i--) {
-        const uint8_t c = *bufSrc;
+    if (fifo->writePtr < fifo->altReadPtr) {
+        available = fifo->bufSize - fifo->altReadPtr + fifo->writePtr;
+    }
+    if (count > available) {
+        count = available;
+    }
 
-        /* is there no more data */
-        if (fifo->altReadPtr == fifo->writePtr) {
-            break;
+    /* copy at most two spans: up to the end of the buffer and from its start */
+    while (read < count) {
+        size_t span = fifo->bufSize - fifo->altReadPtr;
+        if (span > count - read) {
+            span = count - read;
         }
 
-        *(buf++) = c;
-
-        /* increment variables */
-        if (++fifo->altReadPtr == fifo->bufSize) {
+        memcpy(&buf[read], &fifo->buf[fifo->altReadPtr], span);
+        read += span;
+        fifo->altReadPtr += span;
+        if (fifo->altReadPtr == fifo->bufSize) {
             fifo->altReadPtr = 0;
-            bufSrc = &fifo->buf[0];
-        }
-        else {
-            bufSrc++;
         }
     }
 
-    return count - i;
+    return read;
 }
 #endif /* (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ALT_READ */
 
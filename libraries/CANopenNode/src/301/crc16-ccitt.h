@@ -50,6 +50,15 @@ extern "C" {
  * Equation:
  *
  * `x^16 + x^12 + x^5 + 1`
+ *
+ * crc16_ccitt() is the block function, used by all stack objects. By default
+ * it processes one byte per step with a 256 entry table. With
+ * CO_CONFIG_CRC16_SLICE4 or CO_CONFIG_CRC16_SLICE8 it processes four or eight
+ * bytes per step with additional tables, which is faster on longer blocks, for
+ * example SDO block transfer. Calculation may also be replaced by own
+ * implementation of both functions with CO_CONFIG_CRC16_EXTERNAL. Callers
+ * should pass whole blocks to crc16_ccitt() rather than single bytes to
+ * crc16_ccitt_single().
  */
 
 
@@ -0,0 +1,468 @@
+/*
+ * CANopen network boot-up manager.
+ *
+ * @file        CO_bootupMgr.c
+ * @ingroup     CO_bootupMgr
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "302/CO_bootupMgr.h"
+
+#if (CO_CONFIG_BOOTUP_MGR) & CO_CONFIG_BOOTUP_MGR_ENABLE
+
+#if !((CO_CONFIG_NMT) & CO_CONFIG_NMT_MASTER)
+  #error CO_CONFIG_NMT_MASTER must be enabled.
+#endif
+#if !((CO_CONFIG_NMT) & CO_CONFIG_NMT_CENSUS)
+  #error CO_CONFIG_NMT_CENSUS must be enabled.
+#endif
+#if !((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE) \
+    || !((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_MANAGER)
+  #error CO_CONFIG_SDO_CLI_ENABLE and CO_CONFIG_SDO_CLI_MANAGER must be enabled.
+#endif
+
+/* size of the concise DCF entry header: index, sub-index, data size */
+#define CO_BOOTUP_MGR_DCF_ENTRY_HEADER 7U
+
+
+/* Call the callback, if configured. */
+static void CO_bootupMgr_signal(CO_bootupMgr_t *mgr,
+                                uint8_t nodeId,
+                                CO_bootupMgr_state_t state,
+                                CO_bootupMgr_error_t error)
+{
+    if (mgr->pFunctSignal != NULL) {
+        mgr->pFunctSignal(mgr->functSignalObject, nodeId, state, error);
+    }
+}
+
+
+/* Set slave into CO_BOOTUP_MGR_ERROR state. */
+static void CO_bootupMgr_fail(CO_bootupMgr_t *mgr,
+                              CO_bootupMgrNode_t *node,
+                              CO_bootupMgr_error_t error)
+{
+    node->state = CO_BOOTUP_MGR_ERROR;
+    node->error = error;
+    CO_bootupMgr_signal(mgr, node->slave->nodeId, node->state, error);
+}
+
+
+/*
+ * Send NMT command, if NMT transmit buffer is free. Command, which waits in
+ * the full transmit buffer, is sent later by the CAN driver.
+ *
+ * @return true, if command was sent or is waiting in the transmit buffer.
+ */
+static bool_t CO_bootupMgr_sendNMT(CO_bootupMgr_t *mgr,
+                                   CO_NMT_command_t command,
+                                   uint8_t nodeId)
+{
+    if (mgr->NMT->NMT_TXbuff->bufferFull) {
+        return false;
+    }
+    return CO_NMT_sendCommand(mgr->NMT, command, nodeId) == CO_ERROR_NO
+           || mgr->NMT->NMT_TXbuff->bufferFull;
+}
+
+
+/* Queue SDO request of the node to the SDO client manager. */
+static void CO_bootupMgr_request(CO_bootupMgr_t *mgr,
+                                 CO_bootupMgrNode_t *node,
+                                 bool_t upload,
+                                 uint16_t index,
+                                 uint8_t subIndex,
+                                 uint8_t *data,
+                                 size_t dataSize)
+{
+    node->req.upload = upload;
+    node->req.index = index;
+    node->req.subIndex = subIndex;
+    node->req.data = data;
+    node->req.dataSize = dataSize;
+
+    if (CO_SDOclientMgr_request(mgr->SDOmgr, &node->req) != CO_ERROR_NO) {
+        CO_bootupMgr_fail(mgr, node, node->state == CO_BOOTUP_MGR_IDENTITY
+                                     ? CO_BOOTUP_MGR_ERR_IDENTITY
+                                     : CO_BOOTUP_MGR_ERR_CONFIG);
+    }
+}
+
+
+/*
+ * Download the next concise DCF entry or set the slave ready, if there are no
+ * more entries.
+ */
+static void CO_bootupMgr_nextDcfEntry(CO_bootupMgr_t *mgr,
+                                      CO_bootupMgrNode_t *node)
+{
+    const CO_bootupMgrSlave_t *slave = node->slave;
+
+    if (node->dcfEntries == 0) {
+        node->state = CO_BOOTUP_MGR_READY;
+        CO_bootupMgr_signal(mgr, slave->nodeId, node->state,
+                            CO_BOOTUP_MGR_ERR_NONE);
+        return;
+    }
+
+    size_t left = slave->dcfSize - node->dcfOffset;
+    const uint8_t *entry = &slave->dcf[node->dcfOffset];
+    uint32_t size;
+
+    if (left < CO_BOOTUP_MGR_DCF_ENTRY_HEADER) {
+        CO_bootupMgr_fail(mgr, node, CO_BOOTUP_MGR_ERR_DCF);
+        return;
+    }
+    size = CO_getUint32(&entry[3]);
+    if (size == 0 || size > left - CO_BOOTUP_MGR_DCF_ENTRY_HEADER) {
+        CO_bootupMgr_fail(mgr, node, CO_BOOTUP_MGR_ERR_DCF);
+        return;
+    }
+
+    node->dcfEntries--;
+    node->dcfOffset += CO_BOOTUP_MGR_DCF_ENTRY_HEADER + size;
+    /* download does not write into the data */
+    CO_bootupMgr_request(mgr, node, false, CO_getUint16(&entry[0]), entry[2],
+                         (uint8_t *)&entry[CO_BOOTUP_MGR_DCF_ENTRY_HEADER],
+                         size);
+}
+
+
+/* Start downloading the concise DCF. */
+static void CO_bootupMgr_configure(CO_bootupMgr_t *mgr,
+                                   CO_bootupMgrNode_t *node)
+{
+    const CO_bootupMgrSlave_t *slave = node->slave;
+
+    node->state = CO_BOOTUP_MGR_CONFIG;
+    node->dcfOffset = 4;
+    node->dcfEntries = 0;
+
+    if (slave->dcf != NULL && slave->dcfSize > 0) {
+        if (slave->dcfSize < 4) {
+            CO_bootupMgr_fail(mgr, node, CO_BOOTUP_MGR_ERR_DCF);
+            return;
+        }
+        node->dcfEntries = CO_getUint32(&slave->dcf[0]);
+    }
+    CO_bootupMgr_nextDcfEntry(mgr, node);
+}
+
+
+/*
+ * Handle the uploaded identity value.
+ *
+ * @return false, if value is different from the expected one.
+ */
+static bool_t CO_bootupMgr_identityValue(CO_bootupMgrNode_t *node,
+                                         uint8_t subIndex,
+                                         bool_t valid,
+                                         uint32_t value)
+{
+    const CO_NMTcensusIdentity_t *expected = &node->slave->identity;
+    uint32_t *read;
+    uint32_t exp;
+
+    switch (subIndex) {
+        case 1: read = &node->identity.vendorId;
+                exp = expected->vendorId; break;
+        case 2: read = &node->identity.productCode;
+                exp = expected->productCode; break;
+        case 3: read = &node->identity.revisionNumber;
+                exp = expected->revisionNumber; break;
+        default: read = &node->identity.serialNumber;
+                exp = expected->serialNumber; break;
+    }
+
+    *read = valid ? value : 0;
+    return exp == 0 || (valid && value == exp);
+}
+
+
+/*
+ * SDO client manager callback, called after transfer of the slave ends.
+ */
+static void CO_bootupMgr_SDOdone(void *object, CO_SDOclientMgrReq_t *req) {
+    CO_bootupMgr_t *mgr = (CO_bootupMgr_t *)object;
+    /* request is the first member of the node */
+    CO_bootupMgrNode_t *node = (CO_bootupMgrNode_t *)req;
+
+    if (node->state == CO_BOOTUP_MGR_IDENTITY) {
+        bool_t valid = req->abortCode == CO_SDO_AB_NONE
+                       && req->sizeTransferred == sizeof(node->value);
+
+        if (!CO_bootupMgr_identityValue(node, req->subIndex, valid,
+                                        CO_getUint32(node->value))
+        ) {
+            CO_bootupMgr_fail(mgr, node, CO_BOOTUP_MGR_ERR_IDENTITY);
+        }
+        else if (req->subIndex < 4) {
+            CO_bootupMgr_request(mgr, node, true, 0x1018,
+                                 (uint8_t)(req->subIndex + 1),
+                                 node->value, sizeof(node->value));
+        }
+        else {
+            CO_NMTcensus_setIdentity(mgr->census, node->slave->nodeId,
+                                     &node->identity);
+            CO_bootupMgr_configure(mgr, node);
+        }
+    }
+    else if (node->state == CO_BOOTUP_MGR_CONFIG) {
+        if (req->abortCode != CO_SDO_AB_NONE) {
+            CO_bootupMgr_fail(mgr, node, CO_BOOTUP_MGR_ERR_CONFIG);
+        }
+        else {
+            CO_bootupMgr_nextDcfEntry(mgr, node);
+        }
+    }
+}
+
+
+/*
+ * Start boot-up of the slave: cancel its SDO transfer, if any, and upload its
+ * identity.
+ */
+static void CO_bootupMgr_bootSlave(CO_bootupMgr_t *mgr,
+                                   CO_bootupMgrNode_t *node,
+                                   uint16_t bootupCount)
+{
+    uint8_t nodeId = node->slave->nodeId;
+
+    CO_SDOclientMgr_cancel(mgr->SDOmgr, &node->req);
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE
+    if (mgr->SDOmgr->cache != NULL) {
+        CO_SDOclientCache_invalidateNode(mgr->SDOmgr->cache, nodeId);
+    }
+#endif
+
+    node->bootupCount = bootupCount;
+    node->state = CO_BOOTUP_MGR_IDENTITY;
+    node->error = CO_BOOTUP_MGR_ERR_NONE;
+    node->identity.vendorId = 0;
+    node->identity.productCode = 0;
+    node->identity.revisionNumber = 0;
+    node->identity.serialNumber = 0;
+    CO_NMTcensus_setIdentity(mgr->census, nodeId, NULL);
+
+    CO_bootupMgr_request(mgr, node, true, 0x1018, 1,
+                         node->value, sizeof(node->value));
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_bootupMgr_init(CO_bootupMgr_t *mgr,
+                                   CO_NMT_t *NMT,
+                                   CO_NMTcensus_t *census,
+                                   CO_SDOclientMgr_t *SDOmgr)
+{
+    if (mgr == NULL || NMT == NULL || census == NULL || SDOmgr == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    mgr->NMT = NMT;
+    mgr->census = census;
+    mgr->SDOmgr = SDOmgr;
+    mgr->nodes = NULL;
+    mgr->nodesCount = 0;
+    mgr->networkStarted = false;
+    mgr->bootTime_us = 0;
+    mgr->timer_us = 0;
+    mgr->pFunctSignal = NULL;
+    mgr->functSignalObject = NULL;
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_bootupMgr_initCallback(CO_bootupMgr_t *mgr,
+                               void *object,
+                               void (*pFunctSignal)(void *object,
+                                                    uint8_t nodeId,
+                                                    CO_bootupMgr_state_t state,
+                                                    CO_bootupMgr_error_t error))
+{
+    if (mgr != NULL) {
+        mgr->functSignalObject = object;
+        mgr->pFunctSignal = pFunctSignal;
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_bootupMgr_start(CO_bootupMgr_t *mgr,
+                                    const CO_bootupMgrSlave_t slaves[],
+                                    CO_bootupMgrNode_t nodes[],
+                                    uint8_t count,
+                                    uint16_t bootTime_ms)
+{
+    if (mgr == NULL || slaves == NULL || nodes == NULL || count == 0) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        if (slaves[i].nodeId < 1 || slaves[i].nodeId > 127) {
+            return CO_ERROR_ILLEGAL_ARGUMENT;
+        }
+    }
+
+    /* cancel transfers of the previous boot-up */
+    if (mgr->nodes != NULL) {
+        for (uint8_t i = 0; i < mgr->nodesCount; i++) {
+            CO_SDOclientMgr_cancel(mgr->SDOmgr, &mgr->nodes[i].req);
+        }
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        CO_bootupMgrNode_t *node = &nodes[i];
+
+        node->req.nodeId = slaves[i].nodeId;
+        node->req.timeout_ms = 0;
+        node->req.pFunctSignal = CO_bootupMgr_SDOdone;
+        node->req.functSignalObject = (void *)mgr;
+        node->req.state = CO_SDOclientMgr_REQ_IDLE;
+        node->slave = &slaves[i];
+        node->bootupCount =
+            mgr->census->nodes[slaves[i].nodeId - 1].bootupCount;
+        node->resetSent = false;
+        node->state = CO_BOOTUP_MGR_WAIT;
+        node->error = CO_BOOTUP_MGR_ERR_NONE;
+    }
+
+    mgr->nodes = nodes;
+    mgr->nodesCount = count;
+    mgr->networkStarted = false;
+    mgr->bootTime_us = (uint32_t)bootTime_ms * 1000;
+    mgr->timer_us = 0;
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_bootupMgr_process(CO_bootupMgr_t *mgr,
+                          uint32_t timeDifference_us,
+                          uint32_t *timerNext_us)
+{
+    (void)timerNext_us; /* may be unused */
+
+    if (mgr->nodes == NULL) {
+        return;
+    }
+
+    bool_t bootTimeRuns = false;
+    if (mgr->bootTime_us != 0 && mgr->timer_us < mgr->bootTime_us) {
+        uint32_t diff = mgr->bootTime_us - mgr->timer_us;
+        if (timeDifference_us < diff) {
+            mgr->timer_us += timeDifference_us;
+            bootTimeRuns = true;
+#if (CO_CONFIG_BOOTUP_MGR) & CO_CONFIG_FLAG_TIMERNEXT
+            diff -= timeDifference_us;
+            if (timerNext_us != NULL && *timerNext_us > diff) {
+                *timerNext_us = diff;
+            }
+#endif
+        }
+        else {
+            mgr->timer_us = mgr->bootTime_us;
+        }
+    }
+
+    bool_t allReady = true;
+    bool_t canStart = true;
+
+    for (uint8_t i = 0; i < mgr->nodesCount; i++) {
+        CO_bootupMgrNode_t *node = &mgr->nodes[i];
+        uint8_t nodeId = node->slave->nodeId;
+        uint16_t bootupCount = mgr->census->nodes[nodeId - 1].bootupCount;
+        CO_NMT_internalState_t NMTstate =
+            CO_NMTcensus_getNMTstate(mgr->census, nodeId);
+
+        if (bootupCount != node->bootupCount) {
+            /* boot-up message, configure the slave (again) */
+            CO_bootupMgr_bootSlave(mgr, node, bootupCount);
+        }
+        else if (node->state == CO_BOOTUP_MGR_WAIT
+                 || node->error == CO_BOOTUP_MGR_ERR_TIMEOUT
+        ) {
+            if (NMTstate == CO_NMT_PRE_OPERATIONAL) {
+                CO_bootupMgr_bootSlave(mgr, node, bootupCount);
+            }
+            else if ((NMTstate == CO_NMT_OPERATIONAL
+                      || NMTstate == CO_NMT_STOPPED)
+                     && !node->resetSent
+            ) {
+                /* slave was running already, wait for its boot-up */
+                node->resetSent = CO_bootupMgr_sendNMT(mgr,
+                                        CO_NMT_RESET_COMMUNICATION, nodeId);
+            }
+            else if (node->state == CO_BOOTUP_MGR_WAIT
+                     && mgr->bootTime_us != 0 && !bootTimeRuns
+            ) {
+                CO_bootupMgr_fail(mgr, node, CO_BOOTUP_MGR_ERR_TIMEOUT);
+            }
+        }
+        else if (node->state == CO_BOOTUP_MGR_READY && mgr->networkStarted) {
+            /* slave configured after the network start */
+            if (CO_bootupMgr_sendNMT(mgr, CO_NMT_ENTER_OPERATIONAL, nodeId)) {
+                node->state = CO_BOOTUP_MGR_STARTED;
+                CO_bootupMgr_signal(mgr, nodeId, node->state,
+                                    CO_BOOTUP_MGR_ERR_NONE);
+            }
+        }
+
+        if (node->state != CO_BOOTUP_MGR_READY) {
+            allReady = false;
+        }
+        if (node->slave->mandatory) {
+            if (node->state != CO_BOOTUP_MGR_READY) {
+                canStart = false;
+            }
+        }
+        else if (node->state == CO_BOOTUP_MGR_IDENTITY
+                 || node->state == CO_BOOTUP_MGR_CONFIG
+                 || (node->state == CO_BOOTUP_MGR_WAIT
+                     && mgr->bootTime_us != 0)
+        ) {
+            canStart = false;
+        }
+    }
+
+    if (mgr->networkStarted || !canStart) {
+        return;
+    }
+
+    if (allReady) {
+        /* one command for the whole network */
+        if (!CO_bootupMgr_sendNMT(mgr, CO_NMT_ENTER_OPERATIONAL, 0)) {
+            return;
+        }
+        for (uint8_t i = 0; i < mgr->nodesCount; i++) {
+            mgr->nodes[i].state = CO_BOOTUP_MGR_STARTED;
+        }
+    }
+    /* otherwise configured slaves are started one by one from now on */
+    mgr->networkStarted = true;
+    CO_bootupMgr_signal(mgr, 0, CO_BOOTUP_MGR_STARTED, CO_BOOTUP_MGR_ERR_NONE);
+#if (CO_CONFIG_BOOTUP_MGR) & CO_CONFIG_FLAG_TIMERNEXT
+    if (!allReady && timerNext_us != NULL) {
+        *timerNext_us = 0;
+    }
+#endif
+}
+
+#endif /* (CO_CONFIG_BOOTUP_MGR) & CO_CONFIG_BOOTUP_MGR_ENABLE */
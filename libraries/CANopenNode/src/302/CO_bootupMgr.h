@@ -0,0 +1,306 @@
+/**
+ * CANopen network boot-up manager.
+ *
+ * @file        CO_bootupMgr.h
+ * @ingroup     CO_bootupMgr
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_BOOTUP_MGR_H
+#define CO_BOOTUP_MGR_H
+
+#include "301/CO_driver.h"
+#include "301/CO_NMT_Heartbeat.h"
+#include "301/CO_NMTcensus.h"
+#include "301/CO_SDOclientMgr.h"
+
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_BOOTUP_MGR
+#define CO_CONFIG_BOOTUP_MGR (0)
+#endif
+
+#if ((CO_CONFIG_BOOTUP_MGR) & CO_CONFIG_BOOTUP_MGR_ENABLE) || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_bootupMgr Boot-up manager
+ * Network boot-up and configuration of slaves by the NMT master.
+ *
+ * @ingroup CO_CANopen_302
+ * @{
+ * Boot-up manager brings the network into NMT operational in the way of
+ * CiA 302-2: it waits for each slave from the table, verifies its identity,
+ * configures it over SDO and starts the network with one NMT command.
+ *
+ * Slave table (CO_bootupMgrSlave_t) is the application's stored
+ * configuration, it may be constant. It takes the place of objects 0x1F81
+ * (slave assignment), 0x1F84..0x1F88 (expected identity) and 0x1F22 (concise
+ * DCF). Concise DCF is a byte array: UNSIGNED32 number of entries, then for
+ * each entry UNSIGNED16 index, UNSIGNED8 sub-index, UNSIGNED32 data size and
+ * data, all little-endian, as written by the usual DCF tools.
+ *
+ * For each slave:
+ * - Boot-up is detected by @ref CO_NMTcensus, from boot-up message or from
+ *   heartbeat in pre-operational. Slave, which is already operational or
+ *   stopped, gets NMT reset communication first, so its configuration starts
+ *   from the defaults.
+ * - Identity, object 0x1018 sub-indexes 1..4, is uploaded and compared with
+ *   the expected values, which are not zero. It is then stored in the census
+ *   with CO_NMTcensus_setIdentity().
+ * - Concise DCF entries are downloaded one after another.
+ *
+ * SDO transfers run over @ref CO_SDOclientMgr, so slaves are configured
+ * concurrently on all its channels and the time to operational is given by
+ * the slowest slave, not by the sum of all of them. Values of the slave in
+ * @ref CO_SDOclientCache are invalidated on its boot-up.
+ *
+ * Network is started, when all mandatory slaves are configured and no
+ * optional slave is still being configured or waited for during boot time.
+ * If all slaves are configured, one NMT start command is sent to all nodes
+ * (also to this node). Otherwise configured slaves are started one by one.
+ * Slave which boots later, for example after reset or power loss, is
+ * configured again and started alone.
+ *
+ * Slaves should start in NMT pre-operational (without
+ * CO_NMT_STARTUP_TO_OPERATIONAL) and should send heartbeat, otherwise slave,
+ * which is already running before start of the manager, is only seen on its
+ * next boot-up.
+ *
+ * If enabled, boot-up manager is initialized in CANopen.c file and processed
+ * from CO_process(). Application starts it with CO_bootupMgr_start():
+ * @code{.c}
+// heartbeat producer 100 ms, TPDO1 event timer 10 ms
+static const uint8_t dcf_io[] = {
+    0x02, 0x00, 0x00, 0x00,
+    0x17, 0x10, 0x00, 0x02, 0x00, 0x00, 0x00, 0x64, 0x00,
+    0x00, 0x18, 0x05, 0x02, 0x00, 0x00, 0x00, 0x0A, 0x00
+};
+static const CO_bootupMgrSlave_t slaves[] = {
+    {.nodeId = 2, .mandatory = true, .identity = {.vendorId = 0x1234},
+     .dcf = dcf_io, .dcfSize = sizeof(dcf_io)},
+    {.nodeId = 3, .mandatory = false, .dcf = dcf_io, .dcfSize = sizeof(dcf_io)}
+};
+static CO_bootupMgrNode_t nodes[2];
+
+CO_bootupMgr_start(CO->bootupMgr, slaves, nodes, 2, 5000);
+ * @endcode
+ */
+
+
+/**
+ * State of the slave in the boot-up manager.
+ */
+typedef enum {
+    /** Waiting for boot-up or heartbeat of the slave */
+    CO_BOOTUP_MGR_WAIT = 0,
+    /** Uploading identity, object 0x1018 */
+    CO_BOOTUP_MGR_IDENTITY = 1,
+    /** Downloading concise DCF */
+    CO_BOOTUP_MGR_CONFIG = 2,
+    /** Configured, waiting for the network start */
+    CO_BOOTUP_MGR_READY = 3,
+    /** NMT start command was sent */
+    CO_BOOTUP_MGR_STARTED = 4,
+    /** Boot-up failed, see @ref CO_bootupMgr_error_t. Slave is tried again
+     * after its next boot-up. */
+    CO_BOOTUP_MGR_ERROR = 5
+} CO_bootupMgr_state_t;
+
+
+/**
+ * Reason of CO_BOOTUP_MGR_ERROR state.
+ */
+typedef enum {
+    /** No error */
+    CO_BOOTUP_MGR_ERR_NONE = 0,
+    /** Slave was not seen within the boot time */
+    CO_BOOTUP_MGR_ERR_TIMEOUT = 1,
+    /** Identity could not be read or is different from the expected one */
+    CO_BOOTUP_MGR_ERR_IDENTITY = 2,
+    /** Concise DCF is malformed */
+    CO_BOOTUP_MGR_ERR_DCF = 3,
+    /** Download of the concise DCF entry was aborted, see abortCode, index and
+     * subIndex in CO_bootupMgrNode_t::req */
+    CO_BOOTUP_MGR_ERR_CONFIG = 4
+} CO_bootupMgr_error_t;
+
+
+/**
+ * Slave in the boot-up manager, stored configuration from the application.
+ */
+typedef struct {
+    /** Node-ID of the slave, 1..127 */
+    uint8_t nodeId;
+    /** If true, network is not started without this slave */
+    bool_t mandatory;
+    /** Expected identity, members which are zero are not verified */
+    CO_NMTcensusIdentity_t identity;
+    /** Concise DCF or NULL */
+    const uint8_t *dcf;
+    /** Size of dcf in bytes */
+    size_t dcfSize;
+} CO_bootupMgrSlave_t;
+
+
+/**
+ * Boot-up state of one slave, owned by the application and used by the
+ * boot-up manager.
+ */
+typedef struct {
+    /** SDO request for this slave. It is the first member, so the node is
+     * found from the request in the SDO callback. */
+    CO_SDOclientMgrReq_t req;
+    /** Slave from CO_bootupMgr_start() */
+    const CO_bootupMgrSlave_t *slave;
+    /** Identity read from the slave */
+    CO_NMTcensusIdentity_t identity;
+    /** Buffer for the uploaded identity value */
+    uint8_t value[4];
+    /** Offset of the next concise DCF entry */
+    size_t dcfOffset;
+    /** Number of concise DCF entries left */
+    uint32_t dcfEntries;
+    /** CO_NMTcensusNode_t::bootupCount at the start of configuration */
+    uint16_t bootupCount;
+    /** True, if NMT reset communication was sent to the running slave */
+    bool_t resetSent;
+    /** State of the slave */
+    CO_bootupMgr_state_t state;
+    /** Reason of CO_BOOTUP_MGR_ERROR */
+    CO_bootupMgr_error_t error;
+} CO_bootupMgrNode_t;
+
+
+/**
+ * Boot-up manager object.
+ */
+typedef struct {
+    /** From CO_bootupMgr_init() */
+    CO_NMT_t *NMT;
+    /** From CO_bootupMgr_init() */
+    CO_NMTcensus_t *census;
+    /** From CO_bootupMgr_init() */
+    CO_SDOclientMgr_t *SDOmgr;
+    /** From CO_bootupMgr_start() or NULL */
+    CO_bootupMgrNode_t *nodes;
+    /** From CO_bootupMgr_start() */
+    uint8_t nodesCount;
+    /** True, after network start command was sent */
+    bool_t networkStarted;
+    /** Boot time from CO_bootupMgr_start(), 0 for no limit */
+    uint32_t bootTime_us;
+    /** Time since CO_bootupMgr_start(), stops at bootTime_us */
+    uint32_t timer_us;
+    /** From CO_bootupMgr_initCallback() or NULL */
+    void (*pFunctSignal)(void *object,
+                         uint8_t nodeId,
+                         CO_bootupMgr_state_t state,
+                         CO_bootupMgr_error_t error);
+    /** From CO_bootupMgr_initCallback() or NULL */
+    void *functSignalObject;
+} CO_bootupMgr_t;
+
+
+/**
+ * Initialize boot-up manager object.
+ *
+ * @param mgr This object will be initialized.
+ * @param NMT NMT object, used for NMT master commands.
+ * @param census NMT census, used for boot-up detection.
+ * @param SDOmgr SDO client manager, used for identity and configuration.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_bootupMgr_init(CO_bootupMgr_t *mgr,
+                                   CO_NMT_t *NMT,
+                                   CO_NMTcensus_t *census,
+                                   CO_SDOclientMgr_t *SDOmgr);
+
+
+/**
+ * Initialize boot-up manager callback function.
+ *
+ * Function is called from CO_bootupMgr_process() or from the SDO client
+ * manager, when slave becomes CO_BOOTUP_MGR_READY, CO_BOOTUP_MGR_STARTED or
+ * CO_BOOTUP_MGR_ERROR. When network is started, function is called with
+ * nodeId 0 and state CO_BOOTUP_MGR_STARTED.
+ *
+ * @param mgr This object.
+ * @param object Pointer to object, which will be passed to pFunctSignal().
+ * Can be NULL.
+ * @param pFunctSignal Pointer to the callback function. Not called if NULL.
+ */
+void CO_bootupMgr_initCallback(CO_bootupMgr_t *mgr,
+                               void *object,
+                               void (*pFunctSignal)(void *object,
+                                                    uint8_t nodeId,
+                                                    CO_bootupMgr_state_t state,
+                                                    CO_bootupMgr_error_t error));
+
+
+/**
+ * Start boot-up of the network.
+ *
+ * If boot-up is already in progress, its SDO transfers are cancelled and it
+ * starts again.
+ *
+ * @param mgr This object.
+ * @param slaves Slave table, must stay valid.
+ * @param [out] nodes Array of boot-up states, one for each slave, must stay
+ * valid.
+ * @param count Number of slaves.
+ * @param bootTime_ms Time to wait for slaves. Mandatory slave, which is not
+ * seen within this time, blocks the network start. 0 for no limit, then
+ * optional slaves, which are not seen, do not block the network start.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_bootupMgr_start(CO_bootupMgr_t *mgr,
+                                    const CO_bootupMgrSlave_t slaves[],
+                                    CO_bootupMgrNode_t nodes[],
+                                    uint8_t count,
+                                    uint16_t bootTime_ms);
+
+
+/**
+ * Process boot-up manager.
+ *
+ * Function is called cyclically from CO_process(), before the SDO client
+ * manager. It detects boot-up of slaves, sends NMT commands and starts the
+ * network. SDO transfers continue from the SDO client manager callbacks.
+ *
+ * @param mgr This object.
+ * @param timeDifference_us Time difference from previous function call.
+ * @param [out] timerNext_us info to OS - see CO_process().
+ */
+void CO_bootupMgr_process(CO_bootupMgr_t *mgr,
+                          uint32_t timeDifference_us,
+                          uint32_t *timerNext_us);
+
+/** @} */ /* CO_bootupMgr */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_BOOTUP_MGR) & CO_CONFIG_BOOTUP_MGR_ENABLE */
+
+#endif /* CO_BOOTUP_MGR_H */
@@ -0,0 +1,295 @@
+/*
+ * CANopen LSS commissioning, automatic node-ID assignment by the LSS master.
+ *
+ * @file        CO_LSScommission.c
+ * @ingroup     CO_LSScommission
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "305/CO_LSScommission.h"
+
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_COMMISSION
+
+#include <string.h>
+
+#if !((CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER)
+  #error CO_CONFIG_LSS_MASTER must be enabled.
+#endif
+
+/* Internal state, CO_LSScommission_t::state */
+typedef enum {
+    CO_LSS_COMMISSION_STATE_IDLE = 0,
+    CO_LSS_COMMISSION_STATE_SCAN,
+    CO_LSS_COMMISSION_STATE_NODE_ID,
+    CO_LSS_COMMISSION_STATE_STORE
+} CO_LSScommission_state_t;
+
+
+/* Call the callback, if configured. */
+static void CO_LSScommission_signal(CO_LSScommission_t *comm,
+                                    uint8_t nodeId,
+                                    const CO_LSS_address_t *lssAddress,
+                                    CO_LSScommission_result_t result)
+{
+    if (comm->pFunctSignal != NULL) {
+        comm->pFunctSignal(comm->functSignalObject, nodeId, lssAddress, result);
+    }
+}
+
+
+/* Start fastscan for slaves of the current policy entry. */
+static void CO_LSScommission_scan(CO_LSScommission_t *comm) {
+    const CO_LSScommissionPolicy_t *entry = &comm->policy[comm->policyIdx];
+    CO_LSSmaster_fastscan_t *fs = &comm->fastscan;
+
+    memset(fs, 0, sizeof(*fs));
+    fs->scan[CO_LSS_FASTSCAN_VENDOR_ID] = CO_LSSmaster_FS_MATCH;
+    fs->match.identity.vendorID = entry->vendorID;
+    fs->scan[CO_LSS_FASTSCAN_PRODUCT] = CO_LSSmaster_FS_MATCH;
+    fs->match.identity.productCode = entry->productCode;
+    fs->scan[CO_LSS_FASTSCAN_REV] = CO_LSSmaster_FS_SKIP;
+    fs->scan[CO_LSS_FASTSCAN_SERIAL] = CO_LSSmaster_FS_SCAN;
+
+    comm->state = CO_LSS_COMMISSION_STATE_SCAN;
+}
+
+
+/* Continue with the next policy entry or finish. */
+static void CO_LSScommission_nextEntry(CO_LSScommission_t *comm) {
+    comm->errors = 0;
+    comm->policyIdx++;
+    if (comm->policyIdx < comm->policyCount) {
+        CO_LSScommission_scan(comm);
+    }
+    else {
+        comm->state = CO_LSS_COMMISSION_STATE_IDLE;
+        CO_LSScommission_signal(comm, 0, NULL, CO_LSS_COMMISSION_FINISHED);
+    }
+}
+
+
+/* Deselect the slave and scan again, until retries of the entry run out. */
+static void CO_LSScommission_retry(CO_LSScommission_t *comm) {
+    CO_LSSmaster_switchStateDeselect(comm->LSSmaster);
+    comm->errors++;
+    if (comm->errors < CO_LSS_COMMISSION_RETRIES) {
+        CO_LSScommission_scan(comm);
+    }
+    else {
+        CO_LSScommission_nextEntry(comm);
+    }
+}
+
+
+/*
+ * Find free node-ID in the range of the current policy entry.
+ *
+ * @return node-ID or 0, if none is free.
+ */
+static uint8_t CO_LSScommission_freeNodeId(CO_LSScommission_t *comm) {
+    const CO_LSScommissionPolicy_t *entry = &comm->policy[comm->policyIdx];
+
+    for (uint8_t id = entry->firstNodeId; id <= entry->lastNodeId; id++) {
+        if (id == comm->ownNodeId
+            || (comm->assigned[id >> 5] & (1UL << (id & 0x1FU))) != 0
+        ) {
+            continue;
+        }
+#if (CO_CONFIG_NMT) & CO_CONFIG_NMT_CENSUS
+        if (comm->census != NULL) {
+            CO_NMTcensusNode_t node;
+            if (CO_NMTcensus_read(comm->census, id, &node)) {
+                continue;
+            }
+        }
+#endif
+        return id;
+    }
+    return 0;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_LSScommission_init(CO_LSScommission_t *comm,
+                                       CO_LSSmaster_t *LSSmaster,
+#if (CO_CONFIG_NMT) & CO_CONFIG_NMT_CENSUS
+                                       CO_NMTcensus_t *census,
+#endif
+                                       uint8_t ownNodeId)
+{
+    if (comm == NULL || LSSmaster == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(comm, 0, sizeof(*comm));
+    comm->LSSmaster = LSSmaster;
+#if (CO_CONFIG_NMT) & CO_CONFIG_NMT_CENSUS
+    comm->census = census;
+#endif
+    comm->ownNodeId = ownNodeId;
+    comm->state = CO_LSS_COMMISSION_STATE_IDLE;
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_LSScommission_initCallback(CO_LSScommission_t *comm,
+                                   void *object,
+                                   void (*pFunctSignal)(void *object,
+                                        uint8_t nodeId,
+                                        const CO_LSS_address_t *lssAddress,
+                                        CO_LSScommission_result_t result))
+{
+    if (comm != NULL) {
+        comm->functSignalObject = object;
+        comm->pFunctSignal = pFunctSignal;
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_LSScommission_start(CO_LSScommission_t *comm,
+                                        const CO_LSScommissionPolicy_t policy[],
+                                        uint8_t count)
+{
+    if (comm == NULL || policy == NULL || count == 0) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        if (policy[i].firstNodeId < 1
+            || policy[i].lastNodeId > 127
+            || policy[i].lastNodeId < policy[i].firstNodeId
+        ) {
+            return CO_ERROR_ILLEGAL_ARGUMENT;
+        }
+    }
+
+    /* LSS master into a clean state, also if a request is in progress */
+    CO_LSSmaster_switchStateDeselect(comm->LSSmaster);
+
+    comm->policy = policy;
+    comm->policyCount = count;
+    comm->policyIdx = 0;
+    comm->errors = 0;
+    comm->nodeId = 0;
+    comm->assignedCount = 0;
+    memset(comm->assigned, 0, sizeof(comm->assigned));
+    comm->time_us = 0;
+    CO_LSScommission_scan(comm);
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+bool_t CO_LSScommission_isRunning(CO_LSScommission_t *comm) {
+    return comm != NULL && comm->state != CO_LSS_COMMISSION_STATE_IDLE;
+}
+
+
+/******************************************************************************/
+void CO_LSScommission_process(CO_LSScommission_t *comm,
+                              uint32_t timeDifference_us,
+                              uint32_t *timerNext_us)
+{
+    (void)timerNext_us; /* may be unused */
+    CO_LSSmaster_return_t ret;
+
+    if (comm->state == CO_LSS_COMMISSION_STATE_IDLE) {
+        return;
+    }
+    comm->time_us += timeDifference_us;
+
+    switch (comm->state) {
+        case CO_LSS_COMMISSION_STATE_SCAN:
+            ret = CO_LSSmaster_IdentifyFastscan(comm->LSSmaster, timeDifference_us,
+                                                &comm->fastscan);
+            if (ret == CO_LSSmaster_WAIT_SLAVE) {
+                break;
+            }
+            if (ret == CO_LSSmaster_SCAN_FINISHED) {
+                /* one slave is selected */
+                comm->nodeId = CO_LSScommission_freeNodeId(comm);
+                if (comm->nodeId != 0) {
+                    comm->state = CO_LSS_COMMISSION_STATE_NODE_ID;
+                }
+                else {
+                    CO_LSSmaster_switchStateDeselect(comm->LSSmaster);
+                    CO_LSScommission_signal(comm, 0, &comm->fastscan.found,
+                                            CO_LSS_COMMISSION_NO_FREE_ID);
+                    CO_LSScommission_nextEntry(comm);
+                }
+            }
+            else if (ret == CO_LSSmaster_SCAN_NOACK) {
+                /* no more unconfigured slaves of this entry */
+                CO_LSScommission_nextEntry(comm);
+            }
+            else {
+                CO_LSScommission_retry(comm);
+            }
+            break;
+
+        case CO_LSS_COMMISSION_STATE_NODE_ID:
+            ret = CO_LSSmaster_configureNodeId(comm->LSSmaster, timeDifference_us,
+                                               comm->nodeId);
+            if (ret == CO_LSSmaster_WAIT_SLAVE) {
+                break;
+            }
+            if (ret == CO_LSSmaster_OK) {
+                comm->state = CO_LSS_COMMISSION_STATE_STORE;
+            }
+            else {
+                CO_LSScommission_signal(comm, comm->nodeId, &comm->fastscan.found,
+                                        CO_LSS_COMMISSION_REJECTED);
+                CO_LSScommission_retry(comm);
+            }
+            break;
+
+        case CO_LSS_COMMISSION_STATE_STORE:
+            ret = CO_LSSmaster_configureStore(comm->LSSmaster, timeDifference_us);
+            if (ret == CO_LSSmaster_WAIT_SLAVE) {
+                break;
+            }
+            /* Node-ID is pending in the slave also if store failed. Slave
+             * activates it after deselect with reset communication. */
+            comm->assigned[comm->nodeId >> 5] |= 1UL << (comm->nodeId & 0x1FU);
+            comm->assignedCount++;
+            comm->errors = 0;
+            CO_LSSmaster_switchStateDeselect(comm->LSSmaster);
+            CO_LSScommission_signal(comm, comm->nodeId, &comm->fastscan.found,
+                                    (ret == CO_LSSmaster_OK)
+                                    ? CO_LSS_COMMISSION_OK
+                                    : CO_LSS_COMMISSION_NOT_STORED);
+            CO_LSScommission_scan(comm);
+            break;
+
+        default:
+            break;
+    }
+
+#if (CO_CONFIG_LSS) & CO_CONFIG_FLAG_TIMERNEXT
+    if (comm->state != CO_LSS_COMMISSION_STATE_IDLE && timerNext_us != NULL
+        && *timerNext_us > CO_LSS_COMMISSION_INTERVAL_US
+    ) {
+        *timerNext_us = CO_LSS_COMMISSION_INTERVAL_US;
+    }
+#endif
+}
+
+#endif /* (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_COMMISSION */
@@ -0,0 +1,260 @@
+/**
+ * CANopen LSS commissioning, automatic node-ID assignment by the LSS master.
+ *
+ * @file        CO_LSScommission.h
+ * @ingroup     CO_LSScommission
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_LSS_COMMISSION_H
+#define CO_LSS_COMMISSION_H
+
+#include "305/CO_LSSmaster.h"
+#include "301/CO_NMTcensus.h"
+
+#if ((CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_COMMISSION) || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_LSScommission LSS commissioning
+ * Automatic node-ID assignment of unconfigured slaves by the LSS master.
+ *
+ * @ingroup CO_CANopen_305
+ * @{
+ * Commissioning finds slaves without node-ID (#CO_LSS_NODE_ID_ASSIGNMENT)
+ * with @ref CO_LSSmaster fastscan, gives each of them a free node-ID from the
+ * policy table and asks it to store the node-ID. Slave then resets its
+ * communication and boots with the new node-ID.
+ *
+ * Policy table (CO_LSScommissionPolicy_t) is processed entry by entry. Vendor-ID
+ * and product code of the entry are only verified by fastscan, revision number
+ * is skipped and only the serial number is scanned, so one slave is found in
+ * 36 fastscan cycles instead of 133. Slaves of the entry are assigned until
+ * fastscan finds no more of them. Slaves, which match no entry, stay
+ * unconfigured. Serial number must be unique among slaves of the same product.
+ *
+ * Node-ID is free, if it is not this node's node-ID, was not assigned since
+ * CO_LSScommission_start() and no heartbeat or emergency of it was seen by
+ * @ref CO_NMTcensus (if enabled). Start commissioning after the heartbeats of
+ * configured slaves had time to arrive.
+ *
+ * Slave, which does not support storing, keeps the node-ID only until its
+ * next reset (CO_LSS_COMMISSION_NOT_STORED). Slave, which rejects the node-ID
+ * or does not respond, is tried #CO_LSS_COMMISSION_RETRIES times, then the
+ * next policy entry is processed.
+ *
+ * Fastscan is much faster with #CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE, then
+ * the duration of a cycle is given by the response time of slaves and by the
+ * interval of CO_process() calls, not by the LSS timeout.
+ *
+ * LSS master must not be used by the application or by the gateway while
+ * commissioning is running.
+ *
+ * If enabled, LSS commissioning is initialized in CANopen.c file and processed
+ * from CO_process(). Application starts it with CO_LSScommission_start():
+ * @code{.c}
+static const CO_LSScommissionPolicy_t policy[] = {
+    {.vendorID = 0x1234, .productCode = 0x10, .firstNodeId = 0x10, .lastNodeId = 0x1F},
+    {.vendorID = 0x1234, .productCode = 0x20, .firstNodeId = 0x20, .lastNodeId = 0x2F}
+};
+
+CO_LSScommission_start(CO->LSScommission, policy, 2);
+ * @endcode
+ */
+
+/** Number of failed attempts with one policy entry, before it is abandoned. */
+#ifndef CO_LSS_COMMISSION_RETRIES
+#define CO_LSS_COMMISSION_RETRIES 3U
+#endif
+
+/** Interval of CO_LSScommission_process() calls requested with timerNext_us,
+ * while commissioning is running, in microseconds. */
+#ifndef CO_LSS_COMMISSION_INTERVAL_US
+#define CO_LSS_COMMISSION_INTERVAL_US 1000U
+#endif
+
+
+/**
+ * Result of commissioning of one slave, see CO_LSScommission_initCallback().
+ */
+typedef enum {
+    /** Node-ID assigned and stored by the slave */
+    CO_LSS_COMMISSION_OK = 0,
+    /** Node-ID assigned, slave did not store it */
+    CO_LSS_COMMISSION_NOT_STORED = 1,
+    /** No free node-ID in the range of the policy entry, slave stays
+     * unconfigured */
+    CO_LSS_COMMISSION_NO_FREE_ID = 2,
+    /** Slave rejected the node-ID or did not respond */
+    CO_LSS_COMMISSION_REJECTED = 3,
+    /** All policy entries are processed, commissioning is finished */
+    CO_LSS_COMMISSION_FINISHED = 4
+} CO_LSScommission_result_t;
+
+
+/**
+ * Entry of the policy table, stored configuration from the application.
+ */
+typedef struct {
+    /** Vendor-ID of the slaves, object 0x1018,1 */
+    uint32_t vendorID;
+    /** Product code of the slaves, object 0x1018,2 */
+    uint32_t productCode;
+    /** First node-ID of the range, 1..127 */
+    uint8_t firstNodeId;
+    /** Last node-ID of the range, firstNodeId..127 */
+    uint8_t lastNodeId;
+} CO_LSScommissionPolicy_t;
+
+
+/**
+ * LSS commissioning object.
+ */
+typedef struct {
+    /** From CO_LSScommission_init() */
+    CO_LSSmaster_t *LSSmaster;
+#if ((CO_CONFIG_NMT) & CO_CONFIG_NMT_CENSUS) || defined CO_DOXYGEN
+    /** From CO_LSScommission_init() or NULL */
+    CO_NMTcensus_t *census;
+#endif
+    /** From CO_LSScommission_init() */
+    uint8_t ownNodeId;
+    /** From CO_LSScommission_start() or NULL */
+    const CO_LSScommissionPolicy_t *policy;
+    /** From CO_LSScommission_start() */
+    uint8_t policyCount;
+    /** Index of the processed policy entry */
+    uint8_t policyIdx;
+    /** Internal state */
+    uint8_t state;
+    /** Failed attempts with the processed policy entry */
+    uint8_t errors;
+    /** Node-ID, which is being assigned */
+    uint8_t nodeId;
+    /** Number of slaves, which got node-ID since CO_LSScommission_start() */
+    uint8_t assignedCount;
+    /** Node-IDs assigned since CO_LSScommission_start(), bit (nodeId & 0x1F)
+     * of assigned[nodeId >> 5] */
+    uint32_t assigned[4];
+    /** Time since CO_LSScommission_start(), stops when finished */
+    uint32_t time_us;
+    /** Fastscan parameters and the LSS address of the found slave */
+    CO_LSSmaster_fastscan_t fastscan;
+    /** From CO_LSScommission_initCallback() or NULL */
+    void (*pFunctSignal)(void *object,
+                         uint8_t nodeId,
+                         const CO_LSS_address_t *lssAddress,
+                         CO_LSScommission_result_t result);
+    /** From CO_LSScommission_initCallback() or NULL */
+    void *functSignalObject;
+} CO_LSScommission_t;
+
+
+/**
+ * Initialize LSS commissioning object.
+ *
+ * @param comm This object will be initialized.
+ * @param LSSmaster LSS master object.
+ * @param census NMT census, used to skip node-IDs of running slaves. May be
+ * NULL. Only with #CO_CONFIG_NMT_CENSUS.
+ * @param ownNodeId Node-ID of this node, never assigned.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_LSScommission_init(CO_LSScommission_t *comm,
+                                       CO_LSSmaster_t *LSSmaster,
+#if ((CO_CONFIG_NMT) & CO_CONFIG_NMT_CENSUS) || defined CO_DOXYGEN
+                                       CO_NMTcensus_t *census,
+#endif
+                                       uint8_t ownNodeId);
+
+
+/**
+ * Initialize LSS commissioning callback function.
+ *
+ * Function is called from CO_LSScommission_process() for each slave found by
+ * fastscan, with the assigned node-ID (0, if none), its LSS address and the
+ * result. When commissioning is finished, function is called with nodeId 0,
+ * lssAddress NULL and result CO_LSS_COMMISSION_FINISHED.
+ *
+ * @param comm This object.
+ * @param object Pointer to object, which will be passed to pFunctSignal().
+ * Can be NULL.
+ * @param pFunctSignal Pointer to the callback function. Not called if NULL.
+ */
+void CO_LSScommission_initCallback(CO_LSScommission_t *comm,
+                                   void *object,
+                                   void (*pFunctSignal)(void *object,
+                                        uint8_t nodeId,
+                                        const CO_LSS_address_t *lssAddress,
+                                        CO_LSScommission_result_t result));
+
+
+/**
+ * Start commissioning.
+ *
+ * If commissioning is already running, it starts again from the first policy
+ * entry.
+ *
+ * @param comm This object.
+ * @param policy Policy table, must stay valid.
+ * @param count Number of policy entries.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_LSScommission_start(CO_LSScommission_t *comm,
+                                        const CO_LSScommissionPolicy_t policy[],
+                                        uint8_t count);
+
+
+/**
+ * Check if commissioning is running.
+ *
+ * @param comm This object.
+ *
+ * @return true, if started and not finished yet.
+ */
+bool_t CO_LSScommission_isRunning(CO_LSScommission_t *comm);
+
+
+/**
+ * Process LSS commissioning.
+ *
+ * Function is called cyclically from CO_process(). It runs the LSS master
+ * requests one after another.
+ *
+ * @param comm This object.
+ * @param timeDifference_us Time difference from previous function call.
+ * @param [out] timerNext_us info to OS - see CO_process().
+ */
+void CO_LSScommission_process(CO_LSScommission_t *comm,
+                              uint32_t timeDifference_us,
+                              uint32_t *timerNext_us);
+
+/** @} */ /* CO_LSScommission */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_COMMISSION */
+
+#endif /* CO_LSS_COMMISSION_H */
@@ -145,6 +145,10 @@ CO_ReturnError_t CO_LSSmaster_init(
     LSSmaster->state = CO_LSSmaster_STATE_WAITING;
     LSSmaster->command = CO_LSSmaster_COMMAND_WAITING;
     LSSmaster->timeoutTimer = 0;
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE
+    LSSmaster->fsLatency_us = 0;
+    LSSmaster->fsRxSeen = false;
+#endif
     CO_FLAG_CLEAR(LSSmaster->CANrxNew);
     memset(LSSmaster->CANrxData, 0, sizeof(LSSmaster->CANrxData));
 #if (CO_CONFIG_LSS) & CO_CONFIG_FLAG_CALLBACK_PRE
@@ -754,6 +758,9 @@ static void CO_LSSmaster_FsSendMsg(
         uint8_t                 lssNext)
 {
     LSSmaster->timeoutTimer = 0;
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE
+    LSSmaster->fsRxSeen = false;
+#endif
 
     CO_FLAG_CLEAR(LSSmaster->CANrxNew);
     LSSmaster->TXbuff->data[0] = CO_LSS_IDENT_FASTSCAN;
@@ -765,6 +772,62 @@ static void CO_LSSmaster_FsSendMsg(
     CO_CANsend(LSSmaster->CANdevTx, LSSmaster->TXbuff);
 }
 
+/*
+ * Helper function - check end of fastscan cycle
+ *
+ * Fastscan cycle is not ended by the response, as more slaves may respond.
+ * With adaptive fastscan it ends after the window derived from the response
+ * time of slaves, otherwise after the LSS timeout. If missing response ends
+ * the fastscan (ackRequired), cycle without response still waits for the LSS
+ * timeout.
+ */
+static CO_LSSmaster_return_t CO_LSSmaster_FsCheckTimeout(
+        CO_LSSmaster_t         *LSSmaster,
+        uint32_t                timeDifference_us,
+        bool_t                  ackRequired)
+{
+    (void)ackRequired; /* may be unused */
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE
+    CO_LSSmaster_return_t ret = CO_LSSmaster_WAIT_SLAVE;
+    uint32_t window_us = LSSmaster->timeout_us;
+
+    LSSmaster->timeoutTimer += timeDifference_us;
+
+    /* measure response time of the first response in this cycle */
+    if (!LSSmaster->fsRxSeen && CO_FLAG_READ(LSSmaster->CANrxNew)) {
+        uint32_t latency_us = LSSmaster->timeoutTimer;
+
+        if (latency_us == 0) {
+            latency_us = 1;
+        }
+        LSSmaster->fsRxSeen = true;
+        if (latency_us > LSSmaster->fsLatency_us) {
+            LSSmaster->fsLatency_us = latency_us;
+        }
+        else {
+            LSSmaster->fsLatency_us -= (LSSmaster->fsLatency_us - latency_us) / 8;
+        }
+    }
+
+    if (LSSmaster->fsLatency_us > 0 && (LSSmaster->fsRxSeen || !ackRequired)) {
+        uint32_t adaptive_us = LSSmaster->fsLatency_us * CO_LSSmaster_FS_WINDOW_FACTOR
+                               + CO_LSSmaster_FS_WINDOW_MARGIN_US;
+        if (adaptive_us < window_us) {
+            window_us = adaptive_us;
+        }
+    }
+
+    if (LSSmaster->timeoutTimer >= window_us) {
+        LSSmaster->timeoutTimer = 0;
+        ret = CO_LSSmaster_TIMEOUT;
+    }
+
+    return ret;
+#else
+    return CO_LSSmaster_check_timeout(LSSmaster, timeDifference_us);
+#endif
+}
+
 /*
  * Helper function - wait for confirmation
  */
@@ -774,7 +837,7 @@ static CO_LSSmaster_return_t CO_LSSmaster_FsCheckWait(
 {
     CO_LSSmaster_return_t ret;
 
-    ret = CO_LSSmaster_check_timeout(LSSmaster, timeDifference_us);
+    ret = CO_LSSmaster_FsCheckTimeout(LSSmaster, timeDifference_us, true);
     if (ret == CO_LSSmaster_TIMEOUT) {
         ret = CO_LSSmaster_SCAN_NOACK;
 
@@ -847,7 +910,7 @@ static CO_LSSmaster_return_t CO_LSSmaster_FsScanWait(
             return CO_LSSmaster_SCAN_FAILED;
     }
 
-    ret = CO_LSSmaster_check_timeout(LSSmaster, timeDifference_us);
+    ret = CO_LSSmaster_FsCheckTimeout(LSSmaster, timeDifference_us, false);
     if (ret == CO_LSSmaster_TIMEOUT) {
 
         ret = CO_LSSmaster_WAIT_SLAVE;
@@ -932,7 +995,7 @@ static CO_LSSmaster_return_t CO_LSSmaster_FsVerifyWait(
         return CO_LSSmaster_SCAN_FAILED;
     }
 
-    ret = CO_LSSmaster_check_timeout(LSSmaster, timeDifference_us);
+    ret = CO_LSSmaster_FsCheckTimeout(LSSmaster, timeDifference_us, true);
     if (ret == CO_LSSmaster_TIMEOUT) {
 
         *idNumberRet = 0;
@@ -1106,6 +1169,24 @@ CO_LSSmaster_return_t CO_LSSmaster_IdentifyFastscan(
             break;
     }
 
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE
+    /* Scanned value, which is not verified, means that some response was
+     * probably late, same as wrong response. Node may still be there, so it is
+     * reported as scan error. Widen the window for the next scan. */
+    if (ret == CO_LSSmaster_SCAN_NOACK
+        && LSSmaster->fsState == CO_LSSmaster_FS_STATE_VERIFY
+        && fastscan->scan[LSSmaster->fsLssSub] == CO_LSSmaster_FS_SCAN
+    ) {
+        ret = CO_LSSmaster_SCAN_FAILED;
+    }
+    if (ret == CO_LSSmaster_SCAN_FAILED) {
+        LSSmaster->fsLatency_us *= 2;
+        if (LSSmaster->fsLatency_us > LSSmaster->timeout_us) {
+            LSSmaster->fsLatency_us = LSSmaster->timeout_us;
+        }
+    }
+#endif
+
     if (ret != CO_LSSmaster_WAIT_SLAVE) {
         /* finished */
         LSSmaster->command = CO_LSSmaster_COMMAND_WAITING;
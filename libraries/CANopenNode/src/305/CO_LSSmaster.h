@@ -114,6 +114,10 @@ typedef struct{
     uint8_t          fsLssSub;         /**< Current state of node state machine */
     uint8_t          fsBitChecked;     /**< Current scan bit position */
     uint32_t         fsIdNumber;       /**< Current scan result */
+#if ((CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE) || defined CO_DOXYGEN
+    uint32_t         fsLatency_us;     /**< Estimated response time of slaves to fastscan in us, 0 if not known yet */
+    bool_t           fsRxSeen;         /**< Response time of the current fastscan step is recorded */
+#endif
 
     volatile void   *CANrxNew;         /**< Indication if new LSS message is received from CAN bus. It needs to be cleared when received message is completely processed. */
     uint8_t          CANrxData[8];     /**< 8 data bytes of the received message */
@@ -135,6 +139,22 @@ typedef struct{
 #endif
 
 
+#if ((CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE) || defined CO_DOXYGEN
+/**
+ * Adaptive fastscan: step window is this factor times the estimated response
+ * time of slaves, plus #CO_LSSmaster_FS_WINDOW_MARGIN_US.
+ */
+#ifndef CO_LSSmaster_FS_WINDOW_FACTOR
+#define CO_LSSmaster_FS_WINDOW_FACTOR 2U
+#endif
+
+/** Adaptive fastscan: margin added to the step window in us. */
+#ifndef CO_LSSmaster_FS_WINDOW_MARGIN_US
+#define CO_LSSmaster_FS_WINDOW_MARGIN_US 2000U
+#endif
+#endif
+
+
 /**
  * Initialize LSS object.
  *
@@ -449,6 +469,19 @@ fastscan.scan[CO_LSS_FASTSCAN_SERIAL] = CO_LSSmaster_FS_SCAN;
  * @remark When doing partial scans, it is in the responsibility of the user
  * that the LSS address is unique.
  *
+ * Each scan cycle waits for the LSS timeout, because a "negative ack" is a
+ * missing response. With #CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE the response
+ * time of slaves is measured on each acknowledged cycle (the first response
+ * raises the estimate, faster responses lower it by 1/8). Once it is known, a
+ * cycle ends after #CO_LSSmaster_FS_WINDOW_FACTOR times the estimate plus
+ * #CO_LSSmaster_FS_WINDOW_MARGIN_US, but not later than the LSS timeout.
+ * Check and verification cycles without response still wait for the LSS
+ * timeout, as they end the scan. If a scanned value then fails its
+ * verification, a response was probably late: #CO_LSSmaster_SCAN_FAILED is
+ * returned instead of #CO_LSSmaster_SCAN_NOACK and the estimate is doubled,
+ * also on any other scan error. Estimate is kept between the scans and reset
+ * by CO_LSSmaster_init().
+ *
  * This function needs that no node is selected when starting the scan process.
  *
  * Function must be called cyclically until it returns != #CO_LSSmaster_WAIT_SLAVE.
@@ -136,6 +136,21 @@ void CO_GTWA_initRead(CO_GTWA_t* gtwa,
 }
 
 
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS) \
+    || ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS)
+/******************************************************************************/
+void CO_GTWA_initSDOstats(CO_GTWA_t* gtwa,
+                          CO_SDOstats_t *SDOserverStats,
+                          CO_SDOstats_t *SDOclientStats)
+{
+    if (gtwa != NULL) {
+        gtwa->SDOserverStats = SDOserverStats;
+        gtwa->SDOclientStats = SDOclientStats;
+    }
+}
+#endif
+
+
 /******************************************************************************/
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG
 void CO_GTWA_log_print(CO_GTWA_t* gtwa, const char *message) {
@@ -173,7 +188,11 @@ static const char CO_GTWA_helpString[] =
 "\n" \
 "help [datatype|lss]                      # Print this or datatype or lss help.\n" \
 "led                                      # Print status LEDs of this device.\n" \
-"log                                      # Print message log.\n" \
+"log                                      # Print message log.\n"
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS) \
+    || ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS)
+"sdo_stats srv|cli [reset]                # Print or reset SDO statistics.\n"
+#endif
 "\n" \
 "Response:\n" \
 "\"[\"<sequence>\"]\" OK | <value> |\n" \
@@ -1513,6 +1532,62 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
         }
 #endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_PRINT_LEDS */
 
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS) \
+    || ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS)
+        /* Print or reset SDO statistics */
+        else if (strcmp(tok, "sdo_stats") == 0) {
+            CO_SDOstats_t *stats;
+
+            if (closed != 0) {
+                err = true;
+                break;
+            }
+
+            /* get 'srv' or 'cli' */
+            closed = -1;
+            CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok), &closed, &err);
+            if (err) break;
+
+            convertToLower(tok, sizeof(tok));
+            if (strcmp(tok, "srv") == 0) {
+                stats = gtwa->SDOserverStats;
+            }
+            else if (strcmp(tok, "cli") == 0) {
+                stats = gtwa->SDOclientStats;
+            }
+            else {
+                err = true;
+                break;
+            }
+            if (stats == NULL) {
+                respErrorCode = CO_GTWA_respErrorReqNotSupported;
+                err = true;
+                break;
+            }
+
+            if (closed == 0) {
+                /* get 'reset' */
+                closed = 1;
+                CO_fifo_readToken(&gtwa->commFifo,tok,sizeof(tok),&closed,&err);
+                if (err) break;
+
+                convertToLower(tok, sizeof(tok));
+                if (strcmp(tok, "reset") != 0) {
+                    err = true;
+                    break;
+                }
+                CO_SDOstats_reset(stats);
+                responseWithOK(gtwa);
+            }
+            else {
+                /* continue with state machine */
+                gtwa->statsPrint = stats;
+                gtwa->statsPrintSubIndex = CO_SDO_STATS_SUB_TRANSFERS;
+                gtwa->state = CO_GTWA_ST_SDO_STATS;
+            }
+        }
+#endif
+
         /* Unrecognized command */
         else {
             respErrorCode = CO_GTWA_respErrorReqNotSupported;
@@ -2053,6 +2128,42 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
     }
 #endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_PRINT_LEDS */
 
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS) \
+    || ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS)
+    /* print SDO statistics in one line (in multiple segments if necessary) */
+    case CO_GTWA_ST_SDO_STATS: {
+        do {
+            size_t len = 0;
+
+            if (gtwa->statsPrintSubIndex == CO_SDO_STATS_SUB_TRANSFERS) {
+                len = (size_t)snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
+                                       "[%"PRId32"]", gtwa->sequence);
+            }
+            /* value has up to 11 characters, keep space for "\r\n" */
+            while (gtwa->statsPrintSubIndex <= CO_SDO_STATS_SUB_LAST
+                   && (len + 14) <= CO_GTWA_RESP_BUF_SIZE
+            ) {
+                uint32_t value = CO_SDOstats_get(gtwa->statsPrint,
+                                                 gtwa->statsPrintSubIndex);
+                len += (size_t)snprintf(&gtwa->respBuf[len],
+                                        CO_GTWA_RESP_BUF_SIZE - len,
+                                        " %"PRIu32, value);
+                gtwa->statsPrintSubIndex++;
+            }
+            if (gtwa->statsPrintSubIndex > CO_SDO_STATS_SUB_LAST) {
+                len += (size_t)snprintf(&gtwa->respBuf[len],
+                                        CO_GTWA_RESP_BUF_SIZE - len, "\r\n");
+                gtwa->state = CO_GTWA_ST_IDLE;
+            }
+
+            gtwa->respBufCount = len;
+            respBufTransfer(gtwa);
+        } while (gtwa->state == CO_GTWA_ST_SDO_STATS
+                 && gtwa->respHold == false);
+        break;
+    }
+#endif
+
     /* illegal state */
     default: {
         respErrorCode = CO_GTWA_respErrorInternalState;
@@ -92,6 +92,7 @@ Command strings start with '"["<sequence>"]"' followed by:
 help [datatype|lss]                      # Print this or datatype or lss help.
 led                                      # Print status LED diodes.
 log                                      # Print message log.
+sdo_stats srv|cli [reset]                # Print or reset SDO statistics.
 
 Response:
 "["<sequence>"]" OK | <value> |
@@ -259,7 +260,9 @@ typedef enum {
     /** print 'help' text */
     CO_GTWA_ST_HELP = 0x81U,
     /** print 'status' of the node */
-    CO_GTWA_ST_LED = 0x82U
+    CO_GTWA_ST_LED = 0x82U,
+    /** print 'sdo_stats' */
+    CO_GTWA_ST_SDO_STATS = 0x83U
 } CO_GTWA_state_t;
 
 
@@ -399,6 +402,16 @@ typedef struct {
     CO_LEDs_t *LEDs;
     uint8_t ledStringPreviousIndex;
 #endif
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS) \
+    || ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS) || defined CO_DOXYGEN
+    /** SDO server statistics from CO_GTWA_initSDOstats() or NULL */
+    CO_SDOstats_t *SDOserverStats;
+    /** SDO client statistics from CO_GTWA_initSDOstats() or NULL */
+    CO_SDOstats_t *SDOclientStats;
+    /** Statistics object and next sub-index, when printing 'sdo_stats' */
+    const CO_SDOstats_t *statsPrint;
+    uint8_t statsPrintSubIndex;
+#endif
 } CO_GTWA_t;
 
 
@@ -456,6 +469,25 @@ void CO_GTWA_initRead(CO_GTWA_t* gtwa,
                       void *readCallbackObject);
 
 
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS) \
+    || ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS) || defined CO_DOXYGEN
+/**
+ * Initialize statistics objects for non-standard command "sdo_stats"
+ *
+ * Command "sdo_stats srv" or "sdo_stats cli" prints all values of the
+ * statistics in one line, in order of @ref CO_SDOstats_sub_t sub-indexes 1
+ * to 36. "sdo_stats srv reset" or "sdo_stats cli reset" clears them.
+ *
+ * @param gtwa This object
+ * @param SDOserverStats SDO server statistics or NULL
+ * @param SDOclientStats SDO client statistics or NULL
+ */
+void CO_GTWA_initSDOstats(CO_GTWA_t* gtwa,
+                          CO_SDOstats_t *SDOserverStats,
+                          CO_SDOstats_t *SDOclientStats);
+#endif
+
+
 /**
  * Get free write buffer space
  *
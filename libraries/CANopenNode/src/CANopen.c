@@ -290,6 +290,26 @@
 #define CO_CNT_ALL_TX_MSGS  (CO_TX_IDX_LSS_MST  + CO_TX_CNT_LSS_MST)
 #endif /* #ifdef #else CO_MULTIPLE_OD */
 
+/* SDO client manager uses all SDO clients, first is reserved for gateway */
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII) \
+    && ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO)
+ #define CO_SDO_CLI_MGR_FIRST 1
+#else
+ #define CO_SDO_CLI_MGR_FIRST 0
+#endif
+
+/* SDO server buffer pool, not more buffers than SDO servers */
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+ #define CO_SDO_SRV_POOL_CNT (CO_GET_CNT(SDO_SRV) < CO_CONFIG_SDO_SRV_POOL_SIZE \
+                              ? CO_GET_CNT(SDO_SRV) : CO_CONFIG_SDO_SRV_POOL_SIZE)
+ #define CO_SDO_SRV_POOL_BUF_SIZE (CO_CONFIG_SDO_SRV_BUFFER_SIZE + 1)
+#endif
+
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_LOG
+/* Emergency log image must survive reset, so it is never allocated */
+static CO_EMLOG_NOINIT CO_EMlogRam_t CO_EMlogRam;
+#endif
+
 
 /* Objects from heap **********************************************************/
 #ifndef CO_USE_GLOBALS
@@ -375,6 +395,9 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
             ON_MULTI_OD(TX_CNT_NMT_MST = 1);
  #endif
             ON_MULTI_OD(TX_CNT_HB_PROD = 1);
+ #if (CO_CONFIG_NMT) & CO_CONFIG_NMT_CENSUS
+            CO_alloc_break_on_fail(co->NMTcensus, 1, sizeof(*co->NMTcensus));
+ #endif
         }
 
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
@@ -403,6 +426,12 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
             if (fifoSize >= 2) {
                 CO_alloc_break_on_fail(co->em_fifo, fifoSize, sizeof(*co->em_fifo));
             }
+ #endif
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_LOG
+            CO_alloc_break_on_fail(co->EMlog, 1, sizeof(*co->EMlog));
+ #endif
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_CONS_TABLE
+            CO_alloc_break_on_fail(co->EMcons, 1, sizeof(*co->EMcons));
  #endif
         }
 
@@ -411,6 +440,13 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
         ON_MULTI_OD(uint8_t TX_CNT_SDO_SRV = 0);
         if (CO_GET_CNT(SDO_SRV) > 0) {
             CO_alloc_break_on_fail(co->SDOserver, CO_GET_CNT(SDO_SRV), sizeof(*co->SDOserver));
+ #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+            CO_alloc_break_on_fail(co->SDOserverPool, 1, sizeof(*co->SDOserverPool));
+            CO_alloc_break_on_fail(co->SDOserverPoolBuffers, CO_SDO_SRV_POOL_CNT, CO_SDO_SRV_POOL_BUF_SIZE);
+ #endif
+ #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS
+            CO_alloc_break_on_fail(co->SDOserverStats, 1, sizeof(*co->SDOserverStats));
+ #endif
             ON_MULTI_OD(RX_CNT_SDO_SRV = config->CNT_SDO_SRV);
             ON_MULTI_OD(TX_CNT_SDO_SRV = config->CNT_SDO_SRV);
         }
@@ -420,8 +456,22 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
         ON_MULTI_OD(uint8_t TX_CNT_SDO_CLI = 0);
         if (CO_GET_CNT(SDO_CLI) > 0) {
             CO_alloc_break_on_fail(co->SDOclient, CO_GET_CNT(SDO_CLI), sizeof(*co->SDOclient));
+ #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS
+            CO_alloc_break_on_fail(co->SDOclientStats, 1, sizeof(*co->SDOclientStats));
+ #endif
             ON_MULTI_OD(RX_CNT_SDO_CLI = config->CNT_SDO_CLI);
             ON_MULTI_OD(TX_CNT_SDO_CLI = config->CNT_SDO_CLI);
+ #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_MANAGER
+            CO_alloc_break_on_fail(co->SDOclientMgr, 1, sizeof(*co->SDOclientMgr));
+            CO_alloc_break_on_fail(co->SDOclientMgrChannels, CO_GET_CNT(SDO_CLI), sizeof(*co->SDOclientMgrChannels));
+  #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE
+            CO_alloc_break_on_fail(co->SDOclientCache, 1, sizeof(*co->SDOclientCache));
+            CO_alloc_break_on_fail(co->SDOclientCacheEntries, CO_CONFIG_SDO_CLI_CACHE_ENTRIES, sizeof(*co->SDOclientCacheEntries));
+  #endif
+  #if (CO_CONFIG_BOOTUP_MGR) & CO_CONFIG_BOOTUP_MGR_ENABLE
+            CO_alloc_break_on_fail(co->bootupMgr, 1, sizeof(*co->bootupMgr));
+  #endif
+ #endif
         }
 #endif
 
@@ -465,6 +515,10 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
         }
 #endif
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_REMAP
+        CO_alloc_break_on_fail(co->PDOremap, 1, sizeof(*co->PDOremap));
+#endif
+
 #if (CO_CONFIG_LEDS) & CO_CONFIG_LEDS_ENABLE
         if (CO_GET_CNT(LEDS) == 1) {
             CO_alloc_break_on_fail(co->LEDs, CO_GET_CNT(LEDS), sizeof(*co->LEDs));
@@ -507,6 +561,9 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
         ON_MULTI_OD(uint8_t TX_CNT_LSS_MST = 0);
         if (CO_GET_CNT(LSS_MST) == 1) {
             CO_alloc_break_on_fail(co->LSSmaster, CO_GET_CNT(LSS_MST), sizeof(*co->LSSmaster));
+ #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_COMMISSION
+            CO_alloc_break_on_fail(co->LSScommission, 1, sizeof(*co->LSScommission));
+ #endif
             ON_MULTI_OD(RX_CNT_LSS_MST = 1);
             ON_MULTI_OD(TX_CNT_LSS_MST = 1);
         }
@@ -637,6 +694,9 @@ void CO_delete(CO_t *co) {
 #endif
 
 #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER
+ #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_COMMISSION
+    CO_free(co->LSScommission);
+ #endif
     CO_free(co->LSSmaster);
 #endif
 
@@ -657,6 +717,10 @@ void CO_delete(CO_t *co) {
     CO_free(co->LEDs);
 #endif
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_REMAP
+    CO_free(co->PDOremap);
+#endif
+
 #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
     CO_free(co->TPDO);
 #endif
@@ -674,10 +738,31 @@ void CO_delete(CO_t *co) {
 #endif
 
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
+ #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_MANAGER
+  #if (CO_CONFIG_BOOTUP_MGR) & CO_CONFIG_BOOTUP_MGR_ENABLE
+    CO_free(co->bootupMgr);
+  #endif
+  #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE
+    CO_free(co->SDOclientCacheEntries);
+    CO_free(co->SDOclientCache);
+  #endif
+    CO_free(co->SDOclientMgrChannels);
+    CO_free(co->SDOclientMgr);
+ #endif
+ #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS
+    CO_free(co->SDOclientStats);
+ #endif
     free(co->SDOclient);
 #endif
 
     /* SDOserver */
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+    CO_free(co->SDOserverPoolBuffers);
+    CO_free(co->SDOserverPool);
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS
+    CO_free(co->SDOserverStats);
+#endif
     CO_free(co->SDOserver);
 
     /* Emergency */
@@ -685,6 +770,12 @@ void CO_delete(CO_t *co) {
 #if (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY)
     CO_free(co->em_fifo);
 #endif
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_LOG
+    CO_free(co->EMlog);
+#endif
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_CONS_TABLE
+    CO_free(co->EMcons);
+#endif
 
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
     CO_free(co->HBconsMonitoredNodes);
@@ -692,6 +783,9 @@ void CO_delete(CO_t *co) {
 #endif
 
     /* NMT_Heartbeat */
+#if (CO_CONFIG_NMT) & CO_CONFIG_NMT_CENSUS
+    CO_free(co->NMTcensus);
+#endif
     CO_free(co->NMT);
 
     /* CANopen object */
@@ -710,6 +804,9 @@ void CO_delete(CO_t *co) {
     static CO_CANrx_t COO_CANmodule_rxArray[CO_CNT_ALL_RX_MSGS];
     static CO_CANtx_t COO_CANmodule_txArray[CO_CNT_ALL_TX_MSGS];
     static CO_NMT_t COO_NMT;
+#if (CO_CONFIG_NMT) & CO_CONFIG_NMT_CENSUS
+    static CO_NMTcensus_t COO_NMTcensus;
+#endif
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
     static CO_HBconsumer_t COO_HBcons;
     static CO_HBconsNode_t COO_HBconsMonitoredNodes[OD_CNT_ARR_1016];
@@ -717,10 +814,37 @@ void CO_delete(CO_t *co) {
     static CO_EM_t COO_EM;
 #if (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY)
     static CO_EM_fifo_t COO_EM_FIFO[CO_GET_CNT(ARR_1003) + 1];
+#endif
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_LOG
+    static CO_EMlog_t COO_EMlog;
+#endif
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_CONS_TABLE
+    static CO_EMcons_t COO_EMcons;
 #endif
     static CO_SDOserver_t COO_SDOserver[OD_CNT_SDO_SRV];
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+    static CO_SDOserverPool_t COO_SDOserverPool;
+    static uint8_t COO_SDOserverPoolBuffers[CO_SDO_SRV_POOL_CNT * CO_SDO_SRV_POOL_BUF_SIZE];
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS
+    static CO_SDOstats_t COO_SDOserverStats;
+#endif
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
     static CO_SDOclient_t COO_SDOclient[OD_CNT_SDO_CLI];
+ #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS
+    static CO_SDOstats_t COO_SDOclientStats;
+ #endif
+ #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_MANAGER
+    static CO_SDOclientMgr_t COO_SDOclientMgr;
+    static CO_SDOclientMgrChannel_t COO_SDOclientMgrChannels[OD_CNT_SDO_CLI];
+  #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE
+    static CO_SDOclientCache_t COO_SDOclientCache;
+    static CO_SDOclientCacheEntry_t COO_SDOclientCacheEntries[CO_CONFIG_SDO_CLI_CACHE_ENTRIES];
+  #endif
+  #if (CO_CONFIG_BOOTUP_MGR) & CO_CONFIG_BOOTUP_MGR_ENABLE
+    static CO_bootupMgr_t COO_bootupMgr;
+  #endif
+ #endif
 #endif
 #if (CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE
     static CO_TIME_t COO_TIME;
@@ -734,6 +858,9 @@ void CO_delete(CO_t *co) {
 #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
     static CO_TPDO_t COO_TPDO[OD_CNT_TPDO];
 #endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_REMAP
+    static CO_PDOremap_t COO_PDOremap;
+#endif
 #if (CO_CONFIG_LEDS) & CO_CONFIG_LEDS_ENABLE
     static CO_LEDs_t COO_LEDs;
 #endif
@@ -749,6 +876,9 @@ void CO_delete(CO_t *co) {
 #endif
 #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER
     static CO_LSSmaster_t COO_LSSmaster;
+ #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_COMMISSION
+    static CO_LSScommission_t COO_LSScommission;
+ #endif
 #endif
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII
     static CO_GTWA_t COO_gtwa;
@@ -772,6 +902,9 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
     co->CANtx = &COO_CANmodule_txArray[0];
 
     co->NMT = &COO_NMT;
+#if (CO_CONFIG_NMT) & CO_CONFIG_NMT_CENSUS
+    co->NMTcensus = &COO_NMTcensus;
+#endif
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
     co->HBcons = &COO_HBcons;
     co->HBconsMonitoredNodes = &COO_HBconsMonitoredNodes[0];
@@ -779,10 +912,37 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
     co->em = &COO_EM;
 #if (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY)
     co->em_fifo = &COO_EM_FIFO[0];
+#endif
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_LOG
+    co->EMlog = &COO_EMlog;
+#endif
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_CONS_TABLE
+    co->EMcons = &COO_EMcons;
 #endif
     co->SDOserver = &COO_SDOserver[0];
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+    co->SDOserverPool = &COO_SDOserverPool;
+    co->SDOserverPoolBuffers = &COO_SDOserverPoolBuffers[0];
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS
+    co->SDOserverStats = &COO_SDOserverStats;
+#endif
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
     co->SDOclient = &COO_SDOclient[0];
+ #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS
+    co->SDOclientStats = &COO_SDOclientStats;
+ #endif
+ #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_MANAGER
+    co->SDOclientMgr = &COO_SDOclientMgr;
+    co->SDOclientMgrChannels = &COO_SDOclientMgrChannels[0];
+  #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE
+    co->SDOclientCache = &COO_SDOclientCache;
+    co->SDOclientCacheEntries = &COO_SDOclientCacheEntries[0];
+  #endif
+  #if (CO_CONFIG_BOOTUP_MGR) & CO_CONFIG_BOOTUP_MGR_ENABLE
+    co->bootupMgr = &COO_bootupMgr;
+  #endif
+ #endif
 #endif
 #if (CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE
     co->TIME = &COO_TIME;
@@ -796,6 +956,9 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
 #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
     co->TPDO = &COO_TPDO[0];
 #endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_REMAP
+    co->PDOremap = &COO_PDOremap;
+#endif
 #if (CO_CONFIG_LEDS) & CO_CONFIG_LEDS_ENABLE
     co->LEDs = &COO_LEDs;
 #endif
@@ -811,6 +974,9 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
 #endif
 #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER
     co->LSSmaster = &COO_LSSmaster;
+ #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_COMMISSION
+    co->LSScommission = &COO_LSScommission;
+ #endif
 #endif
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII
     co->gtwa = &COO_gtwa;
@@ -984,6 +1150,30 @@ CO_ReturnError_t CO_CANopenInit(CO_t *co,
                          nodeId,
                          errInfo);
         if (err) return err;
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_COALESCE
+        /* counters object in Object Dictionary is optional */
+        err = CO_EM_initCoalesce(co->em, CO_EM_COALESCE_WINDOW_MS,
+                                 OD_find(od, CO_EM_COALESCE_OD_INDEX));
+        if (err) return err;
+ #endif
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_LOG
+        /* log object in Object Dictionary is optional */
+        err = CO_EMlog_init(co->EMlog,
+                            &CO_EMlogRam,
+  #if (CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE
+                            CO_GET_CNT(TIME) == 1 ? co->TIME : NULL,
+  #endif
+                            OD_find(od, CO_EMLOG_OD_INDEX));
+        if (err) return err;
+        CO_EM_initCallbackLog(co->em, co->EMlog, CO_EMlog_record);
+ #endif
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_CONS_TABLE
+        /* table object in Object Dictionary is optional */
+        err = CO_EMcons_init(co->EMcons, co->CANmodule,
+                             OD_find(od, CO_EMCONS_OD_INDEX));
+        if (err) return err;
+        CO_EM_initCallbackRxTable(co->em, co->EMcons, CO_EMcons_receive);
+ #endif
     }
 
     /* NMT_Heartbeat */
@@ -1007,6 +1197,11 @@ CO_ReturnError_t CO_CANopenInit(CO_t *co,
                           CO_CAN_ID_HEARTBEAT + nodeId,
                           errInfo);
         if (err) return err;
+
+ #if (CO_CONFIG_NMT) & CO_CONFIG_NMT_CENSUS
+        err = CO_NMTcensus_init(co->NMTcensus, co->CANmodule);
+        if (err) return err;
+ #endif
     }
 
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
@@ -1026,6 +1221,18 @@ CO_ReturnError_t CO_CANopenInit(CO_t *co,
     /* SDOserver */
     if (CO_GET_CNT(SDO_SRV) > 0) {
         OD_entry_t *SDOsrvPar = OD_GET(H1200, OD_H1200_SDO_SERVER_1_PARAM);
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+        err = CO_SDOserverPool_init(co->SDOserverPool,
+                                    co->SDOserverPoolBuffers,
+                                    (uint8_t)CO_SDO_SRV_POOL_CNT);
+        if (err) return err;
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS
+        /* statistics object in Object Dictionary is optional */
+        err = CO_SDOstats_init(co->SDOserverStats,
+                               OD_find(od, CO_SDO_SRV_STATS_OD_INDEX));
+        if (err) return err;
+#endif
         for (int16_t i = 0; i < CO_GET_CNT(SDO_SRV); i++) {
             err = CO_SDOserver_init(&co->SDOserver[i],
                                     od,
@@ -1038,12 +1245,23 @@ CO_ReturnError_t CO_CANopenInit(CO_t *co,
                                     CO_GET_CO(TX_IDX_SDO_SRV) + i,
                                     errInfo);
             if (err) return err;
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+            CO_SDOserver_initPool(&co->SDOserver[i], co->SDOserverPool);
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS
+            CO_SDOserver_initStats(&co->SDOserver[i], co->SDOserverStats);
+#endif
         }
     }
 
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
     if (CO_GET_CNT(SDO_CLI) > 0) {
         OD_entry_t *SDOcliPar = OD_GET(H1280, OD_H1280_SDO_CLIENT_1_PARAM);
+ #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS
+        err = CO_SDOstats_init(co->SDOclientStats,
+                               OD_find(od, CO_SDO_CLI_STATS_OD_INDEX));
+        if (err) return err;
+ #endif
         for (int16_t i = 0; i < CO_GET_CNT(SDO_CLI); i++) {
             err = CO_SDOclient_init(&co->SDOclient[i],
                                     od,
@@ -1055,8 +1273,47 @@ CO_ReturnError_t CO_CANopenInit(CO_t *co,
                                     CO_GET_CO(TX_IDX_SDO_CLI) + i,
                                     errInfo);
             if (err) return err;
+ #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS
+            CO_SDOclient_initStats(&co->SDOclient[i], co->SDOclientStats);
+ #endif
+        }
+    }
+
+ #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_MANAGER
+    if (CO_GET_CNT(SDO_CLI) > CO_SDO_CLI_MGR_FIRST) {
+        err = CO_SDOclientMgr_init(co->SDOclientMgr,
+                                   co->SDOclientMgrChannels,
+                                   &co->SDOclient[CO_SDO_CLI_MGR_FIRST],
+                                   CO_GET_CNT(SDO_CLI) - CO_SDO_CLI_MGR_FIRST,
+                                   SDOclientTimeoutTime_ms,
+                                   SDOclientBlockTransfer);
+        if (err) return err;
+
+  #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE
+        err = CO_SDOclientCache_init(co->SDOclientCache,
+                                     co->SDOclientCacheEntries,
+                                     CO_CONFIG_SDO_CLI_CACHE_ENTRIES);
+        if (err) return err;
+        CO_SDOclientMgr_initCache(co->SDOclientMgr, co->SDOclientCache);
+
+   #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_RESET
+        /* values of the node are read again after its boot-up or timeout */
+        if (CO_GET_CNT(HB_CONS) == 1) {
+            CO_HBconsumer_initCallbackReset(co->HBcons, co->SDOclientCache,
+                                            CO_SDOclientCache_nodeReset);
+        }
+   #endif
+  #endif
+
+  #if (CO_CONFIG_BOOTUP_MGR) & CO_CONFIG_BOOTUP_MGR_ENABLE
+        if (CO_GET_CNT(NMT) == 1) {
+            err = CO_bootupMgr_init(co->bootupMgr, co->NMT, co->NMTcensus,
+                                    co->SDOclientMgr);
+            if (err) return err;
         }
+  #endif
     }
+ #endif
 #endif
 
 #if (CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE
@@ -1156,6 +1413,15 @@ CO_ReturnError_t CO_CANopenInit(CO_t *co,
                                 CO_GET_CO(TX_IDX_LSS_MST),
                                 CO_CAN_ID_LSS_MST);
         if (err) return err;
+ #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_COMMISSION
+        err = CO_LSScommission_init(co->LSScommission,
+                                    co->LSSmaster,
+  #if (CO_CONFIG_NMT) & CO_CONFIG_NMT_CENSUS
+                                    CO_GET_CNT(NMT) == 1 ? co->NMTcensus : NULL,
+  #endif
+                                    nodeId);
+        if (err) return err;
+ #endif
     }
 #endif
 
@@ -1178,6 +1444,21 @@ CO_ReturnError_t CO_CANopenInit(CO_t *co,
  #endif
                            0);
         if (err) return err;
+ #if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS) \
+     || ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS)
+        CO_GTWA_initSDOstats(co->gtwa,
+  #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS
+                             CO_GET_CNT(SDO_SRV) > 0 ? co->SDOserverStats : NULL,
+  #else
+                             NULL,
+  #endif
+  #if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE) \
+      && ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS)
+                             CO_GET_CNT(SDO_CLI) > 0 ? co->SDOclientStats : NULL);
+  #else
+                             NULL);
+  #endif
+ #endif
     }
 #endif
 
@@ -1296,10 +1577,35 @@ CO_ReturnError_t CO_CANopenInitPDO(CO_t *co,
                                CO_GET_CO(TX_IDX_TPDO) + i,
                                errInfo);
             if (err) return err;
+ #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_SYNC_SCHEDULER
+            CO_TPDO_setSyncOffset(&co->TPDO[i],
+                                  CO_TPDO_SYNC_OFFSET_DEFAULT(nodeId, i));
+ #endif
         }
     }
 #endif
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_REMAP
+    /* PDO remap is optional, it is enabled by object in Object Dictionary */
+    OD_entry_t *PDOremapEntry = OD_find(od, CO_PDO_REMAP_OD_INDEX);
+    if (PDOremapEntry != NULL) {
+        CO_ReturnError_t err;
+        err = CO_PDOremap_init(co->PDOremap,
+                               od,
+                               PDOremapEntry,
+ #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
+                               co->RPDO,
+                               CO_GET_CNT(RPDO),
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
+                               co->TPDO,
+                               CO_GET_CNT(TPDO),
+ #endif
+                               errInfo);
+        if (err) return err;
+    }
+#endif
+
     return CO_ERROR_NO;
 }
 
@@ -1370,6 +1676,12 @@ CO_NMT_reset_cmd_t CO_process(CO_t *co,
                       NMTisPreOrOperational,
                       timeDifference_us,
                       timerNext_us);
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_LOG
+        CO_EMlog_process(co->EMlog, timeDifference_us, timerNext_us);
+#endif
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_CONS_TABLE
+        CO_EMcons_process(co->EMcons, timeDifference_us);
+#endif
     }
 
     /* NMT_Heartbeat */
@@ -1383,12 +1695,52 @@ CO_NMT_reset_cmd_t CO_process(CO_t *co,
                              || NMTstate == CO_NMT_OPERATIONAL);
 
     /* SDOserver */
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+    /* Idle SDO servers first, so new (expedited) requests are answered
+     * before the next segments of long transfers on other SDO servers. */
+    uint32_t SDOsrvBusy[4] = {0};
+    for (uint8_t i = 0; i < CO_GET_CNT(SDO_SRV); i++) {
+        if (co->SDOserver[i].state == CO_SDO_ST_IDLE) {
+            CO_SDOserver_process(&co->SDOserver[i],
+                                 NMTisPreOrOperational,
+                                 timeDifference_us,
+                                 timerNext_us);
+        }
+        else {
+            SDOsrvBusy[i >> 5] |= 1UL << (i & 0x1F);
+        }
+    }
+    for (uint8_t i = 0; i < CO_GET_CNT(SDO_SRV); i++) {
+        if ((SDOsrvBusy[i >> 5] & (1UL << (i & 0x1F))) != 0) {
+            CO_SDOserver_process(&co->SDOserver[i],
+                                 NMTisPreOrOperational,
+                                 timeDifference_us,
+                                 timerNext_us);
+        }
+    }
+#else
     for (uint8_t i = 0; i < CO_GET_CNT(SDO_SRV); i++) {
         CO_SDOserver_process(&co->SDOserver[i],
                              NMTisPreOrOperational,
                              timeDifference_us,
                              timerNext_us);
     }
+#endif
+
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE) \
+    && ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_MANAGER)
+ #if (CO_CONFIG_BOOTUP_MGR) & CO_CONFIG_BOOTUP_MGR_ENABLE
+    /* before SDO client manager, so queued requests start in this cycle */
+    if (CO_GET_CNT(NMT) == 1 && CO_GET_CNT(SDO_CLI) > CO_SDO_CLI_MGR_FIRST) {
+        CO_bootupMgr_process(co->bootupMgr, timeDifference_us, timerNext_us);
+    }
+ #endif
+    if (CO_GET_CNT(SDO_CLI) > CO_SDO_CLI_MGR_FIRST) {
+        CO_SDOclientMgr_process(co->SDOclientMgr,
+                                timeDifference_us,
+                                timerNext_us);
+    }
+#endif
 
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
     if (CO_GET_CNT(HB_CONS) == 1) {
@@ -1405,6 +1757,14 @@ CO_NMT_reset_cmd_t CO_process(CO_t *co,
     }
 #endif
 
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_COMMISSION
+    if (CO_GET_CNT(LSS_MST) == 1) {
+        CO_LSScommission_process(co->LSScommission,
+                                 timeDifference_us,
+                                 timerNext_us);
+    }
+#endif
+
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII
     if (CO_GET_CNT(GTWA) == 1) {
         CO_GTWA_process(co->gtwa,
@@ -1477,6 +1837,11 @@ void CO_process_RPDO(CO_t *co,
                         NMTisOperational,
                         syncWas);
     }
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_REMAP
+    /* new mapping is used from the next received RPDO */
+    CO_PDOremap_processRPDO(co->PDOremap, syncWas);
+#endif
 }
 #endif
 
@@ -1496,6 +1861,11 @@ void CO_process_TPDO(CO_t *co,
     bool_t NMTisOperational =
         CO_NMT_getInternalState(co->NMT) == CO_NMT_OPERATIONAL;
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_REMAP
+    /* new mapping is used already for TPDOs sent on this SYNC */
+    CO_PDOremap_processTPDO(co->PDOremap, syncWas);
+#endif
+
     for (int16_t i = 0; i < CO_GET_CNT(TPDO); i++) {
         CO_TPDO_process(&co->TPDO[i],
 #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_TIMERS_ENABLE
@@ -32,17 +32,23 @@
 #include "301/CO_ODinterface.h"
 #include "301/CO_NMT_Heartbeat.h"
 #include "301/CO_HBconsumer.h"
+#include "301/CO_NMTcensus.h"
 #include "301/CO_Emergency.h"
+#include "301/CO_EMlog.h"
+#include "301/CO_EMcons.h"
 #include "301/CO_SDOserver.h"
 #include "301/CO_SDOclient.h"
+#include "301/CO_SDOclientMgr.h"
 #include "301/CO_SYNC.h"
 #include "301/CO_PDO.h"
 #include "301/CO_TIME.h"
+#include "302/CO_bootupMgr.h"
 #include "303/CO_LEDs.h"
 #include "304/CO_GFC.h"
 #include "304/CO_SRDO.h"
 #include "305/CO_LSSslave.h"
 #include "305/CO_LSSmaster.h"
+#include "305/CO_LSScommission.h"
 #include "309/CO_gateway_ascii.h"
 #include "extra/CO_trace.h"
 
@@ -95,6 +101,17 @@ extern "C" {
  * @}
  */
 
+/**
+ * @defgroup CO_CANopen_302 CANopen_302
+ * @{
+ *
+ * CANopen additional application layer functions (CiA 302)
+ *
+ * Network management of the CANopen manager: boot-up of the network,
+ * verification of the identity and configuration of slaves.
+ * @}
+ */
+
 /**
  * @defgroup CO_CANopen_303 CANopen_303
  * @{
@@ -295,6 +312,10 @@ typedef struct {
     uint16_t TX_IDX_NMT_MST; /**< Start index in CANtx. */
     uint16_t TX_IDX_HB_PROD; /**< Start index in CANtx. */
  #endif
+#if ((CO_CONFIG_NMT) & CO_CONFIG_NMT_CENSUS) || defined CO_DOXYGEN
+    /** NMT census, initialised by @ref CO_NMTcensus_init() */
+    CO_NMTcensus_t *NMTcensus;
+#endif
 #if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE) || defined CO_DOXYGEN
     /** Heartbeat consumer object, initialised by @ref CO_HBconsumer_init() */
     CO_HBconsumer_t *HBcons;
@@ -314,6 +335,14 @@ typedef struct {
     || defined CO_DOXYGEN
     /** FIFO for emergency object, initialised by @ref CO_EM_init() */
     CO_EM_fifo_t *em_fifo;
+#endif
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_LOG) || defined CO_DOXYGEN
+    /** Emergency log, initialised by @ref CO_EMlog_init() */
+    CO_EMlog_t *EMlog;
+#endif
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_CONS_TABLE) || defined CO_DOXYGEN
+    /** Emergency consumer table, initialised by @ref CO_EMcons_init() */
+    CO_EMcons_t *EMcons;
 #endif
     /** SDO server objects, initialised by @ref CO_SDOserver_init() */
     CO_SDOserver_t *SDOserver;
@@ -321,6 +350,17 @@ typedef struct {
     uint16_t RX_IDX_SDO_SRV; /**< Start index in CANrx. */
     uint16_t TX_IDX_SDO_SRV; /**< Start index in CANtx. */
  #endif
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL) || defined CO_DOXYGEN
+    /** Buffer pool of all SDO servers, initialised by
+     * @ref CO_SDOserverPool_init() */
+    CO_SDOserverPool_t *SDOserverPool;
+    /** Buffers of the SDOserverPool */
+    uint8_t *SDOserverPoolBuffers;
+#endif
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_STATS) || defined CO_DOXYGEN
+    /** Statistics of all SDO servers, initialised by @ref CO_SDOstats_init() */
+    CO_SDOstats_t *SDOserverStats;
+#endif
 #if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE) || defined CO_DOXYGEN
     /** SDO client objects, initialised by @ref CO_SDOclient_init() */
     CO_SDOclient_t *SDOclient;
@@ -328,6 +368,28 @@ typedef struct {
     uint16_t RX_IDX_SDO_CLI; /**< Start index in CANrx. */
     uint16_t TX_IDX_SDO_CLI; /**< Start index in CANtx. */
  #endif
+ #if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_STATS) || defined CO_DOXYGEN
+    /** Statistics of all SDO clients, initialised by @ref CO_SDOstats_init() */
+    CO_SDOstats_t *SDOclientStats;
+ #endif
+#endif
+#if (((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE) \
+     && ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_MANAGER)) || defined CO_DOXYGEN
+    /** SDO client manager, initialised by @ref CO_SDOclientMgr_init() */
+    CO_SDOclientMgr_t *SDOclientMgr;
+    /** SDO client manager channels, one for each SDO client it uses */
+    CO_SDOclientMgrChannel_t *SDOclientMgrChannels;
+ #if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE) || defined CO_DOXYGEN
+    /** SDO client cache used by SDOclientMgr, initialised by
+     * @ref CO_SDOclientCache_init() */
+    CO_SDOclientCache_t *SDOclientCache;
+    /** SDO client cache entries, @ref CO_CONFIG_SDO_CLI_CACHE_ENTRIES */
+    CO_SDOclientCacheEntry_t *SDOclientCacheEntries;
+ #endif
+#endif
+#if ((CO_CONFIG_BOOTUP_MGR) & CO_CONFIG_BOOTUP_MGR_ENABLE) || defined CO_DOXYGEN
+    /** Boot-up manager, initialised by @ref CO_bootupMgr_init() */
+    CO_bootupMgr_t *bootupMgr;
 #endif
 #if ((CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE) || defined CO_DOXYGEN
     /** TIME object, initialised by @ref CO_TIME_init() */
@@ -359,6 +421,10 @@ typedef struct {
     uint16_t TX_IDX_TPDO; /**< Start index in CANtx. */
  #endif
 #endif
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_REMAP) || defined CO_DOXYGEN
+    /** PDO remap object, initialised by @ref CO_PDOremap_init() */
+    CO_PDOremap_t *PDOremap;
+#endif
 #if ((CO_CONFIG_LEDS) & CO_CONFIG_LEDS_ENABLE) || defined CO_DOXYGEN
     /** LEDs object, initialised by @ref CO_LEDs_init() */
     CO_LEDs_t *LEDs;
@@ -393,6 +459,10 @@ typedef struct {
 #if ((CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER) || defined CO_DOXYGEN
     /** LSS master object, initialised by @ref CO_LSSmaster_init(). */
     CO_LSSmaster_t *LSSmaster;
+ #if ((CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_COMMISSION) || defined CO_DOXYGEN
+    /** LSS commissioning, initialised by @ref CO_LSScommission_init() */
+    CO_LSScommission_t *LSScommission;
+ #endif
  #if defined CO_MULTIPLE_OD || defined CO_DOXYGEN
     uint16_t RX_IDX_LSS_MST; /**< Start index in CANrx. */
     uint16_t TX_IDX_LSS_MST; /**< Start index in CANtx. */
@@ -300,6 +300,11 @@ void STM32_CAN::setTimestampCounter(bool enabled)
   _can.handle.Init.TimeTriggeredMode = enabled ? (ENABLE) : (DISABLE);
 }
 
+void STM32_CAN::setRxTimestampMicros(bool enabled)
+{
+  rxTimestampMicros = enabled;
+}
+
 void STM32_CAN::setMode(MODE mode)
 {
   _can.handle.Init.Mode = mode;
@@ -616,7 +621,18 @@ bool STM32_CAN::write(CAN_message_t &CAN_tx_msg, bool sendMB)
 
   TxHeader.TransmitGlobalTime = DISABLE;
 
-  if(HAL_CAN_AddTxMessage( &_can.handle, &TxHeader, CAN_tx_msg.buf, &TxMailbox) != HAL_OK)
+  HAL_StatusTypeDef status;
+  if (reservedTxComplete != nullptr)
+  {
+    /* HAL takes the next free mailbox from TSR CODE, which may be the reserved one */
+    status = addTxMessageUnreserved(CAN_tx_msg);
+  }
+  else
+  {
+    status = HAL_CAN_AddTxMessage( &_can.handle, &TxHeader, CAN_tx_msg.buf, &TxMailbox);
+  }
+
+  if(status != HAL_OK)
   {
     /* in normal situation we add up the message to TX ring buffer, if there is no free TX mailbox. But the TX mailbox interrupt is using this same function
     to move the messages from ring buffer to empty TX mailboxes, so for that use case, there is this check */
@@ -636,6 +652,93 @@ bool STM32_CAN::write(CAN_message_t &CAN_tx_msg, bool sendMB)
   return ret;
 }
 
+void STM32_CAN::reserveTxMailbox(void (*txComplete)(void *arg), void *arg)
+{
+  reservedTxArg = arg;
+  reservedTxComplete = txComplete;
+}
+
+void STM32_CAN::releaseTxMailbox(void)
+{
+  reservedTxComplete = nullptr;
+}
+
+bool STM32_CAN::writeReserved(const CAN_message_t &CAN_tx_msg)
+{
+  CAN_TypeDef *instance = _can.handle.Instance;
+  if(!instance || reservedTxComplete == nullptr) return false;
+
+  if ((READ_REG(instance->TSR) & CAN_TSR_TME2) == 0U)
+  {
+    return false;
+  }
+  fillTxMailbox(instance, 2, CAN_tx_msg);
+  return true;
+}
+
+HAL_StatusTypeDef STM32_CAN::addTxMessageUnreserved(const CAN_message_t &CAN_tx_msg)
+{
+  CAN_TypeDef *instance = _can.handle.Instance;
+  uint32_t tsr = READ_REG(instance->TSR);
+  uint32_t mailbox;
+
+  if ((_can.handle.State != HAL_CAN_STATE_READY) && (_can.handle.State != HAL_CAN_STATE_LISTENING))
+  {
+    return HAL_ERROR;
+  }
+
+  if ((tsr & CAN_TSR_TME0) != 0U)
+  {
+    mailbox = 0;
+  }
+  else if ((tsr & CAN_TSR_TME1) != 0U)
+  {
+    mailbox = 1;
+  }
+  else
+  {
+    return HAL_ERROR;
+  }
+  fillTxMailbox(instance, mailbox, CAN_tx_msg);
+  return HAL_OK;
+}
+
+void STM32_CAN::fillTxMailbox(CAN_TypeDef *instance, uint32_t mailbox, const CAN_message_t &CAN_tx_msg)
+{
+  CAN_TxMailBox_TypeDef *mb = &instance->sTxMailBox[mailbox];
+  uint32_t tir;
+  uint8_t len = CAN_tx_msg.len > 8 ? 8 : CAN_tx_msg.len;
+
+  if (CAN_tx_msg.flags.extended == 1)
+  {
+    tir = (CAN_tx_msg.id << CAN_TI0R_EXID_Pos) | CAN_ID_EXT;
+  }
+  else
+  {
+    tir = (CAN_tx_msg.id << CAN_TI0R_STID_Pos);
+  }
+  if (CAN_tx_msg.flags.remote == 1)
+  {
+    tir |= CAN_RTR_REMOTE;
+    len = 0;
+  }
+
+  /* same register sequence as HAL_CAN_AddTxMessage(), request is the last write */
+  WRITE_REG(mb->TIR, tir);
+  WRITE_REG(mb->TDTR, len);
+  WRITE_REG(mb->TDHR,
+            ((uint32_t)CAN_tx_msg.buf[7] << CAN_TDH0R_DATA7_Pos) |
+            ((uint32_t)CAN_tx_msg.buf[6] << CAN_TDH0R_DATA6_Pos) |
+            ((uint32_t)CAN_tx_msg.buf[5] << CAN_TDH0R_DATA5_Pos) |
+            ((uint32_t)CAN_tx_msg.buf[4] << CAN_TDH0R_DATA4_Pos));
+  WRITE_REG(mb->TDLR,
+            ((uint32_t)CAN_tx_msg.buf[3] << CAN_TDL0R_DATA3_Pos) |
+            ((uint32_t)CAN_tx_msg.buf[2] << CAN_TDL0R_DATA2_Pos) |
+            ((uint32_t)CAN_tx_msg.buf[1] << CAN_TDL0R_DATA1_Pos) |
+            ((uint32_t)CAN_tx_msg.buf[0] << CAN_TDL0R_DATA0_Pos));
+  SET_BIT(mb->TIR, CAN_TI0R_TXRQ);
+}
+
 bool STM32_CAN::read(CAN_message_t &CAN_rx_msg)
 {
   bool ret;
@@ -1340,6 +1443,14 @@ extern "C" void HAL_CAN_TxMailbox2CompleteCallback( CAN_HandleTypeDef *CanHandle
   STM32_CAN * _can = (STM32_CAN *)canObj->__this;
   CAN_message_t txmsg;
 
+  // Reserved mailbox is not used for the ring buffer, see reserveTxMailbox()
+  void (*txComplete)(void *arg) = _can->reservedTxComplete;
+  if (txComplete != nullptr)
+  {
+    txComplete(_can->reservedTxArg);
+    return;
+  }
+
   if (_can->removeFromRingBuffer(_can->txRing, txmsg))
   {
     _can->write(txmsg, true);
@@ -1382,7 +1493,7 @@ extern "C" void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *CanHandle)
 
       rxmsg.flags.remote = RxHeader.RTR;
       rxmsg.mb           = RxHeader.FilterMatchIndex;
-      rxmsg.timestamp    = RxHeader.Timestamp;
+      rxmsg.timestamp    = _can->rxTimestampMicros ? (uint16_t)micros() : RxHeader.Timestamp;
       rxmsg.len          = RxHeader.DLC;
 
       rxmsg.bus = canObj->bus;
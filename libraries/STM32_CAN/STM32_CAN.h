@@ -297,6 +297,8 @@ class STM32_CAN {
     void setRxFIFOLock(bool fifo0locked, bool fifo1locked = true);
     void setTxBufferMode(TX_BUFFER_MODE mode);
     void setTimestampCounter(bool enabled);
+    /** Store low 16 bits of micros() from RX interrupt in CAN_message_t.timestamp, instead of bxCAN time stamp */
+    void setRxTimestampMicros(bool enabled);
 
     void setMode(MODE mode);
     void enableLoopBack(bool yes = 1);
@@ -323,6 +325,14 @@ class STM32_CAN {
     bool write(CAN_message_t &CAN_tx_msg, bool sendMB = false);
     bool read(CAN_message_t &CAN_rx_msg);
 
+    /** Reserve TX mailbox 2 for writeReserved(), e.g. for SYNC sent from a timer interrupt.
+     *  write() then uses only mailboxes 0 and 1 and the TX ring buffer.
+     *  txComplete is called from TX interrupt, when the frame in mailbox 2 is sent. */
+    void reserveTxMailbox(void (*txComplete)(void *arg), void *arg);
+    void releaseTxMailbox(void);
+    /** Write to reserved mailbox. Returns false if mailbox is not reserved or previous frame is still pending. */
+    bool writeReserved(const CAN_message_t &CAN_tx_msg);
+
     /** returns number of available filter banks. If hasSharedFilterBanks() is false counts may differ by id type. */
     uint8_t getFilterBankCount(IDE std_ext = STD);
     /** returns if filter count and index are shared (true) or dedicated per id type (false) */
@@ -375,6 +385,10 @@ class STM32_CAN {
     bool addToRingBuffer(RingbufferTypeDef &ring, const CAN_message_t &msg);
     bool removeFromRingBuffer(RingbufferTypeDef &ring, CAN_message_t &msg);
 
+    void (* volatile reservedTxComplete)(void *arg) = nullptr;
+    void *reservedTxArg = nullptr;
+    bool rxTimestampMicros = false;
+
   protected:
     uint16_t sizeRxBuffer;
     uint16_t sizeTxBuffer;
@@ -394,6 +408,8 @@ class STM32_CAN {
     void      freeBuffers(void);
     bool      isRingBufferEmpty(RingbufferTypeDef &ring);
     uint32_t  ringBufferCount(RingbufferTypeDef &ring);
+    HAL_StatusTypeDef addTxMessageUnreserved(const CAN_message_t &CAN_tx_msg);
+    static void fillTxMailbox(CAN_TypeDef *instance, uint32_t mailbox, const CAN_message_t &CAN_tx_msg);
 
     template <typename T, size_t N>
     bool      lookupBaudrate(int Baudrate, const T(&table)[N]);
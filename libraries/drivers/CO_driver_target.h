@@ -20,23 +20,86 @@ extern "C" {
 #define CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE CO_CONFIG_FLAG_CALLBACK_PRE
 #define CO_CONFIG_GLOBAL_FLAG_TIMERNEXT CO_CONFIG_FLAG_TIMERNEXT
 
+/* Services of the network master only: NMT master and census, boot-up
+ * manager, SDO client manager, emergency table and LSS master. The master
+ * sketch defines CO_NETWORK_MASTER to 1 in its hal_conf_extra.h, which
+ * Arduino.h includes in every file, so slaves do not spend RAM on them. */
+#ifndef CO_NETWORK_MASTER
+#define CO_NETWORK_MASTER 0
+#endif
+#if CO_NETWORK_MASTER
+#define CO_TARGET_NMT_MASTER (CO_CONFIG_NMT_MASTER | CO_CONFIG_NMT_CENSUS)
+#define CO_TARGET_EM_MASTER CO_CONFIG_EM_CONS_TABLE
+#define CO_TARGET_SDO_CLI_MASTER (CO_CONFIG_SDO_CLI_MANAGER | CO_CONFIG_SDO_CLI_BATCH | CO_CONFIG_SDO_CLI_CACHE)
+#define CO_TARGET_BOOTUP_MGR CO_CONFIG_BOOTUP_MGR_ENABLE
+#define CO_TARGET_LSS_MASTER (CO_CONFIG_LSS_MASTER | CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE | CO_CONFIG_LSS_MASTER_COMMISSION)
+#else
+#define CO_TARGET_NMT_MASTER 0
+#define CO_TARGET_EM_MASTER 0
+#define CO_TARGET_SDO_CLI_MASTER 0
+#define CO_TARGET_BOOTUP_MGR 0
+#define CO_TARGET_LSS_MASTER 0
+#endif
+
 #undef CO_CONFIG_NMT
-#define CO_CONFIG_NMT (CO_CONFIG_NMT_CALLBACK_CHANGE | CO_CONFIG_NMT_MASTER | CO_CONFIG_GLOBAL_FLAG_TIMERNEXT)
+#define CO_CONFIG_NMT (CO_CONFIG_NMT_CALLBACK_CHANGE | CO_TARGET_NMT_MASTER | CO_CONFIG_GLOBAL_FLAG_TIMERNEXT)
 
 #undef CO_CONFIG_HB_CONS
-#define CO_CONFIG_HB_CONS (CO_CONFIG_HB_CONS_ENABLE | CO_CONFIG_HB_CONS_QUERY_FUNCT | CO_CONFIG_GLOBAL_FLAG_TIMERNEXT)
+#define CO_CONFIG_HB_CONS (CO_CONFIG_HB_CONS_ENABLE | CO_CONFIG_HB_CONS_QUERY_FUNCT | CO_CONFIG_HB_CONS_DEADLINE | CO_CONFIG_HB_CONS_CALLBACK_RESET | CO_CONFIG_GLOBAL_FLAG_TIMERNEXT)
 
 #undef CO_CONFIG_EM
-#define CO_CONFIG_EM (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_CONSUMER | CO_CONFIG_GLOBAL_FLAG_TIMERNEXT)
+#define CO_CONFIG_EM (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_CONSUMER | CO_CONFIG_EM_COALESCE | CO_CONFIG_EM_LOG | CO_TARGET_EM_MASTER | CO_CONFIG_GLOBAL_FLAG_TIMERNEXT)
+
+/* Emergency table of the network, this network has only a few nodes */
+#define CO_CONFIG_EM_CONS_NODES 8
+
+/* Emergency log is placed outside of .data and .bss, startup code neither
+ * copies nor clears it, so it survives software and watchdog resets. */
+#define CO_EMLOG_NOINIT __attribute__((section(".noinit")))
+
+#undef CO_CONFIG_SYNC
+#define CO_CONFIG_SYNC (CO_CONFIG_SYNC_ENABLE | CO_CONFIG_SYNC_PRODUCER | CO_CONFIG_SYNC_PRODUCER_HW | CO_CONFIG_SYNC_CLOCK | CO_CONFIG_GLOBAL_RT_FLAG_CALLBACK_PRE | CO_CONFIG_GLOBAL_FLAG_TIMERNEXT | CO_CONFIG_GLOBAL_FLAG_OD_DYNAMIC)
+
+/* CAN reception is timestamped in the receive interrupt, messages are then
+ * dispatched from the loop. Required for SYNC clock recovery. */
+#define CO_CAN_RX_HW_TIMESTAMP
+
+#undef CO_CONFIG_TIME
+#define CO_CONFIG_TIME (CO_CONFIG_TIME_ENABLE | CO_CONFIG_TIME_PRODUCER | CO_CONFIG_TIME_CLOCK | CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE | CO_CONFIG_GLOBAL_FLAG_OD_DYNAMIC)
+
+/* TIME message takes about 200 us on the bus at 500 kbit/s, producer sends it
+ * right after CO_TIME_now(), consumer timestamps it at the end of frame. */
+#define CO_TIME_CLOCK_DELAY_US 200
 
 #undef CO_CONFIG_FIFO
 #define CO_CONFIG_FIFO (CO_CONFIG_FIFO_ENABLE)
 
 #undef CO_CONFIG_SDO_CLI
-#define CO_CONFIG_SDO_CLI (CO_CONFIG_SDO_CLI_ENABLE | CO_CONFIG_SDO_CLI_SEGMENTED | CO_CONFIG_SDO_CLI_LOCAL | CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE | CO_CONFIG_GLOBAL_FLAG_TIMERNEXT)
+#define CO_CONFIG_SDO_CLI (CO_CONFIG_SDO_CLI_ENABLE | CO_CONFIG_SDO_CLI_SEGMENTED | CO_CONFIG_SDO_CLI_LOCAL | CO_TARGET_SDO_CLI_MASTER | CO_CONFIG_SDO_CLI_STATS | CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE | CO_CONFIG_GLOBAL_FLAG_TIMERNEXT)
+
+#undef CO_CONFIG_BOOTUP_MGR
+#define CO_CONFIG_BOOTUP_MGR (CO_TARGET_BOOTUP_MGR | CO_CONFIG_GLOBAL_FLAG_TIMERNEXT)
+
+/* Master assigns node-IDs to fresh slaves, see CO_LSScommission_start() */
+#undef CO_CONFIG_LSS
+#define CO_CONFIG_LSS (CO_CONFIG_LSS_SLAVE | CO_TARGET_LSS_MASTER | CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE | CO_CONFIG_GLOBAL_FLAG_TIMERNEXT)
+
+#undef CO_CONFIG_SDO_SRV
+#define CO_CONFIG_SDO_SRV (CO_CONFIG_SDO_SRV_SEGMENTED | CO_CONFIG_SDO_SRV_BLOCK | CO_CONFIG_SDO_SRV_BUFFER_SHARED | CO_CONFIG_SDO_SRV_STREAM | CO_CONFIG_SDO_SRV_BUFFER_POOL | CO_CONFIG_SDO_SRV_STATS | CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE | CO_CONFIG_GLOBAL_FLAG_TIMERNEXT | CO_CONFIG_GLOBAL_FLAG_OD_DYNAMIC)
+
+/* SDO server buffer is the RAM budget for block transfer, 64 segments per
+ * block fit into F103 RAM. Buffers are shared by SDO servers from a pool of
+ * min(CO_CONFIG_SDO_SRV_POOL_SIZE, OD_CNT_SDO_SRV) buffers. Buffer can be
+ * used by application, while SDO server is idle, see
+ * CO_SDOserver_bufferAcquire(). */
+#undef CO_CONFIG_SDO_SRV_BUFFER_SIZE
+#define CO_CONFIG_SDO_SRV_BUFFER_SIZE (7 * 64 + 2)
+
+#undef CO_CONFIG_CRC16
+#define CO_CONFIG_CRC16 (CO_CONFIG_CRC16_ENABLE | CO_CONFIG_CRC16_SLICE4)
 
 #undef CO_CONFIG_PDO
-#define CO_CONFIG_PDO (CO_CONFIG_RPDO_ENABLE | CO_CONFIG_TPDO_ENABLE | CO_CONFIG_RPDO_TIMERS_ENABLE | CO_CONFIG_TPDO_TIMERS_ENABLE | CO_CONFIG_FLAG_CALLBACK_PRE | CO_CONFIG_GLOBAL_FLAG_TIMERNEXT)
+#define CO_CONFIG_PDO (CO_CONFIG_RPDO_ENABLE | CO_CONFIG_TPDO_ENABLE | CO_CONFIG_RPDO_TIMERS_ENABLE | CO_CONFIG_TPDO_TIMERS_ENABLE | CO_CONFIG_RPDO_MAILBOX | CO_CONFIG_PDO_REMAP | CO_CONFIG_FLAG_CALLBACK_PRE | CO_CONFIG_GLOBAL_FLAG_TIMERNEXT)
 
 #undef CO_CONFIG_LEDS
 #define CO_CONFIG_LEDS (CO_CONFIG_LEDS_ENABLE | CO_CONFIG_FLAG_TIMERNEXT)
@@ -87,6 +150,8 @@ typedef struct {
     volatile bool_t firstCANtxMessage;
     volatile uint16_t CANtxCount;
     uint32_t errOld;
+    void *rxMonitorObject;
+    void (*rxMonitor)(void *object, void *message);
 } CO_CANmodule_t;
 
 /* Data storage object for one entry */
@@ -114,11 +179,36 @@ typedef struct {
 uint16_t CO_CANrxMsg_readIdent(void *msg);
 uint8_t *CO_CANrxMsg_readData(void *msg);
 uint8_t  CO_CANrxMsg_readDLC(void *msg);
+uint32_t CO_CANrxMsg_readTimestamp(void *msg);
 
 
 /* Prototypes */
 void CO_CANinterruptRx(CO_CANmodule_t *CANmodule);
 
+/* Emergency log image on its own flash page, reserved by the linker, see
+ * CO_EMlog_initFlash() */
+bool_t CO_EMlog_flashWrite(void *object, const void *data, size_t size);
+bool_t CO_EMlog_flashRead(void *object, void *data, size_t size);
+
+/* SYNC producer on hardware timer and reserved bxCAN mailbox 2, see
+ * CO_SYNC_initHwProducer(). Object is CO_SYNC_t. */
+bool_t CO_SYNC_hwSend(void *object, const CO_CANtx_t *buffer);
+void CO_SYNC_hwPeriod(void *object, uint32_t period_us);
+
+/* Local microsecond counter, see CO_TIME_initClock() and
+ * CO_SYNC_initTimestamp() */
+uint32_t CO_TIME_localTime_us(void);
+
+/* LSS slave configuration in the last bytes of emulated EEPROM. Store has the
+ * signature of the callback from CO_LSSslave_initCfgStoreCallback(). Load
+ * returns false and leaves nodeId and bitRate unchanged, if nothing was
+ * stored. */
+bool_t CO_LSS_flashStore(void *object, uint8_t nodeId, uint16_t bitRate);
+bool_t CO_LSS_flashLoad(uint8_t *nodeId, uint16_t *bitRate);
+
+/* LSS serial number from the 96-bit unique device ID of the MCU */
+uint32_t CO_LSS_serialNumber(void);
+
 #ifdef __cplusplus
 }
 #endif
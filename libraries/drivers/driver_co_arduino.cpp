@@ -37,11 +37,23 @@
 #include <STM32_CAN.h>
 
 #include "CO_app_STM32.h"
+#include "stm32_eeprom.h"
 
 extern CAN_message_t msg;
 extern bool messagePending;
 
 
+/* Local CAN module object */
+static CO_CANmodule_t* CANModule_local = NULL; /* Local instance of global CAN module */
+
+/* Reception time of the message being dispatched by CO_CANinterruptRx(),
+ * in micros() time base. See CO_CANrxMsg_readTimestamp(). */
+static uint32_t rxTimestamp_us = 0;
+#if defined CO_STM32_FDCAN_Driver && defined CO_CAN_RX_HW_TIMESTAMP
+/* CAN bit time in nanoseconds, FDCAN timestamp counter counts bit times */
+static uint32_t rxBitTime_ns = 2000;
+#endif
+
 // le block permettant de faire des déclarations du target de manière propre sans avoir d'erreur du à l'inclusion de la bibliothéque stm32_can dans mon target.h
 extern "C" {
   uint16_t CO_CANrxMsg_readIdent(void *msg) {
@@ -55,11 +67,30 @@ extern "C" {
   uint8_t CO_CANrxMsg_readDLC(void *msg) {
     return ((CAN_message_t *)msg)->len;
   }
-}
 
+  uint32_t CO_CANrxMsg_readTimestamp(void *msg) {
+#if defined CO_STM32_FDCAN_Driver && defined CO_CAN_RX_HW_TIMESTAMP
+    /* FDCAN timestamp counter is readable, so message age can be measured in
+     * bit times and referred back to micros(). bxCAN counter is not readable,
+     * time of retrieval from FIFO is used there. */
+    stm32_can_t* internalCAN = (stm32_can_t*)(CANModule_local->CANptr);
+    uint16_t now = (uint16_t)((FDCAN_HandleTypeDef*) &internalCAN->handle)->Instance->TSCV;
+    uint16_t ageBits = (uint16_t)(now - ((CAN_message_t *)msg)->timestamp);
+    return micros() - (uint32_t)(((uint64_t)ageBits * rxBitTime_ns) / 1000U);
+#elif defined CO_CAN_RX_HW_TIMESTAMP
+    /* bxCAN counter is not readable, STM32_CAN stores low 16 bits of micros()
+     * in the receive interrupt instead, see setRxTimestampMicros(). Message
+     * must be dispatched within 65 ms. */
+    uint32_t now = micros();
+    uint16_t age = (uint16_t)((uint16_t)now - ((CAN_message_t *)msg)->timestamp);
+    return now - age;
+#else
+    (void)msg;
+    return rxTimestamp_us;
+#endif
+  }
+}
 
-/* Local CAN module object */
-static CO_CANmodule_t* CANModule_local = NULL; /* Local instance of global CAN module */
 
 /* CAN masks for identifiers */
 #define CANID_MASK 0x07FF /*!< CAN standard ID mask */
@@ -106,6 +137,7 @@ CO_ReturnError_t CO_CANmodule_init(
   log_printf("Voic le petit baudrate: %d\n", CANbitRate);
 
 
+  CANModule_local = CANmodule;
   CANmodule->CANptr = CANptr;
   CANmodule->rxArray = rxArray;
   CANmodule->rxSize = rxSize;
@@ -117,6 +149,8 @@ CO_ReturnError_t CO_CANmodule_init(
   CANmodule->bufferInhibitFlag = false;
   CANmodule->CANtxCount = 0;
   CANmodule->errOld = 0;
+  CANmodule->rxMonitorObject = NULL;
+  CANmodule->rxMonitor = NULL;
 
   /* Reset all variables */
   for (uint16_t i = 0U; i < rxSize; i++) {
@@ -136,6 +170,11 @@ CO_ReturnError_t CO_CANmodule_init(
   log_printf("Voic le petit baudrate: %d\n", CANbitRate);
 
   can->setBaudRate(CANbitRate*1000);
+#if defined CO_STM32_FDCAN_Driver && defined CO_CAN_RX_HW_TIMESTAMP
+  rxBitTime_ns = 1000000U / CANbitRate;
+#elif defined CO_CAN_RX_HW_TIMESTAMP
+  can->setRxTimestampMicros(true);
+#endif
 
   log_printf("CO_CANmodule_init 3\n");
 
@@ -198,6 +237,16 @@ CO_ReturnError_t CO_CANrxBufferInit(CO_CANmodule_t *CANmodule, uint16_t index, u
   return ret;
 }
 
+/******************************************************************************/
+void CO_CANrxMonitorInit(CO_CANmodule_t *CANmodule, void *object,
+                         void (*CANrx_callback)(void *object, void *message)) {
+  if (CANmodule != NULL) {
+    CANmodule->rxMonitor = NULL;
+    CANmodule->rxMonitorObject = object;
+    CANmodule->rxMonitor = CANrx_callback;
+  }
+}
+
 /******************************************************************************/
 CO_CANtx_t *CO_CANtxBufferInit(CO_CANmodule_t *CANmodule, uint16_t index, uint16_t ident, bool_t rtr, uint8_t noOfBytes, bool_t syncFlag) {
   CO_CANtx_t *buffer = NULL;
@@ -375,12 +424,19 @@ void CO_CANinterruptRx(CO_CANmodule_t *CANmodule) {
     }
 
     log_printf("Début traitement message...\n");
+    rxTimestamp_us = micros();
 
     uint32_t ident = msg.id & 0x7FF;
     CO_CANrx_t *buffer = NULL;
     bool msgMatched = false;
 
     log_printf("CAN ID reçu : 0x%03X\n", ident);
+
+    /* receive monitor sees all messages, also those without buffer */
+    if (CANmodule->rxMonitor != NULL) {
+        CAN_message_t monitorMsg = msg;
+        CANmodule->rxMonitor(CANmodule->rxMonitorObject, &monitorMsg);
+    }
     log_printf("Recherche d'un buffer correspondant dans rxArray (%d entrées)...\n", CANmodule->rxSize);
 
     for (uint16_t i = 0; i < CANmodule->rxSize; i++) {
@@ -432,6 +488,189 @@ void CO_CANinterruptRx(CO_CANmodule_t *CANmodule) {
     log_printf("Fin traitement message.\n\n");
 }
 
+/* LSS slave configuration at the end of emulated EEPROM: magic, node-ID,
+ * bit rate (2 bytes, little endian) and check byte. */
+#define CO_LSS_FLASH_SIZE 5U
+#define CO_LSS_FLASH_ADDR ((uint32_t)E2END + 1U - CO_LSS_FLASH_SIZE)
+#define CO_LSS_FLASH_MAGIC 0xA5U
+
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_LOG
+/* Emergency log image on its own flash page. The page is reserved by the
+ * linker: page aligned constant in .rodata, so neither code nor emulated
+ * EEPROM shares it and its address comes from the link. Firmware upload
+ * clears it. Volatile, so reads are not folded to the initial value. */
+static_assert(sizeof(CO_EMlogRam_t) <= FLASH_PAGE_SIZE,
+              "Emergency log image does not fit into one flash page");
+__attribute__((section(".rodata.co_emlog"), aligned(FLASH_PAGE_SIZE), used))
+static const volatile uint8_t CO_EMlogFlash[FLASH_PAGE_SIZE] = {0};
+
+/******************************************************************************/
+bool_t CO_EMlog_flashWrite(void *object, const void *data, size_t size) {
+  const uint8_t *d = (const uint8_t *)data;
+  const uint32_t addr = (uint32_t)CO_EMlogFlash;
+  FLASH_EraseInitTypeDef erase = {0};
+  uint32_t pageError = 0;
+  bool_t ok = true;
+  (void)object;
+
+  if (size > sizeof(CO_EMlogFlash)) {
+    return false;
+  }
+  /* Page erase stalls the CPU for about 20 ms, so log writes are rare */
+  HAL_FLASH_Unlock();
+  erase.TypeErase = FLASH_TYPEERASE_PAGES;
+  erase.Banks = FLASH_BANK_1;
+  erase.PageAddress = addr;
+  erase.NbPages = 1;
+  if (HAL_FLASHEx_Erase(&erase, &pageError) != HAL_OK) {
+    ok = false;
+  }
+  for (size_t i = 0; ok && i < size; i += 4) {
+    uint32_t word = 0xFFFFFFFFU;
+    memcpy(&word, &d[i], (size - i < 4) ? size - i : 4);
+    if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr + i, word) != HAL_OK) {
+      ok = false;
+    }
+  }
+  HAL_FLASH_Lock();
+  return ok;
+}
+
+/******************************************************************************/
+bool_t CO_EMlog_flashRead(void *object, void *data, size_t size) {
+  uint8_t *d = (uint8_t *)data;
+  (void)object;
+
+  if (size > sizeof(CO_EMlogFlash)) {
+    return false;
+  }
+  /* erased or uploaded page does not have the magic, image is rejected */
+  for (size_t i = 0; i < size; i++) {
+    d[i] = CO_EMlogFlash[i];
+  }
+  return true;
+}
+#endif
+
+/******************************************************************************/
+bool_t CO_LSS_flashStore(void *object, uint8_t nodeId, uint16_t bitRate) {
+  uint8_t d[CO_LSS_FLASH_SIZE] = {
+    CO_LSS_FLASH_MAGIC, nodeId, (uint8_t)bitRate, (uint8_t)(bitRate >> 8), 0
+  };
+  (void)object;
+
+  d[4] = (uint8_t)~(d[0] ^ d[1] ^ d[2] ^ d[3]);
+  /* Read the whole page first, so the rest of emulated EEPROM is kept */
+  eeprom_buffer_fill();
+  for (uint32_t i = 0; i < CO_LSS_FLASH_SIZE; i++) {
+    eeprom_buffered_write_byte(CO_LSS_FLASH_ADDR + i, d[i]);
+  }
+  eeprom_buffer_flush();
+  return true;
+}
+
+/******************************************************************************/
+bool_t CO_LSS_flashLoad(uint8_t *nodeId, uint16_t *bitRate) {
+  uint8_t d[CO_LSS_FLASH_SIZE];
+
+  eeprom_buffer_fill();
+  for (uint32_t i = 0; i < CO_LSS_FLASH_SIZE; i++) {
+    d[i] = eeprom_buffered_read_byte(CO_LSS_FLASH_ADDR + i);
+  }
+  /* erased flash reads 0xFF, so magic and check byte do not match */
+  if (d[0] != CO_LSS_FLASH_MAGIC
+      || d[4] != (uint8_t)~(d[0] ^ d[1] ^ d[2] ^ d[3])
+      || !CO_LSS_NODE_ID_VALID(d[1])) {
+    return false;
+  }
+  *nodeId = d[1];
+  *bitRate = (uint16_t)(d[2] | ((uint16_t)d[3] << 8));
+  return true;
+}
+
+/******************************************************************************/
+uint32_t CO_LSS_serialNumber(void) {
+  /* Unique ID is wafer X/Y, wafer and lot number. Words are mixed, so boards
+   * from the same lot differ in the result. */
+  uint32_t w1 = HAL_GetUIDw1();
+  return HAL_GetUIDw0() ^ ((w1 << 13) | (w1 >> 19)) ^ HAL_GetUIDw2();
+}
+
+#if ((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_PRODUCER_HW) && !defined CO_STM32_FDCAN_Driver
+/* SYNC producer on hardware timer. Timer interrupt has higher priority than
+ * CAN interrupts, so SYNC is written into the reserved mailbox on time, also
+ * while other CAN messages are being processed. Transmission is timestamped
+ * with DWT cycle counter in the transmit complete interrupt. With
+ * STM32_CAN_USB_WORKAROUND_POLLING that interrupt is polled, jitter then
+ * includes the polling latency. */
+#ifndef CO_SYNC_HW_TIM
+#define CO_SYNC_HW_TIM TIM3
+#endif
+#ifndef CO_SYNC_HW_IRQ_PRIORITY
+#define CO_SYNC_HW_IRQ_PRIORITY 1
+#endif
+
+static CO_SYNC_t *syncHw = NULL;
+
+static void CO_SYNC_hwTimerCallback(void) {
+  CO_SYNC_hwTimerIsr(syncHw);
+}
+
+static void CO_SYNC_hwTxCallback(void *arg) {
+  CO_SYNC_hwTxComplete((CO_SYNC_t *)arg, DWT->CYCCNT);
+}
+
+/******************************************************************************/
+bool_t CO_SYNC_hwSend(void *object, const CO_CANtx_t *buffer) {
+  (void)object;
+  if (CANModule_local == NULL) return false;
+
+  CAN_message_t txMsg;
+  txMsg.id = buffer->ident & CANID_MASK;
+  txMsg.flags.remote = (buffer->ident & FLAG_RTR) != 0;
+  txMsg.len = buffer->DLC;
+  memcpy(txMsg.buf, buffer->data, sizeof(txMsg.buf));
+
+  STM32_CAN *can = (STM32_CAN *)CANModule_local->CANptr;
+  return can->writeReserved(txMsg);
+}
+
+/******************************************************************************/
+void CO_SYNC_hwPeriod(void *object, uint32_t period_us) {
+  static HardwareTimer syncTimer(CO_SYNC_HW_TIM);
+  static bool started = false;
+  STM32_CAN *can = (CANModule_local != NULL) ? (STM32_CAN *)CANModule_local->CANptr : NULL;
+
+  if (!started) {
+    started = true;
+    syncTimer.attachInterrupt(CO_SYNC_hwTimerCallback);
+    /* free running cycle counter for timestamps */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  }
+
+  syncTimer.pause();
+  syncHw = (CO_SYNC_t *)object;
+  if (period_us == 0) {
+    if (can != NULL) can->releaseTxMailbox();
+    return;
+  }
+
+  if (can != NULL) can->reserveTxMailbox(CO_SYNC_hwTxCallback, object);
+  syncTimer.setOverflow(period_us, MICROSEC_FORMAT);
+  syncTimer.setInterruptPriority(CO_SYNC_HW_IRQ_PRIORITY, 0);
+  syncTimer.refresh();
+  syncTimer.resume();
+}
+#endif
+
+/******************************************************************************/
+uint32_t CO_TIME_localTime_us(void) {
+  /* same time base as CO_CANrxMsg_readTimestamp() */
+  return micros();
+}
+
 
 
 // ---------------- SDO client helpers ----------------
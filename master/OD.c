@@ -25,7 +25,7 @@ OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM = {
     .x1005_COB_ID_SYNCMessage = 0x00000080,
     .x1006_communicationCyclePeriod = 0x00000000,
     .x1007_synchronousWindowLength = 0x00000000,
-    .x1012_COB_IDTimeStampObject = 0x00000100,
+    .x1012_COB_IDTimeStampObject = 0x40000100,
     .x1014_COB_ID_EMCY = 0x00000080,
     .x1015_inhibitTimeEMCY = 0x0000,
     .x1016_consumerHeartbeatTime_sub0 = 0x08,
@@ -45,6 +45,24 @@ OD_ATTR_PERSIST_COMM OD_PERSIST_COMM_t OD_PERSIST_COMM = {
         .COB_IDServerToClientRx = 0x80000000,
         .node_IDOfTheSDOServer = 0x01
     },
+    .x1281_SDOClientParameter = {
+        .highestSub_indexSupported = 0x03,
+        .COB_IDClientToServerTx = 0x80000000,
+        .COB_IDServerToClientRx = 0x80000000,
+        .node_IDOfTheSDOServer = 0x01
+    },
+    .x1282_SDOClientParameter = {
+        .highestSub_indexSupported = 0x03,
+        .COB_IDClientToServerTx = 0x80000000,
+        .COB_IDServerToClientRx = 0x80000000,
+        .node_IDOfTheSDOServer = 0x01
+    },
+    .x1283_SDOClientParameter = {
+        .highestSub_indexSupported = 0x03,
+        .COB_IDClientToServerTx = 0x80000000,
+        .COB_IDServerToClientRx = 0x80000000,
+        .node_IDOfTheSDOServer = 0x01
+    },
     .x1400_RPDOCommunicationParameter = {
         .highestSub_indexSupported = 0x05,
         .COB_IDUsedByRPDO = 0x00000181,
@@ -229,6 +247,9 @@ typedef struct {
     OD_obj_var_t o_1019_synchronousCounterOverflowValue;
     OD_obj_record_t o_1200_SDOServerParameter[3];
     OD_obj_record_t o_1280_SDOClientParameter[4];
+    OD_obj_record_t o_1281_SDOClientParameter[4];
+    OD_obj_record_t o_1282_SDOClientParameter[4];
+    OD_obj_record_t o_1283_SDOClientParameter[4];
     OD_obj_record_t o_1400_RPDOCommunicationParameter[4];
     OD_obj_record_t o_1401_RPDOCommunicationParameter[4];
     OD_obj_record_t o_1402_RPDOCommunicationParameter[4];
@@ -246,6 +267,13 @@ typedef struct {
     OD_obj_record_t o_1A02_TPDOMappingParameter[9];
     OD_obj_record_t o_1A03_TPDOMappingParameter[9];
     OD_obj_array_t o_2110_counter;
+    OD_obj_var_t o_2200_PDORemap;
+    OD_obj_record_t o_2210_SDOServerStatistics[37];
+    OD_obj_record_t o_2211_SDOClientStatistics[37];
+    OD_obj_array_t o_2220_emergencyCounters;
+    OD_obj_var_t o_2221_emergencyLog;
+    OD_obj_var_t o_2222_emergencyTable;
+    OD_obj_array_t o_2230_SYNCJitter;
 } ODObjs_t;
 
 static CO_PROGMEM ODObjs_t ODObjs = {
@@ -409,6 +437,84 @@ static CO_PROGMEM ODObjs_t ODObjs = {
             .dataLength = 1
         }
     },
+    .o_1281_SDOClientParameter = {
+        {
+            .dataOrig = &OD_PERSIST_COMM.x1281_SDOClientParameter.highestSub_indexSupported,
+            .subIndex = 0,
+            .attribute = ODA_SDO_R,
+            .dataLength = 1
+        },
+        {
+            .dataOrig = &OD_PERSIST_COMM.x1281_SDOClientParameter.COB_IDClientToServerTx,
+            .subIndex = 1,
+            .attribute = ODA_SDO_RW | ODA_TRPDO | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_PERSIST_COMM.x1281_SDOClientParameter.COB_IDServerToClientRx,
+            .subIndex = 2,
+            .attribute = ODA_SDO_RW | ODA_TRPDO | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_PERSIST_COMM.x1281_SDOClientParameter.node_IDOfTheSDOServer,
+            .subIndex = 3,
+            .attribute = ODA_SDO_RW,
+            .dataLength = 1
+        }
+    },
+    .o_1282_SDOClientParameter = {
+        {
+            .dataOrig = &OD_PERSIST_COMM.x1282_SDOClientParameter.highestSub_indexSupported,
+            .subIndex = 0,
+            .attribute = ODA_SDO_R,
+            .dataLength = 1
+        },
+        {
+            .dataOrig = &OD_PERSIST_COMM.x1282_SDOClientParameter.COB_IDClientToServerTx,
+            .subIndex = 1,
+            .attribute = ODA_SDO_RW | ODA_TRPDO | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_PERSIST_COMM.x1282_SDOClientParameter.COB_IDServerToClientRx,
+            .subIndex = 2,
+            .attribute = ODA_SDO_RW | ODA_TRPDO | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_PERSIST_COMM.x1282_SDOClientParameter.node_IDOfTheSDOServer,
+            .subIndex = 3,
+            .attribute = ODA_SDO_RW,
+            .dataLength = 1
+        }
+    },
+    .o_1283_SDOClientParameter = {
+        {
+            .dataOrig = &OD_PERSIST_COMM.x1283_SDOClientParameter.highestSub_indexSupported,
+            .subIndex = 0,
+            .attribute = ODA_SDO_R,
+            .dataLength = 1
+        },
+        {
+            .dataOrig = &OD_PERSIST_COMM.x1283_SDOClientParameter.COB_IDClientToServerTx,
+            .subIndex = 1,
+            .attribute = ODA_SDO_RW | ODA_TRPDO | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_PERSIST_COMM.x1283_SDOClientParameter.COB_IDServerToClientRx,
+            .subIndex = 2,
+            .attribute = ODA_SDO_RW | ODA_TRPDO | ODA_MB,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = &OD_PERSIST_COMM.x1283_SDOClientParameter.node_IDOfTheSDOServer,
+            .subIndex = 3,
+            .attribute = ODA_SDO_RW,
+            .dataLength = 1
+        }
+    },
     .o_1400_RPDOCommunicationParameter = {
         {
             .dataOrig = &OD_PERSIST_COMM.x1400_RPDOCommunicationParameter.highestSub_indexSupported,
@@ -1120,7 +1226,486 @@ static CO_PROGMEM ODObjs_t ODObjs = {
         .attribute = ODA_SDO_RW | ODA_TRPDO | ODA_MB,
         .dataElementLength = 4,
         .dataElementSizeof = sizeof(uint32_t)
-    }
+    },
+    .o_2200_PDORemap = {
+        .dataOrig = NULL,
+        .attribute = ODA_SDO_RW,
+        .dataLength = 0
+    },
+    .o_2210_SDOServerStatistics = {
+        {
+            .dataOrig = NULL,
+            .subIndex = 0,
+            .attribute = ODA_SDO_R,
+            .dataLength = 1
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 1,
+            .attribute = ODA_SDO_RW,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 2,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 3,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 4,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 5,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 6,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 7,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 8,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 9,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 10,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 11,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 12,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 13,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 14,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 15,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 16,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 17,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 18,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 19,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 20,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 21,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 22,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 23,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 24,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 25,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 26,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 27,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 28,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 29,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 30,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 31,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 32,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 33,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 34,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 35,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 36,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        }
+    },
+    .o_2211_SDOClientStatistics = {
+        {
+            .dataOrig = NULL,
+            .subIndex = 0,
+            .attribute = ODA_SDO_R,
+            .dataLength = 1
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 1,
+            .attribute = ODA_SDO_RW,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 2,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 3,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 4,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 5,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 6,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 7,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 8,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 9,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 10,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 11,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 12,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 13,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 14,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 15,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 16,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 17,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 18,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 19,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 20,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 21,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 22,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 23,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 24,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 25,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 26,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 27,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 28,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 29,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 30,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 31,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 32,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 33,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 34,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 35,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        },
+        {
+            .dataOrig = NULL,
+            .subIndex = 36,
+            .attribute = ODA_SDO_R,
+            .dataLength = 4
+        }
+    },
+    .o_2220_emergencyCounters = {
+        .dataOrig0 = NULL,
+        .dataOrig = NULL,
+        .attribute0 = ODA_SDO_R,
+        .attribute = ODA_SDO_RW | ODA_MB,
+        .dataElementLength = 2,
+        .dataElementSizeof = sizeof(uint16_t)
+    },
+    .o_2221_emergencyLog = {
+        .dataOrig = NULL,
+        .attribute = ODA_SDO_RW,
+        .dataLength = 0
+    },
+    .o_2222_emergencyTable = {
+        .dataOrig = NULL,
+        .attribute = ODA_SDO_R,
+        .dataLength = 0
+    },
+    .o_2230_SYNCJitter = {
+        .dataOrig0 = NULL,
+        .dataOrig = NULL,
+        .attribute0 = ODA_SDO_R,
+        .attribute = ODA_SDO_R | ODA_MB,
+        .dataElementLength = 4,
+        .dataElementSizeof = sizeof(int32_t)
+    }
 };
 
 
@@ -1145,6 +1730,9 @@ static OD_ATTR_OD OD_entry_t ODList[] = {
     {0x1019, 0x01, ODT_VAR, &ODObjs.o_1019_synchronousCounterOverflowValue, NULL},
     {0x1200, 0x03, ODT_REC, &ODObjs.o_1200_SDOServerParameter, NULL},
     {0x1280, 0x04, ODT_REC, &ODObjs.o_1280_SDOClientParameter, NULL},
+    {0x1281, 0x04, ODT_REC, &ODObjs.o_1281_SDOClientParameter, NULL},
+    {0x1282, 0x04, ODT_REC, &ODObjs.o_1282_SDOClientParameter, NULL},
+    {0x1283, 0x04, ODT_REC, &ODObjs.o_1283_SDOClientParameter, NULL},
     {0x1400, 0x04, ODT_REC, &ODObjs.o_1400_RPDOCommunicationParameter, NULL},
     {0x1401, 0x04, ODT_REC, &ODObjs.o_1401_RPDOCommunicationParameter, NULL},
     {0x1402, 0x04, ODT_REC, &ODObjs.o_1402_RPDOCommunicationParameter, NULL},
@@ -1162,6 +1750,13 @@ static OD_ATTR_OD OD_entry_t ODList[] = {
     {0x1A02, 0x09, ODT_REC, &ODObjs.o_1A02_TPDOMappingParameter, NULL},
     {0x1A03, 0x09, ODT_REC, &ODObjs.o_1A03_TPDOMappingParameter, NULL},
     {0x2110, 0x02, ODT_ARR, &ODObjs.o_2110_counter, NULL},
+    {0x2200, 0x01, ODT_VAR, &ODObjs.o_2200_PDORemap, NULL},
+    {0x2210, 0x25, ODT_REC, &ODObjs.o_2210_SDOServerStatistics, NULL},
+    {0x2211, 0x25, ODT_REC, &ODObjs.o_2211_SDOClientStatistics, NULL},
+    {0x2220, 0x52, ODT_ARR, &ODObjs.o_2220_emergencyCounters, NULL},
+    {0x2221, 0x01, ODT_VAR, &ODObjs.o_2221_emergencyLog, NULL},
+    {0x2222, 0x01, ODT_VAR, &ODObjs.o_2222_emergencyTable, NULL},
+    {0x2230, 0x07, ODT_ARR, &ODObjs.o_2230_SYNCJitter, NULL},
     {0x0000, 0x00, 0, NULL, NULL}
 };
 
@@ -43,7 +43,7 @@
 #define OD_CNT_HB_CONS 1
 #define OD_CNT_HB_PROD 1
 #define OD_CNT_SDO_SRV 1
-#define OD_CNT_SDO_CLI 1
+#define OD_CNT_SDO_CLI 4
 #define OD_CNT_RPDO 4
 #define OD_CNT_TPDO 4
 
@@ -86,6 +86,24 @@ typedef struct {
         uint32_t COB_IDServerToClientRx;
         uint8_t node_IDOfTheSDOServer;
     } x1280_SDOClientParameter;
+    struct {
+        uint8_t highestSub_indexSupported;
+        uint32_t COB_IDClientToServerTx;
+        uint32_t COB_IDServerToClientRx;
+        uint8_t node_IDOfTheSDOServer;
+    } x1281_SDOClientParameter;
+    struct {
+        uint8_t highestSub_indexSupported;
+        uint32_t COB_IDClientToServerTx;
+        uint32_t COB_IDServerToClientRx;
+        uint8_t node_IDOfTheSDOServer;
+    } x1282_SDOClientParameter;
+    struct {
+        uint8_t highestSub_indexSupported;
+        uint32_t COB_IDClientToServerTx;
+        uint32_t COB_IDServerToClientRx;
+        uint8_t node_IDOfTheSDOServer;
+    } x1283_SDOClientParameter;
     struct {
         uint8_t highestSub_indexSupported;
         uint32_t COB_IDUsedByRPDO;
@@ -283,23 +301,33 @@ extern OD_ATTR_OD OD_t *OD;
 #define OD_ENTRY_H1019 &OD->list[14]
 #define OD_ENTRY_H1200 &OD->list[15]
 #define OD_ENTRY_H1280 &OD->list[16]
-#define OD_ENTRY_H1400 &OD->list[17]
-#define OD_ENTRY_H1401 &OD->list[18]
-#define OD_ENTRY_H1402 &OD->list[19]
-#define OD_ENTRY_H1403 &OD->list[20]
-#define OD_ENTRY_H1600 &OD->list[21]
-#define OD_ENTRY_H1601 &OD->list[22]
-#define OD_ENTRY_H1602 &OD->list[23]
-#define OD_ENTRY_H1603 &OD->list[24]
-#define OD_ENTRY_H1800 &OD->list[25]
-#define OD_ENTRY_H1801 &OD->list[26]
-#define OD_ENTRY_H1802 &OD->list[27]
-#define OD_ENTRY_H1803 &OD->list[28]
-#define OD_ENTRY_H1A00 &OD->list[29]
-#define OD_ENTRY_H1A01 &OD->list[30]
-#define OD_ENTRY_H1A02 &OD->list[31]
-#define OD_ENTRY_H1A03 &OD->list[32]
-#define OD_ENTRY_H2110 &OD->list[33]
+#define OD_ENTRY_H1281 &OD->list[17]
+#define OD_ENTRY_H1282 &OD->list[18]
+#define OD_ENTRY_H1283 &OD->list[19]
+#define OD_ENTRY_H1400 &OD->list[20]
+#define OD_ENTRY_H1401 &OD->list[21]
+#define OD_ENTRY_H1402 &OD->list[22]
+#define OD_ENTRY_H1403 &OD->list[23]
+#define OD_ENTRY_H1600 &OD->list[24]
+#define OD_ENTRY_H1601 &OD->list[25]
+#define OD_ENTRY_H1602 &OD->list[26]
+#define OD_ENTRY_H1603 &OD->list[27]
+#define OD_ENTRY_H1800 &OD->list[28]
+#define OD_ENTRY_H1801 &OD->list[29]
+#define OD_ENTRY_H1802 &OD->list[30]
+#define OD_ENTRY_H1803 &OD->list[31]
+#define OD_ENTRY_H1A00 &OD->list[32]
+#define OD_ENTRY_H1A01 &OD->list[33]
+#define OD_ENTRY_H1A02 &OD->list[34]
+#define OD_ENTRY_H1A03 &OD->list[35]
+#define OD_ENTRY_H2110 &OD->list[36]
+#define OD_ENTRY_H2200 &OD->list[37]
+#define OD_ENTRY_H2210 &OD->list[38]
+#define OD_ENTRY_H2211 &OD->list[39]
+#define OD_ENTRY_H2220 &OD->list[40]
+#define OD_ENTRY_H2221 &OD->list[41]
+#define OD_ENTRY_H2222 &OD->list[42]
+#define OD_ENTRY_H2230 &OD->list[43]
 
 
 /*******************************************************************************
@@ -322,23 +350,33 @@ extern OD_ATTR_OD OD_t *OD;
 #define OD_ENTRY_H1019_synchronousCounterOverflowValue &OD->list[14]
 #define OD_ENTRY_H1200_SDOServerParameter &OD->list[15]
 #define OD_ENTRY_H1280_SDOClientParameter &OD->list[16]
-#define OD_ENTRY_H1400_RPDOCommunicationParameter &OD->list[17]
-#define OD_ENTRY_H1401_RPDOCommunicationParameter &OD->list[18]
-#define OD_ENTRY_H1402_RPDOCommunicationParameter &OD->list[19]
-#define OD_ENTRY_H1403_RPDOCommunicationParameter &OD->list[20]
-#define OD_ENTRY_H1600_RPDOMappingParameter &OD->list[21]
-#define OD_ENTRY_H1601_RPDOMappingParameter &OD->list[22]
-#define OD_ENTRY_H1602_RPDOMappingParameter &OD->list[23]
-#define OD_ENTRY_H1603_RPDOMappingParameter &OD->list[24]
-#define OD_ENTRY_H1800_TPDOCommunicationParameter &OD->list[25]
-#define OD_ENTRY_H1801_TPDOCommunicationParameter &OD->list[26]
-#define OD_ENTRY_H1802_TPDOCommunicationParameter &OD->list[27]
-#define OD_ENTRY_H1803_TPDOCommunicationParameter &OD->list[28]
-#define OD_ENTRY_H1A00_TPDOMappingParameter &OD->list[29]
-#define OD_ENTRY_H1A01_TPDOMappingParameter &OD->list[30]
-#define OD_ENTRY_H1A02_TPDOMappingParameter &OD->list[31]
-#define OD_ENTRY_H1A03_TPDOMappingParameter &OD->list[32]
-#define OD_ENTRY_H2110_counter &OD->list[33]
+#define OD_ENTRY_H1281_SDOClientParameter &OD->list[17]
+#define OD_ENTRY_H1282_SDOClientParameter &OD->list[18]
+#define OD_ENTRY_H1283_SDOClientParameter &OD->list[19]
+#define OD_ENTRY_H1400_RPDOCommunicationParameter &OD->list[20]
+#define OD_ENTRY_H1401_RPDOCommunicationParameter &OD->list[21]
+#define OD_ENTRY_H1402_RPDOCommunicationParameter &OD->list[22]
+#define OD_ENTRY_H1403_RPDOCommunicationParameter &OD->list[23]
+#define OD_ENTRY_H1600_RPDOMappingParameter &OD->list[24]
+#define OD_ENTRY_H1601_RPDOMappingParameter &OD->list[25]
+#define OD_ENTRY_H1602_RPDOMappingParameter &OD->list[26]
+#define OD_ENTRY_H1603_RPDOMappingParameter &OD->list[27]
+#define OD_ENTRY_H1800_TPDOCommunicationParameter &OD->list[28]
+#define OD_ENTRY_H1801_TPDOCommunicationParameter &OD->list[29]
+#define OD_ENTRY_H1802_TPDOCommunicationParameter &OD->list[30]
+#define OD_ENTRY_H1803_TPDOCommunicationParameter &OD->list[31]
+#define OD_ENTRY_H1A00_TPDOMappingParameter &OD->list[32]
+#define OD_ENTRY_H1A01_TPDOMappingParameter &OD->list[33]
+#define OD_ENTRY_H1A02_TPDOMappingParameter &OD->list[34]
+#define OD_ENTRY_H1A03_TPDOMappingParameter &OD->list[35]
+#define OD_ENTRY_H2110_counter &OD->list[36]
+#define OD_ENTRY_H2200_PDORemap &OD->list[37]
+#define OD_ENTRY_H2210_SDOServerStatistics &OD->list[38]
+#define OD_ENTRY_H2211_SDOClientStatistics &OD->list[39]
+#define OD_ENTRY_H2220_emergencyCounters &OD->list[40]
+#define OD_ENTRY_H2221_emergencyLog &OD->list[41]
+#define OD_ENTRY_H2222_emergencyTable &OD->list[42]
+#define OD_ENTRY_H2230_SYNCJitter &OD->list[43]
 
 
 /*******************************************************************************
@@ -4,6 +4,8 @@
 #define USE_HAL_DRIVER          // Active l'utilisation de la HAL
 #define HAL_CAN_MODULE_ENABLED  // Active le module CAN
 
+#define CO_NETWORK_MASTER 1     // Services du maître réseau (CO_driver_target.h)
+
 
 /*
   Inclut les HAL spécifiques de la famille de carte stm32f1xx (ici bluepill)
@@ -9,6 +9,43 @@
 
 #define DEBUG 1
 
+// Période d'envoi du message TIME (temps réseau commun), en ms
+#define PERIODE_TIME_MS 1000
+
+// Plage des node-ID des esclaves
+#define PREMIER_ESCLAVE 0x02
+#define DERNIER_ESCLAVE 0x1F
+
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_COMMISSION
+// Mise en service LSS : les cartes neuves (sans node-ID) reçoivent le premier
+// node-ID libre de la plage de leur produit (identité 0x1018 de leur OD) et
+// l'enregistrent en flash. Le node-ID du maître et ceux des esclaves déjà vus
+// (heartbeat) sont sautés.
+static const CO_LSScommissionPolicy_t politiqueLSS[] = {
+  {.vendorID = 0x00000000, .productCode = 0x00000000,
+   .firstNodeId = PREMIER_ESCLAVE, .lastNodeId = DERNIER_ESCLAVE}
+};
+// Démarrage après l'arrivée des heartbeats (1000 ms) des esclaves configurés
+#define DELAI_MISE_EN_SERVICE_MS 3000
+#endif
+
+#if (CO_CONFIG_BOOTUP_MGR) & CO_CONFIG_BOOTUP_MGR_ENABLE
+// Gestionnaire de démarrage : chaque esclave de la plage est configuré (DCF
+// ci-dessous) puis le réseau est démarré (NMT start). Les esclaves sont
+// facultatifs : ceux absents après DUREE_DEMARRAGE_MS ne bloquent plus le
+// démarrage et seront configurés puis démarrés seuls à leur boot-up (carte
+// branchée plus tard, carte neuve après sa mise en service LSS).
+#define DUREE_DEMARRAGE_MS 5000
+#define NB_ESCLAVES (DERNIER_ESCLAVE - PREMIER_ESCLAVE + 1)
+// DCF commun : heartbeat producteur 1000 ms (0x1017)
+static const uint8_t dcfEsclave[] = {
+  0x01, 0x00, 0x00, 0x00,
+  0x17, 0x10, 0x00, 0x02, 0x00, 0x00, 0x00, 0xE8, 0x03
+};
+static CO_bootupMgrSlave_t esclaves[NB_ESCLAVES];
+static CO_bootupMgrNode_t etatsEsclaves[NB_ESCLAVES];
+#endif
+
 
 
 CO_NMT_control_t nmt_control = CO_NMT_STARTUP_TO_OPERATIONAL;
@@ -82,6 +119,55 @@ void setup_hardware_timer() {
   timer.resume();
 }
 
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_COMMISSION
+// === Callback de la mise en service LSS ===
+void miseEnServiceLSS(void *object, uint8_t nodeId, const CO_LSS_address_t *adresse,
+                      CO_LSScommission_result_t resultat) {
+  if (resultat == CO_LSS_COMMISSION_FINISHED) {
+    Serial.printf("Mise en service LSS terminée : %u carte(s) en %lu ms\n",
+                  CO->LSScommission->assignedCount,
+                  (unsigned long)(CO->LSScommission->time_us / 1000));
+    return;
+  }
+  Serial.printf("LSS : série 0x%08lX -> node-ID 0x%02X (résultat %d)\n",
+                (unsigned long)adresse->identity.serialNumber, nodeId, (int)resultat);
+}
+#endif
+
+#if (CO_CONFIG_BOOTUP_MGR) & CO_CONFIG_BOOTUP_MGR_ENABLE
+// === Callback du gestionnaire de démarrage ===
+void demarrageEsclave(void *object, uint8_t nodeId, CO_bootupMgr_state_t etat,
+                      CO_bootupMgr_error_t erreur) {
+  if (nodeId == 0) {
+    Serial.println("Gestionnaire de démarrage : réseau démarré");
+    return;
+  }
+  if (etat == CO_BOOTUP_MGR_ERROR) {
+    Serial.printf("Démarrage : esclave 0x%02X en erreur %d\n", nodeId, (int)erreur);
+  } else if (etat == CO_BOOTUP_MGR_STARTED) {
+    Serial.printf("Démarrage : esclave 0x%02X démarré\n", nodeId);
+  }
+}
+
+// === Lancement du gestionnaire de démarrage ===
+void lancerDemarrage(uint8_t nodeIdMaitre) {
+  uint8_t nb = 0;
+  for (uint8_t id = PREMIER_ESCLAVE; id <= DERNIER_ESCLAVE; id++) {
+    if (id == nodeIdMaitre) continue;
+    esclaves[nb].nodeId = id;
+    esclaves[nb].mandatory = false;
+    esclaves[nb].dcf = dcfEsclave;
+    esclaves[nb].dcfSize = sizeof(dcfEsclave);
+    nb++;
+  }
+  CO_bootupMgr_initCallback(CO->bootupMgr, NULL, demarrageEsclave);
+  if (CO_bootupMgr_start(CO->bootupMgr, esclaves, etatsEsclaves, nb,
+                         DUREE_DEMARRAGE_MS) != CO_ERROR_NO) {
+    debug("Erreur de lancement du gestionnaire de démarrage");
+  }
+}
+#endif
+
 void setup() {
   print_delay(3000); // attente nécessaire pour afficher les premiers messages
   Serial.begin(115200); // Moniteur série
@@ -100,6 +186,7 @@ void setup() {
   OD_INIT_CONFIG(config);
 
   config.CNT_LSS_SLV = 1;
+  config.CNT_LSS_MST = 1;
   config.CNT_RPDO = 1;
   config_ptr = &config;
   /* fin dictionnaire objets */
@@ -191,6 +278,33 @@ void setup() {
       ;
   }
 
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_LOG
+  // Journal EMCY : copie sur sa page de flash, restaurée si la RAM est perdue
+  CO_EMlog_initFlash(CO->EMlog, NULL, CO_EMlog_flashWrite, CO_EMlog_flashRead);
+#endif
+
+#if ((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_PRODUCER_HW) && !defined CO_STM32_FDCAN_Driver
+  // Producteur SYNC : timer matériel (TIM3) et mailbox CAN réservée, gigue en 0x2230
+  CO_SYNC_initHwProducer(CO->SYNC, CO->SYNC, CO_SYNC_hwSend, CO_SYNC_hwPeriod,
+                         SystemCoreClock, OD_find(OD, CO_SYNC_JITTER_OD_INDEX));
+#endif
+
+  // Horodatage du SYNC : les décalages des TPDO synchrones partent du SYNC sur
+  // le bus, pas de son traitement dans loop()
+  CO_SYNC_initTimestamp(CO->SYNC, CO_TIME_localTime_us);
+
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK
+  // Producteur TIME : référence du temps réseau des esclaves (µs depuis le
+  // 01/01/1984). Pas d'horloge calendaire sur la carte, le temps part de 0.
+  CO_TIME_initClock(CO->TIME, CO_TIME_localTime_us);
+  CO_TIME_set(CO->TIME, 0, 0, PERIODE_TIME_MS);
+#endif
+
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_COMMISSION
+  // Mise en service LSS, démarrée depuis loop()
+  CO_LSScommission_initCallback(CO->LSScommission, NULL, miseEnServiceLSS);
+#endif
+
   debug("après Open_init");
   print_delay(2000);
 
@@ -267,21 +381,50 @@ void loop() {
   uint32_t now = millis();
   uint32_t diffMain = now - lastTimeMain;
 
+  // Réception CAN : toutes les trames en attente sont traitées à chaque
+  // passage, sinon le tampon de réception déborde au démarrage du réseau
+  // (boot-up, heartbeats et SDO de tous les esclaves)
+  while (Can1.read(msg)) {
+    messagePending = true;
+    CO_CANinterruptRx(CO->CANmodule);
+  }
+
   /*--------------------------------------------
       Début Boucle Principal (5ms)
     --------------------------------------------*/
   // -- Boucle principale, exécution toutes les ~5ms --
-  if (diffMain > 5) {
+  static bool relanceMain = false;
+  if (diffMain > 5 || relanceMain) {
     lastTimeMain = now;
+    relanceMain = false;
+
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_COMMISSION
+    // Mise en service LSS des cartes neuves, une fois au démarrage
+    static bool miseEnServiceFaite = false;
+    static uint32_t debutBoucle = now;
+    if (!miseEnServiceFaite && now - debutBoucle >= DELAI_MISE_EN_SERVICE_MS) {
+      miseEnServiceFaite = true;
+      CO_LSScommission_start(CO->LSScommission, politiqueLSS,
+                             sizeof(politiqueLSS) / sizeof(politiqueLSS[0]));
+    }
+#endif
+
+#if (CO_CONFIG_BOOTUP_MGR) & CO_CONFIG_BOOTUP_MGR_ENABLE
+    // Configuration et démarrage des esclaves, lancés une fois le bus actif
+    static bool demarrageLance = false;
+    if (!demarrageLance) {
+      demarrageLance = true;
+      lancerDemarrage(CO->NMT->nodeId);
+    }
+#endif
 
-    uint32_t timerNext_us = 0;
+    uint32_t timerNext_us = 1000;
     CO_NMT_reset_cmd_t reset = CO_process(CO, false, diffMain * 1000, &timerNext_us);
 
-    // Traitement réception CAN brute (optionnel)
-    if (Can1.read(msg)) {
-      CO_CANinterruptRx(CO->CANmodule);  // OK ici message reçu
-      messagePending = true;
-      Serial.println("Réception CAN brute :");
+    // transfert SDO bloc en cours : on rappelle CO_process() au prochain
+    // passage sans attendre 5 ms, sinon un seul segment est envoyé par passage
+    if (timerNext_us == 0) {
+      relanceMain = true;
     }
 
     if (reset != CO_RESET_NOT) {
@@ -305,13 +448,19 @@ void loop() {
     uint32_t diff = now - lastProcessTime;
     lastProcessTime = now;
 
-    uint32_t timerNext_us = 0;
+    uint32_t timerNext_us = 1000;
 
     // Appels cycliques CANopenNode
     bool_t syncWas = CO_process_SYNC(CO, diff * 1000, &timerNext_us);
     CO_process_RPDO(CO, syncWas, diff * 1000, &timerNext_us);
     CO_process_TPDO(CO, syncWas, diff * 1000, &timerNext_us);
 
+    // traitement demandé sans délai : on rappelle les process sans attendre
+    // le prochain tick
+    if (timerNext_us == 0) {
+      canopen_1ms_tick = true;
+    }
+
     // Ton code applicatif non-bloquant
     if (newMessage) {
       newMessage = false;
@@ -11,7 +11,15 @@
 
 
 
+// Le gestionnaire de démarrage du maître configure l'esclave puis démarre le
+// réseau : l'esclave reste pré-opérationnel jusqu'au NMT start
+#define DEMARRAGE_PAR_MAITRE 1
+
+#if DEMARRAGE_PAR_MAITRE
+CO_NMT_control_t nmt_control = (CO_NMT_control_t)0;
+#else
 CO_NMT_control_t nmt_control = CO_NMT_STARTUP_TO_OPERATIONAL;
+#endif
 
 
 STM32_CAN Can1(CAN1, DEF);  // Broches PA11/PA12 pour CAN1
@@ -22,6 +30,19 @@ volatile bool newMessage = false;
 bool messagePending = false;
 CAN_message_t msg;
 
+// Node-ID et débit en attente pour l'esclave LSS, lus en flash au démarrage.
+// Sans node-ID enregistré, la carte attend sa mise en service par le maître.
+uint8_t pendingNodeId = CO_LSS_NODE_ID_ASSIGNMENT;
+uint16_t pendingBitRate = 500;  // en kbit/s
+
+// Repli sans maître LSS : une carte non mise en service après
+// DELAI_REPLI_LSS_MS redémarre avec NODE_ID_REPLI (non enregistré en flash).
+// Le marqueur est en RAM non initialisée, il survit au redémarrage logiciel.
+#define DELAI_REPLI_LSS_MS 20000
+#define NODE_ID_REPLI 0x02
+#define REPLI_LSS_MAGIC 0x4C535352UL
+__attribute__((section(".noinit"))) uint32_t repliLSS;
+
 HardwareTimer timer(TIM4);  // TIM1 --> TIM4 https://github.com/stm32duino/Arduino_Core_STM32/wiki/HardwareTimer-library
 volatile bool canopen_1ms_tick = false;
 
@@ -67,6 +88,28 @@ void myRxCallback(void *object, void *msgPtr) {
   newMessage = true;
 }
 
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_CLOCK
+// === Échantillonnage ADC aligné sur le SYNC ===
+// Horloge SYNC verrouillée : la mesure est prise ADC_AVANCE_SYNC_US avant le
+// SYNC prédit, la TPDO synchrone envoie donc une valeur fraîche et en phase.
+// Retourne false si l'horloge n'est pas verrouillée (échantillonnage libre).
+#define ADC_AVANCE_SYNC_US 200
+bool echantillonnage_sync() {
+  static uint32_t faitJusqua_us = 0;
+  CO_SYNC_clock_t horloge;
+  uint32_t now = micros();
+
+  if (CO->SYNC == NULL || !CO_SYNC_clockPredict(CO->SYNC, now, &horloge)) {
+    return false;
+  }
+  if ((int32_t)(now - faitJusqua_us) >= 0 && horloge.nextSync_us - now <= ADC_AVANCE_SYNC_US) {
+    OD_RAM.x2110_newObject[0] = analogRead(PA0);
+    faitJusqua_us = horloge.nextSync_us + horloge.period_us / 2;
+  }
+  return true;
+}
+#endif
+
 // === enregistrement du timer hardware
 void setup_hardware_timer() {
   timer.setOverflow(1000, MICROSEC_FORMAT);  // 1ms
@@ -111,8 +154,6 @@ void setup() {
   debug("après co_news");
 
   uint32_t errInfo = 0;
-  
-  uint16_t bitrate = 500000;  // en kbps → 500 kbps
 
 
   // Init module CANopen avec STM32_CAN
@@ -127,19 +168,34 @@ void setup() {
   delay(1000);
 
 
+  // Numéro de série unique de la carte (UID du MCU), distingue les cartes
+  // identiques pendant le fastscan LSS
+  OD_PERSIST_COMM.x1018_identity.serialNumber = CO_LSS_serialNumber();
+
   CO_LSS_address_t lssAddress = { .identity = { .vendorID = OD_PERSIST_COMM.x1018_identity.vendor_ID,
                                                 .productCode = OD_PERSIST_COMM.x1018_identity.productCode,
                                                 .revisionNumber = OD_PERSIST_COMM.x1018_identity.revisionNumber,
                                                 .serialNumber = OD_PERSIST_COMM.x1018_identity.serialNumber } };
 
-  uint8_t nodeId = 0x02;   // identifiant noeud désiré
+  if (!CO_LSS_flashLoad(&pendingNodeId, &pendingBitRate)) {
+    if (repliLSS == REPLI_LSS_MAGIC) {
+      pendingNodeId = NODE_ID_REPLI;
+      debug("Pas de mise en service LSS, node-ID de repli 0x", false);
+      debug(NODE_ID_REPLI, HEX);
+    } else {
+      debug("Pas de node-ID en flash, attente de la mise en service LSS");
+    }
+  }
+  repliLSS = 0;
 
-  err = CO_LSSinit(CO, &lssAddress, &nodeId, &bitrate);
+  err = CO_LSSinit(CO, &lssAddress, &pendingNodeId, &pendingBitRate);
   if (err != CO_ERROR_NO) {
     debug("Error: LSS slave initialization failed");
     while (1)
       ;
   }
+  // node-ID attribué par le maître : enregistré en flash (EEPROM émulée)
+  CO_LSSslave_initCfgStoreCallback(CO->LSSslave, NULL, CO_LSS_flashStore);
 
   debug("après LSSinit");
   delay(2000);
@@ -156,15 +212,33 @@ void setup() {
     1000,         // SDO server timeout (en ms)
     500,          // SDO client timeout (en ms)
     false,        // SDO client block transfer désactivé
-    nodeId,         // nodeId
+    pendingNodeId,  // nodeId, CO_LSS_NODE_ID_ASSIGNMENT si non configuré
     &errInfo      // erreur détaillée en cas d’échec
   );
-  if (err != CO_ERROR_NO) {
+  // node-ID non configuré : seul l'esclave LSS tourne jusqu'à la mise en service
+  if (err != CO_ERROR_NO && err != CO_ERROR_NODE_ID_UNCONFIGURED_LSS) {
     debug("Erreur d'init CO_CANopenInit");
     while (1)
       ;
   }
 
+  if (!CO->nodeIdUnconfigured) {
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_LOG
+    // Journal EMCY : copie sur sa page de flash, restaurée si la RAM est perdue
+    CO_EMlog_initFlash(CO->EMlog, NULL, CO_EMlog_flashWrite, CO_EMlog_flashRead);
+#endif
+
+    // Horodatage du SYNC reçu : les décalages des TPDO synchrones partent du
+    // SYNC sur le bus, pas de son traitement dans loop()
+    CO_SYNC_initTimestamp(CO->SYNC, CO_TIME_localTime_us);
+
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK
+    // Consommateur TIME : temps réseau du maître, compensé en dérive, pour
+    // horodater les traces (CO_TIME_now())
+    CO_TIME_initClock(CO->TIME, CO_TIME_localTime_us);
+#endif
+  }
+
   debug("après Open_init");
   delay(2000);
 
@@ -173,9 +247,9 @@ void setup() {
   delay(2000);
 
   /* PDO start */
-  err = CO_CANopenInitPDO(CO, CO->em, OD, 0x02, &errInfo);
+  err = CO_CANopenInitPDO(CO, CO->em, OD, pendingNodeId, &errInfo);
 
-  if (err != CO_ERROR_NO) {
+  if (err != CO_ERROR_NO && err != CO_ERROR_NODE_ID_UNCONFIGURED_LSS) {
     if (err == CO_ERROR_OD_PARAMETERS) {
       debug("Erreur : OD invalide, entrée : ");
     } else {
@@ -221,8 +295,19 @@ void setup() {
 void loop() {
   static uint32_t lastProcessTime = 0;
 
+  // Réception CAN : chaque trame lue est passée à CANopenNode (NMT, SDO, LSS,
+  // PDO), toutes les trames en attente à chaque passage
+  while (Can1.read(msg)) {
+    messagePending = true;
+    CO_CANinterruptRx(CO->CANmodule);
+  }
+
   int value = analogRead(PA0);
   //Serial.println(value);
+  bool syncAligne = false;
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_CLOCK
+  syncAligne = echantillonnage_sync();
+#endif
 
   if (canopen_1ms_tick) { // ce flag est mis à vrai à chaque iteration du timer hardware
     canopen_1ms_tick = false; // on met le flag directement à faux
@@ -231,11 +316,13 @@ void loop() {
     uint32_t diff = now - lastProcessTime;
     lastProcessTime = now;
 
-    uint32_t timerNext_us = 0;
+    uint32_t timerNext_us = 1000;
     CO_NMT_reset_cmd_t reset;
 
 
-    OD_RAM.x2110_newObject[0] = value;
+    if (!syncAligne) {
+      OD_RAM.x2110_newObject[0] = value;
+    }
 
 
     // Appel de toute les fonctions process
@@ -243,21 +330,37 @@ void loop() {
     CO_process_RPDO(CO, false, diff * 1000, &timerNext_us);
     CO_process_TPDO(CO, false, diff * 1000, &timerNext_us);
 
-
-    if (reset != CO_RESET_NOT) {
-      // Implémenter un redémarrage logiciel ici si besoin
+    // transfert SDO bloc en cours : on rappelle les process sans attendre le
+    // prochain tick, sinon un seul segment est envoyé par milliseconde
+    if (timerNext_us == 0) {
+      canopen_1ms_tick = true;
     }
 
 
+    if (reset != CO_RESET_NOT && CO->nodeIdUnconfigured) {
+      // Node-ID reçu à la mise en service LSS : redémarrage, il est relu en
+      // flash et CANopen s'initialise complètement
+      NVIC_SystemReset();
+    }
 
-    // Traitement réception CAN brute (optionnel)
-    if (Can1.read(msg)) {
-      messagePending = true;
+    // Pas de mise en service dans le délai : redémarrage avec le node-ID de repli
+    static uint32_t debutAttente = now;
+    if (CO->nodeIdUnconfigured && now - debutAttente >= DELAI_REPLI_LSS_MS) {
+      repliLSS = REPLI_LSS_MAGIC;
+      NVIC_SystemReset();
     }
-    //CO_CANinterruptRx(CO->CANmodule);  // OK ici message reçu
+
+
 
     if (newMessage) {
       newMessage = false;
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK
+      if (DEBUG && CO->TIME != NULL) {
+        // horodatage en temps réseau : ms du jour, au µs près
+        uint64_t t_us = CO_TIME_now(CO->TIME) % (86400000ULL * 1000U);
+        Serial.printf("[%lu.%03u ms] ", (unsigned long)(t_us / 1000U), (unsigned)(t_us % 1000U));
+      }
+#endif
       debug("Reçu ID: 0x", false);
       debug(latestMsg.id, HEX, false);
       debug(" DLC: ", false);
@@ -0,0 +1,235 @@
+/*
+ * Loopback CAN driver for running CANopenNode on a Linux host.
+ *
+ * Functions follow libraries/drivers/driver_co_arduino.cpp, STM32_CAN
+ * calls are replaced by the loopback bus. See CO_driver_loopback.h.
+ */
+
+#include <string.h>
+
+#include "CO_driver_loopback.h"
+
+/* CAN masks for identifiers */
+#define CANID_MASK 0x07FF /*!< CAN standard ID mask */
+#define FLAG_RTR   0x8000 /*!< RTR flag, part of identifier */
+
+
+uint16_t CO_CANrxMsg_readIdent(void *msg) {
+    return ((CO_loopbackMsg_t *)msg)->ident & CANID_MASK;
+}
+
+uint8_t *CO_CANrxMsg_readData(void *msg) {
+    return ((CO_loopbackMsg_t *)msg)->data;
+}
+
+uint8_t CO_CANrxMsg_readDLC(void *msg) {
+    return ((CO_loopbackMsg_t *)msg)->DLC;
+}
+
+uint32_t CO_CANrxMsg_readTimestamp(void *msg) {
+    return ((CO_loopbackMsg_t *)msg)->timestamp_us;
+}
+
+
+/******************************************************************************/
+void CO_CANsetConfigurationMode(void *CANptr) {
+    (void)CANptr;
+}
+
+/******************************************************************************/
+void CO_CANsetNormalMode(CO_CANmodule_t *CANmodule) {
+    CANmodule->CANnormal = true;
+}
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANmodule_init(CO_CANmodule_t *CANmodule,
+                                   void *CANptr,
+                                   CO_CANrx_t rxArray[],
+                                   uint16_t rxSize,
+                                   CO_CANtx_t txArray[],
+                                   uint16_t txSize,
+                                   uint16_t CANbitRate)
+{
+    (void)CANbitRate;
+    CO_loopbackBus_t *bus = (CO_loopbackBus_t *)CANptr;
+
+    if (CANmodule == NULL || rxArray == NULL || txArray == NULL
+        || bus == NULL || bus->modulesCount >= CO_LOOPBACK_MAX_MODULES
+    ) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    CANmodule->CANptr = CANptr;
+    CANmodule->rxArray = rxArray;
+    CANmodule->rxSize = rxSize;
+    CANmodule->txArray = txArray;
+    CANmodule->txSize = txSize;
+    CANmodule->CANerrorStatus = 0;
+    CANmodule->CANnormal = false;
+    CANmodule->useCANrxFilters = false;
+    CANmodule->bufferInhibitFlag = false;
+    CANmodule->firstCANtxMessage = true;
+    CANmodule->CANtxCount = 0;
+    CANmodule->errOld = 0;
+    CANmodule->rxMonitorObject = NULL;
+    CANmodule->rxMonitor = NULL;
+
+    for (uint16_t i = 0U; i < rxSize; i++) {
+        rxArray[i].ident = 0U;
+        rxArray[i].mask = 0xFFFFU;
+        rxArray[i].object = NULL;
+        rxArray[i].CANrx_callback = NULL;
+    }
+    for (uint16_t i = 0U; i < txSize; i++) {
+        txArray[i].bufferFull = false;
+    }
+
+    bus->modules[bus->modulesCount++] = CANmodule;
+
+    return CO_ERROR_NO;
+}
+
+/******************************************************************************/
+void CO_CANmodule_disable(CO_CANmodule_t *CANmodule) {
+    if (CANmodule == NULL || CANmodule->CANptr == NULL) {
+        return;
+    }
+
+    CO_loopbackBus_t *bus = (CO_loopbackBus_t *)CANmodule->CANptr;
+    for (uint8_t i = 0; i < bus->modulesCount; i++) {
+        if (bus->modules[i] == CANmodule) {
+            bus->modules[i] = bus->modules[--bus->modulesCount];
+            break;
+        }
+    }
+    CANmodule->CANnormal = false;
+}
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANrxBufferInit(CO_CANmodule_t *CANmodule,
+                                    uint16_t index,
+                                    uint16_t ident,
+                                    uint16_t mask,
+                                    bool_t rtr,
+                                    void *object,
+                                    void (*CANrx_callback)(void *object,
+                                                           void *message))
+{
+    if (CANmodule == NULL || CANrx_callback == NULL
+        || index >= CANmodule->rxSize
+    ) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    CO_CANrx_t *buffer = &CANmodule->rxArray[index];
+
+    buffer->object = object;
+    buffer->CANrx_callback = CANrx_callback;
+    buffer->ident = (ident & CANID_MASK) | (rtr ? FLAG_RTR : 0x00);
+    buffer->mask = (mask & CANID_MASK) | FLAG_RTR;
+
+    return CO_ERROR_NO;
+}
+
+/******************************************************************************/
+void CO_CANrxMonitorInit(CO_CANmodule_t *CANmodule,
+                         void *object,
+                         void (*CANrx_callback)(void *object, void *message))
+{
+    if (CANmodule != NULL) {
+        CANmodule->rxMonitor = NULL;
+        CANmodule->rxMonitorObject = object;
+        CANmodule->rxMonitor = CANrx_callback;
+    }
+}
+
+/******************************************************************************/
+CO_CANtx_t *CO_CANtxBufferInit(CO_CANmodule_t *CANmodule,
+                               uint16_t index,
+                               uint16_t ident,
+                               bool_t rtr,
+                               uint8_t noOfBytes,
+                               bool_t syncFlag)
+{
+    if (CANmodule == NULL || index >= CANmodule->txSize) {
+        return NULL;
+    }
+
+    CO_CANtx_t *buffer = &CANmodule->txArray[index];
+
+    buffer->ident = ((uint32_t)ident & CANID_MASK)
+                  | ((uint32_t)(rtr ? FLAG_RTR : 0x00));
+    buffer->DLC = noOfBytes;
+    buffer->bufferFull = false;
+    buffer->syncFlag = syncFlag;
+
+    return buffer;
+}
+
+/******************************************************************************/
+bool_t CO_loopback_receive(CO_CANmodule_t *CANmodule,
+                           const CO_loopbackMsg_t *msg)
+{
+    uint16_t ident = msg->ident & CANID_MASK;
+
+    if (CANmodule->rxMonitor != NULL) {
+        CO_loopbackMsg_t monitorMsg = *msg;
+        CANmodule->rxMonitor(CANmodule->rxMonitorObject, &monitorMsg);
+    }
+
+    for (uint16_t i = 0; i < CANmodule->rxSize; i++) {
+        CO_CANrx_t *buffer = &CANmodule->rxArray[i];
+
+        if (buffer->CANrx_callback != NULL
+            && ((ident ^ buffer->ident) & buffer->mask) == 0U
+        ) {
+            CO_loopbackMsg_t localMsg = *msg;
+            buffer->CANrx_callback(buffer->object, &localMsg);
+            return true;
+        }
+    }
+    return false;
+}
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANsend(CO_CANmodule_t *CANmodule, CO_CANtx_t *buffer) {
+    if (CANmodule == NULL || buffer == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    CO_loopbackBus_t *bus = (CO_loopbackBus_t *)CANmodule->CANptr;
+    CO_loopbackMsg_t msg;
+
+    msg.ident = (uint16_t)(buffer->ident & CANID_MASK);
+    msg.DLC = buffer->DLC;
+    memcpy(msg.data, buffer->data, sizeof(msg.data));
+    msg.timestamp_us = bus->now_us;
+
+    CANmodule->bufferInhibitFlag = buffer->syncFlag;
+    CANmodule->firstCANtxMessage = false;
+    bus->txCount++;
+
+    /* Frame is not received by its own CAN controller */
+    for (uint8_t i = 0; i < bus->modulesCount; i++) {
+        if (bus->modules[i] != CANmodule
+            && CO_loopback_receive(bus->modules[i], &msg)
+        ) {
+            bus->rxCount++;
+        }
+    }
+
+    return CO_ERROR_NO;
+}
+
+/******************************************************************************/
+void CO_CANclearPendingSyncPDOs(CO_CANmodule_t *CANmodule) {
+    if (CANmodule->bufferInhibitFlag) {
+        CANmodule->bufferInhibitFlag = false;
+        CANmodule->CANerrorStatus |= CO_CAN_ERRTX_PDO_LATE;
+    }
+}
+
+/******************************************************************************/
+void CO_CANmodule_process(CO_CANmodule_t *CANmodule) {
+    (void)CANmodule;
+}
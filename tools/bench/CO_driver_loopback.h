@@ -0,0 +1,61 @@
+/*
+ * Loopback CAN driver for running CANopenNode on a Linux host.
+ *
+ * Several CO_CANmodule_t objects are attached to one CO_loopbackBus_t. A
+ * frame sent by CO_CANsend() is delivered synchronously to all other
+ * modules on the same bus, the same way as CO_CANinterruptRx() from
+ * libraries/drivers/driver_co_arduino.cpp dispatches a received message.
+ *
+ * Use CANptr argument of CO_CANmodule_init() to pass the bus object.
+ */
+
+#ifndef CO_DRIVER_LOOPBACK_H
+#define CO_DRIVER_LOOPBACK_H
+
+#include "301/CO_driver.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of CAN modules on one loopback bus */
+#ifndef CO_LOOPBACK_MAX_MODULES
+#define CO_LOOPBACK_MAX_MODULES 4
+#endif
+
+/** CAN message, as seen by CO_CANrxMsg_readXXX() */
+typedef struct {
+    uint16_t ident;
+    uint8_t DLC;
+    uint8_t data[8];
+    uint32_t timestamp_us;
+} CO_loopbackMsg_t;
+
+/** Loopback bus */
+typedef struct {
+    CO_CANmodule_t *modules[CO_LOOPBACK_MAX_MODULES];
+    uint8_t modulesCount;
+    /** Number of frames sent on the bus */
+    uint32_t txCount;
+    /** Number of frames, which matched a receive buffer */
+    uint32_t rxCount;
+    /** Value written to CO_loopbackMsg_t.timestamp_us */
+    uint32_t now_us;
+} CO_loopbackBus_t;
+
+/**
+ * Deliver CAN message to the CAN module as from the receive interrupt.
+ *
+ * @param CANmodule CAN module object.
+ * @param msg Received message.
+ *
+ * @return True, if message matched receive buffer.
+ */
+bool_t CO_loopback_receive(CO_CANmodule_t *CANmodule,
+                           const CO_loopbackMsg_t *msg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CO_DRIVER_LOOPBACK_H */
@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+"""
+Compare two co_bench JSON results.
+
+Prints ns/op of every benchmark in both files and the relative change.
+Exits with 1, if any benchmark present in both files is slower than the
+baseline by more than --threshold percent, or reported errors.
+
+Example:
+    python3 tools/bench/bench_compare.py --threshold 10 base.json new.json
+
+Only the python standard library is used.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        data = json.load(f)
+    return {r["name"]: r for r in data.get("results", [])}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("baseline", help="JSON from previous run")
+    parser.add_argument("current", help="JSON from this run")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="allowed slowdown in percent (default 10)")
+    args = parser.parse_args()
+
+    base = load(args.baseline)
+    cur = load(args.current)
+    failed = False
+
+    print("%-26s %12s %12s %9s" % ("benchmark", "base ns/op", "ns/op",
+                                   "change"))
+    for name, r in cur.items():
+        ns = r["ns_per_op"]
+        if r.get("errors", 0):
+            failed = True
+        if name not in base:
+            print("%-26s %12s %12.2f %9s" % (name, "-", ns, "new"))
+            continue
+        ns_base = base[name]["ns_per_op"]
+        change = (ns - ns_base) * 100.0 / ns_base if ns_base > 0 else 0.0
+        mark = ""
+        if change > args.threshold:
+            mark = "  SLOWER"
+            failed = True
+        print("%-26s %12.2f %12.2f %+8.1f%%%s" % (name, ns_base, ns, change,
+                                                 mark))
+    for name in base:
+        if name not in cur:
+            print("%-26s %12.2f %12s %9s" % (name, base[name]["ns_per_op"],
+                                             "-", "missing"))
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
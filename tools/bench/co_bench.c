@@ -0,0 +1,1171 @@
+/*
+ * Host benchmark of the CANopenNode stack, as configured for the Bluepill.
+ *
+ * Stack sources (CO_PDO.c, CO_ODinterface.c, SDO server and client) are
+ * built for Linux together with the generated OD.c and the loopback CAN
+ * driver. Measured are:
+ *  - TPDO build and send, RPDO receive and apply to OD (frames/s),
+ *  - OD_find() and OD_getSub() latency,
+ *  - OD_get_value() / OD_set_value() cost through OD_get_u8/u32 helpers,
+ *  - SDO expedited upload and download round trips between SDO client and
+ *    SDO server over the loopback bus,
+ *  - segmented and block upload of a large DOMAIN object and of a variable in
+ *    RAM from the SDO server, with frames and bus turnarounds counted for a
+ *    CAN throughput estimate,
+ *  - parameter scan with single SDO uploads and with CO_SDOclientBatch(),
+ *  - CRC16-CCITT per byte and per block, CO_fifo write and read (bytes/s),
+ *  - one 1 ms cycle of the heartbeat consumer, which monitors 127 nodes.
+ *
+ * Results are written as JSON, see README in this directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* OD object types, for the variable added to the OD of the block server */
+#define OD_DEFINITION
+#include "301/CO_ODinterface.h"
+#include "301/CO_Emergency.h"
+#include "301/CO_PDO.h"
+#include "301/CO_SDOserver.h"
+#include "301/CO_SDOclient.h"
+#include "301/crc16-ccitt.h"
+#include "301/CO_fifo.h"
+#include "301/CO_HBconsumer.h"
+#include "CO_driver_loopback.h"
+#include "OD.h"
+
+#ifndef BENCH_OD_NAME
+#define BENCH_OD_NAME "OD"
+#endif
+
+/* Mapped object for PDO benchmarks, must be 32-bit and PDO mappable */
+#ifndef BENCH_PDO_MAP_OBJECT
+#define BENCH_PDO_MAP_OBJECT 0x21100120UL
+#endif
+/* Number of times BENCH_PDO_MAP_OBJECT is mapped into the PDO */
+#ifndef BENCH_PDO_MAP_COUNT
+#define BENCH_PDO_MAP_COUNT 2
+#endif
+
+/* DOMAIN object, which is streamed by the SDO upload throughput benchmarks */
+#ifndef BENCH_SDO_DOMAIN_INDEX
+#define BENCH_SDO_DOMAIN_INDEX 0x2200
+#endif
+#ifndef BENCH_SDO_DOMAIN_SIZE
+#define BENCH_SDO_DOMAIN_SIZE 4096
+#endif
+/* Variable of the same size in RAM, added by the benchmark to the OD of the
+ * block transfer server. SDO server streams it without its buffer, if
+ * CO_CONFIG_SDO_SRV_STREAM is enabled. */
+#ifndef BENCH_SDO_STREAM_INDEX
+#define BENCH_SDO_STREAM_INDEX 0x2201
+#endif
+/* blksize requested in block upload, largest the SDO server buffer accepts */
+#ifndef BENCH_SDO_BLKSIZE
+#define BENCH_SDO_BLKSIZE ((CO_CONFIG_SDO_SRV_BUFFER_SIZE / 7) > 127 \
+                           ? 127 : (CO_CONFIG_SDO_SRV_BUFFER_SIZE / 7))
+#endif
+
+/* CAN model for bytes/s estimate of SDO transfers: bitrate, bits of a frame
+ * with 8 data bytes and worst case stuffing, and the time a node needs to
+ * react on a received frame (one 1 ms mainline cycle in the sketches). */
+#define BENCH_CAN_BITRATE 500000
+#define BENCH_CAN_FRAME_BITS 135
+#ifndef BENCH_SDO_TURNAROUND_US
+#define BENCH_SDO_TURNAROUND_US 1000
+#endif
+
+/* Number of objects read by one parameter scan */
+#ifndef BENCH_SDO_SCAN_COUNT
+#define BENCH_SDO_SCAN_COUNT 20
+#endif
+
+/* Size of the data block for the CRC benchmarks */
+#ifndef BENCH_CRC_SIZE
+#define BENCH_CRC_SIZE 1024
+#endif
+
+/* FIFO benchmark: size of the fifo (as SDO client fifo of the Bluepill) and
+ * of the chunks written and read, which makes the fifo wrap around */
+#ifndef BENCH_FIFO_SIZE
+#define BENCH_FIFO_SIZE 1000
+#endif
+#ifndef BENCH_FIFO_CHUNK
+#define BENCH_FIFO_CHUNK 300
+#endif
+
+/* Heartbeat consumer: number of monitored nodes and their heartbeat time.
+ * One node sends its heartbeat in each 1 ms cycle, round robin. */
+#ifndef BENCH_HB_CONS_NODES
+#define BENCH_HB_CONS_NODES 127
+#endif
+#ifndef BENCH_HB_CONS_TIME_MS
+#define BENCH_HB_CONS_TIME_MS 1000
+#endif
+
+#define BENCH_PDO_CAN_ID 0x181
+#define BENCH_SDO_SRV_NODE_ID 1
+#define BENCH_SDO_CLI_NODE_ID 0x10
+#define BENCH_SDO_MAX_LOOPS 16
+
+#define BENCH_OBJ_INDEX ((uint16_t)(BENCH_PDO_MAP_OBJECT >> 16))
+#define BENCH_OBJ_SUB ((uint8_t)(BENCH_PDO_MAP_OBJECT >> 8))
+
+
+/* Stack objects ***************************************************************/
+static CO_loopbackBus_t pdoBus;
+static CO_CANmodule_t pdoCAN;
+static CO_CANrx_t pdoCANrx[1];
+static CO_CANtx_t pdoCANtx[1];
+static CO_EM_t em;
+static CO_TPDO_t TPDO;
+static CO_RPDO_t RPDO;
+
+static CO_loopbackBus_t sdoBus;
+static CO_CANmodule_t srvCAN, cliCAN;
+static CO_CANrx_t srvCANrx[1], cliCANrx[1];
+static CO_CANtx_t srvCANtx[1], cliCANtx[1];
+static CO_SDOserver_t SDOserver;
+static CO_SDOclient_t SDOclient;
+
+/* SDO server and hand made client for large transfers. Client frames are
+ * built in the benchmark, so block transfer can be measured with the SDO
+ * client compiled for segmented transfer only. */
+static CO_loopbackBus_t blkBus;
+static CO_CANmodule_t blkSrvCAN, rawCAN;
+static CO_CANrx_t blkSrvCANrx[1], rawCANrx[1];
+static CO_CANtx_t blkSrvCANtx[1], rawCANtx[1];
+static CO_CANtx_t *rawTx;
+static CO_SDOserver_t SDOblk;
+static OD_extension_t domainExtension;
+static uint8_t rawRxData[8];
+static bool_t rawRxNew;
+static uint8_t domainBuf[BENCH_SDO_DOMAIN_SIZE + 7];
+static uint8_t streamData[BENCH_SDO_DOMAIN_SIZE];
+static OD_obj_var_t streamVar;
+static OD_entry_t blkODlist[3]; /* DOMAIN, stream variable, blank */
+static OD_t blkOD;
+
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+/* one buffer for each of the above SDO servers */
+static CO_SDOserverPool_t srvPool;
+static uint8_t srvPoolBuffers[2 * (CO_CONFIG_SDO_SRV_BUFFER_SIZE + 1)];
+#endif
+
+/* Frames and turnarounds of the SDO transfers, for the CAN model */
+typedef struct {
+    uint64_t transfers;
+    uint64_t bytes;
+    uint64_t frames;
+    uint64_t turnarounds;
+    bool_t lastTx;
+} xferStat_t;
+static xferStat_t xfer;
+
+/* Mainline cycles of parameter scans, one cycle is one client call */
+static uint64_t scanCycles, scanCount;
+
+/* CRC benchmarks: data and its crc */
+static uint8_t crcData[BENCH_CRC_SIZE];
+static uint16_t crcExpected;
+
+/* FIFO benchmark */
+static CO_fifo_t fifo;
+static uint8_t fifoBuf[BENCH_FIFO_SIZE + 1];
+static uint8_t fifoData[BENCH_FIFO_CHUNK];
+
+/* Heartbeat consumer with its own OD object 0x1016 */
+static CO_CANmodule_t hbCAN;
+static CO_CANrx_t hbCANrx[BENCH_HB_CONS_NODES];
+static CO_CANtx_t hbCANtx[1];
+static CO_HBconsumer_t HBcons;
+static CO_HBconsNode_t hbNodes[BENCH_HB_CONS_NODES];
+static uint8_t hbTimes0 = BENCH_HB_CONS_NODES;
+static uint32_t hbTimes[BENCH_HB_CONS_NODES];
+static OD_obj_array_t hbTimesArr;
+static OD_entry_t hbEntry;
+static uint8_t hbNextNode;
+
+/* Bytes processed by one operation of data throughput benchmarks */
+static size_t opBytes;
+
+static OD_entry_t *benchEntry;
+static volatile uint32_t sink;
+static unsigned long errors;
+
+
+/* Benchmarks ******************************************************************/
+static void bench_tpdo_build(uint32_t n) {
+    uint32_t txCount = pdoBus.txCount;
+
+    for (uint32_t i = 0; i < n; i++) {
+        CO_TPDOsendRequest(&TPDO);
+        CO_TPDO_process(&TPDO,
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_TIMERS_ENABLE
+                        0, NULL,
+#endif
+                        true, false);
+    }
+    if (pdoBus.txCount - txCount != n) {
+        errors++;
+    }
+}
+
+static void bench_rpdo_apply(uint32_t n) {
+    /* use CAN-ID, on which RPDO actually listens */
+    CO_loopbackMsg_t msg = {
+        .ident = pdoCANrx[0].ident & 0x7FF,
+        .DLC = 4 * BENCH_PDO_MAP_COUNT
+    };
+
+    for (uint32_t i = 0; i < n; i++) {
+        msg.data[0] = (uint8_t)i;
+        msg.timestamp_us = i;
+        if (!CO_loopback_receive(&pdoCAN, &msg)) {
+            errors++;
+        }
+        CO_RPDO_process(&RPDO,
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_TIMERS_ENABLE
+                        0, NULL,
+#endif
+                        true, false);
+    }
+}
+
+static void bench_od_find(uint32_t n) {
+    uint16_t size = OD->size;
+    uint16_t j = 0;
+    uint32_t found = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        if (OD_find(OD, OD->list[j].index) != NULL) {
+            found++;
+        }
+        if (++j >= size) {
+            j = 0;
+        }
+    }
+    sink = found;
+}
+
+static void bench_od_find_miss(uint32_t n) {
+    uint32_t found = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        if (OD_find(OD, (uint16_t)(0x5F00 + (i & 0xFF))) != NULL) {
+            found++;
+        }
+    }
+    sink = found;
+}
+
+static void bench_od_getSub(uint32_t n) {
+    uint16_t size = OD->size;
+    uint16_t j = 0;
+    OD_IO_t io;
+    uint32_t len = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        OD_entry_t *entry = &OD->list[j];
+        uint8_t sub = (entry->subEntriesCount > 1) ? 1 : 0;
+        if (OD_getSub(entry, sub, &io, false) == ODR_OK) {
+            len += io.stream.dataLength;
+        }
+        if (++j >= size) {
+            j = 0;
+        }
+    }
+    sink = len;
+}
+
+static void bench_od_get_u8(uint32_t n) {
+    uint32_t sum = 0;
+    uint8_t val;
+
+    for (uint32_t i = 0; i < n; i++) {
+        if (OD_get_u8(benchEntry, 0, &val, true) == ODR_OK) {
+            sum += val;
+        }
+    }
+    sink = sum;
+}
+
+static void bench_od_get_u32(uint32_t n) {
+    uint32_t sum = 0;
+    uint32_t val;
+
+    for (uint32_t i = 0; i < n; i++) {
+        if (OD_get_u32(benchEntry, BENCH_OBJ_SUB, &val, true) == ODR_OK) {
+            sum += val;
+        }
+    }
+    sink = sum;
+}
+
+static void bench_od_set_u32(uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        if (OD_set_u32(benchEntry, BENCH_OBJ_SUB, i, true) != ODR_OK) {
+            errors++;
+        }
+    }
+}
+
+static void bench_sdo_upload(uint32_t n) {
+    uint8_t buf[8];
+    size_t len = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
+        CO_SDO_return_t ret;
+        int loops = 0;
+
+        ret = CO_SDOclientUploadInitiate(&SDOclient, BENCH_OBJ_INDEX,
+                                         BENCH_OBJ_SUB, 1000, false);
+        if (ret != CO_SDO_RT_ok_communicationEnd) {
+            errors++;
+            continue;
+        }
+        do {
+            ret = CO_SDOclientUpload(&SDOclient, 0, false, &abortCode,
+                                     NULL, NULL, NULL);
+            CO_SDOserver_process(&SDOserver, true, 0, NULL);
+        } while (ret > 0 && ++loops < BENCH_SDO_MAX_LOOPS);
+
+        if (ret != CO_SDO_RT_ok_communicationEnd) {
+            errors++;
+        }
+        len += CO_SDOclientUploadBufRead(&SDOclient, buf, sizeof(buf));
+    }
+    sink = (uint32_t)len;
+}
+
+static void bench_sdo_download(uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
+        CO_SDO_return_t ret;
+        uint8_t buf[4];
+        int loops = 0;
+
+        ret = CO_SDOclientDownloadInitiate(&SDOclient, BENCH_OBJ_INDEX,
+                                           BENCH_OBJ_SUB, sizeof(buf), 1000,
+                                           false);
+        if (ret != CO_SDO_RT_ok_communicationEnd) {
+            errors++;
+            continue;
+        }
+        CO_setUint32(buf, i);
+        CO_SDOclientDownloadBufWrite(&SDOclient, buf, sizeof(buf));
+        do {
+            ret = CO_SDOclientDownload(&SDOclient, 0, false, false,
+                                       &abortCode, NULL, NULL);
+            CO_SDOserver_process(&SDOserver, true, 0, NULL);
+        } while (ret > 0 && ++loops < BENCH_SDO_MAX_LOOPS);
+
+        if (ret != CO_SDO_RT_ok_communicationEnd) {
+            errors++;
+        }
+    }
+}
+
+
+/* Hand made SDO client ********************************************************/
+static void raw_receive(void *object, void *msg) {
+    (void)object;
+    /* server sends one frame per CO_SDOserver_process(), client must keep up */
+    if (rawRxNew) {
+        errors++;
+    }
+    memcpy(rawRxData, CO_CANrxMsg_readData(msg), sizeof(rawRxData));
+    rawRxNew = true;
+    xfer.frames++;
+    if (xfer.lastTx) {
+        xfer.turnarounds++;
+        xfer.lastTx = false;
+    }
+}
+
+static void raw_send(uint8_t d0, uint8_t d1, uint8_t d2, uint8_t d3,
+                     uint8_t d4)
+{
+    memset(rawTx->data, 0, sizeof(rawTx->data));
+    rawTx->data[0] = d0;
+    rawTx->data[1] = d1;
+    rawTx->data[2] = d2;
+    rawTx->data[3] = d3;
+    rawTx->data[4] = d4;
+    xfer.frames++;
+    if (!xfer.lastTx) {
+        xfer.turnarounds++;
+        xfer.lastTx = true;
+    }
+    CO_CANsend(&rawCAN, rawTx);
+}
+
+/* Process SDO server until it sends a frame. Return the frame or NULL. */
+static const uint8_t *raw_wait(void) {
+    for (int i = 0; !rawRxNew && i < BENCH_SDO_MAX_LOOPS; i++) {
+        CO_SDOserver_process(&SDOblk, true, 0, NULL);
+    }
+    if (!rawRxNew) {
+        return NULL;
+    }
+    rawRxNew = false;
+    return rawRxData;
+}
+
+/* Abort the transfer from the client side and count the error */
+static void raw_abort(void) {
+    raw_send(0x80, (uint8_t)BENCH_SDO_DOMAIN_INDEX,
+             (uint8_t)(BENCH_SDO_DOMAIN_INDEX >> 8), 0, 0);
+    CO_SDOserver_process(&SDOblk, true, 0, NULL);
+    rawRxNew = false;
+    errors++;
+}
+
+/* Contents of the DOMAIN object: byte at offset i has value (uint8_t)i */
+static ODR_t domain_read(OD_stream_t *stream, void *buf,
+                         OD_size_t count, OD_size_t *countRead)
+{
+    uint8_t *b = (uint8_t *)buf;
+    OD_size_t offset = stream->dataOffset;
+    OD_size_t len = BENCH_SDO_DOMAIN_SIZE - offset;
+    ODR_t ret = ODR_OK;
+
+    /* size is indicated to the SDO client */
+    stream->dataLength = BENCH_SDO_DOMAIN_SIZE;
+    if (len > count) {
+        len = count;
+        ret = ODR_PARTIAL;
+    }
+    for (OD_size_t i = 0; i < len; i++) {
+        b[i] = (uint8_t)(offset + i);
+    }
+    stream->dataOffset = (ret == ODR_PARTIAL) ? offset + len : 0;
+    *countRead = len;
+    return ret;
+}
+
+static bool_t domain_verify(size_t len) {
+    if (len != BENCH_SDO_DOMAIN_SIZE) {
+        return false;
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (domainBuf[i] != (uint8_t)i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void raw_segmented_upload(uint32_t n, uint16_t index) {
+    for (uint32_t i = 0; i < n; i++) {
+        const uint8_t *rsp;
+        uint8_t toggle = 0;
+        size_t len = 0;
+        bool_t last = false;
+
+        raw_send(0x40, (uint8_t)index, (uint8_t)(index >> 8), 0, 0);
+        rsp = raw_wait();
+        if (rsp == NULL || (rsp[0] & 0xF3) != 0x41) {
+            raw_abort();
+            continue;
+        }
+        while (!last) {
+            raw_send(0x60 | toggle, 0, 0, 0, 0);
+            rsp = raw_wait();
+            if (rsp == NULL || (rsp[0] & 0xF0) != toggle) {
+                break;
+            }
+            size_t count = 7 - ((rsp[0] >> 1) & 0x07);
+            if (len + count > sizeof(domainBuf)) {
+                break;
+            }
+            memcpy(&domainBuf[len], &rsp[1], count);
+            len += count;
+            last = (rsp[0] & 0x01) != 0;
+            toggle ^= 0x10;
+        }
+        if (!last || !domain_verify(len)) {
+            raw_abort();
+            continue;
+        }
+        xfer.transfers++;
+        xfer.bytes += len;
+    }
+}
+
+static void raw_block_upload(uint32_t n, uint16_t index) {
+    for (uint32_t i = 0; i < n; i++) {
+        const uint8_t *rsp;
+        size_t len = 0;
+        bool_t last = false;
+        bool_t ok = true;
+
+        /* initiate, client supports CRC, pst = 0 */
+        raw_send(0xA4, (uint8_t)index, (uint8_t)(index >> 8), 0,
+                 BENCH_SDO_BLKSIZE);
+        rsp = raw_wait();
+        if (rsp == NULL || (rsp[0] & 0xF9) != 0xC0) {
+            raw_abort();
+            continue;
+        }
+        raw_send(0xA3, 0, 0, 0, 0);
+
+        /* sub-blocks */
+        while (!last && ok) {
+            uint8_t seqno = 0;
+
+            while (ok) {
+                rsp = raw_wait();
+                if (rsp == NULL || (rsp[0] & 0x7F) != seqno + 1
+                    || len + 7 > sizeof(domainBuf)
+                ) {
+                    ok = false;
+                    break;
+                }
+                seqno++;
+                memcpy(&domainBuf[len], &rsp[1], 7);
+                len += 7;
+                if ((rsp[0] & 0x80) != 0) {
+                    last = true;
+                    break;
+                }
+                if (seqno >= BENCH_SDO_BLKSIZE) {
+                    break;
+                }
+            }
+            if (ok) {
+                raw_send(0xA2, seqno, BENCH_SDO_BLKSIZE, 0, 0);
+            }
+        }
+
+        /* end: remove unused bytes of last segment and verify CRC */
+        if (ok) {
+            rsp = raw_wait();
+            if (rsp == NULL || (rsp[0] & 0xE3) != 0xC1) {
+                ok = false;
+            }
+            else {
+                len -= (rsp[0] >> 2) & 0x07;
+                uint16_t crc = (uint16_t)rsp[1] | ((uint16_t)rsp[2] << 8);
+                ok = crc == crc16_ccitt(domainBuf, len, 0)
+                     && domain_verify(len);
+            }
+        }
+        if (!ok) {
+            raw_abort();
+            continue;
+        }
+        raw_send(0xA1, 0, 0, 0, 0);
+        CO_SDOserver_process(&SDOblk, true, 0, NULL);
+        xfer.transfers++;
+        xfer.bytes += len;
+    }
+}
+
+static void bench_sdo_segmented_upload(uint32_t n) {
+    raw_segmented_upload(n, BENCH_SDO_DOMAIN_INDEX);
+}
+
+static void bench_sdo_block_upload(uint32_t n) {
+    raw_block_upload(n, BENCH_SDO_DOMAIN_INDEX);
+}
+
+static void bench_sdo_stream_segmented_upload(uint32_t n) {
+    raw_segmented_upload(n, BENCH_SDO_STREAM_INDEX);
+}
+
+static void bench_sdo_stream_block_upload(uint32_t n) {
+    raw_block_upload(n, BENCH_SDO_STREAM_INDEX);
+}
+
+static void bench_sdo_scan(uint32_t n) {
+    uint32_t value = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        for (int k = 0; k < BENCH_SDO_SCAN_COUNT; k++) {
+            CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
+            CO_SDO_return_t ret;
+            int loops = 0;
+
+            ret = CO_SDOclientUploadInitiate(&SDOclient, BENCH_OBJ_INDEX,
+                                             BENCH_OBJ_SUB, 1000, false);
+            if (ret != CO_SDO_RT_ok_communicationEnd) {
+                errors++;
+                continue;
+            }
+            do {
+                ret = CO_SDOclientUpload(&SDOclient, 0, false, &abortCode,
+                                         NULL, NULL, NULL);
+                CO_SDOserver_process(&SDOserver, true, 0, NULL);
+                scanCycles++;
+            } while (ret > 0 && ++loops < BENCH_SDO_MAX_LOOPS);
+
+            if (ret != CO_SDO_RT_ok_communicationEnd) {
+                errors++;
+            }
+            CO_SDOclientUploadBufRead(&SDOclient, (uint8_t *)&value,
+                                      sizeof(value));
+        }
+        scanCount++;
+    }
+    sink = value;
+}
+
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BATCH
+static void bench_sdo_batch_scan(uint32_t n) {
+    static CO_SDOclientBatchEntry_t entries[BENCH_SDO_SCAN_COUNT];
+    static uint32_t values[BENCH_SDO_SCAN_COUNT];
+    CO_SDOclientBatch_t batch;
+
+    for (int k = 0; k < BENCH_SDO_SCAN_COUNT; k++) {
+        entries[k].nodeId = BENCH_SDO_SRV_NODE_ID;
+        entries[k].download = false;
+        entries[k].index = BENCH_OBJ_INDEX;
+        entries[k].subIndex = BENCH_OBJ_SUB;
+        entries[k].data = &values[k];
+        entries[k].dataSize = sizeof(values[k]);
+    }
+
+    for (uint32_t i = 0; i < n; i++) {
+        CO_SDO_return_t ret;
+        int loops = 0;
+
+        CO_SDOclientBatchInit(&batch, entries, BENCH_SDO_SCAN_COUNT, 1000);
+        do {
+            ret = CO_SDOclientBatch(&SDOclient, &batch, 0, false, NULL);
+            CO_SDOserver_process(&SDOserver, true, 0, NULL);
+            scanCycles++;
+        } while (ret > 0
+                 && ++loops < BENCH_SDO_SCAN_COUNT * BENCH_SDO_MAX_LOOPS);
+
+        if (ret != CO_SDO_RT_ok_communicationEnd || batch.errors != 0) {
+            errors++;
+        }
+        scanCount++;
+    }
+    sink = values[0];
+}
+#endif
+
+/* CRC of a block byte by byte, as CO_fifo did it, and with the block
+ * function, which uses slicing tables, if configured */
+static void bench_crc16_single(uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        uint16_t crc = 0;
+        for (size_t k = 0; k < sizeof(crcData); k++) {
+            crc16_ccitt_single(&crc, crcData[k]);
+        }
+        if (crc != crcExpected) {
+            errors++;
+        }
+    }
+    opBytes = sizeof(crcData);
+}
+
+static void bench_crc16_block(uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        if (crc16_ccitt(crcData, sizeof(crcData), 0) != crcExpected) {
+            errors++;
+        }
+    }
+    opBytes = sizeof(crcData);
+}
+
+/* Write one chunk into the fifo and read it back */
+static void bench_fifo_write_read(uint32_t n) {
+    static uint8_t out[BENCH_FIFO_CHUNK];
+
+    for (uint32_t i = 0; i < n; i++) {
+        if (CO_fifo_write(&fifo, fifoData, sizeof(fifoData), NULL)
+                != sizeof(fifoData)
+            || CO_fifo_read(&fifo, out, sizeof(out), NULL) != sizeof(out)
+        ) {
+            errors++;
+            CO_fifo_reset(&fifo);
+        }
+    }
+    sink = out[BENCH_FIFO_CHUNK - 1];
+    opBytes = BENCH_FIFO_CHUNK;
+}
+
+/* One 1 ms cycle of the heartbeat consumer with one received heartbeat */
+static void bench_hb_consumer_tick(uint32_t n) {
+    CO_loopbackMsg_t msg = {.DLC = 1, .data = {CO_NMT_OPERATIONAL}};
+
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t timerNext_us = 1000;
+
+        msg.ident = CO_CAN_ID_HEARTBEAT + 1 + hbNextNode;
+        CO_loopback_receive(&hbCAN, &msg);
+        if (++hbNextNode >= BENCH_HB_CONS_NODES) {
+            hbNextNode = 0;
+        }
+        CO_HBconsumer_process(&HBcons, true, 1000, &timerNext_us);
+    }
+    if (!HBcons.allMonitoredOperational) {
+        errors++;
+    }
+}
+
+typedef struct {
+    const char *name;
+    const char *unit;
+    void (*run)(uint32_t n);
+} bench_t;
+
+static const bench_t benches[] = {
+    {"tpdo_build", "frame", bench_tpdo_build},
+    {"rpdo_apply", "frame", bench_rpdo_apply},
+    {"od_find", "call", bench_od_find},
+    {"od_find_miss", "call", bench_od_find_miss},
+    {"od_getSub", "call", bench_od_getSub},
+    {"od_get_u8", "call", bench_od_get_u8},
+    {"od_get_u32", "call", bench_od_get_u32},
+    {"od_set_u32", "call", bench_od_set_u32},
+    {"sdo_expedited_upload", "round_trip", bench_sdo_upload},
+    {"sdo_expedited_download", "round_trip", bench_sdo_download},
+    {"sdo_scan", "scan", bench_sdo_scan},
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BATCH
+    {"sdo_batch_scan", "scan", bench_sdo_batch_scan},
+#endif
+    {"sdo_segmented_upload", "transfer", bench_sdo_segmented_upload},
+    {"sdo_block_upload", "transfer", bench_sdo_block_upload},
+    {"sdo_stream_segmented_upload", "transfer",
+     bench_sdo_stream_segmented_upload},
+    {"sdo_stream_block_upload", "transfer", bench_sdo_stream_block_upload},
+    {"crc16_single", "block", bench_crc16_single},
+    {"crc16_block", "block", bench_crc16_block},
+    {"fifo_write_read", "chunk", bench_fifo_write_read},
+    {"hb_consumer_tick", "cycle", bench_hb_consumer_tick}
+};
+
+
+/* Setup ***********************************************************************/
+static int setup_pdo(void) {
+    uint32_t errInfo = 0;
+    CO_ReturnError_t err;
+    OD_entry_t *comm, *map;
+
+    err = CO_CANmodule_init(&pdoCAN, &pdoBus, pdoCANrx, 1, pdoCANtx, 1, 500);
+    if (err != CO_ERROR_NO) return -1;
+
+    /* TPDO 1 and RPDO 1: enabled, event driven, mapped BENCH_PDO_MAP_COUNT
+     * times to BENCH_PDO_MAP_OBJECT */
+    comm = OD_find(OD, OD_H1800_TXPDO_1_PARAM);
+    map = OD_find(OD, OD_H1A00_TXPDO_1_MAPPING);
+    if (comm == NULL || map == NULL) return -2;
+    OD_set_u32(comm, 1, BENCH_PDO_CAN_ID, true);
+    OD_set_u8(comm, 2, CO_PDO_TRANSM_TYPE_SYNC_EVENT_HI, true);
+    OD_set_u16(comm, 3, 0, true);
+    OD_set_u8(map, 0, 0, true);
+    for (uint8_t i = 1; i <= BENCH_PDO_MAP_COUNT; i++) {
+        OD_set_u32(map, i, BENCH_PDO_MAP_OBJECT, true);
+    }
+    OD_set_u8(map, 0, BENCH_PDO_MAP_COUNT, true);
+
+    err = CO_TPDO_init(&TPDO, OD, &em,
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_ENABLE
+                       NULL,
+#endif
+                       0, comm, map, &pdoCAN, 0, &errInfo);
+    if (err != CO_ERROR_NO || !TPDO.PDO_common.valid) {
+        fprintf(stderr, "TPDO init failed: %d, 0x%08lX\n",
+                err, (unsigned long)errInfo);
+        return -3;
+    }
+
+    comm = OD_find(OD, OD_H1400_RXPDO_1_PARAM);
+    map = OD_find(OD, OD_H1600_RXPDO_1_MAPPING);
+    if (comm == NULL || map == NULL) return -4;
+    OD_set_u32(comm, 1, BENCH_PDO_CAN_ID, true);
+    OD_set_u8(comm, 2, CO_PDO_TRANSM_TYPE_SYNC_EVENT_HI, true);
+    OD_set_u8(map, 0, 0, true);
+    for (uint8_t i = 1; i <= BENCH_PDO_MAP_COUNT; i++) {
+        OD_set_u32(map, i, BENCH_PDO_MAP_OBJECT, true);
+    }
+    OD_set_u8(map, 0, BENCH_PDO_MAP_COUNT, true);
+
+    err = CO_RPDO_init(&RPDO, OD, &em,
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_ENABLE
+                       NULL,
+#endif
+                       0, comm, map, &pdoCAN, 0, &errInfo);
+    if (err != CO_ERROR_NO || !RPDO.PDO_common.valid) {
+        fprintf(stderr, "RPDO init failed: %d, 0x%08lX\n",
+                err, (unsigned long)errInfo);
+        return -5;
+    }
+
+    CO_CANsetNormalMode(&pdoCAN);
+    return 0;
+}
+
+static int setup_sdo(void) {
+    uint32_t errInfo = 0;
+    CO_ReturnError_t err;
+    OD_entry_t *srvPar = OD_find(OD, OD_H1200_SDO_SERVER_1_PARAM);
+    OD_entry_t *cliPar = OD_find(OD, OD_H1280_SDO_CLIENT_1_PARAM);
+
+    if (srvPar == NULL || cliPar == NULL) return -1;
+
+    err = CO_CANmodule_init(&srvCAN, &sdoBus, srvCANrx, 1, srvCANtx, 1, 500);
+    if (err != CO_ERROR_NO) return -2;
+    err = CO_CANmodule_init(&cliCAN, &sdoBus, cliCANrx, 1, cliCANtx, 1, 500);
+    if (err != CO_ERROR_NO) return -3;
+
+    err = CO_SDOserver_init(&SDOserver, OD, srvPar, BENCH_SDO_SRV_NODE_ID,
+                            1000, &srvCAN, 0, &srvCAN, 0, &errInfo);
+    if (err != CO_ERROR_NO) return -4;
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+    err = CO_SDOserverPool_init(&srvPool, srvPoolBuffers, 2);
+    if (err != CO_ERROR_NO) return -4;
+    CO_SDOserver_initPool(&SDOserver, &srvPool);
+#endif
+
+    err = CO_SDOclient_init(&SDOclient, OD, cliPar, BENCH_SDO_CLI_NODE_ID,
+                            &cliCAN, 0, &cliCAN, 0, &errInfo);
+    if (err != CO_ERROR_NO) return -5;
+
+    if (CO_SDOclient_setup(&SDOclient,
+                           CO_CAN_ID_SDO_CLI + BENCH_SDO_SRV_NODE_ID,
+                           CO_CAN_ID_SDO_SRV + BENCH_SDO_SRV_NODE_ID,
+                           BENCH_SDO_SRV_NODE_ID)
+        != CO_SDO_RT_ok_communicationEnd
+    ) {
+        return -6;
+    }
+
+    CO_CANsetNormalMode(&srvCAN);
+    CO_CANsetNormalMode(&cliCAN);
+    return 0;
+}
+
+static int setup_sdo_block(void) {
+    uint32_t errInfo = 0;
+    CO_ReturnError_t err;
+    OD_entry_t *srvPar = OD_find(OD, OD_H1200_SDO_SERVER_1_PARAM);
+    OD_entry_t *domain = OD_find(OD, BENCH_SDO_DOMAIN_INDEX);
+
+    if (srvPar == NULL || domain == NULL) return -1;
+
+    /* OD of the server: DOMAIN from OD.c and the variable for streaming */
+    for (size_t i = 0; i < sizeof(streamData); i++) {
+        streamData[i] = (uint8_t)i;
+    }
+    streamVar.dataOrig = streamData;
+    streamVar.attribute = ODA_SDO_R;
+    streamVar.dataLength = sizeof(streamData);
+    blkODlist[0] = *domain;
+    blkODlist[1].index = BENCH_SDO_STREAM_INDEX;
+    blkODlist[1].subEntriesCount = 1;
+    blkODlist[1].odObjectType = ODT_VAR;
+    blkODlist[1].odObject = &streamVar;
+    blkODlist[1].extension = NULL;
+    blkOD.size = 2;
+    blkOD.list = blkODlist;
+    domain = &blkODlist[0];
+
+    err = CO_CANmodule_init(&blkSrvCAN, &blkBus, blkSrvCANrx, 1,
+                            blkSrvCANtx, 1, 500);
+    if (err != CO_ERROR_NO) return -2;
+    err = CO_CANmodule_init(&rawCAN, &blkBus, rawCANrx, 1, rawCANtx, 1, 500);
+    if (err != CO_ERROR_NO) return -3;
+
+    err = CO_SDOserver_init(&SDOblk, &blkOD, srvPar, BENCH_SDO_SRV_NODE_ID,
+                            1000, &blkSrvCAN, 0, &blkSrvCAN, 0, &errInfo);
+    if (err != CO_ERROR_NO) return -4;
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+    CO_SDOserver_initPool(&SDOblk, &srvPool);
+#endif
+
+    err = CO_CANrxBufferInit(&rawCAN, 0,
+                             CO_CAN_ID_SDO_SRV + BENCH_SDO_SRV_NODE_ID,
+                             0x7FF, false, NULL, raw_receive);
+    if (err != CO_ERROR_NO) return -5;
+    rawTx = CO_CANtxBufferInit(&rawCAN, 0,
+                               CO_CAN_ID_SDO_CLI + BENCH_SDO_SRV_NODE_ID,
+                               false, 8, false);
+    if (rawTx == NULL) return -6;
+
+    domainExtension.object = NULL;
+    domainExtension.read = domain_read;
+    domainExtension.write = NULL;
+    if (OD_extension_init(domain, &domainExtension) != ODR_OK) return -7;
+
+    CO_CANsetNormalMode(&blkSrvCAN);
+    CO_CANsetNormalMode(&rawCAN);
+    return 0;
+}
+
+static void setup_crc(void) {
+    /* pseudo random data, reference crc calculated bit by bit */
+    uint32_t x = 1;
+    uint16_t crc = 0;
+
+    for (size_t i = 0; i < sizeof(crcData); i++) {
+        x = x * 1103515245UL + 12345UL;
+        crcData[i] = (uint8_t)(x >> 16);
+        crc ^= (uint16_t)crcData[i] << 8;
+        for (int j = 0; j < 8; j++) {
+            crc = (crc & 0x8000U) ? (uint16_t)((crc << 1) ^ 0x1021U)
+                                  : (uint16_t)(crc << 1);
+        }
+    }
+    crcExpected = crc;
+}
+
+static void setup_fifo(void) {
+    for (size_t i = 0; i < sizeof(fifoData); i++) {
+        fifoData[i] = (uint8_t)i;
+    }
+    CO_fifo_init(&fifo, fifoBuf, sizeof(fifoBuf));
+}
+
+static int setup_hb_consumer(void) {
+    static CO_loopbackBus_t hbBus;
+    CO_ReturnError_t err;
+
+    for (uint8_t i = 0; i < BENCH_HB_CONS_NODES; i++) {
+        hbTimes[i] = ((uint32_t)(i + 1) << 16) | BENCH_HB_CONS_TIME_MS;
+    }
+    hbTimesArr.dataOrig0 = &hbTimes0;
+    hbTimesArr.dataOrig = hbTimes;
+    hbTimesArr.attribute0 = ODA_SDO_R;
+    hbTimesArr.attribute = ODA_SDO_RW | ODA_MB;
+    hbTimesArr.dataElementLength = sizeof(hbTimes[0]);
+    hbTimesArr.dataElementSizeof = sizeof(hbTimes[0]);
+    hbEntry.index = OD_H1016_CONSUMER_HB_TIME;
+    hbEntry.subEntriesCount = BENCH_HB_CONS_NODES + 1;
+    hbEntry.odObjectType = ODT_ARR;
+    hbEntry.odObject = &hbTimesArr;
+    hbEntry.extension = NULL;
+
+    err = CO_CANmodule_init(&hbCAN, &hbBus, hbCANrx, BENCH_HB_CONS_NODES,
+                            hbCANtx, 1, 500);
+    if (err != CO_ERROR_NO) return -1;
+    err = CO_HBconsumer_init(&HBcons, &em, hbNodes, BENCH_HB_CONS_NODES,
+                             &hbEntry, &hbCAN, 0, NULL);
+    if (err != CO_ERROR_NO) return -2;
+    CO_CANsetNormalMode(&hbCAN);
+
+    /* all nodes active and operational */
+    CO_HBconsumer_process(&HBcons, true, 0, NULL);
+    bench_hb_consumer_tick(BENCH_HB_CONS_NODES);
+    return HBcons.allMonitoredOperational ? 0 : -3;
+}
+
+
+/* Measurement *****************************************************************/
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+typedef struct {
+    uint32_t iterations;
+    double ns_median;
+    double ns_min;
+} result_t;
+
+static result_t measure(const bench_t *b, uint32_t minTime_ms, int repeat) {
+    uint64_t minTime_ns = (uint64_t)minTime_ms * 1000000ULL;
+    uint32_t n = 1;
+    uint64_t t;
+    double samples[32];
+    result_t r;
+
+    /* calibrate number of iterations, including warm-up */
+    for (;;) {
+        t = now_ns();
+        b->run(n);
+        t = now_ns() - t;
+        if (t >= minTime_ns / 8 || n >= 0x40000000UL) {
+            break;
+        }
+        n *= 2;
+    }
+    if (t > 0 && t < minTime_ns) {
+        uint64_t scaled = (uint64_t)n * minTime_ns / t;
+        n = scaled > 0xFFFFFFFFULL ? 0xFFFFFFFFUL : (uint32_t)scaled;
+    }
+
+    for (int i = 0; i < repeat; i++) {
+        t = now_ns();
+        b->run(n);
+        t = now_ns() - t;
+        samples[i] = (double)t / n;
+    }
+    qsort(samples, (size_t)repeat, sizeof(samples[0]), cmp_double);
+
+    r.iterations = n;
+    r.ns_median = samples[repeat / 2];
+    r.ns_min = samples[0];
+    return r;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [-t min_time_ms] [-r repeat] [-o output.json] "
+            "[-f filter]\n", prog);
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t minTime_ms = 200;
+    int repeat = 5;
+    const char *outName = NULL;
+    const char *filter = NULL;
+    FILE *out = stdout;
+    int ret;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            minTime_ms = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            repeat = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            outName = argv[++i];
+        }
+        else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        }
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (minTime_ms == 0 || repeat < 1 || repeat > 32) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    benchEntry = OD_find(OD, BENCH_OBJ_INDEX);
+    if (benchEntry == NULL) {
+        fprintf(stderr, "Object 0x%04X not in OD\n", BENCH_OBJ_INDEX);
+        return 1;
+    }
+    if ((ret = setup_pdo()) != 0) {
+        fprintf(stderr, "PDO setup failed (%d)\n", ret);
+        return 1;
+    }
+    if ((ret = setup_sdo()) != 0) {
+        fprintf(stderr, "SDO setup failed (%d)\n", ret);
+        return 1;
+    }
+    if ((ret = setup_sdo_block()) != 0) {
+        fprintf(stderr, "SDO block setup failed (%d)\n", ret);
+        return 1;
+    }
+    setup_crc();
+    setup_fifo();
+    if ((ret = setup_hb_consumer()) != 0) {
+        fprintf(stderr, "HB consumer setup failed (%d)\n", ret);
+        return 1;
+    }
+
+    if (outName != NULL && (out = fopen(outName, "w")) == NULL) {
+        perror(outName);
+        return 1;
+    }
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"benchmark\": \"co_bench\",\n");
+    fprintf(out, "  \"od\": \"%s\",\n", BENCH_OD_NAME);
+    fprintf(out, "  \"config\": {\n");
+    fprintf(out, "    \"CO_CONFIG_PDO\": \"0x%04X\",\n",
+            (unsigned)(CO_CONFIG_PDO));
+    fprintf(out, "    \"CO_CONFIG_SDO_SRV\": \"0x%04X\",\n",
+            (unsigned)(CO_CONFIG_SDO_SRV));
+    fprintf(out, "    \"CO_CONFIG_SDO_CLI\": \"0x%04X\",\n",
+            (unsigned)(CO_CONFIG_SDO_CLI));
+    fprintf(out, "    \"pdo_map\": \"0x%08lX\",\n",
+            (unsigned long)BENCH_PDO_MAP_OBJECT);
+    fprintf(out, "    \"pdo_map_count\": %d,\n", BENCH_PDO_MAP_COUNT);
+    fprintf(out, "    \"CO_CONFIG_SDO_SRV_BUFFER_SIZE\": %d,\n",
+            (int)(CO_CONFIG_SDO_SRV_BUFFER_SIZE));
+    fprintf(out, "    \"sdo_domain_size\": %d,\n", BENCH_SDO_DOMAIN_SIZE);
+    fprintf(out, "    \"sdo_scan_count\": %d,\n", BENCH_SDO_SCAN_COUNT);
+    fprintf(out, "    \"sdo_blksize\": %d,\n", (int)(BENCH_SDO_BLKSIZE));
+    fprintf(out, "    \"can_bitrate\": %d,\n", BENCH_CAN_BITRATE);
+    fprintf(out, "    \"sdo_turnaround_us\": %d,\n", BENCH_SDO_TURNAROUND_US);
+    fprintf(out, "    \"CO_CONFIG_CRC16\": \"0x%02X\",\n",
+            (unsigned)(CO_CONFIG_CRC16));
+    fprintf(out, "    \"crc_size\": %d,\n", BENCH_CRC_SIZE);
+    fprintf(out, "    \"fifo_size\": %d,\n", BENCH_FIFO_SIZE);
+    fprintf(out, "    \"fifo_chunk\": %d,\n", BENCH_FIFO_CHUNK);
+    fprintf(out, "    \"CO_CONFIG_HB_CONS\": \"0x%04X\",\n",
+            (unsigned)(CO_CONFIG_HB_CONS));
+    fprintf(out, "    \"hb_cons_nodes\": %d\n", BENCH_HB_CONS_NODES);
+    fprintf(out, "  },\n");
+    fprintf(out, "  \"min_time_ms\": %lu,\n", (unsigned long)minTime_ms);
+    fprintf(out, "  \"repeat\": %d,\n", repeat);
+    fprintf(out, "  \"results\": [");
+
+    const char *sep = "\n";
+    for (size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++) {
+        const bench_t *b = &benches[i];
+        unsigned long errorsBefore = errors;
+        result_t r;
+
+        if (filter != NULL && strstr(b->name, filter) == NULL) {
+            continue;
+        }
+        memset(&xfer, 0, sizeof(xfer));
+        scanCycles = scanCount = 0;
+        opBytes = 0;
+        r = measure(b, minTime_ms, repeat);
+
+        fprintf(out, "%s    {\"name\": \"%s\", \"unit\": \"%s\", "
+                "\"iterations\": %lu, \"ns_per_op\": %.2f, "
+                "\"ns_per_op_min\": %.2f, \"ops_per_s\": %.0f, "
+                "\"errors\": %lu",
+                sep, b->name, b->unit, (unsigned long)r.iterations,
+                r.ns_median, r.ns_min,
+                r.ns_median > 0 ? 1e9 / r.ns_median : 0.0,
+                errors - errorsBefore);
+        if (xfer.transfers > 0) {
+            /* time of one transfer on the CAN bus: frames plus reaction
+             * time of the nodes, each time the direction changes */
+            double t = (double)xfer.frames * BENCH_CAN_FRAME_BITS
+                       / BENCH_CAN_BITRATE
+                       + (double)xfer.turnarounds * BENCH_SDO_TURNAROUND_US
+                       / 1e6;
+            fprintf(out, ", \"bytes_per_op\": %.0f, \"frames_per_op\": %.1f, "
+                    "\"turnarounds_per_op\": %.1f, \"can_bytes_per_s\": %.0f",
+                    (double)xfer.bytes / xfer.transfers,
+                    (double)xfer.frames / xfer.transfers,
+                    (double)xfer.turnarounds / xfer.transfers,
+                    t > 0 ? (double)xfer.bytes / t : 0.0);
+        }
+        if (scanCount > 0) {
+            fprintf(out, ", \"objects_per_op\": %d, \"cycles_per_op\": %.1f",
+                    BENCH_SDO_SCAN_COUNT, (double)scanCycles / scanCount);
+        }
+        if (opBytes > 0) {
+            fprintf(out, ", \"bytes_per_op\": %lu, \"ns_per_byte\": %.3f, "
+                    "\"mbytes_per_s\": %.1f",
+                    (unsigned long)opBytes, r.ns_median / opBytes,
+                    r.ns_median > 0 ? 1e3 * opBytes / r.ns_median : 0.0);
+        }
+        fprintf(out, "}");
+        sep = ",\n";
+    }
+    fprintf(out, "\n  ]\n}\n");
+
+    if (out != stdout) {
+        fclose(out);
+    }
+
+    return errors != 0 ? 1 : 0;
+}
@@ -0,0 +1,74 @@
+/*
+  CRC16-CCITT throughput on the Bluepill (STM32F103, Cortex-M3).
+
+  Counterpart of the crc16_* benchmarks of co_bench on the target. It uses
+  crc16-ccitt.c as configured by CO_CONFIG_CRC16 in CO_driver_target.h and
+  prints one JSON line per block size on the serial port (115200 baud) every
+  two seconds:
+
+    {"size": 889, "single_cycles_per_byte": ..., "block_cycles_per_byte": ...}
+
+  Time is measured with the DWT cycle counter. 889 bytes is one SDO block
+  transfer sub-block with blksize 127.
+*/
+
+#include "CANopen.h"
+#include "301/crc16-ccitt.h"
+
+#define CRC_MAX_SIZE 889
+
+static uint8_t data[CRC_MAX_SIZE];
+static const uint16_t sizes[] = {7, 64, 448, CRC_MAX_SIZE};
+static volatile uint16_t sink;
+
+/*
+  CPU cycles of crc over size bytes, byte by byte or with the block function
+*/
+uint32_t cycles_crc(uint16_t size, bool block) {
+  uint16_t crc = 0;
+  uint32_t start = DWT->CYCCNT;
+
+  if (block) {
+    crc = crc16_ccitt(data, size, 0);
+  } else {
+    for (uint16_t i = 0; i < size; i++) {
+      crc16_ccitt_single(&crc, data[i]);
+    }
+  }
+
+  uint32_t cycles = DWT->CYCCNT - start;
+  sink = crc;
+  return cycles;
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  for (uint16_t i = 0; i < CRC_MAX_SIZE; i++) {
+    data[i] = (uint8_t)(i * 7 + 3);
+  }
+
+  /* enable DWT cycle counter */
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+void loop() {
+  for (uint8_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+    uint16_t size = sizes[i];
+    uint32_t single = cycles_crc(size, false);
+    uint32_t block = cycles_crc(size, true);
+
+    Serial.print("{\"size\": ");
+    Serial.print(size);
+    Serial.print(", \"single_cycles_per_byte\": ");
+    Serial.print((float)single / size, 2);
+    Serial.print(", \"block_cycles_per_byte\": ");
+    Serial.print((float)block / size, 2);
+    Serial.print(", \"CO_CONFIG_CRC16\": ");
+    Serial.print(CO_CONFIG_CRC16);
+    Serial.println("}");
+  }
+  delay(2000);
+}
@@ -0,0 +1,16 @@
+/*
+ * Host replacement of <Arduino.h> for building the CANopenNode stack with
+ * libraries/drivers/CO_driver_target.h on Linux (tools/bench).
+ *
+ * Only the symbols used by CO_driver_target.h are provided. Benchmark is
+ * single threaded, so critical sections are empty.
+ */
+
+#ifndef BENCH_HOST_ARDUINO_H
+#define BENCH_HOST_ARDUINO_H
+
+#define __disable_irq() do { } while (0)
+#define __enable_irq()  do { } while (0)
+#define __DMB()         __sync_synchronize()
+
+#endif /* BENCH_HOST_ARDUINO_H */
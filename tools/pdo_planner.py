@@ -0,0 +1,849 @@
+#!/usr/bin/env python3
+"""
+CANopen bus-load planner and PDO packing optimizer.
+
+Reads the object dictionary description (EDS or XDD, the same files the OD
+generator consumes) of every node on the network and evaluates the PDO
+communication and mapping parameters (0x14xx/0x16xx/0x18xx/0x1Axx):
+
+ - worst-case frame length of every periodic message, including bit stuffing,
+ - total bus load,
+ - worst-case response time of every message under CAN arbitration
+   (fixed priority non-preemptive analysis, Davis et al. 2007),
+ - a repacked set of synchronous TPDO mappings which minimises the number of
+   frames per SYNC, together with the matching RPDO mappings of consumers,
+ - OD overlays (EDS sections with new DefaultValue) for the changed nodes.
+
+Example:
+    python3 tools/pdo_planner.py --bitrate 500000 --sync-us 10000 \\
+        2:ODs/Slave_STM32/Slave_STM32.eds 3:ODs/Slave_STM32/Slave_STM32.xdd \\
+        --overlay-dir build/overlays
+
+Only the python standard library is used.
+"""
+
+import argparse
+import configparser
+import json
+import math
+import os
+import re
+import sys
+import xml.etree.ElementTree as ET
+
+CAN_MAX_DATA = 8
+PDO_MAX_ENTRIES = 8
+PDO_COUNT_MAX = 512
+
+TPDO_COMM = 0x1800
+TPDO_MAP = 0x1A00
+RPDO_COMM = 0x1400
+RPDO_MAP = 0x1600
+
+COB_INVALID = 0x80000000
+COB_EXTENDED = 0x20000000
+
+# Pre-defined connection set, first four PDOs of each direction
+TPDO_PREDEFINED = (0x180, 0x280, 0x380, 0x480)
+RPDO_PREDEFINED = (0x200, 0x300, 0x400, 0x500)
+
+# Dummy objects usable in RPDO mapping, (length in bytes, mapping value)
+DUMMY_MAP = ((4, 0x00070020), (2, 0x00060010), (1, 0x00050008))
+
+XDD_DATATYPES = {
+    "BOOL": 0x01, "SINT": 0x02, "INT": 0x03, "DINT": 0x04, "USINT": 0x05,
+    "UINT": 0x06, "UDINT": 0x07, "REAL": 0x08, "VISIBLE_STRING": 0x09,
+    "OCTET_STRING": 0x0A, "UNICODE_STRING": 0x0B, "DOMAIN": 0x0F,
+    "LREAL": 0x11, "LINT": 0x15, "ULINT": 0x1B,
+}
+
+
+class PlannerError(Exception):
+    pass
+
+
+###############################################################################
+# Object dictionary loading
+###############################################################################
+class Entry:
+    def __init__(self, default, datatype=None, pdo_mapping=False):
+        self.default = default
+        self.datatype = datatype
+        self.pdo_mapping = pdo_mapping
+
+
+class ObjectDictionary:
+    """Flat view of (index, subIndex) -> Entry from an EDS or XDD file."""
+
+    def __init__(self, path):
+        self.path = path
+        self.entries = {}
+        ext = os.path.splitext(path)[1].lower()
+        if ext in (".xdd", ".xdc", ".xml"):
+            self._load_xdd(path)
+        else:
+            self._load_eds(path)
+
+    def _load_eds(self, path):
+        cp = configparser.ConfigParser(strict=False, interpolation=None,
+                                       comment_prefixes=(";", "#"))
+        cp.optionxform = str
+        with open(path, encoding="utf-8", errors="replace") as f:
+            cp.read_file(f)
+        pattern = re.compile(r"^([0-9A-Fa-f]{4})(?:sub([0-9A-Fa-f]{1,2}))?$")
+        for section in cp.sections():
+            m = pattern.match(section)
+            if m is None:
+                continue
+            sec = cp[section]
+            # Record and array headers carry no value, only their subs do.
+            if m.group(2) is None and "SubNumber" in sec:
+                continue
+            index = int(m.group(1), 16)
+            sub = int(m.group(2), 16) if m.group(2) is not None else 0
+            datatype = sec.get("DataType")
+            self.entries[(index, sub)] = Entry(
+                sec.get("DefaultValue", "0").strip(),
+                parse_int(datatype) if datatype else None,
+                sec.get("PDOMapping", "0").strip() == "1")
+
+    def _load_xdd(self, path):
+        root = ET.parse(path).getroot()
+
+        def local(tag):
+            return tag.rsplit("}", 1)[-1]
+
+        params = {}
+        for el in root.iter():
+            if local(el.tag) != "parameter" or "uniqueID" not in el.attrib:
+                continue
+            default = None
+            datatype = None
+            for child in el:
+                name = local(child.tag)
+                if name == "defaultValue":
+                    default = child.attrib.get("value")
+                elif name in XDD_DATATYPES:
+                    datatype = XDD_DATATYPES[name]
+            params[el.attrib["uniqueID"]] = (default, datatype)
+
+        def add(index, sub, el):
+            default, datatype = params.get(el.attrib.get("uniqueIDRef"),
+                                           (None, None))
+            if default is None:
+                default = el.attrib.get("defaultValue", "0")
+            if datatype is None and "dataType" in el.attrib:
+                datatype = int(el.attrib["dataType"], 16)
+            mapping = el.attrib.get("PDOmapping", "no").lower() != "no"
+            self.entries[(index, sub)] = Entry(default.strip(), datatype,
+                                               mapping)
+
+        for obj in root.iter():
+            if local(obj.tag) != "CANopenObject":
+                continue
+            index = int(obj.attrib["index"], 16)
+            subs = [s for s in obj if local(s.tag) == "CANopenSubObject"]
+            if not subs:
+                add(index, 0, obj)
+            for s in subs:
+                add(index, int(s.attrib["subIndex"], 16), s)
+
+    def has(self, index, sub=0):
+        return (index, sub) in self.entries
+
+    def value(self, index, sub, node_id, fallback=0):
+        """Numeric default value, with $NODEID resolved."""
+        e = self.entries.get((index, sub))
+        if e is None:
+            return fallback
+        return parse_int(e.default, node_id)
+
+
+def parse_int(text, node_id=0):
+    """Parse EDS integer, accepting 0x prefix and "$NODEID+" expressions."""
+    text = text.strip()
+    if not text:
+        return 0
+    total = 0
+    for term in text.replace(" ", "").split("+"):
+        if term.upper() == "$NODEID":
+            total += node_id
+        elif term.lower().startswith("0x"):
+            total += int(term, 16)
+        else:
+            total += int(term)
+    return total
+
+
+###############################################################################
+# Network model
+###############################################################################
+class MapEntry:
+    def __init__(self, index, sub, bits):
+        self.index = index
+        self.sub = sub
+        self.bits = bits
+
+    @classmethod
+    def from_value(cls, value):
+        return cls((value >> 16) & 0xFFFF, (value >> 8) & 0xFF, value & 0xFF)
+
+    @property
+    def size(self):
+        return self.bits // 8
+
+    @property
+    def is_dummy(self):
+        return self.index < 0x20 and self.sub == 0
+
+    def value(self):
+        return (self.index << 16) | (self.sub << 8) | self.bits
+
+    def __repr__(self):
+        return "%04X:%02X/%d" % (self.index, self.sub, self.bits)
+
+
+class Pdo:
+    def __init__(self, node, tx, num):
+        self.node = node
+        self.tx = tx
+        self.num = num
+        comm = (TPDO_COMM if tx else RPDO_COMM) + num
+        mapp = (TPDO_MAP if tx else RPDO_MAP) + num
+        od = node.od
+        nid = node.node_id
+
+        cob = od.value(comm, 1, nid, COB_INVALID)
+        can_id = cob & (0x1FFFFFFF if cob & COB_EXTENDED else 0x7FF)
+        predefined = TPDO_PREDEFINED if tx else RPDO_PREDEFINED
+        # Same rule as CO_PDO.c: a pre-defined base COB-ID gets the node-ID.
+        if num < len(predefined) and can_id == predefined[num]:
+            can_id += nid
+        self.cob_raw = cob
+        self.can_id = can_id
+        self.extended = bool(cob & COB_EXTENDED)
+        self.valid = not (cob & COB_INVALID) and can_id != 0
+        self.trans_type = od.value(comm, 2, nid, 254)
+        self.inhibit_100us = od.value(comm, 3, nid, 0) if tx else 0
+        self.event_ms = od.value(comm, 5, nid, 0)
+        self.sync_start = od.value(comm, 6, nid, 0) if tx else 0
+
+        self.mapping = []
+        count = od.value(mapp, 0, nid, 0)
+        for i in range(1, min(count, PDO_MAX_ENTRIES) + 1):
+            self.mapping.append(MapEntry.from_value(od.value(mapp, i, nid)))
+
+    @property
+    def name(self):
+        return "%s%d@%02X" % ("TPDO" if self.tx else "RPDO", self.num + 1,
+                              self.node.node_id)
+
+    @property
+    def dlc(self):
+        return sum(e.size for e in self.mapping)
+
+    @property
+    def is_sync(self):
+        return self.trans_type <= 240
+
+    def mapping_error(self):
+        if len(self.mapping) > PDO_MAX_ENTRIES:
+            return "more than %d mapped objects" % PDO_MAX_ENTRIES
+        for e in self.mapping:
+            if e.bits % 8 != 0:
+                return "%r is not byte aligned" % e
+            if not e.is_dummy and not self.node.od.has(e.index, e.sub):
+                return "%r does not exist in OD" % e
+        if self.dlc > CAN_MAX_DATA:
+            return "mapped length %d exceeds %d bytes" % (self.dlc,
+                                                           CAN_MAX_DATA)
+        return None
+
+
+class Node:
+    def __init__(self, node_id, path):
+        if not 1 <= node_id <= 127:
+            raise PlannerError("node-ID %d out of range 1..127" % node_id)
+        self.node_id = node_id
+        self.path = path
+        self.od = ObjectDictionary(path)
+        self.tpdos = self._pdos(True)
+        self.rpdos = self._pdos(False)
+        self.heartbeat_ms = self.od.value(0x1017, 0, node_id, 0)
+        self.sync_cob = self.od.value(0x1005, 0, node_id, 0x80)
+        self.sync_period_us = self.od.value(0x1006, 0, node_id, 0)
+        self.sync_window_us = self.od.value(0x1007, 0, node_id, 0)
+        self.sync_overflow = self.od.value(0x1019, 0, node_id, 0)
+
+    def _pdos(self, tx):
+        base = TPDO_COMM if tx else RPDO_COMM
+        pdos = []
+        for num in range(PDO_COUNT_MAX):
+            if not self.od.has(base + num, 1):
+                break
+            pdos.append(Pdo(self, tx, num))
+        return pdos
+
+    @property
+    def name(self):
+        return "%02X(%s)" % (self.node_id, os.path.basename(self.path))
+
+
+class Network:
+    def __init__(self, nodes, bitrate, sync_us=None, jitter_us=0.0,
+                 cos_floor_us=1000.0):
+        self.nodes = nodes
+        self.bitrate = bitrate
+        self.jitter_us = jitter_us
+        self.cos_floor_us = cos_floor_us
+        self.warnings = []
+
+        producers = [n for n in nodes if n.sync_cob & 0x40000000]
+        if sync_us is None:
+            periods = [n.sync_period_us for n in producers
+                       if n.sync_period_us] or \
+                      [n.sync_period_us for n in nodes if n.sync_period_us]
+            sync_us = max(periods) if periods else 0
+        self.sync_us = sync_us
+        windows = [n.sync_window_us for n in nodes if n.sync_window_us]
+        self.sync_window_us = min(windows) if windows else 0
+        self.sync_cob = producers[0].sync_cob & 0x7FF if producers else 0x80
+        self.sync_dlc = 1 if any(n.sync_overflow > 1 for n in nodes) else 0
+
+    @property
+    def bit_us(self):
+        return 1e6 / self.bitrate
+
+    def tpdo_by_id(self):
+        table = {}
+        for n in self.nodes:
+            for p in n.tpdos:
+                if p.valid:
+                    table.setdefault(p.can_id, []).append(p)
+        return table
+
+    def consumers(self, tpdo):
+        return [r for n in self.nodes for r in n.rpdos
+                if r.valid and r.can_id == tpdo.can_id
+                and r.node is not tpdo.node]
+
+
+###############################################################################
+# Timing analysis
+###############################################################################
+def frame_bits(dlc, extended=False):
+    """Worst-case frame length in bits, including stuffing and interframe
+    space (Davis, Burns, Bril, Lukkien, "Controller Area Network (CAN)
+    schedulability analysis: Refuted, revisited and revised", 2007)."""
+    if extended:
+        return 8 * dlc + 67 + (54 + 8 * dlc - 1) // 4
+    return 8 * dlc + 47 + (34 + 8 * dlc - 1) // 4
+
+
+class Frame:
+    def __init__(self, name, can_id, extended, dlc, period_us, deadline_us,
+                 jitter_us, note=""):
+        self.name = name
+        self.can_id = can_id
+        self.extended = extended
+        self.dlc = dlc
+        self.period_us = period_us
+        self.deadline_us = deadline_us
+        self.jitter_us = jitter_us
+        self.note = note
+        self.bits = frame_bits(dlc, extended)
+        self.c_us = 0.0
+        self.response_us = None
+
+    @property
+    def priority(self):
+        # Arbitration compares the 11 base bits first, then IDE (standard
+        # frame wins), then the 18 extension bits.
+        if self.extended:
+            return ((self.can_id >> 18) << 19) | (1 << 18) | \
+                (self.can_id & 0x3FFFF)
+        return self.can_id << 19
+
+    def as_dict(self):
+        return {
+            "name": self.name, "can_id": self.can_id, "dlc": self.dlc,
+            "bits": self.bits, "c_us": round(self.c_us, 2),
+            "period_us": self.period_us, "deadline_us": self.deadline_us,
+            "response_us": None if self.response_us is None
+            else round(self.response_us, 2),
+            "note": self.note,
+        }
+
+
+def tpdo_timing(net, pdo):
+    """Minimum inter-arrival time, deadline and note of a TPDO, or None."""
+    t = pdo.trans_type
+    if t <= 240:
+        if not net.sync_us:
+            net.warnings.append("%s is synchronous but no SYNC period is "
+                                "known (use --sync-us)" % pdo.name)
+            return None
+        period = net.sync_us * max(t, 1)
+        deadline = net.sync_window_us or net.sync_us
+        return period, min(deadline, period), "sync/%d" % max(t, 1)
+    if t in (252, 253):
+        return None
+    if pdo.inhibit_100us:
+        period = pdo.inhibit_100us * 100
+        return period, period, "inhibit"
+    if pdo.event_ms and pdo.event_ms * 1000 <= net.cos_floor_us:
+        period = pdo.event_ms * 1000
+        return period, period, "event"
+    net.warnings.append("%s: event driven without inhibit time, rate is only "
+                        "bounded by the processing cycle (%g us assumed)"
+                        % (pdo.name, net.cos_floor_us))
+    return net.cos_floor_us, net.cos_floor_us, "cos!"
+
+
+def build_frames(net):
+    frames = []
+    jitter = net.jitter_us
+    if net.sync_us:
+        frames.append(Frame("SYNC", net.sync_cob, False, net.sync_dlc,
+                            net.sync_us, net.sync_us, jitter))
+    produced = set()
+    for n in net.nodes:
+        for p in n.tpdos:
+            if not p.valid:
+                continue
+            err = p.mapping_error()
+            if err:
+                net.warnings.append("%s: %s" % (p.name, err))
+            timing = tpdo_timing(net, p)
+            if timing is None:
+                continue
+            produced.add(p.can_id)
+            frames.append(Frame(p.name, p.can_id, p.extended,
+                                min(p.dlc, CAN_MAX_DATA), timing[0],
+                                timing[1], jitter, timing[2]))
+        if n.heartbeat_ms:
+            hb = n.heartbeat_ms * 1000
+            frames.append(Frame("HB@%02X" % n.node_id, 0x700 + n.node_id,
+                                False, 1, hb, hb, jitter))
+    # RPDOs whose producer is not part of the description (e.g. a host).
+    for n in net.nodes:
+        for r in n.rpdos:
+            if not r.valid or r.can_id in produced:
+                continue
+            err = r.mapping_error()
+            if err:
+                net.warnings.append("%s: %s" % (r.name, err))
+            if r.is_sync and net.sync_us:
+                produced.add(r.can_id)
+                frames.append(Frame("ext>" + r.name, r.can_id, r.extended,
+                                    min(r.dlc, CAN_MAX_DATA), net.sync_us,
+                                    net.sync_us, jitter, "external"))
+            else:
+                net.warnings.append("%s: producer of 0x%X is unknown, not "
+                                    "counted" % (r.name, r.can_id))
+
+    seen = {}
+    for f in frames:
+        if f.can_id in seen and not f.name.startswith("ext>"):
+            net.warnings.append("CAN-ID 0x%X used by %s and %s"
+                                % (f.can_id, seen[f.can_id], f.name))
+        seen.setdefault(f.can_id, f.name)
+        f.c_us = f.bits * net.bit_us
+    frames.sort(key=lambda f: f.priority)
+    return frames
+
+
+def bus_load(frames):
+    return sum(f.c_us / f.period_us for f in frames)
+
+
+def _ceil(x):
+    return math.ceil(x - 1e-9)
+
+
+def response_times(frames, bit_us, max_iter=10000):
+    """Worst-case response time of every frame, frames sorted by priority.
+    response_us stays None when the busy period does not converge."""
+    for i, m in enumerate(frames):
+        hp = frames[:i]
+        lp = frames[i + 1:]
+        blocking = max([f.c_us for f in lp] + [0.0])
+        if bus_load(frames[:i + 1]) >= 1.0:
+            continue
+
+        # Length of the level-m busy period
+        t = m.c_us
+        for _ in range(max_iter):
+            t_new = blocking + sum(_ceil((t + k.jitter_us) / k.period_us)
+                                   * k.c_us for k in hp + [m])
+            if t_new <= t:
+                break
+            t = t_new
+        else:
+            continue
+        instances = _ceil((t + m.jitter_us) / m.period_us)
+
+        worst = 0.0
+        w = blocking
+        for q in range(max(instances, 1)):
+            w = max(w, blocking + q * m.c_us)
+            for _ in range(max_iter):
+                w_new = blocking + q * m.c_us + \
+                    sum(_ceil((w + k.jitter_us + bit_us) / k.period_us)
+                        * k.c_us for k in hp)
+                if w_new <= w:
+                    break
+                w = w_new
+            else:
+                worst = None
+                break
+            worst = max(worst, m.jitter_us + w - q * m.period_us + m.c_us)
+        m.response_us = worst
+
+
+###############################################################################
+# PDO repacking
+###############################################################################
+class Item:
+    """One mapped object of a producer TPDO together with its byte range."""
+
+    def __init__(self, pdo, entry, offset):
+        self.pdo = pdo
+        self.entry = entry
+        self.offset = offset
+
+
+def pack(items):
+    """First fit decreasing of mapped objects into CAN frames."""
+    bins = []
+    for it in sorted(items, key=lambda x: (-x.entry.size, x.pdo.num,
+                                           x.offset)):
+        for b in bins:
+            if sum(x.entry.size for x in b) + it.entry.size <= CAN_MAX_DATA \
+                    and len(b) < PDO_MAX_ENTRIES:
+                b.append(it)
+                break
+        else:
+            bins.append([it])
+    # Keep original order inside a frame, less churn for consumers.
+    for b in bins:
+        b.sort(key=lambda x: (x.pdo.num, x.offset))
+    return bins
+
+
+def dummies(size):
+    out = []
+    for length, value in DUMMY_MAP:
+        while size >= length:
+            out.append(MapEntry.from_value(value))
+            size -= length
+    return out
+
+
+def consumer_slice(rpdo, offset, size):
+    """RPDO entries which receive bytes [offset, offset+size) of the frame,
+    None if the consumer entries are not aligned to the producer object."""
+    pos = 0
+    out = []
+    for e in rpdo.mapping:
+        if pos >= offset and pos + e.size <= offset + size:
+            out.append(e)
+        elif pos < offset + size and pos + e.size > offset:
+            return None
+        pos += e.size
+    if sum(e.size for e in out) < size:
+        out += dummies(size - sum(e.size for e in out))
+    return out
+
+
+class NodePlan:
+    def __init__(self, node):
+        self.node = node
+        # pdo -> (cob, trans_type, [MapEntry]) ; only changed PDOs
+        self.tpdo = {}
+        self.rpdo = {}
+
+    def empty(self):
+        return not self.tpdo and not self.rpdo
+
+
+def repack(net):
+    """Repack synchronous TPDOs of every node. Objects are only moved between
+    TPDOs with identical transmission type, so every object keeps its rate.
+    Returns (plans, notes)."""
+    plans = {n.node_id: NodePlan(n) for n in net.nodes}
+    notes = []
+
+    for n in net.nodes:
+        groups = {}
+        for p in n.tpdos:
+            if p.valid and p.is_sync and p.mapping and not p.mapping_error():
+                groups.setdefault(p.trans_type, []).append(p)
+        for trans_type, pdos in sorted(groups.items()):
+            items = []
+            for p in pdos:
+                off = 0
+                for e in p.mapping:
+                    if not e.is_dummy:
+                        items.append(Item(p, e, off))
+                    off += e.size
+            bins = pack(items)
+            if len(bins) >= len(pdos):
+                continue
+            note = _apply_group(net, plans, n, pdos, bins, trans_type)
+            notes.append(note)
+    return plans, notes
+
+
+def _apply_group(net, plans, node, pdos, bins, trans_type):
+    slots = sorted(pdos, key=lambda p: p.can_id)
+    new = {}
+    for b, slot in zip(bins, slots):
+        new[slot] = b
+    plan = plans[node.node_id]
+    for slot in slots:
+        if slot in new:
+            mapping = [it.entry for it in new[slot]]
+            plan.tpdo[slot] = (slot.can_id, trans_type, mapping)
+        else:
+            plan.tpdo[slot] = (slot.can_id | COB_INVALID, trans_type, [])
+
+    # Consumers: rebuild RPDOs listening to any PDO of the group.
+    conflicts = []
+    for c in net.nodes:
+        if c is node:
+            continue
+        listening = {}
+        for p in pdos:
+            for r in net.consumers(p):
+                if r.node is c:
+                    listening[p] = r
+        if not listening:
+            continue
+        free = [r for r in c.rpdos if not r.valid]
+        available = list(listening.values()) + free
+        cplan = plans[c.node_id]
+        used = set()
+        for slot, b in new.items():
+            if not any(it.pdo in listening for it in b):
+                continue
+            mapping = []
+            ok = True
+            for it in b:
+                r = listening.get(it.pdo)
+                if r is None:
+                    mapping += dummies(it.entry.size)
+                    continue
+                part = consumer_slice(r, it.offset, it.entry.size)
+                if part is None:
+                    ok = False
+                    break
+                mapping += part
+            if not ok or len(mapping) > PDO_MAX_ENTRIES:
+                conflicts.append("%s cannot follow %s" % (c.name, slot.name))
+                continue
+            # Prefer the RPDO which already listens on the kept COB-ID.
+            target = next((r for r in available if r not in used
+                           and r.can_id == slot.can_id and r.valid), None) \
+                or next((r for r in available if r not in used), None)
+            if target is None:
+                conflicts.append("%s has no free RPDO for %s"
+                                 % (c.name, slot.name))
+                continue
+            used.add(target)
+            cplan.rpdo[target] = (slot.can_id, target.trans_type
+                                  if target.valid else trans_type, mapping)
+        for r in listening.values():
+            if r not in used:
+                cplan.rpdo[r] = (r.can_id | COB_INVALID, r.trans_type, [])
+
+    rate = "SYNC" if trans_type <= 1 else "%d SYNCs" % trans_type
+    text = "node %02X: %d -> %d TPDOs every %s" % (node.node_id, len(pdos),
+                                                   len(bins), rate)
+    if conflicts:
+        text += " (" + "; ".join(conflicts) + ")"
+    return text
+
+
+def apply_plans(net, plans):
+    """Write planned values back into the loaded PDO objects."""
+    for plan in plans.values():
+        for table in (plan.tpdo, plan.rpdo):
+            for pdo, (cob, trans_type, mapping) in table.items():
+                pdo.cob_raw = cob
+                pdo.can_id = cob & (0x1FFFFFFF if cob & COB_EXTENDED
+                                    else 0x7FF)
+                pdo.valid = not (cob & COB_INVALID)
+                pdo.trans_type = trans_type
+                pdo.mapping = list(mapping)
+
+
+def frames_per_sync(net):
+    total = 0.0
+    for n in net.nodes:
+        for p in n.tpdos:
+            if p.valid and p.is_sync:
+                total += 1.0 / max(p.trans_type, 1)
+    return total
+
+
+def write_overlay(plan, directory):
+    node = plan.node
+    base = os.path.splitext(os.path.basename(node.path))[0]
+    path = os.path.join(directory, "%s_node%02X_pdo.eds" % (base,
+                                                            node.node_id))
+    lines = [
+        "; PDO overlay for node-ID 0x%02X, generated by pdo_planner.py from"
+        % node.node_id,
+        "; %s. Replace DefaultValue of the listed sections in the EDS"
+        % os.path.basename(node.path),
+        "; (or XDD) before running the OD generator.",
+        "",
+    ]
+
+    def section(name, value):
+        lines.extend(["[%s]" % name, "DefaultValue=%s" % value, ""])
+
+    for tx, table in ((True, plan.tpdo), (False, plan.rpdo)):
+        comm = TPDO_COMM if tx else RPDO_COMM
+        mapp = TPDO_MAP if tx else RPDO_MAP
+        for pdo, (cob, trans_type, mapping) in sorted(
+                table.items(), key=lambda kv: kv[0].num):
+            section("%04Xsub1" % (comm + pdo.num), "0x%08X" % cob)
+            section("%04Xsub2" % (comm + pdo.num), "%d" % trans_type)
+            section("%04Xsub0" % (mapp + pdo.num), "%d" % len(mapping))
+            for i in range(PDO_MAX_ENTRIES):
+                value = mapping[i].value() if i < len(mapping) else 0
+                section("%04Xsub%X" % (mapp + pdo.num, i + 1),
+                        "0x%08X" % value)
+    os.makedirs(directory, exist_ok=True)
+    with open(path, "w", encoding="utf-8") as f:
+        f.write("\n".join(lines))
+    return path
+
+
+###############################################################################
+# Reporting
+###############################################################################
+def analyse(net):
+    frames = build_frames(net)
+    response_times(frames, net.bit_us)
+    return frames
+
+
+def summary(net, frames):
+    missed = [f.name for f in frames
+              if f.response_us is None or f.response_us > f.deadline_us]
+    return {
+        "bitrate": net.bitrate,
+        "sync_us": net.sync_us,
+        "bus_load": round(bus_load(frames), 4),
+        "frames_per_sync": round(frames_per_sync(net), 3),
+        "deadline_misses": missed,
+        "frames": [f.as_dict() for f in frames],
+    }
+
+
+def print_report(title, net, frames, out=sys.stdout):
+    s = summary(net, frames)
+    out.write("== %s ==\n" % title)
+    out.write("bitrate %d bit/s, SYNC %s, bus load %.1f %%, %.2f TPDO frames"
+              " per SYNC\n" % (net.bitrate, "%d us" % net.sync_us
+                               if net.sync_us else "off",
+                               100 * s["bus_load"], s["frames_per_sync"]))
+    out.write("%-14s %8s %3s %4s %8s %10s %10s %10s  %s\n"
+              % ("frame", "CAN-ID", "DLC", "bits", "C[us]", "T[us]",
+                 "D[us]", "R[us]", "note"))
+    for f in frames:
+        r = "unbound" if f.response_us is None else "%.1f" % f.response_us
+        flag = "" if f.response_us is not None \
+            and f.response_us <= f.deadline_us else " MISS"
+        out.write("%-14s %8X %3d %4d %8.1f %10.0f %10.0f %10s  %s%s\n"
+                  % (f.name, f.can_id, f.dlc, f.bits, f.c_us, f.period_us,
+                     f.deadline_us, r, f.note, flag))
+    out.write("\n")
+
+
+def parse_node_arg(text):
+    try:
+        node_id, path = text.split(":", 1)
+        return int(node_id, 0), path
+    except ValueError:
+        raise argparse.ArgumentTypeError("expected NODEID:PATH, got '%s'"
+                                         % text)
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(
+        description="CANopen bus-load planner and PDO packing optimizer.")
+    ap.add_argument("nodes", nargs="+", type=parse_node_arg,
+                    metavar="NODEID:PATH",
+                    help="node-ID and its EDS/XDD file")
+    ap.add_argument("--bitrate", type=int, default=500000,
+                    help="CAN bitrate in bit/s (default 500000)")
+    ap.add_argument("--sync-us", type=int, default=None,
+                    help="SYNC period in us, default from 0x1006")
+    ap.add_argument("--jitter-us", type=float, default=0.0,
+                    help="queuing jitter of every frame, e.g. the "
+                         "processing interval (default 0)")
+    ap.add_argument("--cos-floor-us", type=float, default=1000.0,
+                    help="assumed minimum period of event driven TPDOs "
+                         "without inhibit time (default 1000)")
+    ap.add_argument("--overlay-dir", default=None,
+                    help="write OD overlays of repacked nodes here")
+    ap.add_argument("--no-repack", action="store_true",
+                    help="only analyse the given configuration")
+    ap.add_argument("--json", action="store_true",
+                    help="print results as JSON")
+    args = ap.parse_args(argv)
+
+    try:
+        nodes = [Node(nid, path) for nid, path in args.nodes]
+    except (OSError, PlannerError, ET.ParseError,
+            configparser.Error) as e:
+        ap.error(str(e))
+    ids = [n.node_id for n in nodes]
+    if len(set(ids)) != len(ids):
+        ap.error("duplicate node-ID")
+
+    net = Network(nodes, args.bitrate, args.sync_us, args.jitter_us,
+                  args.cos_floor_us)
+    frames = analyse(net)
+    result = {"current": summary(net, frames)}
+    if not args.json:
+        print_report("current configuration", net, frames)
+
+    if not args.no_repack:
+        plans, notes = repack(net)
+        overlays = []
+        if notes:
+            apply_plans(net, plans)
+            new_frames = analyse(net)
+            result["repacked"] = summary(net, new_frames)
+            if not args.json:
+                print_report("repacked configuration", net, new_frames)
+            if args.overlay_dir:
+                overlays = [write_overlay(p, args.overlay_dir)
+                            for p in plans.values() if not p.empty()]
+        result["repack_notes"] = notes
+        result["overlays"] = overlays
+        if not args.json:
+            for line in notes or ["nothing to repack"]:
+                print("repack: " + line)
+            for path in overlays:
+                print("overlay: " + path)
+
+    result["warnings"] = sorted(set(net.warnings))
+    if args.json:
+        json.dump(result, sys.stdout, indent=2)
+        sys.stdout.write("\n")
+    else:
+        for w in result["warnings"]:
+            print("warning: " + w)
+
+    misses = result.get("repacked", result["current"])["deadline_misses"]
+    return 1 if misses else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+"""
+SDO client cache policy generator.
+
+Reads the EDS file of every node on the network and writes a C policy table
+for CO_SDOclientCache (libraries/CANopenNode/src/301/CO_SDOclientCache.h):
+
+ - objects with AccessType=const are immutable,
+ - CiA 301 constant objects (0x1000, 0x1008..0x100A, 0x1018) are immutable,
+   also if the EDS declares them ro, as most generators do,
+ - read-only manufacturer and profile objects (0x2000 and above), which are
+   not PDO mappable, get --ttl-ms,
+ - other objects are not cached.
+
+Policy entries of all sub-indexes of an object with the same time to live are
+merged into one entry. The table is used by the master with:
+
+    CO_SDOclientCache_initPolicy(CO->SDOclientCache, SDOcachePolicy,
+                                 SDOcachePolicyCount);
+
+Example:
+    python3 tools/sdo_cache_policy.py --ttl-ms 5000 \\
+        4:ODs/Slave_STM32/Slave_STM32.eds -o master/SDOcachePolicy.c
+
+Only the python standard library is used.
+"""
+
+import argparse
+import configparser
+import re
+import sys
+
+CONST_OBJECTS = (0x1000, 0x1008, 0x1009, 0x100A, 0x1018)
+TTL_FIRST_INDEX = 0x2000
+IMMUTABLE = "CO_SDO_CLI_CACHE_TTL_IMMUTABLE"
+SUB_ALL = "CO_SDO_CLI_CACHE_SUB_ALL"
+
+
+def load_eds(path):
+    """Return {index: (name, [(sub, access, pdo_mapping), ...])}."""
+    cp = configparser.ConfigParser(strict=False, interpolation=None,
+                                   comment_prefixes=(";", "#"))
+    cp.optionxform = str
+    with open(path, encoding="utf-8", errors="replace") as f:
+        cp.read_file(f)
+    pattern = re.compile(r"^([0-9A-Fa-f]{4})(?:sub([0-9A-Fa-f]{1,2}))?$")
+    objects = {}
+    names = {}
+    for section in cp.sections():
+        m = pattern.match(section)
+        if m is None:
+            continue
+        sec = cp[section]
+        index = int(m.group(1), 16)
+        if m.group(2) is None:
+            names[index] = sec.get("ParameterName", "").strip()
+            # Record and array headers carry no access type, only their subs.
+            if "SubNumber" in sec:
+                continue
+        sub = int(m.group(2), 16) if m.group(2) is not None else 0
+        objects.setdefault(index, []).append((
+            sub,
+            sec.get("AccessType", "rw").strip().lower(),
+            sec.get("PDOMapping", "0").strip() == "1"))
+    return {i: (names.get(i, ""), sorted(subs))
+            for i, subs in objects.items()}
+
+
+def ttl_of(index, access, pdo_mapping, ttl_ms):
+    """Time to live of the sub-object, IMMUTABLE or None if not cached."""
+    if access == "const" or index in CONST_OBJECTS:
+        return IMMUTABLE
+    if access == "ro" and not pdo_mapping and index >= TTL_FIRST_INDEX:
+        return str(ttl_ms)
+    return None
+
+
+def policy(node_id, objects, ttl_ms):
+    """Policy entries (index, sub, node_id, ttl, name) of one node."""
+    entries = []
+    for index in sorted(objects):
+        name, subs = objects[index]
+        ttls = [(sub, ttl_of(index, access, mapping, ttl_ms))
+                for sub, access, mapping in subs]
+        if len(ttls) > 1 and len(set(t for _, t in ttls)) == 1:
+            if ttls[0][1] is not None:
+                entries.append((index, SUB_ALL, node_id, ttls[0][1], name))
+            continue
+        for sub, ttl in ttls:
+            if ttl is not None:
+                entries.append((index, str(sub), node_id, ttl, name))
+    return entries
+
+
+def write_c(out, entries, sources, name):
+    out.write("/* Generated by tools/sdo_cache_policy.py from %s,\n"
+              " * do not edit. */\n\n" % ", ".join(sources))
+    out.write('#include "301/CO_SDOclientCache.h"\n\n')
+    out.write("const CO_SDOclientCachePolicy_t %s[] = {\n" % name)
+    for i, (index, sub, node_id, ttl, comment) in enumerate(entries):
+        sep = "," if i < len(entries) - 1 else ""
+        line = "    {0x%04X, %s, %d, %s}%s" % (index, sub, node_id, ttl, sep)
+        if comment:
+            line = "%-64s /* %s */" % (line, comment.replace("*/", ""))
+        out.write(line + "\n")
+    out.write("};\n\n")
+    out.write("const uint16_t %sCount =\n"
+              "    sizeof(%s) / sizeof(%s[0]);\n" % (name, name, name))
+
+
+def parse_node_arg(text):
+    try:
+        node_id, path = text.split(":", 1)
+        return int(node_id, 0), path
+    except ValueError:
+        raise argparse.ArgumentTypeError("expected NODEID:PATH, got '%s'"
+                                         % text)
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(
+        description="SDO client cache policy generator.")
+    ap.add_argument("nodes", nargs="+", type=parse_node_arg,
+                    metavar="NODEID:PATH",
+                    help="node-ID and its EDS file, node-ID 0 for all nodes")
+    ap.add_argument("--ttl-ms", type=int, default=10000,
+                    help="time to live of read-only objects in ms "
+                         "(default 10000)")
+    ap.add_argument("--name", default="SDOcachePolicy",
+                    help="name of the C array (default SDOcachePolicy)")
+    ap.add_argument("-o", "--output", default=None,
+                    help="output file (default stdout)")
+    args = ap.parse_args(argv)
+
+    if args.ttl_ms <= 0 or args.ttl_ms >= 0xFFFFFFFF:
+        ap.error("--ttl-ms out of range")
+    ids = [nid for nid, _ in args.nodes]
+    if len(set(ids)) != len(ids) or any(n < 0 or n > 127 for n in ids):
+        ap.error("node-IDs must be unique and 0..127")
+
+    entries = []
+    try:
+        for node_id, path in args.nodes:
+            entries += policy(node_id, load_eds(path), args.ttl_ms)
+    except (OSError, configparser.Error) as e:
+        ap.error(str(e))
+    if not entries:
+        ap.error("no cacheable objects found")
+    # first matching entry is used, so entries for all nodes go last
+    entries.sort(key=lambda e: e[2] == 0)
+
+    sources = [path for _, path in args.nodes]
+    if args.output:
+        with open(args.output, "w") as out:
+            write_c(out, entries, sources, args.name)
+    else:
+        write_c(sys.stdout, entries, sources, args.name)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())